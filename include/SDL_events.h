@@ -662,6 +662,28 @@ extern DECLSPEC void SDLCALL SDL_FlushEvents(Uint32 minType, Uint32 maxType);
  */
 extern DECLSPEC int SDLCALL SDL_PollEvent(SDL_Event * event);
 
+/**
+ *  \brief Polls for all currently pending events in a type range at once.
+ *
+ *  This pumps the event loop once and then moves up to \c numevents events,
+ *  within the specified minimum and maximum type, out of the queue while
+ *  holding the queue lock only once. Pass ::SDL_FIRSTEVENT and
+ *  ::SDL_LASTEVENT to drain every event. This is much cheaper than calling
+ *  SDL_PollEvent() in a loop when many events are queued.
+ *
+ *  \return The number of events stored in \c events, or -1 if there was an
+ *          error.
+ *
+ *  \param events An array of at least \c numevents events.
+ *  \param numevents The maximum number of events to retrieve.
+ *  \param minType The lowest event type to retrieve.
+ *  \param maxType The highest event type to retrieve.
+ *
+ *  \sa SDL_PeepEvents
+ */
+extern DECLSPEC int SDLCALL SDL_PollEvents(SDL_Event * events, int numevents,
+                                           Uint32 minType, Uint32 maxType);
+
 /**
  *  \brief Waits indefinitely for the next available event.
  *
@@ -135,7 +135,7 @@ extern "C" {
  *
  *  This variable can be set to the following values:
  *    "0" or "nearest" - Nearest pixel sampling
- *    "1" or "linear"  - Linear filtering (supported by OpenGL and Direct3D)
+ *    "1" or "linear"  - Linear filtering (supported by OpenGL, Direct3D and the software renderer)
  *    "2" or "best"    - Currently this is the same as "linear"
  *
  *  By default nearest pixel sampling is used
@@ -1093,7 +1093,8 @@ extern "C" {
  *  that you will either never use the underlying graphics API directly, or
  *  if you do, you will call SDL_RenderFlush() before you do so any current
  *  batch goes to the GPU before your work begins. Not following this contract
- *  will result in undefined behavior.
+ *  will result in undefined behavior. Renderers created with
+ *  SDL_CreateSoftwareRenderer() only batch when this is set to "1".
  */
 #define SDL_HINT_RENDER_BATCHING  "SDL_RENDER_BATCHING"
 
@@ -1120,6 +1121,198 @@ extern "C" {
 #define SDL_HINT_EVENT_LOGGING   "SDL_EVENT_LOGGING"
 
 
+/**
+ *  \brief  A variable controlling how many threads software blits may use.
+ *
+ *  Large surface blits, fills, stretches and SDL_ConvertPixels() calls are
+ *  split into horizontal bands that run in parallel on a pool of worker
+ *  threads. Operations smaller than 256x256 pixels always run on the
+ *  calling thread.
+ *
+ *  This variable can be set to the following values:
+ *    "0" or "1"  - Run all blits on the calling thread (default)
+ *    "N"         - Split large blits across N threads, including the calling thread
+ *    "-1"        - Use one thread per CPU core
+ *
+ *  The worker threads are created on the first large blit and shut down
+ *  with the video subsystem. Lowering the value at runtime takes effect
+ *  immediately; raising it above the number of threads already started
+ *  takes effect after the video subsystem is reinitialized.
+ */
+#define SDL_HINT_BLIT_THREADS   "SDL_BLIT_THREADS"
+
+
+/**
+ *  \brief  A variable controlling how many threads the software renderer may use.
+ *
+ *  With more than one thread, the software renderer sorts the queued render
+ *  commands into 64x64 pixel tiles and draws the tiles in parallel. The
+ *  result is the same as drawing on one thread. Diagonal lines, scaled RGB
+ *  copies and rotated copies that cross a tile edge are still drawn on the
+ *  calling thread, between the parallel passes. This works best with
+ *  SDL_HINT_RENDER_BATCHING enabled, so whole frames are drawn at once.
+ *  Targets smaller than 256x256 pixels are always drawn on one thread.
+ *
+ *  This variable can be set to the following values:
+ *    "0" or "1"  - Draw on the calling thread (default)
+ *    "N"         - Draw on N threads, including the calling thread
+ *    "-1"        - Use one thread per CPU core
+ *
+ *  This hint is checked every time the render commands are flushed.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_THREADS   "SDL_RENDER_SOFTWARE_THREADS"
+
+
+/**
+ *  \brief  A variable setting how many bytes of vertex data a renderer reserves for its render command queue.
+ *
+ *  The vertex data of the queued render commands is allocated from one
+ *  buffer, which is kept and reused after the queue is flushed, and is
+ *  grown when a frame doesn't fit. Setting this to the size a frame needs
+ *  avoids growing it while the first frames are drawn.
+ *
+ *  By default no vertex data is reserved up front.
+ *
+ *  This hint is checked when a renderer is created.
+ */
+#define SDL_HINT_RENDER_VERTEX_CAPACITY   "SDL_RENDER_VERTEX_CAPACITY"
+
+
+/**
+ *  \brief  A variable naming a file to record the render commands of a renderer into.
+ *
+ *  When this is set as a renderer is created, the textures it creates and
+ *  updates and everything drawn with it are written to this file, frame by
+ *  frame, in a compact binary format. The file can be played back against
+ *  any renderer with SDL_RenderOpenReplay() and SDL_RenderReplayFrame(), to
+ *  benchmark renderers or to check their output against a known result.
+ *
+ *  By default nothing is recorded.
+ *
+ *  This hint is checked when a renderer is created.
+ */
+#define SDL_HINT_RENDER_CAPTURE_FILE   "SDL_RENDER_CAPTURE_FILE"
+
+
+/**
+ *  \brief  A variable setting how many frames are recorded with SDL_HINT_RENDER_CAPTURE_FILE.
+ *
+ *  The file is closed when this many frames have been presented. By
+ *  default, or when this is "0", recording goes on until the renderer is
+ *  destroyed.
+ *
+ *  This hint is checked when a renderer is created.
+ */
+#define SDL_HINT_RENDER_CAPTURE_FRAMES   "SDL_RENDER_CAPTURE_FRAMES"
+
+
+/**
+ *  \brief  A variable setting how many buffers streaming textures are created with.
+ *
+ *  Locking or updating a texture that is used by render commands which
+ *  haven't been drawn yet makes the renderer draw them first, which breaks
+ *  up the batch of the frame. With more than one buffer, a lock or update
+ *  of the whole texture is instead given a buffer that no queued command
+ *  uses, and the buffers are cycled through as the texture is drawn. This
+ *  helps video players and other programs that update a streaming texture
+ *  every frame. Locks and updates of part of a texture always use the
+ *  buffer that was updated last, since the rest of it has to be kept.
+ *
+ *  This variable can be set to the following values:
+ *    "1"         - Streaming textures have one buffer (default)
+ *    "N"         - Streaming textures have N buffers, up to 8
+ *
+ *  Each buffer takes as much memory as the texture. This hint is checked
+ *  when a streaming texture is created.
+ */
+#define SDL_HINT_RENDER_STREAMING_BUFFERS   "SDL_RENDER_STREAMING_BUFFERS"
+
+
+/**
+ *  \brief  A variable controlling whether the software renderer draws at the logical size.
+ *
+ *  With a logical size set by SDL_RenderSetLogicalSize() and integer scaling
+ *  enabled by SDL_RenderSetIntegerScale(), the software renderer can draw at
+ *  the logical size into a surface of its own, and upscale it to the window
+ *  once when the frame is presented or read back, instead of scaling every
+ *  copy. Lines, points and geometry are then drawn at the logical size too,
+ *  so they are as thick as a logical pixel.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Draw scaled directly to the window (default)
+ *    "1"       - Draw at the logical size and upscale when presenting
+ *
+ *  This hint is checked when the renderer is created.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_UPSCALE   "SDL_RENDER_SOFTWARE_UPSCALE"
+
+
+/**
+ *  \brief  A variable controlling whether high-rate motion and axis events are merged in the event queue.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Every motion and axis event is queued separately (default)
+ *    "1"       - A mouse motion, finger motion, joystick axis or game controller
+ *                axis event replaces a queued, not yet retrieved event for the
+ *                same device and axis. The newest position or value is kept and
+ *                relative motion is summed, so no movement is lost.
+ *
+ *  Event filters and watchers still see every event. Only runs of motion and
+ *  axis events are merged; any other input event queued in between, such as
+ *  a button press, ends the run. This hint can be toggled at runtime.
+ */
+#define SDL_HINT_EVENT_COALESCING   "SDL_EVENT_COALESCING"
+
+
+/**
+ *  \brief  A variable controlling whether the event queue preallocates its entries.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Queue entries are allocated as needed, up to 65535 events (default)
+ *    "N"       - Preallocate N queue entries, at most 65535, in one block
+ *                when the event subsystem is initialized. The queue then
+ *                holds at most N events and never allocates memory while
+ *                adding events.
+ *
+ *  The queue is then full at N events; see SDL_HINT_EVENT_QUEUE_OVERFLOW for
+ *  what happens to events pushed after that.
+ *
+ *  This hint should be set before SDL_Init().
+ */
+#define SDL_HINT_EVENT_QUEUE_PREALLOCATE   "SDL_EVENT_QUEUE_PREALLOCATE"
+
+
+/**
+ *  \brief  A variable controlling what happens when an event is pushed onto a full event queue.
+ *
+ *  This variable can be set to the following values:
+ *    "error"       - The new event is dropped and SDL_PushEvent() returns an error (default)
+ *    "drop_oldest" - The oldest queued mouse motion, finger motion, joystick
+ *                    axis or game controller axis event is dropped to make
+ *                    room. If there is none, the new event is dropped and
+ *                    SDL_PushEvent() returns an error.
+ *
+ *  This hint can be changed at any time.
+ */
+#define SDL_HINT_EVENT_QUEUE_OVERFLOW   "SDL_EVENT_QUEUE_OVERFLOW"
+
+
+/**
+ *  \brief  A variable controlling whether the software renderer uses SSE2 or NEON code to rotate textures.
+ *
+ *  Smooth rotated copies are interpolated with SSE2 or NEON when the CPU
+ *  has them. The results are the same as the plain C code, which can be
+ *  forced to compare against it.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Always use the plain C code
+ *    "1"       - Use SSE2 or NEON when available (default)
+ *
+ *  This hint is checked every time a texture is rotated.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_SIMD   "SDL_RENDER_SOFTWARE_SIMD"
+
+
 
 /**
  *  \brief  An enumeration of hint priorities
@@ -127,6 +127,50 @@ typedef struct SDL_Renderer SDL_Renderer;
 struct SDL_Texture;
 typedef struct SDL_Texture SDL_Texture;
 
+/**
+ *  \brief Vertex structure for SDL_RenderGeometry()
+ */
+typedef struct SDL_Vertex
+{
+    SDL_FPoint position;        /**< Vertex position, in SDL_Renderer coordinates  */
+    SDL_Color  color;           /**< Vertex color */
+    SDL_FPoint tex_coord;       /**< Normalized texture coordinates, if needed */
+} SDL_Vertex;
+
+/**
+ *  \brief What caused the render command queue to be flushed
+ */
+typedef enum
+{
+    SDL_RENDERFLUSH_PRESENT,        /**< SDL_RenderPresent() */
+    SDL_RENDERFLUSH_EXPLICIT,       /**< SDL_RenderFlush() */
+    SDL_RENDERFLUSH_NOT_BATCHING,   /**< A render call, with batching disabled */
+    SDL_RENDERFLUSH_TEXTURE,        /**< A queued texture was updated, locked or destroyed */
+    SDL_RENDERFLUSH_TARGET,         /**< SDL_SetRenderTarget() */
+    SDL_RENDERFLUSH_READPIXELS,     /**< SDL_RenderReadPixels() */
+    SDL_RENDERFLUSH_NATIVE,         /**< Access to the underlying rendering API */
+    SDL_NUM_RENDERFLUSH_REASONS
+} SDL_RenderFlushReason;
+
+/**
+ *  \brief The work a renderer did during a frame, see SDL_RenderGetStats()
+ */
+typedef struct SDL_RenderStats
+{
+    Uint32 commands_queued;     /**< Render commands queued, including state changes */
+    Uint32 commands_merged;     /**< Draw commands merged into the previous command */
+    Uint32 commands_issued;     /**< Render commands run by the backend */
+    Uint32 flushes;             /**< Times the command queue was run */
+    Uint32 flush_reasons[SDL_NUM_RENDERFLUSH_REASONS];  /**< Flushes by reason */
+    Uint64 vertex_bytes;        /**< Vertex data used by the commands that were run */
+    Uint32 texture_updates;     /**< Texture updates, including the uploads of converted formats */
+    Uint32 texture_locks;       /**< Texture locks, including the ones to convert formats */
+    Uint64 pixels_filled;       /**< Pixels cleared or filled with rectangles (software renderer only) */
+    Uint64 pixels_copied;       /**< Pixels copied from textures (software renderer only) */
+    Uint64 queue_time;          /**< Time spent running the command queue, in microseconds */
+    Uint64 present_time;        /**< Time spent presenting, in microseconds */
+} SDL_RenderStats;
+
 
 /* Function prototypes */
 
@@ -795,6 +839,45 @@ extern DECLSPEC int SDLCALL SDL_RenderFillRects(SDL_Renderer * renderer,
                                                 const SDL_Rect * rects,
                                                 int count);
 
+/**
+ *  \brief Draw a series of connected lines of the given width on the current rendering target.
+ *
+ *  The lines have square ends, and pixels where lines overlap are only drawn
+ *  once. Antialiasing only applies with the ::SDL_BLENDMODE_BLEND and
+ *  ::SDL_BLENDMODE_ADD blend modes.
+ *
+ *  \param renderer The renderer which should draw the lines.
+ *  \param points The points along the lines, a single point draws a square
+ *  \param count The number of points, drawing count-1 lines
+ *  \param width The width of the lines
+ *  \param antialias SDL_TRUE to smooth the edges of the lines
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderDrawWideLines(SDL_Renderer * renderer,
+                                                    const SDL_Point * points,
+                                                    int count, float width,
+                                                    SDL_bool antialias);
+
+/**
+ *  \brief Fill a convex polygon on the current rendering target with the drawing color.
+ *
+ *  The vertices are corners of the area to fill, like the corners of a
+ *  rectangle given to SDL_RenderFillRect(). Antialiasing only applies with
+ *  the ::SDL_BLENDMODE_BLEND and ::SDL_BLENDMODE_ADD blend modes.
+ *
+ *  \param renderer The renderer which should fill the polygon.
+ *  \param points The vertices of the polygon, in either winding order
+ *  \param count The number of vertices
+ *  \param antialias SDL_TRUE to smooth the edges of the polygon
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderFillConvexPolygon(SDL_Renderer * renderer,
+                                                        const SDL_Point * points,
+                                                        int count,
+                                                        SDL_bool antialias);
+
 /**
  *  \brief Copy a portion of the texture to the current rendering target.
  *
@@ -835,6 +918,34 @@ extern DECLSPEC int SDLCALL SDL_RenderCopyEx(SDL_Renderer * renderer,
                                            const SDL_Point *center,
                                            const SDL_RendererFlip flip);
 
+/**
+ *  \brief Copy many portions of a texture to the current rendering target.
+ *
+ *  This is equivalent to calling SDL_RenderCopy() once for each item, but
+ *  the copies are queued as a single render command, which avoids most of
+ *  the per-call overhead when drawing large numbers of sprites or tiles.
+ *
+ *  \param renderer The renderer which should copy parts of a texture.
+ *  \param texture The source texture.
+ *  \param srcrects An array of source rectangles, or NULL to use the entire
+ *                  texture for every item.
+ *  \param dstrects An array of destination rectangles.
+ *  \param colors   An array of colors to modulate each item with, replacing
+ *                  the texture color and alpha modulation, or NULL to use the
+ *                  texture modulation for every item.
+ *  \param count    The number of items to copy.
+ *
+ *  \return 0 on success, or -1 on error
+ *
+ *  \sa SDL_RenderCopy()
+ */
+extern DECLSPEC int SDLCALL SDL_RenderCopyBatch(SDL_Renderer * renderer,
+                                                SDL_Texture * texture,
+                                                const SDL_Rect * srcrects,
+                                                const SDL_Rect * dstrects,
+                                                const SDL_Color * colors,
+                                                int count);
+
 
 /**
  *  \brief Draw a point on the current rendering target.
@@ -937,6 +1048,41 @@ extern DECLSPEC int SDLCALL SDL_RenderFillRectsF(SDL_Renderer * renderer,
                                                  const SDL_FRect * rects,
                                                  int count);
 
+/**
+ *  \brief Draw a series of connected lines of the given width on the current rendering target.
+ *
+ *  \param renderer The renderer which should draw the lines.
+ *  \param points The points along the lines, a single point draws a square
+ *  \param count The number of points, drawing count-1 lines
+ *  \param width The width of the lines
+ *  \param antialias SDL_TRUE to smooth the edges of the lines
+ *
+ *  \return 0 on success, or -1 on error
+ *
+ *  \sa SDL_RenderDrawWideLines()
+ */
+extern DECLSPEC int SDLCALL SDL_RenderDrawWideLinesF(SDL_Renderer * renderer,
+                                                     const SDL_FPoint * points,
+                                                     int count, float width,
+                                                     SDL_bool antialias);
+
+/**
+ *  \brief Fill a convex polygon on the current rendering target with the drawing color.
+ *
+ *  \param renderer The renderer which should fill the polygon.
+ *  \param points The vertices of the polygon, in either winding order
+ *  \param count The number of vertices
+ *  \param antialias SDL_TRUE to smooth the edges of the polygon
+ *
+ *  \return 0 on success, or -1 on error
+ *
+ *  \sa SDL_RenderFillConvexPolygon()
+ */
+extern DECLSPEC int SDLCALL SDL_RenderFillConvexPolygonF(SDL_Renderer * renderer,
+                                                         const SDL_FPoint * points,
+                                                         int count,
+                                                         SDL_bool antialias);
+
 /**
  *  \brief Copy a portion of the texture to the current rendering target.
  *
@@ -977,6 +1123,56 @@ extern DECLSPEC int SDLCALL SDL_RenderCopyExF(SDL_Renderer * renderer,
                                             const SDL_FPoint *center,
                                             const SDL_RendererFlip flip);
 
+/**
+ *  \brief Copy many portions of a texture to the current rendering target.
+ *
+ *  \param renderer The renderer which should copy parts of a texture.
+ *  \param texture The source texture.
+ *  \param srcrects An array of source rectangles, or NULL to use the entire
+ *                  texture for every item.
+ *  \param dstrects An array of destination rectangles.
+ *  \param colors   An array of colors to modulate each item with, replacing
+ *                  the texture color and alpha modulation, or NULL to use the
+ *                  texture modulation for every item.
+ *  \param count    The number of items to copy.
+ *
+ *  \return 0 on success, or -1 on error
+ *
+ *  \sa SDL_RenderCopyBatch()
+ */
+extern DECLSPEC int SDLCALL SDL_RenderCopyBatchF(SDL_Renderer * renderer,
+                                                 SDL_Texture * texture,
+                                                 const SDL_Rect * srcrects,
+                                                 const SDL_FRect * dstrects,
+                                                 const SDL_Color * colors,
+                                                 int count);
+
+/**
+ *  \brief Render a list of triangles, optionally using a texture and indices
+ *         into the vertex array.
+ *
+ *  The vertex colors are modulated by the texture color and alpha modulation.
+ *  Triangles that share an edge don't draw the pixels along it twice.
+ *
+ *  \param renderer     The rendering context.
+ *  \param texture      The texture to use, or NULL to fill the triangles with
+ *                      the vertex colors, using the draw blend mode.
+ *  \param vertices     The vertices.
+ *  \param num_vertices The number of vertices.
+ *  \param indices      An array of indices into the vertices, three for each
+ *                      triangle, or NULL to take every three vertices in order
+ *                      as a triangle.
+ *  \param num_indices  The number of indices.
+ *
+ *  \return 0 on success, or -1 if the operation is not supported
+ */
+extern DECLSPEC int SDLCALL SDL_RenderGeometry(SDL_Renderer * renderer,
+                                               SDL_Texture * texture,
+                                               const SDL_Vertex * vertices,
+                                               int num_vertices,
+                                               const int * indices,
+                                               int num_indices);
+
 /**
  *  \brief Read pixels from the current rendering target.
  *
@@ -997,11 +1193,73 @@ extern DECLSPEC int SDLCALL SDL_RenderReadPixels(SDL_Renderer * renderer,
                                                  Uint32 format,
                                                  void *pixels, int pitch);
 
+/**
+ *  \brief The function called when the pixels of SDL_RenderReadPixelsAsync() have been read.
+ *
+ *  \param userdata The userdata passed to SDL_RenderReadPixelsAsync().
+ *  \param pixels   The pixels passed to SDL_RenderReadPixelsAsync().
+ *  \param result   0 if the pixels were read, or -1 on error; call
+ *                  SDL_GetError() for more information.
+ */
+typedef void (SDLCALL * SDL_RenderReadPixelsCallback) (void *userdata, void *pixels, int result);
+
+/**
+ *  \brief Read pixels from the current rendering target without waiting for them.
+ *
+ *  \param renderer The renderer from which pixels should be read.
+ *  \param rect     A pointer to the rectangle to read, or NULL for the entire
+ *                  render target.
+ *  \param format   The desired format of the pixel data, or 0 to use the format
+ *                  of the rendering target
+ *  \param pixels   A pointer to be filled in with the pixel data, which has to
+ *                  stay valid until the callback is called.
+ *  \param pitch    The pitch of the pixels parameter.
+ *  \param callback The function called when the pixels have been read.
+ *  \param userdata A pointer that is passed to the callback.
+ *
+ *  \return 0 if the read was queued, or -1 if pixel reading is not supported.
+ *
+ *  Unlike SDL_RenderReadPixels(), this doesn't draw the queued render
+ *  commands right away. The read is queued after them, and the pixels are
+ *  read when the queue is drawn, at the latest by SDL_RenderPresent() or
+ *  SDL_SetRenderTarget(). They are what was drawn when this was called.
+ *  The callback is called on the thread drawing the queue once it's done,
+ *  and may use the renderer. If the renderer is destroyed first, the
+ *  callback is called with an error.
+ *
+ *  \sa SDL_RenderReadPixels()
+ */
+extern DECLSPEC int SDLCALL SDL_RenderReadPixelsAsync(SDL_Renderer * renderer,
+                                                      const SDL_Rect * rect,
+                                                      Uint32 format,
+                                                      void *pixels, int pitch,
+                                                      SDL_RenderReadPixelsCallback callback,
+                                                      void *userdata);
+
 /**
  *  \brief Update the screen with rendering performed.
  */
 extern DECLSPEC void SDLCALL SDL_RenderPresent(SDL_Renderer * renderer);
 
+/**
+ *  \brief Get the parts of the output that changed in the last presented frame.
+ *
+ *  The software renderer keeps track of the rectangles its draws touch, and
+ *  only copies those to the window when presenting. The first frame, and
+ *  the first one after the window was resized or exposed, change the whole
+ *  output.
+ *
+ *  \param renderer The rendering context.
+ *  \param rects    An array filled in with up to maxrects rectangles, in
+ *                  output pixels, may be NULL.
+ *  \param maxrects The number of rectangles rects can hold.
+ *
+ *  \return The number of rectangles that changed, which may be more than
+ *          maxrects, 0 if nothing changed, or -1 if the renderer doesn't
+ *          track them.
+ */
+extern DECLSPEC int SDLCALL SDL_RenderGetDamageRects(SDL_Renderer * renderer, SDL_Rect * rects, int maxrects);
+
 /**
  *  \brief Destroy the specified texture.
  *
@@ -1043,6 +1301,178 @@ extern DECLSPEC void SDLCALL SDL_DestroyRenderer(SDL_Renderer * renderer);
  */
 extern DECLSPEC int SDLCALL SDL_RenderFlush(SDL_Renderer * renderer);
 
+/**
+ *  \brief Get the statistics of the last frame of a rendering context.
+ *
+ *  A frame lasts from the end of one call to SDL_RenderPresent() to the end
+ *  of the next one, so this describes the frame that was presented last.
+ *
+ *  \param renderer The rendering context.
+ *  \param stats    A pointer filled in with the statistics.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderGetStats(SDL_Renderer * renderer, SDL_RenderStats * stats);
+
+/**
+ *  \brief A render capture being played back, see SDL_RenderOpenReplay()
+ */
+struct SDL_RenderReplay;
+typedef struct SDL_RenderReplay SDL_RenderReplay;
+
+/**
+ *  \brief Open a render capture for playback.
+ *
+ *  A render capture is recorded by setting SDL_HINT_RENDER_CAPTURE_FILE
+ *  before a renderer is created. It holds the textures the renderer created
+ *  and updated and everything that was drawn, frame by frame, in output
+ *  pixels.
+ *
+ *  \param src     The data stream to read the capture from.
+ *  \param freesrc Non-zero to close the stream when the replay is closed.
+ *  \param w       A pointer filled in with the output width of the captured
+ *                 renderer, may be NULL.
+ *  \param h       A pointer filled in with the output height of the captured
+ *                 renderer, may be NULL.
+ *
+ *  \return The replay, or NULL on error
+ *
+ *  \sa SDL_RenderReplayFrame()
+ *  \sa SDL_RenderCloseReplay()
+ */
+extern DECLSPEC SDL_RenderReplay * SDLCALL SDL_RenderOpenReplay(SDL_RWops * src, int freesrc, int *w, int *h);
+
+/**
+ *  \brief Draw the next frame of a render capture.
+ *
+ *  The frame is drawn as it was captured, but it isn't presented, so it can
+ *  be read back with SDL_RenderReadPixels() first. The same renderer must be
+ *  used for every frame of a replay, and it shouldn't have a logical size or
+ *  a scale set, as the capture is in output pixels.
+ *
+ *  \param replay   The replay.
+ *  \param renderer The rendering context to draw the frame with.
+ *
+ *  \return 1 if a frame was drawn, 0 at the end of the capture, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderReplayFrame(SDL_RenderReplay * replay, SDL_Renderer * renderer);
+
+/**
+ *  \brief Close a render capture, destroying the textures it created.
+ *
+ *  \param replay The replay.
+ */
+extern DECLSPEC void SDLCALL SDL_RenderCloseReplay(SDL_RenderReplay * replay);
+
+/**
+ *  \brief A set of textures that many small surfaces are packed into, see
+ *         SDL_CreateTextureAtlas()
+ */
+struct SDL_TextureAtlas;
+typedef struct SDL_TextureAtlas SDL_TextureAtlas;
+
+/**
+ *  \brief Create a texture atlas for a rendering context.
+ *
+ *  Surfaces added to the atlas are packed into shared textures of the given
+ *  size, which are created as they're needed. Copies from the same texture
+ *  can be drawn in one batch, so drawing many small images, like glyphs or
+ *  icons, from an atlas takes much fewer render commands than drawing them
+ *  from textures of their own.
+ *
+ *  The atlas must be destroyed before the rendering context.
+ *
+ *  \param renderer The rendering context.
+ *  \param format   The format of the textures, or 0 for
+ *                  SDL_PIXELFORMAT_ARGB8888. It can't be a YUV or indexed
+ *                  format.
+ *  \param w        The width of the textures.
+ *  \param h        The height of the textures.
+ *
+ *  \return The atlas, or NULL on error
+ *
+ *  \sa SDL_AddTextureAtlasSurfaces()
+ *  \sa SDL_DestroyTextureAtlas()
+ */
+extern DECLSPEC SDL_TextureAtlas * SDLCALL SDL_CreateTextureAtlas(SDL_Renderer * renderer,
+                                                                Uint32 format,
+                                                                int w, int h);
+
+/**
+ *  \brief Add surfaces to a texture atlas.
+ *
+ *  The surfaces are packed together, the tallest first, and then copied to
+ *  the textures of the atlas. Textures with an alpha channel use
+ *  SDL_BLENDMODE_BLEND, and the pixels between the entries are transparent.
+ *  If any of the surfaces can't be added, none of them are.
+ *
+ *  \param atlas    The texture atlas.
+ *  \param surfaces The surfaces to add, each no larger than the textures of
+ *                  the atlas.
+ *  \param count    The number of surfaces.
+ *  \param ids      An array filled in with the ids of the new entries, in
+ *                  the order of the surfaces.
+ *
+ *  \return 0 on success, or -1 on error
+ *
+ *  \sa SDL_QueryTextureAtlasEntry()
+ *  \sa SDL_RemoveTextureAtlasEntry()
+ */
+extern DECLSPEC int SDLCALL SDL_AddTextureAtlasSurfaces(SDL_TextureAtlas * atlas,
+                                                        SDL_Surface ** surfaces,
+                                                        int count, int *ids);
+
+/**
+ *  \brief Add a surface to a texture atlas.
+ *
+ *  \param atlas   The texture atlas.
+ *  \param surface The surface to add.
+ *
+ *  \return The id of the new entry, which is greater than 0, or -1 on error
+ *
+ *  \sa SDL_AddTextureAtlasSurfaces()
+ */
+extern DECLSPEC int SDLCALL SDL_AddTextureAtlasSurface(SDL_TextureAtlas * atlas,
+                                                       SDL_Surface * surface);
+
+/**
+ *  \brief Get where an entry of a texture atlas is.
+ *
+ *  The texture and rectangle can be passed to SDL_RenderCopy() and the
+ *  other copy functions to draw the entry. They don't change until the
+ *  entry is removed.
+ *
+ *  \param atlas   The texture atlas.
+ *  \param id      The id of the entry.
+ *  \param texture A pointer filled in with the texture holding the entry,
+ *                 may be NULL.
+ *  \param rect    A pointer filled in with the rectangle of the entry in the
+ *                 texture, may be NULL.
+ *
+ *  \return 0 on success, or -1 if the id isn't valid
+ */
+extern DECLSPEC int SDLCALL SDL_QueryTextureAtlasEntry(SDL_TextureAtlas * atlas, int id,
+                                                       SDL_Texture ** texture,
+                                                       SDL_Rect * rect);
+
+/**
+ *  \brief Remove an entry from a texture atlas.
+ *
+ *  The space the entry took up is reused by the entries added later. The id
+ *  may be returned again for another entry.
+ *
+ *  \param atlas The texture atlas.
+ *  \param id    The id of the entry.
+ */
+extern DECLSPEC void SDLCALL SDL_RemoveTextureAtlasEntry(SDL_TextureAtlas * atlas, int id);
+
+/**
+ *  \brief Destroy a texture atlas and its textures.
+ *
+ *  \param atlas The texture atlas.
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyTextureAtlas(SDL_TextureAtlas * atlas);
+
 
 /**
  *  \brief Bind the texture to the current OpenGL/ES/ES2 context for use with
@@ -34,6 +34,7 @@
 #include "haptic/SDL_haptic_c.h"
 #include "joystick/SDL_joystick_c.h"
 #include "sensor/SDL_sensor_c.h"
+#include "video/SDL_blit.h"
 
 /* Initialization/Cleanup routines */
 #if !SDL_TIMERS_DISABLED
@@ -385,6 +386,9 @@ SDL_Quit(void)
     SDL_TicksQuit();
 #endif
 
+    /* Surfaces can be blitted without initializing video */
+    SDL_QuitBlitThreads();
+
     SDL_ClearHints();
     SDL_AssertionsQuit();
     SDL_LogResetPriorities();
@@ -0,0 +1,199 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "./SDL_internal.h"
+#include "SDL.h"
+#include "./SDL_workerpool.h"
+#include "SDL_assert.h"
+
+struct SDL_WorkerPool
+{
+    SDL_Thread **threads;
+    int num_threads;
+    SDL_mutex *lock;
+    SDL_cond *work_cond;  /* signaled when a new batch of jobs is posted. */
+    SDL_cond *done_cond;  /* signaled when the last worker finished a batch. */
+    Uint32 generation;  /* bumped for every batch, so workers don't run one twice. */
+    SDL_bool shutdown;
+    int active;  /* workers that haven't finished the current batch yet. */
+    SDL_atomic_t busy;  /* nonzero while a batch is in flight. */
+
+    /* the current batch */
+    SDL_WorkerPoolFunc func;
+    void *userdata;
+    int count;
+    SDL_atomic_t next;
+};
+
+static void
+RunWorkerPoolBatch(SDL_WorkerPool *pool)
+{
+    const SDL_WorkerPoolFunc func = pool->func;
+    void *userdata = pool->userdata;
+    const int count = pool->count;
+    int index;
+
+    while ((index = SDL_AtomicAdd(&pool->next, 1)) < count) {
+        func(userdata, index);
+    }
+}
+
+static int SDLCALL
+WorkerPoolThread(void *data)
+{
+    SDL_WorkerPool *pool = (SDL_WorkerPool *) data;
+    Uint32 generation = 0;
+
+    SDL_LockMutex(pool->lock);
+    for (;;) {
+        while (!pool->shutdown && (pool->generation == generation)) {
+            SDL_CondWait(pool->work_cond, pool->lock);
+        }
+        if (pool->shutdown) {
+            break;
+        }
+        generation = pool->generation;
+        SDL_UnlockMutex(pool->lock);
+
+        RunWorkerPoolBatch(pool);
+
+        SDL_LockMutex(pool->lock);
+        if (--pool->active == 0) {
+            SDL_CondSignal(pool->done_cond);
+        }
+    }
+    SDL_UnlockMutex(pool->lock);
+    return 0;
+}
+
+SDL_WorkerPool *
+SDL_CreateWorkerPool(const char *name, int num_threads)
+{
+    SDL_WorkerPool *pool;
+    int i;
+
+    if (num_threads <= 0) {
+        SDL_InvalidParamError("num_threads");
+        return NULL;
+    }
+
+    pool = (SDL_WorkerPool *) SDL_calloc(1, sizeof (SDL_WorkerPool));
+    if (!pool) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    pool->threads = (SDL_Thread **) SDL_calloc(num_threads, sizeof (SDL_Thread *));
+    pool->lock = SDL_CreateMutex();
+    pool->work_cond = SDL_CreateCond();
+    pool->done_cond = SDL_CreateCond();
+    if (!pool->threads || !pool->lock || !pool->work_cond || !pool->done_cond) {
+        if (!pool->threads) {
+            SDL_OutOfMemory();
+        }
+        SDL_DestroyWorkerPool(pool);
+        return NULL;
+    }
+
+    for (i = 0; i < num_threads; ++i) {
+        pool->threads[i] = SDL_CreateThread(WorkerPoolThread, name, pool);
+        if (!pool->threads[i]) {
+            SDL_DestroyWorkerPool(pool);
+            return NULL;
+        }
+        pool->num_threads++;
+    }
+
+    return pool;
+}
+
+void
+SDL_DestroyWorkerPool(SDL_WorkerPool *pool)
+{
+    int i;
+
+    if (!pool) {
+        return;
+    }
+
+    SDL_assert(SDL_AtomicGet(&pool->busy) == 0);
+
+    if (pool->lock) {
+        SDL_LockMutex(pool->lock);
+        pool->shutdown = SDL_TRUE;
+        if (pool->work_cond) {
+            SDL_CondBroadcast(pool->work_cond);
+        }
+        SDL_UnlockMutex(pool->lock);
+    }
+
+    for (i = 0; i < pool->num_threads; ++i) {
+        SDL_WaitThread(pool->threads[i], NULL);
+    }
+
+    SDL_DestroyCond(pool->done_cond);
+    SDL_DestroyCond(pool->work_cond);
+    SDL_DestroyMutex(pool->lock);
+    SDL_free(pool->threads);
+    SDL_free(pool);
+}
+
+int
+SDL_GetWorkerPoolThreadCount(SDL_WorkerPool *pool)
+{
+    return pool ? pool->num_threads : 0;
+}
+
+void
+SDL_RunWorkerPoolJobs(SDL_WorkerPool *pool, SDL_WorkerPoolFunc func, void *userdata, int count)
+{
+    int i;
+
+    if (!pool || (count <= 1) || !SDL_AtomicCAS(&pool->busy, 0, 1)) {
+        for (i = 0; i < count; ++i) {
+            func(userdata, i);
+        }
+        return;
+    }
+
+    SDL_LockMutex(pool->lock);
+    pool->func = func;
+    pool->userdata = userdata;
+    pool->count = count;
+    SDL_AtomicSet(&pool->next, 0);
+    pool->active = pool->num_threads;
+    pool->generation++;
+    SDL_CondBroadcast(pool->work_cond);
+    SDL_UnlockMutex(pool->lock);
+
+    /* The calling thread pitches in, too. */
+    RunWorkerPoolBatch(pool);
+
+    SDL_LockMutex(pool->lock);
+    while (pool->active > 0) {
+        SDL_CondWait(pool->done_cond, pool->lock);
+    }
+    SDL_UnlockMutex(pool->lock);
+
+    SDL_AtomicSet(&pool->busy, 0);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,47 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#ifndef SDL_workerpool_h_
+#define SDL_workerpool_h_
+
+/* this is not (currently) a public API. */
+
+struct SDL_WorkerPool;
+typedef struct SDL_WorkerPool SDL_WorkerPool;
+
+/* A job callback, called once for every index in [0, count) */
+typedef void (*SDL_WorkerPoolFunc)(void *userdata, int index);
+
+/* Creates a pool with num_threads worker threads. The thread calling
+   SDL_RunWorkerPoolJobs() works on the jobs too, so a pool that should use
+   N cores needs N-1 workers. Returns NULL on error. */
+SDL_WorkerPool *SDL_CreateWorkerPool(const char *name, int num_threads);
+void SDL_DestroyWorkerPool(SDL_WorkerPool *pool);
+int SDL_GetWorkerPoolThreadCount(SDL_WorkerPool *pool);
+
+/* Runs func(userdata, i) for every i in [0, count) and returns once all of
+   them are done. Jobs may run in any order and on any thread. If the pool is
+   NULL or already running jobs (from another thread, or because this is
+   called from inside a job), the jobs run serially on the calling thread. */
+void SDL_RunWorkerPoolJobs(SDL_WorkerPool *pool, SDL_WorkerPoolFunc func, void *userdata, int count);
+
+#endif /* SDL_workerpool_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -714,3 +714,24 @@
 #define SDL_RenderCopyExF SDL_RenderCopyExF_REAL
 #define SDL_GetTouchDeviceType SDL_GetTouchDeviceType_REAL
 #define SDL_UIKitRunApp SDL_UIKitRunApp_REAL
+#define SDL_SoftStretchLinear SDL_SoftStretchLinear_REAL
+#define SDL_RenderCopyBatch SDL_RenderCopyBatch_REAL
+#define SDL_RenderCopyBatchF SDL_RenderCopyBatchF_REAL
+#define SDL_RenderDrawWideLines SDL_RenderDrawWideLines_REAL
+#define SDL_RenderFillConvexPolygon SDL_RenderFillConvexPolygon_REAL
+#define SDL_RenderDrawWideLinesF SDL_RenderDrawWideLinesF_REAL
+#define SDL_RenderFillConvexPolygonF SDL_RenderFillConvexPolygonF_REAL
+#define SDL_RenderGeometry SDL_RenderGeometry_REAL
+#define SDL_RenderGetStats SDL_RenderGetStats_REAL
+#define SDL_RenderOpenReplay SDL_RenderOpenReplay_REAL
+#define SDL_RenderReplayFrame SDL_RenderReplayFrame_REAL
+#define SDL_RenderCloseReplay SDL_RenderCloseReplay_REAL
+#define SDL_RenderGetDamageRects SDL_RenderGetDamageRects_REAL
+#define SDL_RenderReadPixelsAsync SDL_RenderReadPixelsAsync_REAL
+#define SDL_CreateTextureAtlas SDL_CreateTextureAtlas_REAL
+#define SDL_AddTextureAtlasSurfaces SDL_AddTextureAtlasSurfaces_REAL
+#define SDL_AddTextureAtlasSurface SDL_AddTextureAtlasSurface_REAL
+#define SDL_QueryTextureAtlasEntry SDL_QueryTextureAtlasEntry_REAL
+#define SDL_RemoveTextureAtlasEntry SDL_RemoveTextureAtlasEntry_REAL
+#define SDL_DestroyTextureAtlas SDL_DestroyTextureAtlas_REAL
+#define SDL_PollEvents SDL_PollEvents_REAL
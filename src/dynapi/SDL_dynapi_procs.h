@@ -770,3 +770,24 @@ SDL_DYNAPI_PROC(SDL_TouchDeviceType,SDL_GetTouchDeviceType,(SDL_TouchID a),(a),r
 #ifdef __IPHONEOS__
 SDL_DYNAPI_PROC(int,SDL_UIKitRunApp,(int a, char *b, SDL_main_func c),(a,b,c),return)
 #endif
+SDL_DYNAPI_PROC(int,SDL_SoftStretchLinear,(SDL_Surface *a, const SDL_Rect *b, SDL_Surface *c, const SDL_Rect *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_RenderCopyBatch,(SDL_Renderer *a, SDL_Texture *b, const SDL_Rect *c, const SDL_Rect *d, const SDL_Color *e, int f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_RenderCopyBatchF,(SDL_Renderer *a, SDL_Texture *b, const SDL_Rect *c, const SDL_FRect *d, const SDL_Color *e, int f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_RenderDrawWideLines,(SDL_Renderer *a, const SDL_Point *b, int c, float d, SDL_bool e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_RenderFillConvexPolygon,(SDL_Renderer *a, const SDL_Point *b, int c, SDL_bool d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_RenderDrawWideLinesF,(SDL_Renderer *a, const SDL_FPoint *b, int c, float d, SDL_bool e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_RenderFillConvexPolygonF,(SDL_Renderer *a, const SDL_FPoint *b, int c, SDL_bool d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_RenderGeometry,(SDL_Renderer *a, SDL_Texture *b, const SDL_Vertex *c, int d, const int *e, int f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_RenderGetStats,(SDL_Renderer *a, SDL_RenderStats *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_RenderReplay*,SDL_RenderOpenReplay,(SDL_RWops *a, int b, int *c, int *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_RenderReplayFrame,(SDL_RenderReplay *a, SDL_Renderer *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_RenderCloseReplay,(SDL_RenderReplay *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_RenderGetDamageRects,(SDL_Renderer *a, SDL_Rect *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_RenderReadPixelsAsync,(SDL_Renderer *a, const SDL_Rect *b, Uint32 c, void *d, int e, SDL_RenderReadPixelsCallback f, void *g),(a,b,c,d,e,f,g),return)
+SDL_DYNAPI_PROC(SDL_TextureAtlas*,SDL_CreateTextureAtlas,(SDL_Renderer *a, Uint32 b, int c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_AddTextureAtlasSurfaces,(SDL_TextureAtlas *a, SDL_Surface **b, int c, int *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_AddTextureAtlasSurface,(SDL_TextureAtlas *a, SDL_Surface *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_QueryTextureAtlasEntry,(SDL_TextureAtlas *a, int b, SDL_Texture **c, SDL_Rect *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(void,SDL_RemoveTextureAtlasEntry,(SDL_TextureAtlas *a, int b),(a,b),)
+SDL_DYNAPI_PROC(void,SDL_DestroyTextureAtlas,(SDL_TextureAtlas *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_PollEvents,(SDL_Event *a, int b, Uint32 c, Uint32 d),(a,b,c,d),return)
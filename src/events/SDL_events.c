@@ -36,6 +36,12 @@
 /* An arbitrary limit so we don't have unbounded growth */
 #define SDL_MAX_QUEUED_EVENTS   65535
 
+/* How often SDL_WaitEventTimeout() wakes up when something has to be polled */
+#define SDL_EVENT_POLL_INTERVAL 10
+
+/* How far back SDL_CoalesceEvent() looks through a run of motion events */
+#define SDL_COALESCE_LOOKBACK   8
+
 typedef struct SDL_EventWatcher {
     SDL_EventFilter callback;
     void *userdata;
@@ -57,32 +63,104 @@ static SDL_DisabledEventBlock *SDL_disabled_events[256];
 static Uint32 SDL_userevents = SDL_USEREVENT;
 
 /* Private data -- event queue */
+typedef struct _SDL_SysWMEntry
+{
+    SDL_SysWMmsg msg;   /* must be first, see SDL_AppendEvent() */
+    struct _SDL_SysWMEntry *next;
+} SDL_SysWMEntry;
+
+/* Queued events are kept in a list per category, so that type range
+   queries only walk the lists that can contain matching events. Serial
+   numbers give the order across lists.
+ */
+typedef enum
+{
+    SDL_EVENTCATEGORY_INPUT,
+    SDL_EVENTCATEGORY_WINDOW,
+    SDL_EVENTCATEGORY_DEVICE,
+    SDL_EVENTCATEGORY_USER,
+    SDL_EVENTCATEGORY_OTHER,
+    SDL_NUM_EVENTCATEGORIES
+} SDL_EventCategory;
+
+/* Sorted by type; anything not listed is SDL_EVENTCATEGORY_OTHER */
+static const struct
+{
+    Uint32 first;
+    Uint32 last;
+    SDL_EventCategory category;
+} SDL_event_categories[] = {
+    { SDL_DISPLAYEVENT, SDL_SYSWMEVENT, SDL_EVENTCATEGORY_WINDOW },
+    { SDL_KEYDOWN, SDL_MOUSEWHEEL, SDL_EVENTCATEGORY_INPUT },
+    { SDL_JOYAXISMOTION, SDL_JOYBUTTONUP, SDL_EVENTCATEGORY_INPUT },
+    { SDL_JOYDEVICEADDED, SDL_JOYDEVICEREMOVED, SDL_EVENTCATEGORY_DEVICE },
+    { SDL_CONTROLLERAXISMOTION, SDL_CONTROLLERBUTTONUP, SDL_EVENTCATEGORY_INPUT },
+    { SDL_CONTROLLERDEVICEADDED, SDL_CONTROLLERDEVICEREMAPPED, SDL_EVENTCATEGORY_DEVICE },
+    { SDL_FINGERDOWN, SDL_MULTIGESTURE, SDL_EVENTCATEGORY_INPUT },
+    { SDL_AUDIODEVICEADDED, SDL_AUDIODEVICEREMOVED, SDL_EVENTCATEGORY_DEVICE },
+    { SDL_SENSORUPDATE, SDL_SENSORUPDATE, SDL_EVENTCATEGORY_INPUT },
+    { SDL_USEREVENT, SDL_LASTEVENT, SDL_EVENTCATEGORY_USER }
+};
+
 typedef struct _SDL_EventEntry
 {
     SDL_Event event;
-    SDL_SysWMmsg msg;
-    struct _SDL_EventEntry *prev;
+    SDL_SysWMEntry *wmmsg;  /* side buffer for SDL_SYSWMEVENT, otherwise NULL */
+    Uint32 serial;
+    SDL_EventCategory category;
+    struct _SDL_EventEntry *prev;   /* within the category */
     struct _SDL_EventEntry *next;
 } SDL_EventEntry;
 
-typedef struct _SDL_SysWMEntry
+/* Walks the queued events of several categories in the order they were added */
+typedef struct
 {
-    SDL_SysWMmsg msg;
-    struct _SDL_SysWMEntry *next;
-} SDL_SysWMEntry;
+    SDL_EventEntry *next[SDL_NUM_EVENTCATEGORIES];
+} SDL_EventCursor;
+
+/* Producers post events to a bounded lock-free ring, and whoever next reads
+   the queue moves them to the list with the queue locked. A slot is free
+   for the producer holding ticket 'sequence', and ready to be read once it
+   is one past that ticket. Producers count themselves in 'ring_producers'
+   while they use the ring, so SDL_StopEventLoop() can wait for them before
+   freeing it. When the ring is full, a producer adds its event to the list
+   directly, after all the slots claimed before it.
+ */
+typedef struct
+{
+    SDL_atomic_t sequence;
+    SDL_Event event;
+} SDL_EventSlot;
+
+#define SDL_EVENT_RING_SIZE 1024    /* must be a power of two */
 
 static struct
 {
     SDL_mutex *lock;
+    SDL_cond *cond;
     SDL_atomic_t active;
     SDL_atomic_t count;
     int max_events_seen;
-    SDL_EventEntry *head;
-    SDL_EventEntry *tail;
+    SDL_EventEntry *head[SDL_NUM_EVENTCATEGORIES];
+    SDL_EventEntry *tail[SDL_NUM_EVENTCATEGORIES];
+    Uint32 serial;
     SDL_EventEntry *free;
     SDL_SysWMEntry *wmmsg_used;
     SDL_SysWMEntry *wmmsg_free;
-} SDL_EventQ = { NULL, { 1 }, { 0 }, 0, NULL, NULL, NULL, NULL, NULL };
+    SDL_EventEntry *arena;          /* preallocated entries, see SDL_HINT_EVENT_QUEUE_PREALLOCATE */
+    int arena_size;
+    SDL_SysWMEntry *wmmsg_arena;
+    int wmmsg_arena_size;
+    SDL_EventSlot *ring;
+    SDL_atomic_t ring_enqueue;
+    Uint32 ring_dequeue;
+    SDL_atomic_t ring_producers;
+    SDL_atomic_t waiters;
+    SDL_atomic_t video_waiters;
+} SDL_EventQ = { NULL, NULL, { 1 }, { 0 }, 0, { NULL }, { NULL }, 0, NULL, NULL, NULL, NULL, 0, NULL, 0, NULL, { 0 }, 0, { 0 }, { 0 }, { 0 } };
+
+static void SDL_DrainEventRing(void);
+static void SDL_CutEvent(SDL_EventEntry *entry);
 
 
 /* 0 (default) means no logging, 1 means logging, 2 means logging with mouse and finger motion */
@@ -94,6 +172,22 @@ SDL_EventLoggingChanged(void *userdata, const char *name, const char *oldValue,
     SDL_DoEventLogging = (hint && *hint) ? SDL_max(SDL_min(SDL_atoi(hint), 2), 0) : 0;
 }
 
+static SDL_bool SDL_DoEventCoalescing = SDL_FALSE;
+
+static void SDLCALL
+SDL_EventCoalescingChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_DoEventCoalescing = (hint && *hint && *hint != '0') ? SDL_TRUE : SDL_FALSE;
+}
+
+static SDL_bool SDL_DropOldestOnOverflow = SDL_FALSE;
+
+static void SDLCALL
+SDL_EventQueueOverflowChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_DropOldestOnOverflow = (hint && SDL_strcasecmp(hint, "drop_oldest") == 0) ? SDL_TRUE : SDL_FALSE;
+}
+
 static void
 SDL_LogEvent(const SDL_Event *event)
 {
@@ -333,6 +427,80 @@ SDL_LogEvent(const SDL_Event *event)
 }
 
 
+/* Entries from the preallocated arenas are freed with the arenas */
+static void
+SDL_FreeEventEntry(SDL_EventEntry *entry)
+{
+    if (!SDL_EventQ.arena || entry < SDL_EventQ.arena || entry >= SDL_EventQ.arena + SDL_EventQ.arena_size) {
+        SDL_free(entry);
+    }
+}
+
+static void
+SDL_FreeSysWMEntry(SDL_SysWMEntry *wmmsg)
+{
+    if (!SDL_EventQ.wmmsg_arena || wmmsg < SDL_EventQ.wmmsg_arena || wmmsg >= SDL_EventQ.wmmsg_arena + SDL_EventQ.wmmsg_arena_size) {
+        SDL_free(wmmsg);
+    }
+}
+
+/* Get a SysWM side buffer -- called with the queue locked */
+static SDL_SysWMEntry *
+SDL_AllocSysWMEntry(void)
+{
+    SDL_SysWMEntry *wmmsg = SDL_EventQ.wmmsg_free;
+
+    if (wmmsg) {
+        SDL_EventQ.wmmsg_free = wmmsg->next;
+    } else if (SDL_EventQ.wmmsg_arena) {
+        /* Never touch the heap once the queue is preallocated */
+        SDL_SetError("Out of SysWM message buffers");
+    } else {
+        wmmsg = (SDL_SysWMEntry *)SDL_malloc(sizeof(*wmmsg));
+        if (!wmmsg) {
+            SDL_OutOfMemory();
+        }
+    }
+    return wmmsg;
+}
+
+/* Set up the preallocated queue entries, see SDL_HINT_EVENT_QUEUE_PREALLOCATE */
+static int
+SDL_PreallocateEventQueue(int size)
+{
+    int wmmsg_size;
+    int i;
+
+    size = SDL_min(size, SDL_MAX_QUEUED_EVENTS);
+    wmmsg_size = SDL_max(size / 16, 8);
+    SDL_EventQ.arena = (SDL_EventEntry *)SDL_malloc(size * sizeof(*SDL_EventQ.arena));
+    SDL_EventQ.wmmsg_arena = (SDL_SysWMEntry *)SDL_malloc(wmmsg_size * sizeof(*SDL_EventQ.wmmsg_arena));
+    if (!SDL_EventQ.arena || !SDL_EventQ.wmmsg_arena) {
+        SDL_free(SDL_EventQ.arena);
+        SDL_EventQ.arena = NULL;
+        SDL_free(SDL_EventQ.wmmsg_arena);
+        SDL_EventQ.wmmsg_arena = NULL;
+        return SDL_OutOfMemory();
+    }
+    SDL_EventQ.arena_size = size;
+    SDL_EventQ.wmmsg_arena_size = wmmsg_size;
+
+    if (SDL_EventQ.lock) {
+        SDL_LockMutex(SDL_EventQ.lock);
+    }
+    for (i = size; i--; ) {
+        SDL_EventQ.arena[i].next = SDL_EventQ.free;
+        SDL_EventQ.free = &SDL_EventQ.arena[i];
+    }
+    for (i = wmmsg_size; i--; ) {
+        SDL_EventQ.wmmsg_arena[i].next = SDL_EventQ.wmmsg_free;
+        SDL_EventQ.wmmsg_free = &SDL_EventQ.wmmsg_arena[i];
+    }
+    if (SDL_EventQ.lock) {
+        SDL_UnlockMutex(SDL_EventQ.lock);
+    }
+    return 0;
+}
 
 /* Public functions */
 
@@ -350,41 +518,67 @@ SDL_StopEventLoop(void)
 
     SDL_AtomicSet(&SDL_EventQ.active, 0);
 
+    /* Pick up anything still in flight so its side buffers are freed */
+    SDL_DrainEventRing();
+
     if (report && SDL_atoi(report)) {
         SDL_Log("SDL EVENT QUEUE: Maximum events in-flight: %d\n",
                 SDL_EventQ.max_events_seen);
     }
 
     /* Clean out EventQ */
-    for (entry = SDL_EventQ.head; entry; ) {
-        SDL_EventEntry *next = entry->next;
-        SDL_free(entry);
-        entry = next;
+    for (i = 0; i < SDL_NUM_EVENTCATEGORIES; ++i) {
+        for (entry = SDL_EventQ.head[i]; entry; ) {
+            SDL_EventEntry *next = entry->next;
+            if (entry->wmmsg) {
+                SDL_FreeSysWMEntry(entry->wmmsg);
+            }
+            SDL_FreeEventEntry(entry);
+            entry = next;
+        }
+        SDL_EventQ.head[i] = NULL;
+        SDL_EventQ.tail[i] = NULL;
     }
     for (entry = SDL_EventQ.free; entry; ) {
         SDL_EventEntry *next = entry->next;
-        SDL_free(entry);
+        SDL_FreeEventEntry(entry);
         entry = next;
     }
     for (wmmsg = SDL_EventQ.wmmsg_used; wmmsg; ) {
         SDL_SysWMEntry *next = wmmsg->next;
-        SDL_free(wmmsg);
+        SDL_FreeSysWMEntry(wmmsg);
         wmmsg = next;
     }
     for (wmmsg = SDL_EventQ.wmmsg_free; wmmsg; ) {
         SDL_SysWMEntry *next = wmmsg->next;
-        SDL_free(wmmsg);
+        SDL_FreeSysWMEntry(wmmsg);
         wmmsg = next;
     }
+    SDL_free(SDL_EventQ.arena);
+    SDL_EventQ.arena = NULL;
+    SDL_EventQ.arena_size = 0;
+    SDL_free(SDL_EventQ.wmmsg_arena);
+    SDL_EventQ.wmmsg_arena = NULL;
+    SDL_EventQ.wmmsg_arena_size = 0;
 
     SDL_AtomicSet(&SDL_EventQ.count, 0);
     SDL_EventQ.max_events_seen = 0;
-    SDL_EventQ.head = NULL;
-    SDL_EventQ.tail = NULL;
+    SDL_EventQ.serial = 0;
     SDL_EventQ.free = NULL;
     SDL_EventQ.wmmsg_used = NULL;
     SDL_EventQ.wmmsg_free = NULL;
 
+    if (SDL_EventQ.ring) {
+        /* Producers that got the ring before it was taken away may still be writing to it */
+        SDL_EventSlot *ring = (SDL_EventSlot *)SDL_AtomicSetPtr((void **)&SDL_EventQ.ring, NULL);
+        while (SDL_AtomicGet(&SDL_EventQ.ring_producers) > 0) {
+            SDL_Delay(0);
+        }
+        SDL_free(ring);
+        SDL_AtomicSet(&SDL_EventQ.ring_enqueue, 0);
+        SDL_EventQ.ring_dequeue = 0;
+    }
+
     /* Clear disabled event state */
     for (i = 0; i < SDL_arraysize(SDL_disabled_events); ++i) {
         SDL_free(SDL_disabled_events[i]);
@@ -402,6 +596,11 @@ SDL_StopEventLoop(void)
     }
     SDL_zero(SDL_EventOK);
 
+    if (SDL_EventQ.cond) {
+        SDL_DestroyCond(SDL_EventQ.cond);
+        SDL_EventQ.cond = NULL;
+    }
+
     if (SDL_EventQ.lock) {
         SDL_UnlockMutex(SDL_EventQ.lock);
         SDL_DestroyMutex(SDL_EventQ.lock);
@@ -428,6 +627,28 @@ SDL_StartEventLoop(void)
         }
     }
 
+    if (!SDL_EventQ.cond) {
+        SDL_EventQ.cond = SDL_CreateCond();
+        if (SDL_EventQ.cond == NULL) {
+            return -1;
+        }
+    }
+
+    if (!SDL_EventQ.ring) {
+        SDL_EventSlot *ring = (SDL_EventSlot *)SDL_malloc(SDL_EVENT_RING_SIZE * sizeof(*ring));
+        int i;
+
+        if (ring == NULL) {
+            return SDL_OutOfMemory();
+        }
+        for (i = 0; i < SDL_EVENT_RING_SIZE; ++i) {
+            SDL_AtomicSet(&ring[i].sequence, i);
+        }
+        SDL_AtomicSet(&SDL_EventQ.ring_enqueue, 0);
+        SDL_EventQ.ring_dequeue = 0;
+        SDL_AtomicSetPtr((void **)&SDL_EventQ.ring, ring);
+    }
+
     if (!SDL_event_watchers_lock) {
         SDL_event_watchers_lock = SDL_CreateMutex();
         if (SDL_event_watchers_lock == NULL) {
@@ -436,6 +657,14 @@ SDL_StartEventLoop(void)
     }
 #endif /* !SDL_THREADS_DISABLED */
 
+    if (!SDL_EventQ.arena) {
+        const char *hint = SDL_GetHint(SDL_HINT_EVENT_QUEUE_PREALLOCATE);
+        const int size = hint ? SDL_atoi(hint) : 0;
+        if (size > 0 && SDL_PreallocateEventQueue(size) < 0) {
+            return -1;
+        }
+    }
+
     /* Process most event types */
     SDL_EventState(SDL_TEXTINPUT, SDL_DISABLE);
     SDL_EventState(SDL_TEXTEDITING, SDL_DISABLE);
@@ -451,22 +680,242 @@ SDL_StartEventLoop(void)
 }
 
 
-/* Add an event to the event queue -- called with the queue locked */
+static SDL_EventCategory
+SDL_GetEventCategory(Uint32 type)
+{
+    int i;
+
+    for (i = 0; i < SDL_arraysize(SDL_event_categories); ++i) {
+        if (type < SDL_event_categories[i].first) {
+            break;
+        }
+        if (type <= SDL_event_categories[i].last) {
+            return SDL_event_categories[i].category;
+        }
+    }
+    return SDL_EVENTCATEGORY_OTHER;
+}
+
+/* Find the categories that can hold events in a type range */
+static Uint32
+SDL_GetEventCategoryMask(Uint32 minType, Uint32 maxType)
+{
+    Uint32 mask = 0;
+    Uint32 next = minType;  /* first type in the range not covered yet */
+    int i;
+
+    if (minType > maxType) {
+        return 0;
+    }
+    for (i = 0; i < SDL_arraysize(SDL_event_categories); ++i) {
+        if (SDL_event_categories[i].last < minType) {
+            continue;
+        }
+        if (SDL_event_categories[i].first > maxType) {
+            break;
+        }
+        if (SDL_event_categories[i].first > next) {
+            mask |= (1 << SDL_EVENTCATEGORY_OTHER);
+        }
+        mask |= (1 << SDL_event_categories[i].category);
+        next = SDL_event_categories[i].last + 1;
+    }
+    if (next <= maxType) {
+        mask |= (1 << SDL_EVENTCATEGORY_OTHER);
+    }
+    return mask;
+}
+
+/* Start walking the queue -- called with the queue locked */
+static void
+SDL_StartEventCursor(SDL_EventCursor *cursor, Uint32 mask)
+{
+    int i;
+
+    for (i = 0; i < SDL_NUM_EVENTCATEGORIES; ++i) {
+        cursor->next[i] = (mask & (1 << i)) ? SDL_EventQ.head[i] : NULL;
+    }
+}
+
+/* Get the oldest entry left in the cursor's categories. It's safe to cut
+   the returned entry before asking for the next one. */
+static SDL_EventEntry *
+SDL_NextEventEntry(SDL_EventCursor *cursor)
+{
+    SDL_EventEntry *entry = NULL;
+    int i, which = 0;
+
+    for (i = 0; i < SDL_NUM_EVENTCATEGORIES; ++i) {
+        SDL_EventEntry *candidate = cursor->next[i];
+        if (candidate && (!entry || (Sint32)(candidate->serial - entry->serial) < 0)) {
+            entry = candidate;
+            which = i;
+        }
+    }
+    if (entry) {
+        cursor->next[which] = entry->next;
+    }
+    return entry;
+}
+
+static SDL_bool
+SDL_EventQueueEmpty(void)
+{
+    int i;
+
+    for (i = 0; i < SDL_NUM_EVENTCATEGORIES; ++i) {
+        if (SDL_EventQ.head[i]) {
+            return SDL_FALSE;
+        }
+    }
+    return SDL_TRUE;
+}
+
+typedef enum
+{
+    SDL_COALESCE_STOP,  /* not a motion event, or one that must stay separate */
+    SDL_COALESCE_SKIP,  /* a motion event for some other device or axis */
+    SDL_COALESCE_MERGE
+} SDL_CoalesceAction;
+
+/* Motion and axis events, which can be merged or dropped without losing state */
+static SDL_bool
+SDL_IsCoalescibleEvent(Uint32 type)
+{
+    switch (type) {
+    case SDL_MOUSEMOTION:
+    case SDL_FINGERMOTION:
+    case SDL_JOYAXISMOTION:
+    case SDL_CONTROLLERAXISMOTION:
+        return SDL_TRUE;
+    default:
+        return SDL_FALSE;
+    }
+}
+
+static SDL_CoalesceAction
+SDL_CanCoalesceEvents(const SDL_Event * queued, const SDL_Event * event)
+{
+    if (!SDL_IsCoalescibleEvent(queued->type)) {
+        return SDL_COALESCE_STOP;
+    }
+    if (queued->type != event->type) {
+        return SDL_COALESCE_SKIP;
+    }
+
+    switch (event->type) {
+    case SDL_MOUSEMOTION:
+        if (queued->motion.which != event->motion.which ||
+            queued->motion.windowID != event->motion.windowID) {
+            return SDL_COALESCE_SKIP;
+        }
+        /* Keep drags separate from moves */
+        return (queued->motion.state == event->motion.state) ? SDL_COALESCE_MERGE : SDL_COALESCE_STOP;
+    case SDL_FINGERMOTION:
+        return (queued->tfinger.touchId == event->tfinger.touchId &&
+                queued->tfinger.fingerId == event->tfinger.fingerId) ? SDL_COALESCE_MERGE : SDL_COALESCE_SKIP;
+    case SDL_JOYAXISMOTION:
+        return (queued->jaxis.which == event->jaxis.which &&
+                queued->jaxis.axis == event->jaxis.axis) ? SDL_COALESCE_MERGE : SDL_COALESCE_SKIP;
+    case SDL_CONTROLLERAXISMOTION:
+        return (queued->caxis.which == event->caxis.which &&
+                queued->caxis.axis == event->caxis.axis) ? SDL_COALESCE_MERGE : SDL_COALESCE_SKIP;
+    default:
+        return SDL_COALESCE_STOP;
+    }
+}
+
+/* Whether an event of another category was queued after this entry */
+static SDL_bool
+SDL_IsEventQueuedAfter(const SDL_EventEntry *entry)
+{
+    int i;
+
+    for (i = 0; i < SDL_NUM_EVENTCATEGORIES; ++i) {
+        const SDL_EventEntry *tail = SDL_EventQ.tail[i];
+        if (i != entry->category && tail && (Sint32)(tail->serial - entry->serial) > 0) {
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
+/* Merge a motion or axis event into a queued one for the same device and axis,
+   returns SDL_TRUE if it was merged -- called with the queue locked */
+static SDL_bool
+SDL_CoalesceEvent(const SDL_Event * event)
+{
+    /* All the events we merge are input events */
+    SDL_EventEntry *entry = SDL_EventQ.tail[SDL_EVENTCATEGORY_INPUT];
+    int i;
+
+    for (i = 0; entry && i < SDL_COALESCE_LOOKBACK; ++i, entry = entry->prev) {
+        SDL_Event *queued = &entry->event;
+
+        switch (SDL_CanCoalesceEvents(queued, event)) {
+        case SDL_COALESCE_STOP:
+            return SDL_FALSE;
+        case SDL_COALESCE_SKIP:
+            continue;
+        case SDL_COALESCE_MERGE:
+            break;
+        }
+
+        /* Merging into an entry that is older than an event of another
+           category would deliver the new motion before that event */
+        if (SDL_IsEventQueuedAfter(entry)) {
+            return SDL_FALSE;
+        }
+
+        switch (event->type) {
+        case SDL_MOUSEMOTION:
+            queued->motion.x = event->motion.x;
+            queued->motion.y = event->motion.y;
+            queued->motion.xrel += event->motion.xrel;
+            queued->motion.yrel += event->motion.yrel;
+            break;
+        case SDL_FINGERMOTION:
+            queued->tfinger.x = event->tfinger.x;
+            queued->tfinger.y = event->tfinger.y;
+            queued->tfinger.dx += event->tfinger.dx;
+            queued->tfinger.dy += event->tfinger.dy;
+            queued->tfinger.pressure = event->tfinger.pressure;
+            break;
+        case SDL_JOYAXISMOTION:
+            queued->jaxis.value = event->jaxis.value;
+            break;
+        case SDL_CONTROLLERAXISMOTION:
+            queued->caxis.value = event->caxis.value;
+            break;
+        }
+        queued->common.timestamp = event->common.timestamp;
+        return SDL_TRUE;
+    }
+    return SDL_FALSE;
+}
+
+/* Append an event to the queue list -- called with the queue locked */
 static int
-SDL_AddEvent(SDL_Event * event)
+SDL_AppendEvent(const SDL_Event * event)
 {
     SDL_EventEntry *entry;
-    const int initial_count = SDL_AtomicGet(&SDL_EventQ.count);
-    int final_count;
+    SDL_EventCategory category;
+    int count;
 
-    if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
-        SDL_SetError("Event queue is full (%d events)", initial_count);
-        return 0;
+    if (SDL_DoEventCoalescing && SDL_CoalesceEvent(event)) {
+        SDL_AtomicAdd(&SDL_EventQ.count, -1);
+        return 1;
     }
 
     if (SDL_EventQ.free == NULL) {
+        if (SDL_EventQ.arena) {
+            /* Never touch the heap once the queue is preallocated */
+            SDL_SetError("Event queue is full (%d events)", SDL_EventQ.arena_size);
+            return 0;
+        }
         entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
         if (!entry) {
+            SDL_OutOfMemory();
             return 0;
         }
     } else {
@@ -474,33 +923,292 @@ SDL_AddEvent(SDL_Event * event)
         SDL_EventQ.free = entry->next;
     }
 
-    if (SDL_DoEventLogging) {
-        SDL_LogEvent(event);
-    }
-
     entry->event = *event;
     if (event->type == SDL_SYSWMEVENT) {
-        entry->msg = *event->syswm.msg;
-        entry->event.syswm.msg = &entry->msg;
+        entry->wmmsg = (SDL_SysWMEntry *)event->syswm.msg;
+    } else {
+        entry->wmmsg = NULL;
     }
 
-    if (SDL_EventQ.tail) {
-        SDL_EventQ.tail->next = entry;
-        entry->prev = SDL_EventQ.tail;
-        SDL_EventQ.tail = entry;
+    category = SDL_GetEventCategory(event->type);
+    entry->category = category;
+    entry->serial = SDL_EventQ.serial++;
+
+    if (SDL_EventQ.tail[category]) {
+        SDL_EventQ.tail[category]->next = entry;
+        entry->prev = SDL_EventQ.tail[category];
+        SDL_EventQ.tail[category] = entry;
         entry->next = NULL;
     } else {
-        SDL_assert(!SDL_EventQ.head);
-        SDL_EventQ.head = entry;
-        SDL_EventQ.tail = entry;
+        SDL_assert(!SDL_EventQ.head[category]);
+        SDL_EventQ.head[category] = entry;
+        SDL_EventQ.tail[category] = entry;
         entry->prev = NULL;
         entry->next = NULL;
     }
 
-    final_count = SDL_AtomicAdd(&SDL_EventQ.count, 1) + 1;
-    if (final_count > SDL_EventQ.max_events_seen) {
-        SDL_EventQ.max_events_seen = final_count;
+    count = SDL_AtomicGet(&SDL_EventQ.count);
+    if (count > SDL_EventQ.max_events_seen) {
+        SDL_EventQ.max_events_seen = count;
+    }
+
+    return 1;
+}
+
+/* Move the events posted to the ring to the queue list -- called with the queue locked */
+static void
+SDL_DrainEventRing(void)
+{
+    SDL_EventSlot *ring = SDL_EventQ.ring;
+
+    if (!ring) {
+        return;
+    }
+
+    for (;;) {
+        const Uint32 pos = SDL_EventQ.ring_dequeue;
+        SDL_EventSlot *slot = &ring[pos & (SDL_EVENT_RING_SIZE - 1)];
+
+        if ((Uint32)SDL_AtomicGet(&slot->sequence) != pos + 1) {
+            /* Empty, or the producer hasn't finished writing it yet */
+            break;
+        }
+        SDL_MemoryBarrierAcquire();
+
+        if (!SDL_AppendEvent(&slot->event)) {
+            /* Out of memory, leave it in the ring for now */
+            break;
+        }
+
+        /* Hand the slot back to producers for the next time around */
+        SDL_MemoryBarrierRelease();
+        SDL_AtomicSet(&slot->sequence, (int)(pos + SDL_EVENT_RING_SIZE));
+        SDL_EventQ.ring_dequeue = pos + 1;
+    }
+}
+
+/* Move every event claimed in the ring so far to the queue list, waiting for
+   producers that are still writing theirs. An event added to the list
+   directly then comes after everything posted before it, in particular
+   the earlier events of the same thread -- called with the queue locked */
+static void
+SDL_DrainEventRingFully(void)
+{
+    SDL_EventSlot *ring = SDL_EventQ.ring;
+    Uint32 end;
+
+    if (!ring) {
+        return;
+    }
+
+    end = (Uint32)SDL_AtomicGet(&SDL_EventQ.ring_enqueue);
+    for (;;) {
+        Uint32 pos;
+
+        SDL_DrainEventRing();
+        pos = SDL_EventQ.ring_dequeue;
+        if ((Sint32)(end - pos) <= 0) {
+            break;
+        }
+        if ((Uint32)SDL_AtomicGet(&ring[pos & (SDL_EVENT_RING_SIZE - 1)].sequence) == pos + 1) {
+            /* The slot is ready but couldn't be added, we're out of memory */
+            break;
+        }
+        /* Producers don't take the lock while they write a slot, so they'll finish */
+        SDL_Delay(0);
+    }
+}
+
+/* Post an event to the ring without taking the queue lock */
+static SDL_bool
+SDL_PostEventToRing(const SDL_Event * event)
+{
+    SDL_EventSlot *ring;
+    SDL_EventSlot *slot;
+    Uint32 pos;
+
+    /* Count ourselves in before looking at the ring, so it can't be freed under us */
+    SDL_AtomicAdd(&SDL_EventQ.ring_producers, 1);
+    ring = (SDL_EventSlot *)SDL_AtomicGetPtr((void **)&SDL_EventQ.ring);
+    if (!ring) {
+        SDL_AtomicAdd(&SDL_EventQ.ring_producers, -1);
+        return SDL_FALSE;
+    }
+
+    /* Claim a ticket for the next free slot */
+    pos = (Uint32)SDL_AtomicGet(&SDL_EventQ.ring_enqueue);
+    for (;;) {
+        Sint32 diff;
+
+        slot = &ring[pos & (SDL_EVENT_RING_SIZE - 1)];
+        diff = (Sint32)((Uint32)SDL_AtomicGet(&slot->sequence) - pos);
+        if (diff == 0) {
+            if (SDL_AtomicCAS(&SDL_EventQ.ring_enqueue, (int)pos, (int)(pos + 1))) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* The ring is full */
+            SDL_AtomicAdd(&SDL_EventQ.ring_producers, -1);
+            return SDL_FALSE;
+        }
+        pos = (Uint32)SDL_AtomicGet(&SDL_EventQ.ring_enqueue);
+    }
+
+    slot->event = *event;
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&slot->sequence, (int)(pos + 1));
+    SDL_AtomicAdd(&SDL_EventQ.ring_producers, -1);
+    return SDL_TRUE;
+}
+
+/* Wake up anyone sleeping in SDL_WaitEventTimeout() */
+static void
+SDL_WakeEventWaiters(void)
+{
+    /* These are full barriers, so we can't miss a waiter that just found the queue empty */
+    if (SDL_AtomicAdd(&SDL_EventQ.waiters, 0) > 0 && SDL_EventQ.lock) {
+        SDL_LockMutex(SDL_EventQ.lock);
+        SDL_CondBroadcast(SDL_EventQ.cond);
+        SDL_UnlockMutex(SDL_EventQ.lock);
+    }
+    if (SDL_AtomicAdd(&SDL_EventQ.video_waiters, 0) > 0) {
+        SDL_VideoDevice *_this = SDL_GetVideoDevice();
+        if (_this && _this->SendWakeupEvent) {
+            _this->SendWakeupEvent(_this);
+        }
     }
+}
+
+/* Add the relative motion of an event that is about to be dropped to the
+   next queued motion of the same mouse or finger, so it isn't lost.
+   Axis events carry absolute values and need nothing.
+ */
+static void
+SDL_FoldDroppedMotion(const SDL_EventEntry *dropped)
+{
+    const SDL_Event *event = &dropped->event;
+    SDL_EventEntry *entry;
+
+    if (event->type != SDL_MOUSEMOTION && event->type != SDL_FINGERMOTION) {
+        return;
+    }
+    for (entry = dropped->next; entry; entry = entry->next) {
+        SDL_Event *queued = &entry->event;
+
+        if (queued->type != event->type) {
+            continue;
+        }
+        if (event->type == SDL_MOUSEMOTION && queued->motion.which == event->motion.which) {
+            queued->motion.xrel += event->motion.xrel;
+            queued->motion.yrel += event->motion.yrel;
+            return;
+        }
+        if (event->type == SDL_FINGERMOTION &&
+            queued->tfinger.touchId == event->tfinger.touchId &&
+            queued->tfinger.fingerId == event->tfinger.fingerId) {
+            queued->tfinger.dx += event->tfinger.dx;
+            queued->tfinger.dy += event->tfinger.dy;
+            return;
+        }
+    }
+}
+
+/* Make room in a full queue by dropping the oldest motion or axis event */
+static SDL_bool
+SDL_DropOldestEvent(void)
+{
+    SDL_bool dropped = SDL_FALSE;
+
+    if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
+        SDL_EventEntry *entry;
+
+        SDL_DrainEventRing();
+        for (entry = SDL_EventQ.head[SDL_EVENTCATEGORY_INPUT]; entry; entry = entry->next) {
+            if (SDL_IsCoalescibleEvent(entry->event.type)) {
+                SDL_FoldDroppedMotion(entry);
+                SDL_CutEvent(entry);
+                dropped = SDL_TRUE;
+                break;
+            }
+        }
+        if (SDL_EventQ.lock) {
+            SDL_UnlockMutex(SDL_EventQ.lock);
+        }
+    }
+    return dropped;
+}
+
+/* Add an event to the event queue */
+static int
+SDL_AddEvent(SDL_Event * event)
+{
+    SDL_Event copy;
+    SDL_SysWMEntry *wmmsg = NULL;
+    const int max_count = SDL_EventQ.arena ? SDL_EventQ.arena_size : SDL_MAX_QUEUED_EVENTS;
+    int initial_count = SDL_AtomicAdd(&SDL_EventQ.count, 1);
+
+    if (initial_count >= max_count) {
+        SDL_AtomicAdd(&SDL_EventQ.count, -1);
+        if (!SDL_DropOldestOnOverflow || !SDL_DropOldestEvent()) {
+            SDL_SetError("Event queue is full (%d events)", initial_count);
+            return 0;
+        }
+
+        /* Another producer may have taken the room we made */
+        initial_count = SDL_AtomicAdd(&SDL_EventQ.count, 1);
+        if (initial_count >= max_count) {
+            SDL_AtomicAdd(&SDL_EventQ.count, -1);
+            SDL_SetError("Event queue is full (%d events)", initial_count);
+            return 0;
+        }
+    }
+
+    if (SDL_DoEventLogging) {
+        SDL_LogEvent(event);
+    }
+
+    if (event->type == SDL_SYSWMEVENT) {
+        /* Keep the message in a side buffer so queue entries stay small.
+           These only come from the thread pumping events, so the lock is fine. */
+        if (SDL_EventQ.lock) {
+            SDL_LockMutex(SDL_EventQ.lock);
+        }
+        wmmsg = SDL_AllocSysWMEntry();
+        if (SDL_EventQ.lock) {
+            SDL_UnlockMutex(SDL_EventQ.lock);
+        }
+        if (!wmmsg) {
+            SDL_AtomicAdd(&SDL_EventQ.count, -1);
+            return 0;
+        }
+        wmmsg->msg = *event->syswm.msg;
+        copy = *event;
+        copy.syswm.msg = &wmmsg->msg;
+        event = &copy;
+    }
+
+    if (!SDL_PostEventToRing(event)) {
+        /* There's no ring yet, or it's full; add it to the list directly */
+        int added = 0;
+
+        if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
+            SDL_DrainEventRingFully();
+            added = SDL_AppendEvent(event);
+            if (!added && wmmsg) {
+                wmmsg->next = SDL_EventQ.wmmsg_free;
+                SDL_EventQ.wmmsg_free = wmmsg;
+            }
+            if (SDL_EventQ.lock) {
+                SDL_UnlockMutex(SDL_EventQ.lock);
+            }
+        }
+        if (!added) {
+            SDL_AtomicAdd(&SDL_EventQ.count, -1);
+            return 0;
+        }
+    }
+
+    SDL_WakeEventWaiters();
 
     return 1;
 }
@@ -516,13 +1224,19 @@ SDL_CutEvent(SDL_EventEntry *entry)
         entry->next->prev = entry->prev;
     }
 
-    if (entry == SDL_EventQ.head) {
+    if (entry == SDL_EventQ.head[entry->category]) {
         SDL_assert(entry->prev == NULL);
-        SDL_EventQ.head = entry->next;
+        SDL_EventQ.head[entry->category] = entry->next;
     }
-    if (entry == SDL_EventQ.tail) {
+    if (entry == SDL_EventQ.tail[entry->category]) {
         SDL_assert(entry->next == NULL);
-        SDL_EventQ.tail = entry->prev;
+        SDL_EventQ.tail[entry->category] = entry->prev;
+    }
+
+    if (entry->wmmsg) {
+        entry->wmmsg->next = SDL_EventQ.wmmsg_free;
+        SDL_EventQ.wmmsg_free = entry->wmmsg;
+        entry->wmmsg = NULL;
     }
 
     entry->next = SDL_EventQ.free;
@@ -536,6 +1250,10 @@ int
 SDL_PeepEvents(SDL_Event * events, int numevents, SDL_eventaction action,
                Uint32 minType, Uint32 maxType)
 {
+    SDL_EventCursor cursor;
+    SDL_EventEntry *entry;
+    SDL_SysWMEntry *wmmsg, *wmmsg_next;
+    Uint32 type;
     int i, used;
 
     /* Don't look after we've quit */
@@ -546,59 +1264,66 @@ SDL_PeepEvents(SDL_Event * events, int numevents, SDL_eventaction action,
         }
         return (-1);
     }
-    /* Lock the event queue */
     used = 0;
+    if (action == SDL_ADDEVENT) {
+        /* Producers don't need the queue lock */
+        for (i = 0; i < numevents; ++i) {
+            used += SDL_AddEvent(&events[i]);
+        }
+        return (used);
+    }
+
+    /* Lock the event queue */
     if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
-        if (action == SDL_ADDEVENT) {
-            for (i = 0; i < numevents; ++i) {
-                used += SDL_AddEvent(&events[i]);
-            }
-        } else {
-            SDL_EventEntry *entry, *next;
-            SDL_SysWMEntry *wmmsg, *wmmsg_next;
-            Uint32 type;
-
-            if (action == SDL_GETEVENT) {
-                /* Clean out any used wmmsg data
-                   FIXME: Do we want to retain the data for some period of time?
-                 */
-                for (wmmsg = SDL_EventQ.wmmsg_used; wmmsg; wmmsg = wmmsg_next) {
-                    wmmsg_next = wmmsg->next;
-                    wmmsg->next = SDL_EventQ.wmmsg_free;
-                    SDL_EventQ.wmmsg_free = wmmsg;
-                }
-                SDL_EventQ.wmmsg_used = NULL;
+        SDL_DrainEventRing();
+
+        if (action == SDL_GETEVENT) {
+            /* Clean out any used wmmsg data
+               FIXME: Do we want to retain the data for some period of time?
+             */
+            for (wmmsg = SDL_EventQ.wmmsg_used; wmmsg; wmmsg = wmmsg_next) {
+                wmmsg_next = wmmsg->next;
+                wmmsg->next = SDL_EventQ.wmmsg_free;
+                SDL_EventQ.wmmsg_free = wmmsg;
             }
+            SDL_EventQ.wmmsg_used = NULL;
+        }
 
-            for (entry = SDL_EventQ.head; entry && (!events || used < numevents); entry = next) {
-                next = entry->next;
-                type = entry->event.type;
-                if (minType <= type && type <= maxType) {
-                    if (events) {
-                        events[used] = entry->event;
-                        if (entry->event.type == SDL_SYSWMEVENT) {
-                            /* We need to copy the wmmsg somewhere safe.
-                               For now we'll guarantee it's valid at least until
-                               the next call to SDL_PeepEvents()
-                             */
-                            if (SDL_EventQ.wmmsg_free) {
-                                wmmsg = SDL_EventQ.wmmsg_free;
-                                SDL_EventQ.wmmsg_free = wmmsg->next;
-                            } else {
-                                wmmsg = (SDL_SysWMEntry *)SDL_malloc(sizeof(*wmmsg));
+        SDL_StartEventCursor(&cursor, SDL_GetEventCategoryMask(minType, maxType));
+        while ((!events || used < numevents) && (entry = SDL_NextEventEntry(&cursor)) != NULL) {
+            type = entry->event.type;
+            if (minType <= type && type <= maxType) {
+                if (events) {
+                    events[used] = entry->event;
+                    if (entry->wmmsg) {
+                        /* We need to keep the wmmsg somewhere safe.
+                           For now we'll guarantee it's valid at least until
+                           the next call to SDL_PeepEvents()
+                         */
+                        if (action == SDL_GETEVENT) {
+                            /* The entry is going away, take its side buffer */
+                            wmmsg = entry->wmmsg;
+                            entry->wmmsg = NULL;
+                        } else {
+                            wmmsg = SDL_AllocSysWMEntry();
+                            if (wmmsg) {
+                                wmmsg->msg = entry->wmmsg->msg;
                             }
-                            wmmsg->msg = *entry->event.syswm.msg;
+                        }
+                        if (wmmsg) {
                             wmmsg->next = SDL_EventQ.wmmsg_used;
                             SDL_EventQ.wmmsg_used = wmmsg;
                             events[used].syswm.msg = &wmmsg->msg;
+                        } else {
+                            events[used].syswm.msg = NULL;
                         }
+                    }
 
-                        if (action == SDL_GETEVENT) {
-                            SDL_CutEvent(entry);
-                        }
+                    if (action == SDL_GETEVENT) {
+                        SDL_CutEvent(entry);
                     }
-                    ++used;
                 }
+                ++used;
             }
         }
         if (SDL_EventQ.lock) {
@@ -613,13 +1338,39 @@ SDL_PeepEvents(SDL_Event * events, int numevents, SDL_eventaction action,
 SDL_bool
 SDL_HasEvent(Uint32 type)
 {
-    return (SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, type, type) > 0);
+    return SDL_HasEvents(type, type);
 }
 
 SDL_bool
 SDL_HasEvents(Uint32 minType, Uint32 maxType)
 {
-    return (SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, minType, maxType) > 0);
+    SDL_bool found = SDL_FALSE;
+
+    /* Don't look after we've quit */
+    if (!SDL_AtomicGet(&SDL_EventQ.active)) {
+        return SDL_FALSE;
+    }
+
+    /* Stop at the first match instead of counting them all */
+    if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
+        SDL_EventCursor cursor;
+        SDL_EventEntry *entry;
+        Uint32 type;
+
+        SDL_DrainEventRing();
+        SDL_StartEventCursor(&cursor, SDL_GetEventCategoryMask(minType, maxType));
+        while ((entry = SDL_NextEventEntry(&cursor)) != NULL) {
+            type = entry->event.type;
+            if (minType <= type && type <= maxType) {
+                found = SDL_TRUE;
+                break;
+            }
+        }
+        if (SDL_EventQ.lock) {
+            SDL_UnlockMutex(SDL_EventQ.lock);
+        }
+    }
+    return found;
 }
 
 void
@@ -650,10 +1401,12 @@ SDL_FlushEvents(Uint32 minType, Uint32 maxType)
 
     /* Lock the event queue */
     if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
-        SDL_EventEntry *entry, *next;
+        SDL_EventCursor cursor;
+        SDL_EventEntry *entry;
         Uint32 type;
-        for (entry = SDL_EventQ.head; entry; entry = next) {
-            next = entry->next;
+        SDL_DrainEventRing();
+        SDL_StartEventCursor(&cursor, SDL_GetEventCategoryMask(minType, maxType));
+        while ((entry = SDL_NextEventEntry(&cursor)) != NULL) {
             type = entry->event.type;
             if (minType <= type && type <= maxType) {
                 SDL_CutEvent(entry);
@@ -700,12 +1453,93 @@ SDL_PollEvent(SDL_Event * event)
     return SDL_WaitEventTimeout(event, 0);
 }
 
+int
+SDL_PollEvents(SDL_Event * events, int numevents, Uint32 minType, Uint32 maxType)
+{
+    if (!events) {
+        return SDL_InvalidParamError("events");
+    }
+    if (numevents <= 0) {
+        return 0;
+    }
+    SDL_PumpEvents();
+    return SDL_PeepEvents(events, numevents, SDL_GETEVENT, minType, maxType);
+}
+
 int
 SDL_WaitEvent(SDL_Event * event)
 {
     return SDL_WaitEventTimeout(event, -1);
 }
 
+/* Joysticks and sensors have no way to wake us up, so they must be polled */
+static SDL_bool
+SDL_EventsNeedPolling(void)
+{
+#if !SDL_JOYSTICK_DISABLED
+    if (SDL_WasInit(SDL_INIT_JOYSTICK) &&
+        (!SDL_disabled_events[SDL_JOYAXISMOTION >> 8] || SDL_JoystickEventState(SDL_QUERY))) {
+        return SDL_TRUE;
+    }
+#endif
+#if !SDL_SENSOR_DISABLED
+    if (SDL_WasInit(SDL_INIT_SENSOR) && !SDL_disabled_events[SDL_SENSORUPDATE >> 8] &&
+        SDL_NumSensors() > 0) {
+        return SDL_TRUE;
+    }
+#endif
+    return SDL_FALSE;
+}
+
+/* Sleep until an event is added to the queue or the timeout expires */
+static void
+SDL_WaitForQueue(int timeout)
+{
+    if (!SDL_EventQ.lock || !SDL_EventQ.cond) {
+        /* No threads, nobody else can add an event while we sleep */
+        SDL_Delay((timeout < 0 || timeout > SDL_EVENT_POLL_INTERVAL) ? SDL_EVENT_POLL_INTERVAL : timeout);
+        return;
+    }
+
+    if (SDL_LockMutex(SDL_EventQ.lock) == 0) {
+        /* Count ourselves before looking, so producers know to signal us */
+        SDL_AtomicAdd(&SDL_EventQ.waiters, 1);
+        SDL_DrainEventRing();
+        if (SDL_EventQueueEmpty()) {
+            if (timeout < 0) {
+                SDL_CondWait(SDL_EventQ.cond, SDL_EventQ.lock);
+            } else {
+                SDL_CondWaitTimeout(SDL_EventQ.cond, SDL_EventQ.lock, (Uint32)timeout);
+            }
+        }
+        SDL_AtomicAdd(&SDL_EventQ.waiters, -1);
+        SDL_UnlockMutex(SDL_EventQ.lock);
+    }
+}
+
+/* Let the video driver block on its event source until it has something
+   for us, the timeout expires or SDL_AddEvent() wakes it up. */
+static void
+SDL_WaitForVideoEvents(SDL_VideoDevice *_this, int timeout)
+{
+    SDL_bool empty = SDL_FALSE;
+
+    /* Count ourselves before looking, so producers know to wake us */
+    SDL_AtomicAdd(&SDL_EventQ.video_waiters, 1);
+    if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
+        SDL_DrainEventRing();
+        empty = SDL_EventQueueEmpty();
+        if (SDL_EventQ.lock) {
+            SDL_UnlockMutex(SDL_EventQ.lock);
+        }
+    }
+
+    if (empty) {
+        _this->WaitEventTimeout(_this, timeout);
+    }
+    SDL_AtomicAdd(&SDL_EventQ.video_waiters, -1);
+}
+
 int
 SDL_WaitEventTimeout(SDL_Event * event, int timeout)
 {
@@ -715,6 +1549,9 @@ SDL_WaitEventTimeout(SDL_Event * event, int timeout)
         expiration = SDL_GetTicks() + timeout;
 
     for (;;) {
+        SDL_VideoDevice *_this;
+        int remaining = -1;
+
         SDL_PumpEvents();
         switch (SDL_PeepEvents(event, 1, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT)) {
         case -1:
@@ -724,11 +1561,29 @@ SDL_WaitEventTimeout(SDL_Event * event, int timeout)
                 /* Polling and no events, just return */
                 return 0;
             }
-            if (timeout > 0 && SDL_TICKS_PASSED(SDL_GetTicks(), expiration)) {
-                /* Timeout expired and no events */
-                return 0;
+            if (timeout > 0) {
+                const Uint32 now = SDL_GetTicks();
+                if (SDL_TICKS_PASSED(now, expiration)) {
+                    /* Timeout expired and no events */
+                    return 0;
+                }
+                remaining = (int)(expiration - now);
+            }
+
+            _this = SDL_GetVideoDevice();
+            if (SDL_EventsNeedPolling() || SDL_HasSignalHandlers() ||
+                (_this && !_this->WaitEventTimeout)) {
+                /* Something has to be pumped or a signal may be pending, but
+                   pushed events and the video driver still wake us */
+                if (remaining < 0 || remaining > SDL_EVENT_POLL_INTERVAL) {
+                    remaining = SDL_EVENT_POLL_INTERVAL;
+                }
+            }
+            if (_this && _this->WaitEventTimeout && !SDL_EventsNeedPolling()) {
+                SDL_WaitForVideoEvents(_this, remaining);
+            } else {
+                SDL_WaitForQueue(remaining);
             }
-            SDL_Delay(10);
             break;
         default:
             /* Has events */
@@ -885,9 +1740,11 @@ void
 SDL_FilterEvents(SDL_EventFilter filter, void *userdata)
 {
     if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
-        SDL_EventEntry *entry, *next;
-        for (entry = SDL_EventQ.head; entry; entry = next) {
-            next = entry->next;
+        SDL_EventCursor cursor;
+        SDL_EventEntry *entry;
+        SDL_DrainEventRing();
+        SDL_StartEventCursor(&cursor, ~0u);
+        while ((entry = SDL_NextEventEntry(&cursor)) != NULL) {
             if (!filter(userdata, &entry->event)) {
                 SDL_CutEvent(entry);
             }
@@ -1002,8 +1859,12 @@ int
 SDL_EventsInit(void)
 {
     SDL_AddHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_EVENT_COALESCING, SDL_EventCoalescingChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_EVENT_QUEUE_OVERFLOW, SDL_EventQueueOverflowChanged, NULL);
     if (SDL_StartEventLoop() < 0) {
         SDL_DelHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
+        SDL_DelHintCallback(SDL_HINT_EVENT_COALESCING, SDL_EventCoalescingChanged, NULL);
+        SDL_DelHintCallback(SDL_HINT_EVENT_QUEUE_OVERFLOW, SDL_EventQueueOverflowChanged, NULL);
         return -1;
     }
 
@@ -1018,6 +1879,8 @@ SDL_EventsQuit(void)
     SDL_QuitQuit();
     SDL_StopEventLoop();
     SDL_DelHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
+    SDL_DelHintCallback(SDL_HINT_EVENT_COALESCING, SDL_EventCoalescingChanged, NULL);
+    SDL_DelHintCallback(SDL_HINT_EVENT_QUEUE_OVERFLOW, SDL_EventQueueOverflowChanged, NULL);
 }
 
 /* vi: set ts=4 sw=4 expandtab: */
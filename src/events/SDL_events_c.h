@@ -53,6 +53,7 @@ extern int SDL_EventsInit(void);
 extern void SDL_EventsQuit(void);
 
 extern void SDL_SendPendingSignalEvents(void);
+extern SDL_bool SDL_HasSignalHandlers(void);
 
 extern int SDL_QuitInit(void);
 extern void SDL_QuitQuit(void);
@@ -37,6 +37,7 @@
 
 #ifdef HAVE_SIGNAL_SUPPORT
 static SDL_bool disable_signals = SDL_FALSE;
+static SDL_bool signal_handlers_installed = SDL_FALSE;
 static SDL_bool send_quit_pending = SDL_FALSE;
 
 #ifdef SDL_BACKGROUNDING_SIGNAL
@@ -86,11 +87,14 @@ SDL_EventSignal_Init(const int sig)
 #endif
         action.sa_handler = SDL_HandleSIG;
         sigaction(sig, &action, NULL);
+        signal_handlers_installed = SDL_TRUE;
     }
 #elif HAVE_SIGNAL_H
     void (*ohandler) (int) = signal(sig, SDL_HandleSIG);
     if (ohandler != SIG_DFL) {
         signal(sig, ohandler);
+    } else {
+        signal_handlers_installed = SDL_TRUE;
     }
 #endif
 }
@@ -147,6 +151,8 @@ SDL_QuitQuit_Internal(void)
     #ifdef SDL_FOREGROUNDING_SIGNAL
     SDL_EventSignal_Quit(SDL_FOREGROUNDING_SIGNAL);
     #endif
+
+    signal_handlers_installed = SDL_FALSE;
 }
 #endif
 
@@ -196,6 +202,18 @@ SDL_SendPendingSignalEvents(void)
 #endif
 }
 
+/* The signal handlers only set a flag, they can't wake up a thread waiting
+   for events. Waits have to come back regularly to look at it instead. */
+SDL_bool
+SDL_HasSignalHandlers(void)
+{
+#ifdef HAVE_SIGNAL_SUPPORT
+    return signal_handlers_installed;
+#else
+    return SDL_FALSE;
+#endif
+}
+
 /* This function returns 1 if it's okay to close the application window */
 int
 SDL_SendQuit(void)
@@ -0,0 +1,288 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#include "SDL_rasterize_c.h"
+
+/* Antialiased rows are sampled on this many scanlines. Horizontally, the
+   coverage of every scanline is exact.
+ */
+#define SUBSAMPLES  4
+
+typedef struct
+{
+    const SDL_FPoint *points;
+    int count;
+    float miny, maxy;
+} RasterPolygon;
+
+typedef struct
+{
+    SDL_RasterSpan *spans;
+    int num_spans;
+    int max_spans;
+} RasterSpans;
+
+static int SDLCALL
+ComparePolygons(const void *a, const void *b)
+{
+    const float miny_a = ((const RasterPolygon *) a)->miny;
+    const float miny_b = ((const RasterPolygon *) b)->miny;
+
+    return (miny_a < miny_b) ? -1 : (miny_a > miny_b) ? 1 : 0;
+}
+
+/* Gets where the scanline at y enters and leaves a convex polygon */
+static SDL_bool
+GetPolygonInterval(const RasterPolygon *polygon, float y, int w, float *xl, float *xr)
+{
+    const SDL_FPoint *points = polygon->points;
+    SDL_bool found = SDL_FALSE;
+    float minx = 0.0f, maxx = 0.0f;
+    int i, j;
+
+    for (i = 0, j = polygon->count - 1; i < polygon->count; j = i++) {
+        const SDL_FPoint *a = &points[j];
+        const SDL_FPoint *b = &points[i];
+        if ((a->y <= y && y < b->y) || (b->y <= y && y < a->y)) {
+            const float x = a->x + (y - a->y) * (b->x - a->x) / (b->y - a->y);
+            if (!found) {
+                minx = maxx = x;
+                found = SDL_TRUE;
+            } else {
+                minx = SDL_min(minx, x);
+                maxx = SDL_max(maxx, x);
+            }
+        }
+    }
+
+    *xl = SDL_max(minx, 0.0f);
+    *xr = SDL_min(maxx, (float) w);
+    return (found && *xl < *xr);
+}
+
+/* Adds the coverage of a polygon on row y to the row, keeping the highest coverage of each pixel */
+static void
+CoverPolygonRow(const RasterPolygon *polygon, int y, int w, SDL_bool antialias,
+                Uint8 *row, Uint16 *accum, int *rowmin, int *rowmax)
+{
+    float xl[SUBSAMPLES], xr[SUBSAMPLES];
+    SDL_bool inside[SUBSAMPLES];
+    int outer0 = w, outer1 = 0, inner0 = 0, inner1 = w;
+    int s, x;
+
+    if (!antialias) {
+        float l, r;
+        if (GetPolygonInterval(polygon, y + 0.5f, w, &l, &r)) {
+            /* The pixels with their centers in [l, r) */
+            const int x0 = (int) SDL_ceilf(l - 0.5f);
+            const int x1 = (int) SDL_ceilf(r - 0.5f);
+            if (x0 < x1) {
+                SDL_memset(&row[x0], 0xFF, x1 - x0);
+                *rowmin = SDL_min(*rowmin, x0);
+                *rowmax = SDL_max(*rowmax, x1);
+            }
+        }
+        return;
+    }
+
+    for (s = 0; s < SUBSAMPLES; ++s) {
+        inside[s] = GetPolygonInterval(polygon, y + (s + 0.5f) / SUBSAMPLES, w, &xl[s], &xr[s]);
+        if (inside[s]) {
+            outer0 = SDL_min(outer0, (int) SDL_floorf(xl[s]));
+            outer1 = SDL_max(outer1, (int) SDL_ceilf(xr[s]));
+            inner0 = SDL_max(inner0, (int) SDL_ceilf(xl[s]));
+            inner1 = SDL_min(inner1, (int) SDL_floorf(xr[s]));
+        } else {
+            inner1 = 0;
+        }
+    }
+    if (outer0 >= outer1) {
+        return;
+    }
+    /* The pixels in [inner0, inner1) are covered by every scanline */
+    if (inner0 >= inner1) {
+        inner0 = inner1 = outer1;
+    }
+
+    SDL_memset(&accum[outer0], 0, (outer1 - outer0) * sizeof (*accum));
+    for (s = 0; s < SUBSAMPLES; ++s) {
+        if (inside[s]) {
+            const int x0 = (int) SDL_floorf(xl[s]);
+            const int x1 = (int) SDL_ceilf(xr[s]);
+            for (x = x0; x < x1; ++x) {
+                if (x == inner0) {
+                    x = inner1;
+                    if (x >= x1) {
+                        break;
+                    }
+                }
+                accum[x] += (Uint16) ((SDL_min(xr[s], x + 1.0f) - SDL_max(xl[s], (float) x)) * (256 / SUBSAMPLES) + 0.5f);
+            }
+        }
+    }
+    for (x = outer0; x < outer1; ++x) {
+        if (x == inner0) {
+            if (inner0 < inner1) {
+                SDL_memset(&row[inner0], 0xFF, inner1 - inner0);
+            }
+            x = inner1;
+            if (x >= outer1) {
+                break;
+            }
+        }
+        if (accum[x] > row[x]) {
+            row[x] = (Uint8) SDL_min(accum[x], 0xFF);
+        }
+    }
+    *rowmin = SDL_min(*rowmin, outer0);
+    *rowmax = SDL_max(*rowmax, outer1);
+}
+
+static int
+AddSpan(RasterSpans *spans, int x, int y, int w, Uint8 coverage)
+{
+    SDL_RasterSpan *span;
+
+    if (spans->num_spans == spans->max_spans) {
+        const int max_spans = spans->max_spans ? spans->max_spans * 2 : 256;
+        SDL_RasterSpan *array = (SDL_RasterSpan *) SDL_realloc(spans->spans, max_spans * sizeof (*array));
+        if (!array) {
+            return SDL_OutOfMemory();
+        }
+        spans->spans = array;
+        spans->max_spans = max_spans;
+    }
+    span = &spans->spans[spans->num_spans++];
+    span->x = x;
+    span->y = y;
+    span->w = w;
+    span->coverage = coverage;
+    return 0;
+}
+
+int
+SDL_RasterizeConvexPolygons(const SDL_FPoint *points, const int *counts, int num_polygons,
+                            int w, int h, SDL_bool antialias,
+                            SDL_RasterSpan **spans, int *num_spans)
+{
+    RasterSpans result;
+    RasterPolygon *polygons;
+    Uint8 *row = NULL;
+    Uint16 *accum = NULL;
+    int *active = NULL;
+    int i, j, n = 0, num_active = 0, next = 0, y, y0, y1;
+    float miny = 0.0f, maxy = 0.0f;
+    int retval = 0;
+
+    SDL_zero(result);
+    *spans = NULL;
+    *num_spans = 0;
+
+    if (num_polygons <= 0 || w <= 0 || h <= 0) {
+        return 0;
+    }
+
+    polygons = (RasterPolygon *) SDL_malloc(num_polygons * sizeof (*polygons));
+    if (!polygons) {
+        return SDL_OutOfMemory();
+    }
+    for (i = 0; i < num_polygons; points += counts[i++]) {
+        RasterPolygon *polygon = &polygons[n];
+        if (counts[i] < 3) {
+            continue;
+        }
+        polygon->points = points;
+        polygon->count = counts[i];
+        polygon->miny = polygon->maxy = points[0].y;
+        for (j = 1; j < counts[i]; ++j) {
+            polygon->miny = SDL_min(polygon->miny, points[j].y);
+            polygon->maxy = SDL_max(polygon->maxy, points[j].y);
+        }
+        if (polygon->miny < polygon->maxy) {
+            miny = n ? SDL_min(miny, polygon->miny) : polygon->miny;
+            maxy = n ? SDL_max(maxy, polygon->maxy) : polygon->maxy;
+            ++n;
+        }
+    }
+    if (n == 0 || maxy <= 0.0f || miny >= (float) h) {
+        SDL_free(polygons);
+        return 0;
+    }
+    y0 = (int) SDL_max(SDL_floorf(miny), 0.0f);
+    y1 = (int) SDL_min(SDL_ceilf(maxy), (float) h);
+
+    /* The polygons become active when the rows reach them */
+    SDL_qsort(polygons, n, sizeof (*polygons), ComparePolygons);
+
+    row = (Uint8 *) SDL_calloc(w, sizeof (*row));
+    accum = (Uint16 *) SDL_malloc(w * sizeof (*accum));
+    active = (int *) SDL_malloc(n * sizeof (*active));
+    if (!row || !accum || !active) {
+        retval = SDL_OutOfMemory();
+        y1 = y0;
+    }
+
+    for (y = y0; y < y1 && retval == 0; ++y) {
+        int rowmin = w, rowmax = 0, x;
+
+        while (next < n && polygons[next].miny < (float) (y + 1)) {
+            active[num_active++] = next++;
+        }
+        for (i = 0, j = 0; i < num_active; ++i) {
+            const RasterPolygon *polygon = &polygons[active[i]];
+            if (polygon->maxy > (float) y) {
+                active[j++] = active[i];
+                CoverPolygonRow(polygon, y, w, antialias, row, accum, &rowmin, &rowmax);
+            }
+        }
+        num_active = j;
+
+        for (x = rowmin; x < rowmax && retval == 0; ) {
+            const Uint8 coverage = row[x];
+            const int start = x;
+            while (x < rowmax && row[x] == coverage) {
+                ++x;
+            }
+            if (coverage) {
+                retval = AddSpan(&result, start, y, x - start, coverage);
+            }
+        }
+        if (rowmin < rowmax) {
+            SDL_memset(&row[rowmin], 0, rowmax - rowmin);
+        }
+    }
+
+    SDL_free(active);
+    SDL_free(accum);
+    SDL_free(row);
+    SDL_free(polygons);
+
+    if (retval < 0) {
+        SDL_free(result.spans);
+        return retval;
+    }
+    *spans = result.spans;
+    *num_spans = result.num_spans;
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
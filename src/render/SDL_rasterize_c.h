@@ -0,0 +1,52 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_rasterize_c_h_
+#define SDL_rasterize_c_h_
+
+#include "../SDL_internal.h"
+
+#include "SDL_rect.h"
+
+/* This is the span rasterizer for wide lines and polygons */
+
+/* A horizontal run of pixels with the same coverage, from 1 to 255 */
+typedef struct SDL_RasterSpan
+{
+    int x, y, w;
+    Uint8 coverage;
+} SDL_RasterSpan;
+
+/* Rasterizes the union of convex polygons into spans, clipped to the
+   rectangle (0, 0, w, h). Polygon i has counts[i] vertices, which follow the
+   ones of polygon i-1 in points. Pixels covered by several polygons are only
+   returned once, with the highest coverage. Without antialiasing the pixels
+   whose centers are inside a polygon are covered.
+
+   The spans are returned in row order, in an array allocated with SDL_malloc().
+ */
+extern int SDL_RasterizeConvexPolygons(const SDL_FPoint *points, const int *counts, int num_polygons,
+                                       int w, int h, SDL_bool antialias,
+                                       SDL_RasterSpan **spans, int *num_spans);
+
+#endif /* SDL_rasterize_c_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -26,12 +26,17 @@
 #include "SDL_hints.h"
 #include "SDL_log.h"
 #include "SDL_render.h"
+#include "SDL_timer.h"
 #include "SDL_sysrender.h"
+#include "SDL_rasterize_c.h"
+#include "SDL_rendercapture_c.h"
 #include "software/SDL_render_sw_c.h"
 
 
 #define SDL_WINDOWRENDERDATA    "_SDL_WindowRenderData"
 
+#define SDL_MAX_STREAMING_BUFFERS   8
+
 #define CHECK_RENDERER_MAGIC(renderer, retval) \
     SDL_assert(renderer && renderer->magic == &renderer_magic); \
     if (!renderer || renderer->magic != &renderer_magic) { \
@@ -190,17 +195,85 @@ DebugLogRenderCommands(const SDL_RenderCommand *cmd)
                         (int) cmd->data.draw.b, (int) cmd->data.draw.a,
                         (int) cmd->data.draw.blend, cmd->data.draw.texture);
                 break;
+
+            case SDL_RENDERCMD_GEOMETRY:
+                SDL_Log(" %u. geometry (first=%u, count=%u, r=%d, g=%d, b=%d, a=%d, blend=%d, tex=%p)", i++,
+                        (unsigned int) cmd->data.draw.first,
+                        (unsigned int) cmd->data.draw.count,
+                        (int) cmd->data.draw.r, (int) cmd->data.draw.g,
+                        (int) cmd->data.draw.b, (int) cmd->data.draw.a,
+                        (int) cmd->data.draw.blend, cmd->data.draw.texture);
+                break;
         }
         cmd = cmd->next;
     }
 #endif
 }
 
+/* A read queued by SDL_RenderReadPixelsAsync() */
+typedef struct SDL_RenderReadback
+{
+    SDL_RenderCommand *marker;  /* the no-op command queued in its place */
+    SDL_Rect rect;              /* already adjusted to the viewport, empty if nothing is read */
+    Uint32 format;
+    void *dst;                  /* where the first pixel of rect goes */
+    int pitch;
+    void *pixels;               /* as passed in, for the callback */
+    SDL_RenderReadPixelsCallback callback;
+    void *userdata;
+    int result;
+    struct SDL_RenderReadback *next;
+} SDL_RenderReadback;
+
+/* Runs the command queue up to each queued read in turn, and reads the
+   pixels in between. The callbacks are called later, by
+   FinishRenderReadbacks(), as they may queue more commands. */
+static int
+RunCommandQueueWithReadbacks(SDL_Renderer *renderer, SDL_RenderReadback *readbacks)
+{
+    SDL_RenderCommand *first = renderer->render_commands;
+    SDL_RenderReadback *readback;
+    int retval = 0;
+
+    for (readback = readbacks; readback; readback = readback->next) {
+        SDL_RenderCommand *next = readback->marker->next;
+
+        readback->marker->next = NULL;
+        readback->result = renderer->RunCommandQueue(renderer, first, renderer->vertex_data, renderer->vertex_data_used);
+        readback->marker->next = next;
+        first = next;
+
+        if (readback->result < 0) {
+            retval = -1;
+        } else if (!SDL_RectEmpty(&readback->rect)) {
+            readback->result = renderer->RenderReadPixels(renderer, &readback->rect, readback->format,
+                                                          readback->dst, readback->pitch);
+        }
+    }
+    if (first) {
+        if (renderer->RunCommandQueue(renderer, first, renderer->vertex_data, renderer->vertex_data_used) < 0) {
+            retval = -1;
+        }
+    }
+    return retval;
+}
+
+static void
+FinishRenderReadbacks(SDL_RenderReadback *readbacks)
+{
+    while (readbacks) {
+        SDL_RenderReadback *next = readbacks->next;
+        readbacks->callback(readbacks->userdata, readbacks->pixels, readbacks->result);
+        SDL_free(readbacks);
+        readbacks = next;
+    }
+}
+
 static int
-FlushRenderCommands(SDL_Renderer *renderer)
+FlushRenderCommands(SDL_Renderer *renderer, const SDL_RenderFlushReason reason)
 {
-    SDL_AllocVertGap *prevgap = &renderer->vertex_data_gaps;
-    SDL_AllocVertGap *gap = prevgap;
+    SDL_RenderReadback *readbacks = renderer->readbacks;
+    Uint64 start;
     int retval;
 
     SDL_assert((renderer->render_commands == NULL) == (renderer->render_commands_tail == NULL));
@@ -212,15 +285,20 @@ FlushRenderCommands(SDL_Renderer *renderer)
 
     DebugLogRenderCommands(renderer->render_commands);
 
-    retval = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
+    renderer->stats.flushes++;
+    renderer->stats.flush_reasons[reason]++;
+    renderer->stats.commands_issued += renderer->num_render_commands;
+    renderer->stats.vertex_bytes += renderer->vertex_data_used;
 
-    while (gap) {
-        prevgap = gap;
-        gap = gap->next;
+    start = SDL_GetPerformanceCounter();
+    if (readbacks) {
+        renderer->readbacks = NULL;
+        renderer->readbacks_tail = NULL;
+        retval = RunCommandQueueWithReadbacks(renderer, readbacks);
+    } else {
+        retval = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
     }
-    prevgap->next = renderer->vertex_data_gaps_pool;
-    renderer->vertex_data_gaps_pool = renderer->vertex_data_gaps.next;
-    renderer->vertex_data_gaps.next = NULL;
+    renderer->stats.queue_time += SDL_GetPerformanceCounter() - start;
 
     /* Move the whole render command queue to the unused pool so we can reuse them next time. */
     if (renderer->render_commands_tail != NULL) {
@@ -230,20 +308,24 @@ FlushRenderCommands(SDL_Renderer *renderer)
         renderer->render_commands = NULL;
     }
     renderer->vertex_data_used = 0;
+    renderer->num_render_commands = 0;
     renderer->render_command_generation++;
     renderer->color_queued = SDL_FALSE;
     renderer->viewport_queued = SDL_FALSE;
     renderer->cliprect_queued = SDL_FALSE;
+    renderer->merge_command = NULL;
+
+    FinishRenderReadbacks(readbacks);
     return retval;
 }
 
 static int
-FlushRenderCommandsIfTextureNeeded(SDL_Texture *texture)
+FlushRenderCommandsIfTextureNeeded(SDL_Texture *texture, const SDL_RenderFlushReason reason)
 {
     SDL_Renderer *renderer = texture->renderer;
     if (texture->last_command_generation == renderer->render_command_generation) {
         /* the current command queue depends on this texture, flush the queue now before it changes */
-        return FlushRenderCommands(renderer);
+        return FlushRenderCommands(renderer, reason);
     }
     return 0;
 }
@@ -251,117 +333,104 @@ FlushRenderCommandsIfTextureNeeded(SDL_Texture *texture)
 static SDL_INLINE int
 FlushRenderCommandsIfNotBatching(SDL_Renderer *renderer)
 {
-    return renderer->batching ? 0 : FlushRenderCommands(renderer);
+    return renderer->batching ? 0 : FlushRenderCommands(renderer, SDL_RENDERFLUSH_NOT_BATCHING);
 }
 
 int
 SDL_RenderFlush(SDL_Renderer * renderer)
 {
-    return FlushRenderCommands(renderer);
+    return FlushRenderCommands(renderer, SDL_RENDERFLUSH_EXPLICIT);
 }
 
-static SDL_AllocVertGap *
-AllocateVertexGap(SDL_Renderer *renderer)
+/* Ends the frame of the statistics, at the end of SDL_RenderPresent() */
+static void
+EndRenderStatsFrame(SDL_Renderer *renderer)
 {
-    SDL_AllocVertGap *retval = renderer->vertex_data_gaps_pool;
-    if (retval) {
-        renderer->vertex_data_gaps_pool = retval->next;
-        retval->next = NULL;
-    } else {
-        retval = (SDL_AllocVertGap *) SDL_malloc(sizeof (SDL_AllocVertGap));
-        if (!retval) {
-            SDL_OutOfMemory();
-        }
-    }
-    return retval;
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+
+    renderer->last_stats = renderer->stats;
+    renderer->last_stats.queue_time = (renderer->stats.queue_time * 1000000) / frequency;
+    renderer->last_stats.present_time = (renderer->stats.present_time * 1000000) / frequency;
+    SDL_zero(renderer->stats);
 }
 
+int
+SDL_RenderGetStats(SDL_Renderer * renderer, SDL_RenderStats * stats)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
 
-void *
-SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes, const size_t alignment, size_t *offset)
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+    *stats = renderer->last_stats;
+    return 0;
+}
+
+static SDL_bool
+GrowVertexData(SDL_Renderer *renderer, const size_t needed)
 {
-    const size_t needed = renderer->vertex_data_used + numbytes + alignment;
-    size_t aligner, aligned;
-    void *retval;
-
-    SDL_AllocVertGap *prevgap = &renderer->vertex_data_gaps;
-    SDL_AllocVertGap *gap = prevgap->next;
-    while (gap) {
-        const size_t gapoffset = gap->offset;
-        aligner = (alignment && ((gap->offset % alignment) != 0)) ? (alignment - (gap->offset % alignment)) : 0;
-        aligned = gapoffset + aligner;
-
-        /* Can we use this gap? */
-        if ((aligner < gap->len) && ((gap->len - aligner) >= numbytes)) {
-            /* we either finished this gap off, trimmed the left, trimmed the right, or split it into two gaps. */
-            if (gap->len == numbytes) {  /* finished it off, remove it */
-                SDL_assert(aligned == gapoffset);
-                prevgap->next = gap->next;
-                gap->next = renderer->vertex_data_gaps_pool;
-                renderer->vertex_data_gaps_pool = gap;
-            } else if (aligned == gapoffset) {  /* trimmed the left */
-                gap->offset += numbytes;
-                gap->len -= numbytes;
-            } else if (((aligned - gapoffset) + numbytes) == gap->len) {  /* trimmed the right */
-                gap->len -= numbytes;
-            } else {  /* split into two gaps */
-                SDL_AllocVertGap *newgap = AllocateVertexGap(renderer);
-                if (!newgap) {
-                    return NULL;
-                }
-                newgap->offset = aligned + numbytes;
-                newgap->len = gap->len - (aligner + numbytes);
-                newgap->next = gap->next;
-                // gap->offset doesn't change.
-                gap->len = aligner;
-                gap->next = newgap;
-            }
+    size_t newsize = renderer->vertex_data ? renderer->vertex_data_allocation : 1024;
+    void *ptr;
 
-            if (offset) {
-                *offset = aligned;
-            }
-            return ((Uint8 *) renderer->vertex_data) + aligned;
+    while (newsize < needed) {
+        if (newsize > (~(size_t)0) / 2) {
+            SDL_OutOfMemory();  /* doubling it again would wrap around */
+            return SDL_FALSE;
         }
+        newsize *= 2;
+    }
 
-        /* Try the next gap */
-        prevgap = gap;
-        gap = gap->next;
+    ptr = SDL_realloc(renderer->vertex_data, newsize);
+    if (ptr == NULL) {
+        SDL_OutOfMemory();
+        return SDL_FALSE;
     }
+    renderer->vertex_data = ptr;
+    renderer->vertex_data_allocation = newsize;
+    return SDL_TRUE;
+}
 
-    /* no gaps with enough space; get a new piece of the vertex buffer */
-    while (needed > renderer->vertex_data_allocation) {
-        const size_t current_allocation = renderer->vertex_data ? renderer->vertex_data_allocation : 1024;
-        const size_t newsize = current_allocation * 2;
-        void *ptr = SDL_realloc(renderer->vertex_data, newsize);
-        if (ptr == NULL) {
-            SDL_OutOfMemory();
-            return NULL;
+/* Reserves the vertex data asked for by SDL_HINT_RENDER_VERTEX_CAPACITY, so
+   a frame that fits doesn't have to grow it. */
+static void
+ReserveVertexData(SDL_Renderer *renderer)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_RENDER_VERTEX_CAPACITY);
+    if (hint) {
+        const int capacity = SDL_atoi(hint);
+        if (capacity > 0) {
+            GrowVertexData(renderer, (size_t) capacity);
         }
-        renderer->vertex_data = ptr;
-        renderer->vertex_data_allocation = newsize;
     }
+}
 
-    aligner = (alignment && ((renderer->vertex_data_used % alignment) != 0)) ? (alignment - (renderer->vertex_data_used % alignment)) : 0;
-    aligned = renderer->vertex_data_used + aligner;
-
-    retval = ((Uint8 *) renderer->vertex_data) + aligned;
-    if (offset) {
-        *offset = aligned;
+void *
+SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes, const size_t alignment, size_t *offset)
+{
+    /* Allocations just bump the used size, any padding for the alignment
+       is skipped. FlushRenderCommands() resets it, keeping the memory. */
+    const size_t used = renderer->vertex_data_used;
+    const size_t aligner = (alignment && ((used % alignment) != 0)) ? (alignment - (used % alignment)) : 0;
+    const size_t aligned = used + aligner;
+    const size_t needed = aligned + numbytes;
+
+    if (needed < aligned) {
+        SDL_OutOfMemory();  /* numbytes is so large that the sum wrapped around */
+        return NULL;
     }
 
-    if (aligner) {  /* made a new gap... */
-        SDL_AllocVertGap *newgap = AllocateVertexGap(renderer);
-        if (newgap) {  /* just let it slide as lost space if malloc fails. */
-            newgap->offset = renderer->vertex_data_used;
-            newgap->len = aligner;
-            newgap->next = NULL;
-            prevgap->next = newgap;
+    if (needed > renderer->vertex_data_allocation) {
+        if (!GrowVertexData(renderer, needed)) {
+            return NULL;
         }
     }
 
-    renderer->vertex_data_used += aligner + numbytes;
+    renderer->vertex_data_used = needed;
 
-    return retval;
+    if (offset) {
+        *offset = aligned;
+    }
+    return ((Uint8 *) renderer->vertex_data) + aligned;
 }
 
 static SDL_RenderCommand *
@@ -389,6 +458,8 @@ AllocateRenderCommand(SDL_Renderer *renderer)
         renderer->render_commands = retval;
     }
     renderer->render_commands_tail = retval;
+    renderer->num_render_commands++;
+    renderer->stats.commands_queued++;
 
     return retval;
 }
@@ -410,6 +481,9 @@ QueueCmdSetViewport(SDL_Renderer *renderer)
             } else {
                 SDL_memcpy(&renderer->last_queued_viewport, &renderer->viewport, sizeof (SDL_Rect));
                 renderer->viewport_queued = SDL_TRUE;
+                if (renderer->capture) {
+                    SDL_CaptureViewport(renderer);
+                }
             }
         }
     }
@@ -433,6 +507,9 @@ QueueCmdSetClipRect(SDL_Renderer *renderer)
             SDL_memcpy(&renderer->last_queued_cliprect, &renderer->clip_rect, sizeof (SDL_Rect));
             renderer->last_queued_cliprect_enabled = renderer->clipping_enabled;
             renderer->cliprect_queued = SDL_TRUE;
+            if (renderer->capture) {
+                SDL_CaptureClipRect(renderer);
+            }
         }
     }
     return retval;
@@ -481,6 +558,9 @@ QueueCmdClear(SDL_Renderer *renderer)
     cmd->data.color.g = renderer->g;
     cmd->data.color.b = renderer->b;
     cmd->data.color.a = renderer->a;
+    if (renderer->capture) {
+        SDL_CaptureClear(renderer, cmd);
+    }
     return 0;
 }
 
@@ -500,12 +580,80 @@ PrepQueueCmdDraw(SDL_Renderer *renderer, const Uint8 r, const Uint8 g, const Uin
     return retval;
 }
 
+/* Remembers the last queued command if the draw about to be queued can be
+   merged into it: it has to draw the same way, with nothing queued since.
+   Lines are never merged, as that would join the two polylines.
+ */
+static void
+PrepMergeDrawCommand(SDL_Renderer *renderer, const SDL_RenderCommandType cmdtype, SDL_Texture *texture,
+                     const Uint8 r, const Uint8 g, const Uint8 b, const Uint8 a, const SDL_BlendMode blend)
+{
+    SDL_RenderCommand *prev = renderer->render_commands_tail;
+
+    renderer->merge_command = NULL;
+
+    if (!renderer->batching || !prev || prev->command != cmdtype) {
+        return;
+    }
+    if (cmdtype != SDL_RENDERCMD_DRAW_POINTS && cmdtype != SDL_RENDERCMD_FILL_RECTS &&
+        cmdtype != SDL_RENDERCMD_GEOMETRY &&
+        (cmdtype != SDL_RENDERCMD_COPY || !renderer->QueueCopyBatch)) {
+        return;
+    }
+    if (prev->data.draw.texture != texture || prev->data.draw.blend != blend ||
+        prev->data.draw.r != r || prev->data.draw.g != g ||
+        prev->data.draw.b != b || prev->data.draw.a != a) {
+        return;
+    }
+
+    renderer->merge_command = prev;
+    renderer->merge_vertex_end = renderer->vertex_data_used;
+}
+
+/* Merges a draw command that was just queued into the one found by
+   PrepMergeDrawCommand(). The backends store each item of these commands
+   in the same number of bytes, so the vertex data can be joined when the
+   new items were placed right after the old ones.
+ */
+static void
+MergeDrawCommand(SDL_Renderer *renderer, SDL_RenderCommand *cmd)
+{
+    SDL_RenderCommand *prev = renderer->merge_command;
+    size_t prevlen, len;
+
+    renderer->merge_command = NULL;
+
+    if (!prev || cmd->command != prev->command || cmd->data.draw.count == 0 ||
+        cmd->data.draw.first != renderer->merge_vertex_end) {
+        return;
+    }
+
+    /* Nothing was allocated after the previous command, so its vertex data
+       ends at merge_vertex_end; check that the items are the same size. */
+    prevlen = cmd->data.draw.first - prev->data.draw.first;
+    len = renderer->vertex_data_used - cmd->data.draw.first;
+    if (cmd->data.draw.first < prev->data.draw.first ||
+        (prevlen * cmd->data.draw.count) != (len * prev->data.draw.count)) {
+        return;
+    }
+
+    SDL_assert(renderer->render_commands_tail == cmd);
+    renderer->num_render_commands--;
+    renderer->stats.commands_merged++;
+    prev->data.draw.count += cmd->data.draw.count;
+    prev->next = NULL;
+    renderer->render_commands_tail = prev;
+    cmd->next = renderer->render_commands_pool;
+    renderer->render_commands_pool = cmd;
+}
+
 static SDL_RenderCommand *
 PrepQueueCmdDrawSolid(SDL_Renderer *renderer, const SDL_RenderCommandType cmdtype)
 {
     /* !!! FIXME: drop this draw if viewport w or h is zero. */
     SDL_RenderCommand *cmd = NULL;
     if (PrepQueueCmdDraw(renderer, renderer->r, renderer->g, renderer->b, renderer->a) == 0) {
+        PrepMergeDrawCommand(renderer, cmdtype, NULL, renderer->r, renderer->g, renderer->b, renderer->a, renderer->blendMode);
         cmd = AllocateRenderCommand(renderer);
         if (cmd != NULL) {
             cmd->command = cmdtype;
@@ -531,6 +679,11 @@ QueueCmdDrawPoints(SDL_Renderer *renderer, const SDL_FPoint * points, const int
         retval = renderer->QueueDrawPoints(renderer, cmd, points, count);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            if (renderer->capture) {
+                SDL_CapturePoints(renderer, cmd, points, count);
+            }
+            MergeDrawCommand(renderer, cmd);
         }
     }
     return retval;
@@ -545,6 +698,8 @@ QueueCmdDrawLines(SDL_Renderer *renderer, const SDL_FPoint * points, const int c
         retval = renderer->QueueDrawLines(renderer, cmd, points, count);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else if (renderer->capture) {
+            SDL_CapturePoints(renderer, cmd, points, count);
         }
     }
     return retval;
@@ -559,26 +714,43 @@ QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect * rects, const int cou
         retval = renderer->QueueFillRects(renderer, cmd, rects, count);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            if (renderer->capture) {
+                SDL_CaptureRects(renderer, cmd, rects, count);
+            }
+            MergeDrawCommand(renderer, cmd);
         }
     }
     return retval;
 }
 
 static SDL_RenderCommand *
-PrepQueueCmdDrawTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_RenderCommandType cmdtype)
+PrepQueueCmdDrawTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Color *color, const SDL_RenderCommandType cmdtype)
 {
     /* !!! FIXME: drop this draw if viewport w or h is zero. */
     SDL_RenderCommand *cmd = NULL;
-    if (PrepQueueCmdDraw(renderer, texture->r, texture->g, texture->b, texture->a) == 0) {
+    SDL_Color c;
+
+    if (color) {
+        c = *color;
+    } else {
+        c.r = texture->r;
+        c.g = texture->g;
+        c.b = texture->b;
+        c.a = texture->a;
+    }
+
+    if (PrepQueueCmdDraw(renderer, c.r, c.g, c.b, c.a) == 0) {
+        PrepMergeDrawCommand(renderer, cmdtype, texture, c.r, c.g, c.b, c.a, texture->blendMode);
         cmd = AllocateRenderCommand(renderer);
         if (cmd != NULL) {
             cmd->command = cmdtype;
             cmd->data.draw.first = 0;  /* render backend will fill this in. */
             cmd->data.draw.count = 0;  /* render backend will fill this in. */
-            cmd->data.draw.r = texture->r;
-            cmd->data.draw.g = texture->g;
-            cmd->data.draw.b = texture->b;
-            cmd->data.draw.a = texture->a;
+            cmd->data.draw.r = c.r;
+            cmd->data.draw.g = c.g;
+            cmd->data.draw.b = c.b;
+            cmd->data.draw.a = c.a;
             cmd->data.draw.blend = texture->blendMode;
             cmd->data.draw.texture = texture;
         }
@@ -589,12 +761,59 @@ PrepQueueCmdDrawTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_
 static int
 QueueCmdCopy(SDL_Renderer *renderer, SDL_Texture * texture, const SDL_Rect * srcrect, const SDL_FRect * dstrect)
 {
-    SDL_RenderCommand *cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY);
+    SDL_RenderCommand *cmd = PrepQueueCmdDrawTexture(renderer, texture, NULL, SDL_RENDERCMD_COPY);
     int retval = -1;
     if (cmd != NULL) {
         retval = renderer->QueueCopy(renderer, cmd, texture, srcrect, dstrect);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            if (renderer->capture) {
+                SDL_CaptureCopies(renderer, cmd, srcrect, dstrect, 1);
+            }
+            MergeDrawCommand(renderer, cmd);
+        }
+    }
+    return retval;
+}
+
+static int
+QueueCmdCopyBatch(SDL_Renderer *renderer, SDL_Texture * texture, const SDL_Color *color,
+                  const SDL_Rect * srcrects, const SDL_FRect * dstrects, const int count)
+{
+    SDL_RenderCommand *cmd;
+    int retval = -1;
+    int i;
+
+    if (!renderer->QueueCopyBatch) {
+        /* The backend can only draw one copy per command, queue them separately. */
+        for (i = 0; i < count; ++i) {
+            cmd = PrepQueueCmdDrawTexture(renderer, texture, color, SDL_RENDERCMD_COPY);
+            if (cmd == NULL) {
+                return -1;
+            }
+            retval = renderer->QueueCopy(renderer, cmd, texture, &srcrects[i], &dstrects[i]);
+            if (retval < 0) {
+                cmd->command = SDL_RENDERCMD_NO_OP;
+                return retval;
+            }
+            if (renderer->capture) {
+                SDL_CaptureCopies(renderer, cmd, &srcrects[i], &dstrects[i], 1);
+            }
+        }
+        return 0;
+    }
+
+    cmd = PrepQueueCmdDrawTexture(renderer, texture, color, SDL_RENDERCMD_COPY);
+    if (cmd != NULL) {
+        retval = renderer->QueueCopyBatch(renderer, cmd, texture, srcrects, dstrects, count);
+        if (retval < 0) {
+            cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            if (renderer->capture) {
+                SDL_CaptureCopies(renderer, cmd, srcrects, dstrects, count);
+            }
+            MergeDrawCommand(renderer, cmd);
         }
     }
     return retval;
@@ -605,13 +824,43 @@ QueueCmdCopyEx(SDL_Renderer *renderer, SDL_Texture * texture,
                const SDL_Rect * srcquad, const SDL_FRect * dstrect,
                const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip)
 {
-    SDL_RenderCommand *cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY_EX);
+    SDL_RenderCommand *cmd = PrepQueueCmdDrawTexture(renderer, texture, NULL, SDL_RENDERCMD_COPY_EX);
     int retval = -1;
     SDL_assert(renderer->QueueCopyEx != NULL);  /* should have caught at higher level. */
     if (cmd != NULL) {
         retval = renderer->QueueCopyEx(renderer, cmd, texture, srcquad, dstrect, angle, center, flip);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else if (renderer->capture) {
+            SDL_CaptureCopyEx(renderer, cmd, srcquad, dstrect, angle, center, flip);
+        }
+    }
+    return retval;
+}
+
+static int
+QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
+                 const SDL_Vertex *vertices, const int num_vertices,
+                 const int *indices, const int num_indices)
+{
+    SDL_RenderCommand *cmd;
+    int retval = -1;
+    if (texture) {
+        cmd = PrepQueueCmdDrawTexture(renderer, texture, NULL, SDL_RENDERCMD_GEOMETRY);
+    } else {
+        cmd = PrepQueueCmdDrawSolid(renderer, SDL_RENDERCMD_GEOMETRY);
+    }
+    if (cmd != NULL) {
+        retval = renderer->QueueGeometry(renderer, cmd, texture, vertices, num_vertices,
+                                         indices, num_indices,
+                                         renderer->scale.x, renderer->scale.y);
+        if (retval < 0) {
+            cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            if (renderer->capture) {
+                SDL_CaptureGeometry(renderer, cmd, vertices, num_vertices, indices, num_indices);
+            }
+            MergeDrawCommand(renderer, cmd);
         }
     }
     return retval;
@@ -923,6 +1172,10 @@ SDL_CreateRenderer(SDL_Window * window, int index, Uint32 flags)
         /* new textures start at zero, so we start at 1 so first render doesn't flush by accident. */
         renderer->render_command_generation = 1;
 
+        ReserveVertexData(renderer);
+
+        SDL_StartRenderCapture(renderer);
+
         if (window && renderer->GetOutputSize) {
             int window_w, window_h;
             int output_w, output_h;
@@ -973,6 +1226,13 @@ SDL_CreateSoftwareRenderer(SDL_Surface * surface)
         /* new textures start at zero, so we start at 1 so first render doesn't flush by accident. */
         renderer->render_command_generation = 1;
 
+        ReserveVertexData(renderer);
+
+        /* Apps may read the surface at any time, so only batch when asked to. */
+        renderer->batching = SDL_GetHintBoolean(SDL_HINT_RENDER_BATCHING, SDL_FALSE);
+
+        SDL_StartRenderCapture(renderer);
+
         SDL_RenderSetViewport(renderer, NULL);
     }
     return renderer;
@@ -1087,8 +1347,97 @@ static SDL_ScaleMode SDL_GetScaleMode(void)
     }
 }
 
+/* The number of buffers asked for by SDL_HINT_RENDER_STREAMING_BUFFERS */
+static int
+GetStreamingBufferCount(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_RENDER_STREAMING_BUFFERS);
+    if (hint) {
+        return SDL_max(SDL_min(SDL_atoi(hint), SDL_MAX_STREAMING_BUFFERS), 1);
+    }
+    return 1;
+}
+
+static SDL_Texture *
+CreateTexture(SDL_Renderer * renderer, Uint32 format, int access, int w, int h, SDL_ScaleMode scaleMode, int num_buffers);
+
+/* Creates the buffers of a streaming texture, each one a texture of its
+   own, so the queued commands can keep using one while another is updated. */
+static int
+CreateStreamingBuffers(SDL_Texture * texture, int num_buffers)
+{
+    SDL_Renderer *renderer = texture->renderer;
+
+    texture->buffers = (SDL_Texture **) SDL_calloc(num_buffers, sizeof(*texture->buffers));
+    if (!texture->buffers) {
+        return SDL_OutOfMemory();
+    }
+    while (texture->num_buffers < num_buffers) {
+        SDL_Texture *buffer = CreateTexture(renderer, texture->format, texture->access,
+                                            texture->w, texture->h, texture->scaleMode, 1);
+        if (!buffer) {
+            return -1;
+        }
+        texture->buffers[texture->num_buffers++] = buffer;
+    }
+    texture->native = texture->buffers[0];
+
+    /* Move the texture before its buffers in the list, so it's destroyed first */
+    texture->prev->next = texture->next;
+    if (texture->next) {
+        texture->next->prev = texture->prev;
+    }
+    texture->prev = NULL;
+    texture->next = renderer->textures;
+    renderer->textures->prev = texture;
+    renderer->textures = texture;
+    return 0;
+}
+
+/* Returns the buffer of a streaming texture to lock or update. That's the
+   one in use, unless the queued commands use it and the whole texture is
+   replaced: then any buffer they don't use is taken instead of flushing. */
+static SDL_Texture *
+SelectStreamingBuffer(SDL_Texture * texture, const SDL_Rect * rect)
+{
+    SDL_Renderer *renderer = texture->renderer;
+    int i;
+
+    if (texture->native->last_command_generation != renderer->render_command_generation) {
+        return texture->native;
+    }
+    if (rect->x != 0 || rect->y != 0 || rect->w != texture->w || rect->h != texture->h) {
+        return texture->native;  /* the rest of the texture has to be kept */
+    }
+    for (i = 0; i < texture->num_buffers; ++i) {
+        SDL_Texture *buffer = texture->buffers[i];
+        if (buffer->last_command_generation != renderer->render_command_generation) {
+            SDL_SetTextureColorMod(buffer, texture->r, texture->g, texture->b);
+            SDL_SetTextureAlphaMod(buffer, texture->a);
+            SDL_SetTextureBlendMode(buffer, texture->blendMode);
+            texture->native = buffer;
+            break;
+        }
+    }
+    return texture->native;
+}
+
 SDL_Texture *
 SDL_CreateTexture(SDL_Renderer * renderer, Uint32 format, int access, int w, int h)
+{
+    return SDL_CreateTextureWithScaleMode(renderer, format, access, w, h, SDL_GetScaleMode());
+}
+
+SDL_Texture *
+SDL_CreateTextureWithScaleMode(SDL_Renderer * renderer, Uint32 format, int access, int w, int h, SDL_ScaleMode scaleMode)
+{
+    const int num_buffers = (access == SDL_TEXTUREACCESS_STREAMING) ? GetStreamingBufferCount() : 1;
+
+    return CreateTexture(renderer, format, access, w, h, scaleMode, num_buffers);
+}
+
+static SDL_Texture *
+CreateTexture(SDL_Renderer * renderer, Uint32 format, int access, int w, int h, SDL_ScaleMode scaleMode, int num_buffers)
 {
     SDL_Texture *texture;
 
@@ -1128,7 +1477,7 @@ SDL_CreateTexture(SDL_Renderer * renderer, Uint32 format, int access, int w, int
     texture->g = 255;
     texture->b = 255;
     texture->a = 255;
-    texture->scaleMode = SDL_GetScaleMode();
+    texture->scaleMode = scaleMode;
     texture->renderer = renderer;
     texture->next = renderer->textures;
     if (renderer->textures) {
@@ -1136,15 +1485,23 @@ SDL_CreateTexture(SDL_Renderer * renderer, Uint32 format, int access, int w, int
     }
     renderer->textures = texture;
 
-    if (IsSupportedFormat(renderer, format)) {
+    if (num_buffers > 1 && IsSupportedFormat(renderer, format)) {
+        if (CreateStreamingBuffers(texture, num_buffers) < 0) {
+            SDL_DestroyTexture(texture);
+            return NULL;
+        }
+    } else if (IsSupportedFormat(renderer, format)) {
         if (renderer->CreateTexture(renderer, texture) < 0) {
             SDL_DestroyTexture(texture);
             return NULL;
         }
+        if (renderer->capture) {
+            SDL_CaptureCreateTexture(texture);
+        }
     } else {
-        texture->native = SDL_CreateTexture(renderer,
+        texture->native = CreateTexture(renderer,
                                 GetClosestSupportedFormat(renderer, format),
-                                access, w, h);
+                                access, w, h, scaleMode, num_buffers);
         if (!texture->native) {
             SDL_DestroyTexture(texture);
             return NULL;
@@ -1526,14 +1883,23 @@ SDL_UpdateTexture(SDL_Texture * texture, const SDL_Rect * rect,
         return 0;  /* nothing to do. */
     } else if (texture->yuv) {
         return SDL_UpdateTextureYUV(texture, rect, pixels, pitch);
+    } else if (texture->buffers) {
+        return SDL_UpdateTexture(SelectStreamingBuffer(texture, rect), rect, pixels, pitch);
     } else if (texture->native) {
         return SDL_UpdateTextureNative(texture, rect, pixels, pitch);
     } else {
         SDL_Renderer *renderer = texture->renderer;
-        if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
+        if (FlushRenderCommandsIfTextureNeeded(texture, SDL_RENDERFLUSH_TEXTURE) < 0) {
+            return -1;
+        }
+        renderer->stats.texture_updates++;
+        if (renderer->UpdateTexture(renderer, texture, rect, pixels, pitch) < 0) {
             return -1;
         }
-        return renderer->UpdateTexture(renderer, texture, rect, pixels, pitch);
+        if (renderer->capture) {
+            SDL_CaptureUpdateTexture(texture, rect, pixels, pitch);
+        }
+        return 0;
     }
 }
 
@@ -1637,15 +2003,24 @@ int SDL_UpdateYUVTexture(SDL_Texture * texture, const SDL_Rect * rect,
 
     if (texture->yuv) {
         return SDL_UpdateTextureYUVPlanar(texture, rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
+    } else if (texture->buffers) {
+        return SDL_UpdateYUVTexture(SelectStreamingBuffer(texture, rect), rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
     } else {
         SDL_assert(!texture->native);
         renderer = texture->renderer;
         SDL_assert(renderer->UpdateTextureYUV);
         if (renderer->UpdateTextureYUV) {
-            if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
+            if (FlushRenderCommandsIfTextureNeeded(texture, SDL_RENDERFLUSH_TEXTURE) < 0) {
+                return -1;
+            }
+            renderer->stats.texture_updates++;
+            if (renderer->UpdateTextureYUV(renderer, texture, rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch) < 0) {
                 return -1;
             }
-            return renderer->UpdateTextureYUV(renderer, texture, rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
+            if (renderer->capture) {
+                SDL_CaptureUpdateTextureYUV(texture, rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
+            }
+            return 0;
         } else {
             return SDL_Unsupported();
         }
@@ -1692,19 +2067,32 @@ SDL_LockTexture(SDL_Texture * texture, const SDL_Rect * rect,
     }
 
     if (texture->yuv) {
-        if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
+        if (FlushRenderCommandsIfTextureNeeded(texture, SDL_RENDERFLUSH_TEXTURE) < 0) {
             return -1;
         }
         return SDL_LockTextureYUV(texture, rect, pixels, pitch);
+    } else if (texture->buffers) {
+        /* The buffer stays in use until the texture is unlocked */
+        return SDL_LockTexture(SelectStreamingBuffer(texture, rect), rect, pixels, pitch);
     } else if (texture->native) {
         /* Calls a real SDL_LockTexture/SDL_UnlockTexture on unlock, flushing then. */
         return SDL_LockTextureNative(texture, rect, pixels, pitch);
     } else {
         SDL_Renderer *renderer = texture->renderer;
-        if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
+        if (FlushRenderCommandsIfTextureNeeded(texture, SDL_RENDERFLUSH_TEXTURE) < 0) {
+            return -1;
+        }
+        renderer->stats.texture_locks++;
+        if (renderer->LockTexture(renderer, texture, rect, pixels, pitch) < 0) {
             return -1;
         }
-        return renderer->LockTexture(renderer, texture, rect, pixels, pitch);
+        if (renderer->capture) {
+            /* The pixels are recorded when the texture is unlocked. */
+            texture->capture_pixels = *pixels;
+            texture->capture_pitch = *pitch;
+            texture->capture_rect = *rect;
+        }
+        return 0;
     }
 }
 
@@ -1760,10 +2148,15 @@ SDL_UnlockTexture(SDL_Texture * texture)
     }
     if (texture->yuv) {
         SDL_UnlockTextureYUV(texture);
+    } else if (texture->buffers) {
+        SDL_UnlockTexture(texture->native);
     } else if (texture->native) {
         SDL_UnlockTextureNative(texture);
     } else {
         SDL_Renderer *renderer = texture->renderer;
+        if (renderer->capture) {
+            SDL_CaptureUnlockTexture(texture);
+        }
         renderer->UnlockTexture(renderer, texture);
     }
 }
@@ -1788,7 +2181,7 @@ SDL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
         return 0;
     }
 
-    FlushRenderCommands(renderer);  /* time to send everything to the GPU! */
+    FlushRenderCommands(renderer, SDL_RENDERFLUSH_TARGET);  /* time to send everything to the GPU! */
 
     /* texture == NULL is valid and means reset the target to the window */
     if (texture) {
@@ -1823,6 +2216,10 @@ SDL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
         return -1;
     }
 
+    if (renderer->capture) {
+        SDL_CaptureSetTarget(renderer, texture);
+    }
+
     if (texture) {
         renderer->viewport.x = 0;
         renderer->viewport.y = 0;
@@ -2105,6 +2502,9 @@ SDL_RenderSetScale(SDL_Renderer * renderer, float scaleX, float scaleY)
 
     renderer->scale.x = scaleX;
     renderer->scale.y = scaleY;
+    /* The backends may draw differently at another scale, let them know */
+    renderer->viewport_queued = SDL_FALSE;
+    renderer->cliprect_queued = SDL_FALSE;
     return 0;
 }
 
@@ -2181,7 +2581,11 @@ SDL_RenderClear(SDL_Renderer * renderer)
 {
     int retval;
     CHECK_RENDERER_MAGIC(renderer, -1);
-    retval = QueueCmdClear(renderer);
+    /* The viewport tells the backends what's drawn to, even if it doesn't clip the clear */
+    retval = QueueCmdSetViewport(renderer);
+    if (retval == 0) {
+        retval = QueueCmdClear(renderer);
+    }
     return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
 }
 
@@ -2798,34 +3202,291 @@ SDL_RenderFillRectsF(SDL_Renderer * renderer,
     return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
 }
 
-/* !!! FIXME: move this to a public API if we want to do float versions of all of these later */
-SDL_FORCE_INLINE SDL_bool SDL_FRectEmpty(const SDL_FRect *r)
-{
-    return ((!r) || (r->w <= 0.0f) || (r->h <= 0.0f)) ? SDL_TRUE : SDL_FALSE;
-}
+/* Antialiased edges are drawn with this many levels of coverage, each one
+   queued as a fill of its spans with the draw alpha scaled down.
+ */
+#define RENDER_COVERAGE_LEVELS  32
 
-/* !!! FIXME: move this to a public API if we want to do float versions of all of these later */
-static SDL_bool
-SDL_HasIntersectionF(const SDL_FRect * A, const SDL_FRect * B)
+/* Fills the union of convex polygons, in output coordinates relative to the viewport */
+static int
+RenderFillPolygons(SDL_Renderer * renderer, const SDL_FPoint * points,
+                   const int *counts, int num_polygons, SDL_bool antialias)
 {
-    float Amin, Amax, Bmin, Bmax;
+    SDL_RasterSpan *spans;
+    SDL_FRect *frects;
+    int first[RENDER_COVERAGE_LEVELS + 2];
+    const Uint8 a = renderer->a;
+    int i, level, num_spans;
+    int retval = 0;
 
-    if (!A) {
-        SDL_InvalidParamError("A");
-        return SDL_FALSE;
+    /* Partial coverage needs blending */
+    if (renderer->blendMode != SDL_BLENDMODE_BLEND && renderer->blendMode != SDL_BLENDMODE_ADD) {
+        antialias = SDL_FALSE;
     }
 
-    if (!B) {
-        SDL_InvalidParamError("B");
-        return SDL_FALSE;
+    if (SDL_RasterizeConvexPolygons(points, counts, num_polygons,
+                                    renderer->viewport.w, renderer->viewport.h,
+                                    antialias, &spans, &num_spans) < 0) {
+        return -1;
+    }
+    if (num_spans == 0) {
+        return 0;
     }
 
-    /* Special cases for empty rects */
-    if (SDL_FRectEmpty(A) || SDL_FRectEmpty(B)) {
-        return SDL_FALSE;
+    frects = (SDL_FRect *) SDL_malloc(num_spans * sizeof (*frects));
+    if (!frects) {
+        SDL_free(spans);
+        return SDL_OutOfMemory();
     }
 
-    /* Horizontal intersection */
+    /* Sort the spans by coverage level. They don't overlap, so the order they're drawn in doesn't matter. */
+    SDL_zero(first);
+    for (i = 0; i < num_spans; ++i) {
+        level = (spans[i].coverage * RENDER_COVERAGE_LEVELS + 127) / 255;
+        ++first[level + 1];
+    }
+    for (level = 0; level <= RENDER_COVERAGE_LEVELS; ++level) {
+        first[level + 1] += first[level];
+    }
+    for (i = 0; i < num_spans; ++i) {
+        SDL_FRect *frect;
+        level = (spans[i].coverage * RENDER_COVERAGE_LEVELS + 127) / 255;
+        frect = &frects[first[level]++];
+        frect->x = (float) spans[i].x;
+        frect->y = (float) spans[i].y;
+        frect->w = (float) spans[i].w;
+        frect->h = 1.0f;
+    }
+    /* Now first[level] is where the next level starts */
+
+    for (level = 1; level <= RENDER_COVERAGE_LEVELS; ++level) {
+        const int start = first[level - 1];
+        if (start < first[level]) {
+            renderer->a = (Uint8) ((a * level + RENDER_COVERAGE_LEVELS / 2) / RENDER_COVERAGE_LEVELS);
+            retval = QueueCmdFillRects(renderer, &frects[start], first[level] - start);
+            if (retval < 0) {
+                break;
+            }
+        }
+    }
+    renderer->a = a;
+
+    SDL_free(frects);
+    SDL_free(spans);
+
+    return retval;
+}
+
+int
+SDL_RenderDrawWideLines(SDL_Renderer * renderer,
+                        const SDL_Point * points, int count,
+                        float width, SDL_bool antialias)
+{
+    SDL_FPoint *fpoints;
+    int i;
+    int retval;
+    SDL_bool isstack;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!points) {
+        return SDL_SetError("SDL_RenderDrawWideLines(): Passed NULL points");
+    }
+    if (count < 1) {
+        return 0;
+    }
+
+    fpoints = SDL_small_alloc(SDL_FPoint, count, &isstack);
+    if (!fpoints) {
+        return SDL_OutOfMemory();
+    }
+    for (i = 0; i < count; ++i) {
+        fpoints[i].x = (float) points[i].x;
+        fpoints[i].y = (float) points[i].y;
+    }
+
+    retval = SDL_RenderDrawWideLinesF(renderer, fpoints, count, width, antialias);
+
+    SDL_small_free(fpoints, isstack);
+
+    return retval;
+}
+
+int
+SDL_RenderDrawWideLinesF(SDL_Renderer * renderer,
+                         const SDL_FPoint * points, int count,
+                         float width, SDL_bool antialias)
+{
+    SDL_FPoint *quads, *quad;
+    int *counts;
+    int i, num_segments;
+    int retval;
+    SDL_bool isstack, isstack_counts;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!points) {
+        return SDL_SetError("SDL_RenderDrawWideLinesF(): Passed NULL points");
+    }
+    if (count < 1 || width <= 0.0f) {
+        return 0;
+    }
+
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+
+    /* A single point is drawn as a square */
+    num_segments = (count > 1) ? (count - 1) : 1;
+    quads = SDL_small_alloc(SDL_FPoint, num_segments * 4, &isstack);
+    if (!quads) {
+        return SDL_OutOfMemory();
+    }
+    counts = SDL_small_alloc(int, num_segments, &isstack_counts);
+    if (!counts) {
+        SDL_small_free(quads, isstack);
+        return SDL_OutOfMemory();
+    }
+
+    /* Each segment is a rectangle around the pixel centers of its ends, with
+       square caps, so consecutive segments join without gaps.
+     */
+    for (i = 0; i < num_segments; ++i) {
+        const SDL_FPoint *p0 = &points[i];
+        const SDL_FPoint *p1 = &points[(count > 1) ? (i + 1) : i];
+        const float dx = p1->x - p0->x;
+        const float dy = p1->y - p0->y;
+        const float length = SDL_sqrtf(dx * dx + dy * dy);
+        const float half = width * 0.5f;
+        const float ux = (length > 0.0f) ? (dx / length * half) : half;
+        const float uy = (length > 0.0f) ? (dy / length * half) : 0.0f;
+        const float x0 = p0->x + 0.5f - ux, y0 = p0->y + 0.5f - uy;
+        const float x1 = p1->x + 0.5f + ux, y1 = p1->y + 0.5f + uy;
+
+        quad = &quads[i * 4];
+        quad[0].x = (x0 - uy) * renderer->scale.x;
+        quad[0].y = (y0 + ux) * renderer->scale.y;
+        quad[1].x = (x1 - uy) * renderer->scale.x;
+        quad[1].y = (y1 + ux) * renderer->scale.y;
+        quad[2].x = (x1 + uy) * renderer->scale.x;
+        quad[2].y = (y1 - ux) * renderer->scale.y;
+        quad[3].x = (x0 + uy) * renderer->scale.x;
+        quad[3].y = (y0 - ux) * renderer->scale.y;
+        counts[i] = 4;
+    }
+
+    retval = RenderFillPolygons(renderer, quads, counts, num_segments, antialias);
+
+    SDL_small_free(counts, isstack_counts);
+    SDL_small_free(quads, isstack);
+
+    return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
+}
+
+int
+SDL_RenderFillConvexPolygon(SDL_Renderer * renderer,
+                            const SDL_Point * points, int count,
+                            SDL_bool antialias)
+{
+    SDL_FPoint *fpoints;
+    int i;
+    int retval;
+    SDL_bool isstack;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!points) {
+        return SDL_SetError("SDL_RenderFillConvexPolygon(): Passed NULL points");
+    }
+    if (count < 3) {
+        return 0;
+    }
+
+    fpoints = SDL_small_alloc(SDL_FPoint, count, &isstack);
+    if (!fpoints) {
+        return SDL_OutOfMemory();
+    }
+    for (i = 0; i < count; ++i) {
+        fpoints[i].x = (float) points[i].x;
+        fpoints[i].y = (float) points[i].y;
+    }
+
+    retval = SDL_RenderFillConvexPolygonF(renderer, fpoints, count, antialias);
+
+    SDL_small_free(fpoints, isstack);
+
+    return retval;
+}
+
+int
+SDL_RenderFillConvexPolygonF(SDL_Renderer * renderer,
+                             const SDL_FPoint * points, int count,
+                             SDL_bool antialias)
+{
+    SDL_FPoint *fpoints;
+    int i;
+    int retval;
+    SDL_bool isstack;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!points) {
+        return SDL_SetError("SDL_RenderFillConvexPolygonF(): Passed NULL points");
+    }
+    if (count < 3) {
+        return 0;
+    }
+
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+
+    fpoints = SDL_small_alloc(SDL_FPoint, count, &isstack);
+    if (!fpoints) {
+        return SDL_OutOfMemory();
+    }
+    for (i = 0; i < count; ++i) {
+        fpoints[i].x = points[i].x * renderer->scale.x;
+        fpoints[i].y = points[i].y * renderer->scale.y;
+    }
+
+    retval = RenderFillPolygons(renderer, fpoints, &count, 1, antialias);
+
+    SDL_small_free(fpoints, isstack);
+
+    return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
+}
+
+/* !!! FIXME: move this to a public API if we want to do float versions of all of these later */
+SDL_FORCE_INLINE SDL_bool SDL_FRectEmpty(const SDL_FRect *r)
+{
+    return ((!r) || (r->w <= 0.0f) || (r->h <= 0.0f)) ? SDL_TRUE : SDL_FALSE;
+}
+
+/* !!! FIXME: move this to a public API if we want to do float versions of all of these later */
+static SDL_bool
+SDL_HasIntersectionF(const SDL_FRect * A, const SDL_FRect * B)
+{
+    float Amin, Amax, Bmin, Bmax;
+
+    if (!A) {
+        SDL_InvalidParamError("A");
+        return SDL_FALSE;
+    }
+
+    if (!B) {
+        SDL_InvalidParamError("B");
+        return SDL_FALSE;
+    }
+
+    /* Special cases for empty rects */
+    if (SDL_FRectEmpty(A) || SDL_FRectEmpty(B)) {
+        return SDL_FALSE;
+    }
+
+    /* Horizontal intersection */
     Amin = A->x;
     Amax = Amin + A->w;
     Bmin = B->x;
@@ -2912,7 +3573,7 @@ SDL_RenderCopyF(SDL_Renderer * renderer, SDL_Texture * texture,
         real_dstrect = *dstrect;
     }
 
-    if (texture->native) {
+    while (texture->native) {
         texture = texture->native;
     }
 
@@ -2927,6 +3588,138 @@ SDL_RenderCopyF(SDL_Renderer * renderer, SDL_Texture * texture,
     return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
 }
 
+int
+SDL_RenderCopyBatch(SDL_Renderer * renderer, SDL_Texture * texture,
+                    const SDL_Rect * srcrects, const SDL_Rect * dstrects,
+                    const SDL_Color * colors, int count)
+{
+    SDL_FRect *frects;
+    int i;
+    int retval;
+    SDL_bool isstack;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!dstrects) {
+        return SDL_SetError("SDL_RenderCopyBatch(): Passed NULL dstrects");
+    }
+    if (count < 1) {
+        return 0;
+    }
+
+    frects = SDL_small_alloc(SDL_FRect, count, &isstack);
+    if (!frects) {
+        return SDL_OutOfMemory();
+    }
+    for (i = 0; i < count; ++i) {
+        frects[i].x = (float) dstrects[i].x;
+        frects[i].y = (float) dstrects[i].y;
+        frects[i].w = (float) dstrects[i].w;
+        frects[i].h = (float) dstrects[i].h;
+    }
+
+    retval = SDL_RenderCopyBatchF(renderer, texture, srcrects, frects, colors, count);
+
+    SDL_small_free(frects, isstack);
+
+    return retval;
+}
+
+int
+SDL_RenderCopyBatchF(SDL_Renderer * renderer, SDL_Texture * texture,
+                     const SDL_Rect * srcrects, const SDL_FRect * dstrects,
+                     const SDL_Color * colors, int count)
+{
+    SDL_Rect *real_srcrects;
+    SDL_FRect *real_dstrects;
+    const SDL_Color *color = NULL;
+    SDL_Texture *native;
+    SDL_FRect viewport;
+    SDL_Rect r;
+    int i, n, start;
+    int retval = 0;
+    SDL_bool isstack;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (renderer != texture->renderer) {
+        return SDL_SetError("Texture was not created with this renderer");
+    }
+    if (!dstrects) {
+        return SDL_SetError("SDL_RenderCopyBatchF(): Passed NULL dstrects");
+    }
+    if (count < 1) {
+        return 0;
+    }
+
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+
+    /* Both arrays share one allocation so a batch costs a single small_alloc */
+    real_srcrects = (SDL_Rect *) SDL_small_alloc(Uint8, count * (sizeof (SDL_Rect) + sizeof (SDL_FRect)), &isstack);
+    if (!real_srcrects) {
+        return SDL_OutOfMemory();
+    }
+    real_dstrects = (SDL_FRect *) (real_srcrects + count);
+
+    SDL_zero(r);
+    SDL_RenderGetViewport(renderer, &r);
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.w = (float) r.w;
+    viewport.h = (float) r.h;
+
+    native = texture;
+    while (native->native) {
+        native = native->native;
+    }
+    native->last_command_generation = renderer->render_command_generation;
+
+    /* Items are queued in runs that share a modulation color, each run
+       becoming one render command. */
+    n = 0;
+    for (start = 0; start < count && retval == 0; start = i) {
+        for (i = start; i < count; ++i) {
+            SDL_Rect *srcrect = &real_srcrects[n];
+            SDL_FRect *dstrect = &real_dstrects[n];
+
+            if (colors && i > start && SDL_memcmp(&colors[i], &colors[start], sizeof (SDL_Color)) != 0) {
+                break;
+            }
+
+            srcrect->x = 0;
+            srcrect->y = 0;
+            srcrect->w = texture->w;
+            srcrect->h = texture->h;
+            if (srcrects && !SDL_IntersectRect(&srcrects[i], srcrect, srcrect)) {
+                continue;
+            }
+            if (!SDL_HasIntersectionF(&dstrects[i], &viewport)) {
+                continue;
+            }
+
+            dstrect->x = dstrects[i].x * renderer->scale.x;
+            dstrect->y = dstrects[i].y * renderer->scale.y;
+            dstrect->w = dstrects[i].w * renderer->scale.x;
+            dstrect->h = dstrects[i].h * renderer->scale.y;
+            ++n;
+        }
+
+        if (n > 0) {
+            color = colors ? &colors[start] : NULL;
+            retval = QueueCmdCopyBatch(renderer, native, color, real_srcrects, real_dstrects, n);
+            n = 0;
+        }
+    }
+
+    SDL_small_free(real_srcrects, isstack);
+
+    return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
+}
+
 int
 SDL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
                const SDL_Rect * srcrect, const SDL_Rect * dstrect,
@@ -3006,7 +3799,7 @@ SDL_RenderCopyExF(SDL_Renderer * renderer, SDL_Texture * texture,
         real_dstrect.h = (float) r.h;
     }
 
-    if (texture->native) {
+    while (texture->native) {
         texture = texture->native;
     }
 
@@ -3031,6 +3824,66 @@ SDL_RenderCopyExF(SDL_Renderer * renderer, SDL_Texture * texture,
     return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
 }
 
+int
+SDL_RenderGeometry(SDL_Renderer * renderer, SDL_Texture * texture,
+                   const SDL_Vertex * vertices, int num_vertices,
+                   const int * indices, int num_indices)
+{
+    int i, retval;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (texture) {
+        CHECK_TEXTURE_MAGIC(texture, -1);
+
+        if (renderer != texture->renderer) {
+            return SDL_SetError("Texture was not created with this renderer");
+        }
+    }
+
+    if (!vertices) {
+        return SDL_InvalidParamError("vertices");
+    }
+    if (num_vertices < 0) {
+        return SDL_InvalidParamError("num_vertices");
+    }
+    if (indices) {
+        if (num_indices < 0 || (num_indices % 3) != 0) {
+            return SDL_InvalidParamError("num_indices");
+        }
+        for (i = 0; i < num_indices; ++i) {
+            if (indices[i] < 0 || indices[i] >= num_vertices) {
+                return SDL_SetError("SDL_RenderGeometry(): Index %d is out of bounds", indices[i]);
+            }
+        }
+    } else if ((num_vertices % 3) != 0) {
+        return SDL_InvalidParamError("num_vertices");
+    }
+
+    if (!renderer->QueueGeometry) {
+        return SDL_Unsupported();
+    }
+
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+
+    if ((indices ? num_indices : num_vertices) == 0) {
+        return 0;
+    }
+
+    if (texture) {
+        while (texture->native) {
+            texture = texture->native;
+        }
+        texture->last_command_generation = renderer->render_command_generation;
+    }
+
+    retval = QueueCmdGeometry(renderer, texture, vertices, num_vertices, indices, num_indices);
+    return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
+}
+
 int
 SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                      Uint32 format, void * pixels, int pitch)
@@ -3043,7 +3896,7 @@ SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
         return SDL_Unsupported();
     }
 
-    FlushRenderCommands(renderer);  /* we need to render before we read the results. */
+    FlushRenderCommands(renderer, SDL_RENDERFLUSH_READPIXELS);  /* we need to render before we read the results. */
 
     if (!format) {
         format = SDL_GetWindowPixelFormat(renderer->window);
@@ -3070,18 +3923,116 @@ SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                                       format, pixels, pitch);
 }
 
+int
+SDL_RenderReadPixelsAsync(SDL_Renderer * renderer, const SDL_Rect * rect,
+                          Uint32 format, void * pixels, int pitch,
+                          SDL_RenderReadPixelsCallback callback, void *userdata)
+{
+    SDL_RenderReadback *readback;
+    SDL_RenderCommand *marker;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!renderer->RenderReadPixels) {
+        return SDL_Unsupported();
+    }
+    if (!pixels) {
+        return SDL_InvalidParamError("pixels");
+    }
+    if (!callback) {
+        return SDL_InvalidParamError("callback");
+    }
+
+    readback = (SDL_RenderReadback *) SDL_calloc(1, sizeof(*readback));
+    if (!readback) {
+        return SDL_OutOfMemory();
+    }
+
+    if (!format) {
+        format = SDL_GetWindowPixelFormat(renderer->window);
+    }
+
+    readback->rect.x = renderer->viewport.x;
+    readback->rect.y = renderer->viewport.y;
+    readback->rect.w = renderer->viewport.w;
+    readback->rect.h = renderer->viewport.h;
+    readback->dst = pixels;
+    if (rect) {
+        if (!SDL_IntersectRect(rect, &readback->rect, &readback->rect)) {
+            SDL_zero(readback->rect);
+        }
+        if (readback->rect.y > rect->y) {
+            readback->dst = (Uint8 *)readback->dst + pitch * (readback->rect.y - rect->y);
+        }
+        if (readback->rect.x > rect->x) {
+            int bpp = SDL_BYTESPERPIXEL(format);
+            readback->dst = (Uint8 *)readback->dst + bpp * (readback->rect.x - rect->x);
+        }
+    }
+    readback->format = format;
+    readback->pitch = pitch;
+    readback->pixels = pixels;
+    readback->callback = callback;
+    readback->userdata = userdata;
+
+    /* The no-op marks where the queue is split to read the pixels. Nothing
+       can be merged into the commands before it, and the state is queued
+       again after it, as the backends set it up anew for every part. */
+    marker = AllocateRenderCommand(renderer);
+    if (!marker) {
+        SDL_free(readback);
+        return -1;
+    }
+    marker->command = SDL_RENDERCMD_NO_OP;
+    renderer->color_queued = SDL_FALSE;
+    renderer->viewport_queued = SDL_FALSE;
+    renderer->cliprect_queued = SDL_FALSE;
+    renderer->merge_command = NULL;
+
+    readback->marker = marker;
+    if (renderer->readbacks_tail) {
+        renderer->readbacks_tail->next = readback;
+    } else {
+        renderer->readbacks = readback;
+    }
+    renderer->readbacks_tail = readback;
+
+    return FlushRenderCommandsIfNotBatching(renderer);
+}
+
 void
 SDL_RenderPresent(SDL_Renderer * renderer)
 {
     CHECK_RENDERER_MAGIC(renderer, );
 
-    FlushRenderCommands(renderer);  /* time to send everything to the GPU! */
+    FlushRenderCommands(renderer, SDL_RENDERFLUSH_PRESENT);  /* time to send everything to the GPU! */
+
+    if (renderer->capture) {
+        SDL_CapturePresent(renderer);
+    }
 
     /* Don't present while we're hidden */
-    if (renderer->hidden) {
-        return;
+    if (!renderer->hidden) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        renderer->RenderPresent(renderer);
+        renderer->stats.present_time += SDL_GetPerformanceCounter() - start;
     }
-    renderer->RenderPresent(renderer);
+
+    EndRenderStatsFrame(renderer);
+}
+
+int
+SDL_RenderGetDamageRects(SDL_Renderer * renderer, SDL_Rect * rects, int maxrects)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (maxrects < 0) {
+        return SDL_InvalidParamError("maxrects");
+    }
+    if (!renderer->GetDamageRects) {
+        return SDL_Unsupported();
+    }
+    return renderer->GetDamageRects(renderer, rects, rects ? maxrects : 0);
 }
 
 void
@@ -3095,7 +4046,7 @@ SDL_DestroyTexture(SDL_Texture * texture)
     if (texture == renderer->target) {
         SDL_SetRenderTarget(renderer, NULL);  /* implies command queue flush */
     } else {
-        FlushRenderCommandsIfTextureNeeded(texture);
+        FlushRenderCommandsIfTextureNeeded(texture, SDL_RENDERFLUSH_TEXTURE);
     }
 
     texture->magic = NULL;
@@ -3109,7 +4060,17 @@ SDL_DestroyTexture(SDL_Texture * texture)
         renderer->textures = texture->next;
     }
 
-    if (texture->native) {
+    if (renderer->capture && texture->capture_id) {
+        SDL_CaptureDestroyTexture(texture);
+    }
+
+    if (texture->buffers) {
+        int i;
+        for (i = 0; i < texture->num_buffers; ++i) {
+            SDL_DestroyTexture(texture->buffers[i]);
+        }
+        SDL_free(texture->buffers);
+    } else if (texture->native) {
         SDL_DestroyTexture(texture->native);
     }
     if (texture->yuv) {
@@ -3125,13 +4086,28 @@ void
 SDL_DestroyRenderer(SDL_Renderer * renderer)
 {
     SDL_RenderCommand *cmd;
-    SDL_AllocVertGap *gap;
-    SDL_AllocVertGap *nextgap;
 
     CHECK_RENDERER_MAGIC(renderer, );
 
     SDL_DelEventWatch(SDL_RendererEventWatch, renderer);
 
+    if (renderer->capture) {
+        SDL_StopRenderCapture(renderer);
+    }
+
+    /* The queued reads are never done */
+    while (renderer->readbacks) {
+        SDL_RenderReadback *readbacks = renderer->readbacks;
+        SDL_RenderReadback *readback;
+
+        renderer->readbacks = NULL;
+        renderer->readbacks_tail = NULL;
+        for (readback = readbacks; readback; readback = readback->next) {
+            readback->result = SDL_SetError("The renderer was destroyed before the pixels were read");
+        }
+        FinishRenderReadbacks(readbacks);
+    }
+
     if (renderer->render_commands_tail != NULL) {
         renderer->render_commands_tail->next = renderer->render_commands_pool;
         cmd = renderer->render_commands;
@@ -3151,16 +4127,6 @@ SDL_DestroyRenderer(SDL_Renderer * renderer)
 
     SDL_free(renderer->vertex_data);
 
-    for (gap = renderer->vertex_data_gaps.next; gap; gap = nextgap) {
-        nextgap = gap->next;
-        SDL_free(gap);
-    }
-
-    for (gap = renderer->vertex_data_gaps_pool; gap; gap = nextgap) {
-        nextgap = gap->next;
-        SDL_free(gap);
-    }
-
     /* Free existing textures for this renderer */
     while (renderer->textures) {
         SDL_Texture *tex = renderer->textures; (void) tex;
@@ -3192,7 +4158,7 @@ int SDL_GL_BindTexture(SDL_Texture *texture, float *texw, float *texh)
     if (texture->native) {
         return SDL_GL_BindTexture(texture->native, texw, texh);
     } else if (renderer && renderer->GL_BindTexture) {
-        FlushRenderCommandsIfTextureNeeded(texture);  /* in case the app is going to mess with it. */
+        FlushRenderCommandsIfTextureNeeded(texture, SDL_RENDERFLUSH_NATIVE);  /* in case the app is going to mess with it. */
         return renderer->GL_BindTexture(renderer, texture, texw, texh);
     } else {
         return SDL_Unsupported();
@@ -3208,7 +4174,7 @@ int SDL_GL_UnbindTexture(SDL_Texture *texture)
     if (texture->native) {
         return SDL_GL_UnbindTexture(texture->native);
     } else if (renderer && renderer->GL_UnbindTexture) {
-        FlushRenderCommandsIfTextureNeeded(texture);  /* in case the app messed with it. */
+        FlushRenderCommandsIfTextureNeeded(texture, SDL_RENDERFLUSH_NATIVE);  /* in case the app messed with it. */
         return renderer->GL_UnbindTexture(renderer, texture);
     }
 
@@ -3221,7 +4187,7 @@ SDL_RenderGetMetalLayer(SDL_Renderer * renderer)
     CHECK_RENDERER_MAGIC(renderer, NULL);
 
     if (renderer->GetMetalLayer) {
-        FlushRenderCommands(renderer);  /* in case the app is going to mess with it. */
+        FlushRenderCommands(renderer, SDL_RENDERFLUSH_NATIVE);  /* in case the app is going to mess with it. */
         return renderer->GetMetalLayer(renderer);
     }
     return NULL;
@@ -3233,7 +4199,7 @@ SDL_RenderGetMetalCommandEncoder(SDL_Renderer * renderer)
     CHECK_RENDERER_MAGIC(renderer, NULL);
 
     if (renderer->GetMetalCommandEncoder) {
-        FlushRenderCommands(renderer);  /* in case the app is going to mess with it. */
+        FlushRenderCommands(renderer, SDL_RENDERFLUSH_NATIVE);  /* in case the app is going to mess with it. */
         return renderer->GetMetalCommandEncoder(renderer);
     }
     return NULL;
@@ -0,0 +1,617 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#include "SDL_render.h"
+
+/* A texture atlas packs surfaces into pages, textures that all have the
+   size of the atlas. Every page is filled from the top with the skyline
+   bottom-left method: the top edge of what's packed so far is kept as a
+   list of horizontal segments, and a new rectangle goes where its bottom
+   ends up the lowest.
+
+   The space of removed entries is kept in a list of free rectangles for
+   the page, which are tried before the skyline. When the last entry of a
+   page is removed, the whole page is free again.
+
+   Entries are a pixel apart, so scaling with linear filtering doesn't
+   bleed into the neighbours. The pages are cleared to zero when they're
+   created, so that pixel is transparent. Space that is used again may
+   still hold the pixels of a removed entry there, so the padding of the
+   entries placed in it is cleared when they're uploaded.
+ */
+
+#define ATLAS_PADDING   1
+
+/* The number of rows of zeros uploaded at a time to clear a new page */
+#define ATLAS_CLEAR_ROWS    64
+
+typedef struct
+{
+    int x, y, w;
+} AtlasSkylineNode;
+
+typedef struct
+{
+    SDL_Texture *texture;
+    AtlasSkylineNode *skyline;
+    int num_skyline;
+    int max_skyline;
+    SDL_Rect *free_rects;
+    int num_free_rects;
+    int max_free_rects;
+    int num_entries;
+    SDL_bool reused;    /* entries were removed, the padding may not be zero */
+} AtlasPage;
+
+typedef struct
+{
+    int page;           /* -1 if the entry isn't used */
+    SDL_Rect rect;      /* the pixels of the surface in the page */
+    SDL_Rect slot;      /* the space it takes up, with the padding */
+} AtlasEntry;
+
+struct SDL_TextureAtlas
+{
+    SDL_Renderer *renderer;
+    Uint32 format;
+    int w, h;
+    AtlasPage *pages;
+    int num_pages;
+    int max_pages;
+    AtlasEntry *entries;
+    int num_entries;
+    int max_entries;
+};
+
+typedef struct
+{
+    int index;
+    int w, h;
+} AtlasItem;
+
+
+static SDL_bool
+AtlasGrowArray(void **array, int *max, int count, size_t size)
+{
+    if (count > *max) {
+        const int newmax = SDL_max(count, *max * 2);
+        void *newarray = SDL_realloc(*array, newmax * size);
+        if (!newarray) {
+            SDL_OutOfMemory();
+            return SDL_FALSE;
+        }
+        *array = newarray;
+        *max = newmax;
+    }
+    return SDL_TRUE;
+}
+
+/* The padding of the entries at the right and bottom edges is left out, so
+   the skyline works with a page that's one padding larger.
+ */
+static void
+AtlasResetPage(const SDL_TextureAtlas *atlas, AtlasPage *page)
+{
+    page->skyline[0].x = 0;
+    page->skyline[0].y = 0;
+    page->skyline[0].w = atlas->w + ATLAS_PADDING;
+    page->num_skyline = 1;
+    page->num_free_rects = 0;
+}
+
+/* Returns where a rectangle of w x h would go with its left edge at the
+   skyline node i, or -1 if it doesn't fit there.
+ */
+static int
+AtlasSkylineFit(const SDL_TextureAtlas *atlas, const AtlasPage *page, int i, int w, int h)
+{
+    const int x = page->skyline[i].x;
+    int width_left = w;
+    int y = 0;
+
+    if (x + w > atlas->w + ATLAS_PADDING) {
+        return -1;
+    }
+    while (width_left > 0) {
+        y = SDL_max(y, page->skyline[i].y);
+        if (y + h > atlas->h + ATLAS_PADDING) {
+            return -1;
+        }
+        width_left -= page->skyline[i].w;
+        ++i;
+    }
+    return y;
+}
+
+static SDL_bool
+AtlasSkylineInsert(const SDL_TextureAtlas *atlas, AtlasPage *page, int w, int h, SDL_Rect *slot)
+{
+    AtlasSkylineNode *nodes;
+    int best = -1, best_y = 0, best_bottom = 0, best_width = 0;
+    int i, right;
+
+    for (i = 0; i < page->num_skyline; ++i) {
+        const int y = AtlasSkylineFit(atlas, page, i, w, h);
+        if (y < 0) {
+            continue;
+        }
+        if (best < 0 || y + h < best_bottom ||
+            (y + h == best_bottom && page->skyline[i].w < best_width)) {
+            best = i;
+            best_y = y;
+            best_bottom = y + h;
+            best_width = page->skyline[i].w;
+        }
+    }
+    if (best < 0) {
+        return SDL_FALSE;
+    }
+    if (!AtlasGrowArray((void **) &page->skyline, &page->max_skyline, page->num_skyline + 1, sizeof(AtlasSkylineNode))) {
+        return SDL_FALSE;
+    }
+
+    nodes = page->skyline;
+    slot->x = nodes[best].x;
+    slot->y = best_y;
+    slot->w = w;
+    slot->h = h;
+
+    SDL_memmove(&nodes[best + 1], &nodes[best], (page->num_skyline - best) * sizeof(*nodes));
+    ++page->num_skyline;
+    nodes[best].y = best_y + h;
+    nodes[best].w = w;
+
+    /* The nodes below the new one are cut off */
+    right = nodes[best].x + nodes[best].w;
+    for (i = best + 1; i < page->num_skyline && nodes[i].x < right; ) {
+        const int shrink = right - nodes[i].x;
+        if (nodes[i].w > shrink) {
+            nodes[i].x += shrink;
+            nodes[i].w -= shrink;
+            break;
+        }
+        SDL_memmove(&nodes[i], &nodes[i + 1], (page->num_skyline - i - 1) * sizeof(*nodes));
+        --page->num_skyline;
+    }
+
+    /* Neighbours at the same height become one */
+    for (i = 0; i + 1 < page->num_skyline; ) {
+        if (nodes[i].y == nodes[i + 1].y) {
+            nodes[i].w += nodes[i + 1].w;
+            SDL_memmove(&nodes[i + 1], &nodes[i + 2], (page->num_skyline - i - 2) * sizeof(*nodes));
+            --page->num_skyline;
+        } else {
+            ++i;
+        }
+    }
+    return SDL_TRUE;
+}
+
+/* Puts a rectangle into the smallest free rectangle it fits, splitting off
+   what's left to the right and below it.
+ */
+static SDL_bool
+AtlasFreeRectInsert(AtlasPage *page, int w, int h, SDL_Rect *slot)
+{
+    SDL_Rect free_rect, right, below;
+    int best = -1, i;
+
+    for (i = 0; i < page->num_free_rects; ++i) {
+        const SDL_Rect *rect = &page->free_rects[i];
+        if (rect->w >= w && rect->h >= h &&
+            (best < 0 || rect->w * rect->h < page->free_rects[best].w * page->free_rects[best].h)) {
+            best = i;
+        }
+    }
+    if (best < 0) {
+        return SDL_FALSE;
+    }
+    if (!AtlasGrowArray((void **) &page->free_rects, &page->max_free_rects, page->num_free_rects + 1, sizeof(SDL_Rect))) {
+        return SDL_FALSE;
+    }
+
+    free_rect = page->free_rects[best];
+    slot->x = free_rect.x;
+    slot->y = free_rect.y;
+    slot->w = w;
+    slot->h = h;
+
+    right.x = free_rect.x + w;
+    right.y = free_rect.y;
+    right.w = free_rect.w - w;
+    right.h = h;
+    below.x = free_rect.x;
+    below.y = free_rect.y + h;
+    below.w = free_rect.w;
+    below.h = free_rect.h - h;
+
+    page->free_rects[best] = page->free_rects[--page->num_free_rects];
+    if (!SDL_RectEmpty(&right)) {
+        page->free_rects[page->num_free_rects++] = right;
+    }
+    if (!SDL_RectEmpty(&below)) {
+        page->free_rects[page->num_free_rects++] = below;
+    }
+    return SDL_TRUE;
+}
+
+static int
+AtlasAddPage(SDL_TextureAtlas *atlas)
+{
+    const int pitch = atlas->w * SDL_BYTESPERPIXEL(atlas->format);
+    AtlasPage *page;
+    SDL_Rect rect;
+    void *zeros;
+
+    if (!AtlasGrowArray((void **) &atlas->pages, &atlas->max_pages, atlas->num_pages + 1, sizeof(AtlasPage))) {
+        return -1;
+    }
+    page = &atlas->pages[atlas->num_pages];
+    SDL_zerop(page);
+
+    page->texture = SDL_CreateTexture(atlas->renderer, atlas->format, SDL_TEXTUREACCESS_STATIC, atlas->w, atlas->h);
+    if (!page->texture) {
+        return -1;
+    }
+    page->skyline = (AtlasSkylineNode *) SDL_malloc(sizeof(AtlasSkylineNode));
+    zeros = SDL_calloc(ATLAS_CLEAR_ROWS, pitch);
+    if (!page->skyline || !zeros) {
+        SDL_DestroyTexture(page->texture);
+        SDL_free(page->skyline);
+        SDL_free(zeros);
+        return SDL_OutOfMemory();
+    }
+    page->max_skyline = 1;
+    ++atlas->num_pages;
+    AtlasResetPage(atlas, page);
+
+    if (SDL_ISPIXELFORMAT_ALPHA(atlas->format)) {
+        SDL_SetTextureBlendMode(page->texture, SDL_BLENDMODE_BLEND);
+    }
+
+    /* The padding between the entries is never written */
+    rect.x = 0;
+    rect.w = atlas->w;
+    for (rect.y = 0; rect.y < atlas->h; rect.y += rect.h) {
+        rect.h = SDL_min(ATLAS_CLEAR_ROWS, atlas->h - rect.y);
+        SDL_UpdateTexture(page->texture, &rect, zeros, pitch);
+    }
+    SDL_free(zeros);
+
+    return atlas->num_pages - 1;
+}
+
+/* Finds space for an entry in any page, adding one if they're all full */
+static int
+AtlasPlaceEntry(SDL_TextureAtlas *atlas, AtlasEntry *entry, int w, int h)
+{
+    const int slot_w = w + ATLAS_PADDING;
+    const int slot_h = h + ATLAS_PADDING;
+    int i;
+
+    for (i = 0; i < atlas->num_pages; ++i) {
+        AtlasPage *page = &atlas->pages[i];
+        if (AtlasFreeRectInsert(page, slot_w, slot_h, &entry->slot) ||
+            AtlasSkylineInsert(atlas, page, slot_w, slot_h, &entry->slot)) {
+            break;
+        }
+    }
+    if (i == atlas->num_pages) {
+        i = AtlasAddPage(atlas);
+        if (i < 0) {
+            return -1;
+        }
+        if (!AtlasSkylineInsert(atlas, &atlas->pages[i], slot_w, slot_h, &entry->slot)) {
+            return -1;
+        }
+    }
+
+    entry->page = i;
+    entry->rect.x = entry->slot.x;
+    entry->rect.y = entry->slot.y;
+    entry->rect.w = w;
+    entry->rect.h = h;
+    ++atlas->pages[i].num_entries;
+    return 0;
+}
+
+static void
+AtlasRemoveEntry(SDL_TextureAtlas *atlas, AtlasEntry *entry)
+{
+    AtlasPage *page = &atlas->pages[entry->page];
+
+    page->reused = SDL_TRUE;
+    if (--page->num_entries == 0) {
+        AtlasResetPage(atlas, page);
+    } else if (AtlasGrowArray((void **) &page->free_rects, &page->max_free_rects, page->num_free_rects + 1, sizeof(SDL_Rect))) {
+        page->free_rects[page->num_free_rects++] = entry->slot;
+    }
+    entry->page = -1;
+}
+
+static AtlasEntry *
+AtlasGetEntry(SDL_TextureAtlas *atlas, int id)
+{
+    if (id <= 0 || id > atlas->num_entries || atlas->entries[id - 1].page < 0) {
+        return NULL;
+    }
+    return &atlas->entries[id - 1];
+}
+
+/* Returns the id of an unused entry */
+static int
+AtlasAllocateEntry(SDL_TextureAtlas *atlas)
+{
+    int i;
+
+    for (i = 0; i < atlas->num_entries; ++i) {
+        if (atlas->entries[i].page < 0) {
+            return i + 1;
+        }
+    }
+    if (!AtlasGrowArray((void **) &atlas->entries, &atlas->max_entries, atlas->num_entries + 1, sizeof(AtlasEntry))) {
+        return -1;
+    }
+    atlas->entries[atlas->num_entries].page = -1;
+    return ++atlas->num_entries;
+}
+
+/* Clears the column right of an entry and the row below it, as far as
+   they're in the page */
+static int
+AtlasClearPadding(SDL_TextureAtlas *atlas, const AtlasEntry *entry)
+{
+    const int bpp = SDL_BYTESPERPIXEL(atlas->format);
+    SDL_Texture *texture = atlas->pages[entry->page].texture;
+    SDL_Rect rect;
+    void *zeros;
+    int retval = 0;
+
+    zeros = SDL_calloc(SDL_max(entry->slot.w, entry->slot.h) * ATLAS_PADDING, bpp);
+    if (!zeros) {
+        return SDL_OutOfMemory();
+    }
+    rect.x = entry->rect.x + entry->rect.w;
+    rect.y = entry->slot.y;
+    rect.w = SDL_min(ATLAS_PADDING, atlas->w - rect.x);
+    rect.h = SDL_min(entry->slot.h, atlas->h - rect.y);
+    if (rect.w > 0 && rect.h > 0) {
+        retval = SDL_UpdateTexture(texture, &rect, zeros, ATLAS_PADDING * bpp);
+    }
+    rect.x = entry->slot.x;
+    rect.y = entry->rect.y + entry->rect.h;
+    rect.w = SDL_min(entry->rect.w, atlas->w - rect.x);
+    rect.h = SDL_min(ATLAS_PADDING, atlas->h - rect.y);
+    if (retval == 0 && rect.w > 0 && rect.h > 0) {
+        retval = SDL_UpdateTexture(texture, &rect, zeros, entry->slot.w * bpp);
+    }
+    SDL_free(zeros);
+    return retval;
+}
+
+static int
+AtlasUploadEntry(SDL_TextureAtlas *atlas, const AtlasEntry *entry, SDL_Surface *surface)
+{
+    SDL_Surface *converted = surface;
+    int retval;
+
+    if (atlas->pages[entry->page].reused && AtlasClearPadding(atlas, entry) < 0) {
+        return -1;
+    }
+
+    if (surface->format->format != atlas->format) {
+        converted = SDL_ConvertSurfaceFormat(surface, atlas->format, 0);
+        if (!converted) {
+            return -1;
+        }
+    }
+
+    if (SDL_MUSTLOCK(converted)) {
+        SDL_LockSurface(converted);
+    }
+    retval = SDL_UpdateTexture(atlas->pages[entry->page].texture, &entry->rect, converted->pixels, converted->pitch);
+    if (SDL_MUSTLOCK(converted)) {
+        SDL_UnlockSurface(converted);
+    }
+
+    if (converted != surface) {
+        SDL_FreeSurface(converted);
+    }
+    return retval;
+}
+
+/* The tallest surfaces are packed first, which leaves less space under the skyline */
+static int SDLCALL
+AtlasCompareItems(const void *a, const void *b)
+{
+    const AtlasItem *A = (const AtlasItem *) a;
+    const AtlasItem *B = (const AtlasItem *) b;
+
+    if (A->h != B->h) {
+        return B->h - A->h;
+    }
+    if (A->w != B->w) {
+        return B->w - A->w;
+    }
+    return A->index - B->index;
+}
+
+SDL_TextureAtlas *
+SDL_CreateTextureAtlas(SDL_Renderer * renderer, Uint32 format, int w, int h)
+{
+    SDL_TextureAtlas *atlas;
+
+    if (!renderer) {
+        SDL_InvalidParamError("renderer");
+        return NULL;
+    }
+    if (!format) {
+        format = SDL_PIXELFORMAT_ARGB8888;
+    }
+    if (SDL_ISPIXELFORMAT_FOURCC(format) || SDL_ISPIXELFORMAT_INDEXED(format)) {
+        SDL_SetError("Texture atlases need a packed pixel format");
+        return NULL;
+    }
+    if (w <= 0 || h <= 0) {
+        SDL_SetError("Texture atlas dimensions are not valid");
+        return NULL;
+    }
+
+    atlas = (SDL_TextureAtlas *) SDL_calloc(1, sizeof(*atlas));
+    if (!atlas) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    atlas->renderer = renderer;
+    atlas->format = format;
+    atlas->w = w;
+    atlas->h = h;
+    return atlas;
+}
+
+int
+SDL_AddTextureAtlasSurfaces(SDL_TextureAtlas * atlas, SDL_Surface ** surfaces, int count, int *ids)
+{
+    AtlasItem *items;
+    int i, retval = 0;
+
+    if (!atlas) {
+        return SDL_InvalidParamError("atlas");
+    }
+    if (!surfaces || !ids || count < 0) {
+        return SDL_InvalidParamError(!surfaces ? "surfaces" : !ids ? "ids" : "count");
+    }
+    for (i = 0; i < count; ++i) {
+        if (!surfaces[i]) {
+            return SDL_InvalidParamError("surfaces");
+        }
+        if (surfaces[i]->w <= 0 || surfaces[i]->h <= 0 ||
+            surfaces[i]->w > atlas->w || surfaces[i]->h > atlas->h) {
+            return SDL_SetError("Surface %d doesn't fit in the texture atlas", i);
+        }
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    items = (AtlasItem *) SDL_malloc(count * sizeof(*items));
+    if (!items) {
+        return SDL_OutOfMemory();
+    }
+    for (i = 0; i < count; ++i) {
+        items[i].index = i;
+        items[i].w = surfaces[i]->w;
+        items[i].h = surfaces[i]->h;
+        ids[i] = 0;
+    }
+    SDL_qsort(items, count, sizeof(*items), AtlasCompareItems);
+
+    /* All of them are packed before any is uploaded, or none is added */
+    for (i = 0; i < count; ++i) {
+        const int id = AtlasAllocateEntry(atlas);
+        if (id < 0 || AtlasPlaceEntry(atlas, &atlas->entries[id - 1], items[i].w, items[i].h) < 0) {
+            retval = -1;
+            break;
+        }
+        ids[items[i].index] = id;
+    }
+    for (i = 0; i < count && retval == 0; ++i) {
+        retval = AtlasUploadEntry(atlas, &atlas->entries[ids[i] - 1], surfaces[i]);
+    }
+
+    if (retval < 0) {
+        for (i = 0; i < count; ++i) {
+            if (ids[i]) {
+                AtlasRemoveEntry(atlas, &atlas->entries[ids[i] - 1]);
+                ids[i] = 0;
+            }
+        }
+    }
+    SDL_free(items);
+    return retval;
+}
+
+int
+SDL_AddTextureAtlasSurface(SDL_TextureAtlas * atlas, SDL_Surface * surface)
+{
+    int id;
+
+    if (SDL_AddTextureAtlasSurfaces(atlas, &surface, 1, &id) < 0) {
+        return -1;
+    }
+    return id;
+}
+
+int
+SDL_QueryTextureAtlasEntry(SDL_TextureAtlas * atlas, int id, SDL_Texture ** texture, SDL_Rect * rect)
+{
+    const AtlasEntry *entry;
+
+    if (!atlas) {
+        return SDL_InvalidParamError("atlas");
+    }
+    entry = AtlasGetEntry(atlas, id);
+    if (!entry) {
+        return SDL_InvalidParamError("id");
+    }
+    if (texture) {
+        *texture = atlas->pages[entry->page].texture;
+    }
+    if (rect) {
+        *rect = entry->rect;
+    }
+    return 0;
+}
+
+void
+SDL_RemoveTextureAtlasEntry(SDL_TextureAtlas * atlas, int id)
+{
+    AtlasEntry *entry;
+
+    if (!atlas) {
+        return;
+    }
+    entry = AtlasGetEntry(atlas, id);
+    if (entry) {
+        AtlasRemoveEntry(atlas, entry);
+    }
+}
+
+void
+SDL_DestroyTextureAtlas(SDL_TextureAtlas * atlas)
+{
+    int i;
+
+    if (!atlas) {
+        return;
+    }
+    for (i = 0; i < atlas->num_pages; ++i) {
+        SDL_DestroyTexture(atlas->pages[i].texture);
+        SDL_free(atlas->pages[i].skyline);
+        SDL_free(atlas->pages[i].free_rects);
+    }
+    SDL_free(atlas->pages);
+    SDL_free(atlas->entries);
+    SDL_free(atlas);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,1237 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#include "SDL_hints.h"
+#include "SDL_log.h"
+#include "SDL_render.h"
+#include "SDL_rendercapture_c.h"
+
+/* A render capture starts with a header:
+
+     char magic[8]       "SDLRCAP" and a zero byte
+     Uint32 version      CAPTURE_VERSION
+     Uint32 w, h         the output size of the renderer
+
+   which is followed by records, made of a CaptureOp byte and the Uint32
+   length of the data that follows. Records that aren't known are skipped.
+
+   Numbers are little endian, floats are IEEE 754 and rectangles are x, y,
+   w, h. Draws are preceded by the draw state: the Uint32 id of the texture,
+   or 0 for none, the Uint8 r, g, b and a of the color or texture modulation,
+   and the Uint32 blend mode.
+ */
+#define CAPTURE_MAGIC   "SDLRCAP"
+#define CAPTURE_VERSION 1
+#define CAPTURE_HEADER_SIZE (8 + 3 * 4)
+#define RECORD_HEADER_SIZE  (1 + 4)
+
+/* Texture ids are handed out in order, so this is only hit by broken files */
+#define MAX_TEXTURE_ID  0x100000
+
+typedef enum
+{
+    CAPTURE_PRESENT = 1,            /* nothing */
+    CAPTURE_CREATE_TEXTURE,         /* Uint32 id, format, access, w, h, scale mode */
+    CAPTURE_DESTROY_TEXTURE,        /* Uint32 id */
+    CAPTURE_UPDATE_TEXTURE,         /* Uint32 id, Sint32 rect, pitch, the pixels */
+    CAPTURE_UPDATE_TEXTURE_YUV,     /* Uint32 id, Sint32 rect, the packed Y, U and V planes */
+    CAPTURE_SET_TARGET,             /* Uint32 id, 0 for the default target */
+    CAPTURE_VIEWPORT,               /* Sint32 rect */
+    CAPTURE_CLIPRECT,               /* Uint8 enabled, Sint32 rect */
+    CAPTURE_CLEAR,                  /* Uint8 r, g, b, a */
+    CAPTURE_DRAW_POINTS,            /* draw state, Uint32 count, float x, y per point */
+    CAPTURE_DRAW_LINES,             /* draw state, Uint32 count, float x, y per point */
+    CAPTURE_FILL_RECTS,             /* draw state, Uint32 count, float rect per rect */
+    CAPTURE_COPY,                   /* draw state, Uint32 count, Sint32 srcrect and float dstrect per copy */
+    CAPTURE_COPY_EX,                /* draw state, Sint32 srcrect, float dstrect, double angle, float center, Uint32 flip */
+    CAPTURE_GEOMETRY                /* draw state, Uint32 vertex and index count, float x, y, Uint8 r, g, b, a,
+                                       float u, v per vertex, Sint32 per index */
+} CaptureOp;
+
+#define DRAW_STATE_SIZE (4 + 4 + 4)
+#define VERTEX_SIZE     (2 * 4 + 4 + 2 * 4)
+
+struct SDL_RenderCapture
+{
+    SDL_RWops *dst;
+    Uint8 *record;              /* the record being written */
+    size_t record_length;
+    size_t record_allocation;
+    SDL_bool failed;
+    Uint32 next_texture_id;
+    int frames_left;            /* 0 to record until the renderer is destroyed */
+
+    /* What was recorded last, the queue repeats these after every flush */
+    SDL_bool viewport_recorded;
+    SDL_Rect viewport;
+    SDL_bool cliprect_recorded;
+    SDL_bool clipping_enabled;
+    SDL_Rect clip_rect;
+};
+
+/* The number of bytes of pixels SDL_UpdateTexture() reads from a rect */
+static size_t
+GetPixelDataSize(Uint32 format, int w, int h, int pitch)
+{
+    switch (format) {
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        return (size_t)h * pitch + 2 * (size_t)((h + 1) / 2) * ((pitch + 1) / 2);
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+        return (size_t)h * pitch;
+    default:
+        return (size_t)(h - 1) * pitch + (size_t)w * SDL_BYTESPERPIXEL(format);
+    }
+}
+
+static SDL_INLINE Uint8 *
+Put32(Uint8 *p, Uint32 value)
+{
+    p[0] = (Uint8) value;
+    p[1] = (Uint8) (value >> 8);
+    p[2] = (Uint8) (value >> 16);
+    p[3] = (Uint8) (value >> 24);
+    return p + 4;
+}
+
+static SDL_INLINE Uint8 *
+PutFloat(Uint8 *p, float value)
+{
+    union { float f; Uint32 u; } cast;
+    cast.f = value;
+    return Put32(p, cast.u);
+}
+
+static SDL_INLINE Uint8 *
+PutRect(Uint8 *p, const SDL_Rect *rect)
+{
+    p = Put32(p, (Uint32) rect->x);
+    p = Put32(p, (Uint32) rect->y);
+    p = Put32(p, (Uint32) rect->w);
+    return Put32(p, (Uint32) rect->h);
+}
+
+static SDL_INLINE Uint8 *
+PutFRect(Uint8 *p, const SDL_FRect *rect)
+{
+    p = PutFloat(p, rect->x);
+    p = PutFloat(p, rect->y);
+    p = PutFloat(p, rect->w);
+    return PutFloat(p, rect->h);
+}
+
+/* Makes room for size more bytes in the record, NULL if it failed */
+static Uint8 *
+Reserve(SDL_RenderCapture *capture, size_t size)
+{
+    Uint8 *p;
+
+    if (capture->failed) {
+        return NULL;
+    }
+    if (capture->record_length + size > capture->record_allocation) {
+        size_t allocation = capture->record_allocation ? capture->record_allocation : 1024;
+        Uint8 *record;
+
+        while (capture->record_length + size > allocation) {
+            allocation *= 2;
+        }
+        record = (Uint8 *) SDL_realloc(capture->record, allocation);
+        if (!record) {
+            SDL_OutOfMemory();
+            capture->failed = SDL_TRUE;
+            return NULL;
+        }
+        capture->record = record;
+        capture->record_allocation = allocation;
+    }
+    p = capture->record + capture->record_length;
+    capture->record_length += size;
+    return p;
+}
+
+/* Starts a record, its data is added with Reserve() */
+static void
+BeginRecord(SDL_RenderCapture *capture, CaptureOp op)
+{
+    Uint8 *p;
+
+    capture->record_length = 0;
+    p = Reserve(capture, RECORD_HEADER_SIZE);
+    if (p) {
+        *p = (Uint8) op;
+    }
+}
+
+static void
+EndRecord(SDL_Renderer *renderer)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+
+    if (!capture->failed) {
+        Put32(capture->record + 1, (Uint32) (capture->record_length - RECORD_HEADER_SIZE));
+        if (SDL_RWwrite(capture->dst, capture->record, capture->record_length, 1) != 1) {
+            capture->failed = SDL_TRUE;
+        }
+    }
+    if (capture->failed) {
+        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Stopped recording the render commands: %s", SDL_GetError());
+        SDL_StopRenderCapture(renderer);
+    }
+}
+
+static void
+AppendDrawState(SDL_RenderCapture *capture, const SDL_RenderCommand *cmd)
+{
+    Uint8 *p = Reserve(capture, DRAW_STATE_SIZE);
+    if (p) {
+        const SDL_Texture *texture = cmd->data.draw.texture;
+        p = Put32(p, texture ? texture->capture_id : 0);
+        *p++ = cmd->data.draw.r;
+        *p++ = cmd->data.draw.g;
+        *p++ = cmd->data.draw.b;
+        *p++ = cmd->data.draw.a;
+        Put32(p, (Uint32) cmd->data.draw.blend);
+    }
+}
+
+void
+SDL_StartRenderCapture(SDL_Renderer *renderer)
+{
+    const char *file = SDL_GetHint(SDL_HINT_RENDER_CAPTURE_FILE);
+    const char *frames = SDL_GetHint(SDL_HINT_RENDER_CAPTURE_FRAMES);
+    SDL_RenderCapture *capture;
+    Uint8 header[CAPTURE_HEADER_SIZE];
+    Uint8 *p;
+    int w = 0, h = 0;
+
+    if (!file || !*file) {
+        return;
+    }
+
+    capture = (SDL_RenderCapture *) SDL_calloc(1, sizeof(*capture));
+    if (!capture) {
+        SDL_OutOfMemory();
+        return;
+    }
+    capture->dst = SDL_RWFromFile(file, "wb");
+    if (!capture->dst) {
+        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Couldn't record the render commands: %s", SDL_GetError());
+        SDL_free(capture);
+        return;
+    }
+    capture->next_texture_id = 1;
+    capture->frames_left = frames ? SDL_max(SDL_atoi(frames), 0) : 0;
+    renderer->capture = capture;
+
+    SDL_GetRendererOutputSize(renderer, &w, &h);
+    SDL_memcpy(header, CAPTURE_MAGIC, 8);
+    p = Put32(header + 8, CAPTURE_VERSION);
+    p = Put32(p, (Uint32) w);
+    Put32(p, (Uint32) h);
+    if (SDL_RWwrite(capture->dst, header, sizeof (header), 1) != 1) {
+        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Couldn't record the render commands: %s", SDL_GetError());
+        SDL_StopRenderCapture(renderer);
+    }
+}
+
+void
+SDL_StopRenderCapture(SDL_Renderer *renderer)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+
+    renderer->capture = NULL;
+    SDL_RWclose(capture->dst);
+    SDL_free(capture->record);
+    SDL_free(capture);
+}
+
+void
+SDL_CaptureCreateTexture(SDL_Texture *texture)
+{
+    SDL_Renderer *renderer = texture->renderer;
+    SDL_RenderCapture *capture = renderer->capture;
+    Uint8 *p;
+
+    texture->capture_id = capture->next_texture_id++;
+
+    BeginRecord(capture, CAPTURE_CREATE_TEXTURE);
+    p = Reserve(capture, 6 * 4);
+    if (p) {
+        p = Put32(p, texture->capture_id);
+        p = Put32(p, texture->format);
+        p = Put32(p, (Uint32) texture->access);
+        p = Put32(p, (Uint32) texture->w);
+        p = Put32(p, (Uint32) texture->h);
+        Put32(p, (Uint32) texture->scaleMode);
+    }
+    EndRecord(renderer);
+}
+
+void
+SDL_CaptureDestroyTexture(SDL_Texture *texture)
+{
+    SDL_Renderer *renderer = texture->renderer;
+    SDL_RenderCapture *capture = renderer->capture;
+    Uint8 *p;
+
+    BeginRecord(capture, CAPTURE_DESTROY_TEXTURE);
+    p = Reserve(capture, 4);
+    if (p) {
+        Put32(p, texture->capture_id);
+    }
+    EndRecord(renderer);
+}
+
+void
+SDL_CaptureUpdateTexture(SDL_Texture *texture, const SDL_Rect *rect, const void *pixels, int pitch)
+{
+    SDL_Renderer *renderer = texture->renderer;
+    SDL_RenderCapture *capture = renderer->capture;
+    const Uint8 *src = (const Uint8 *) pixels;
+    size_t size;
+    Uint8 *p;
+
+    if (!SDL_ISPIXELFORMAT_FOURCC(texture->format)) {
+        /* Drop the padding between the rows */
+        const int length = rect->w * SDL_BYTESPERPIXEL(texture->format);
+        int row;
+
+        size = (size_t) length * rect->h;
+        BeginRecord(capture, CAPTURE_UPDATE_TEXTURE);
+        p = Reserve(capture, 6 * 4 + size);
+        if (p) {
+            p = Put32(p, texture->capture_id);
+            p = PutRect(p, rect);
+            p = Put32(p, (Uint32) length);
+            for (row = 0; row < rect->h; ++row) {
+                SDL_memcpy(p, src, length);
+                src += pitch;
+                p += length;
+            }
+        }
+    } else {
+        size = GetPixelDataSize(texture->format, rect->w, rect->h, pitch);
+        BeginRecord(capture, CAPTURE_UPDATE_TEXTURE);
+        p = Reserve(capture, 6 * 4 + size);
+        if (p) {
+            p = Put32(p, texture->capture_id);
+            p = PutRect(p, rect);
+            p = Put32(p, (Uint32) pitch);
+            SDL_memcpy(p, src, size);
+        }
+    }
+    EndRecord(renderer);
+}
+
+static Uint8 *
+PutPlane(Uint8 *p, const Uint8 *src, int pitch, int length, int rows)
+{
+    int row;
+
+    for (row = 0; row < rows; ++row) {
+        SDL_memcpy(p, src, length);
+        src += pitch;
+        p += length;
+    }
+    return p;
+}
+
+void
+SDL_CaptureUpdateTextureYUV(SDL_Texture *texture, const SDL_Rect *rect,
+                            const Uint8 *Yplane, int Ypitch,
+                            const Uint8 *Uplane, int Upitch,
+                            const Uint8 *Vplane, int Vpitch)
+{
+    SDL_Renderer *renderer = texture->renderer;
+    SDL_RenderCapture *capture = renderer->capture;
+    const int uvw = (rect->w + 1) / 2;
+    const int uvh = (rect->h + 1) / 2;
+    const size_t size = (size_t) rect->w * rect->h + 2 * (size_t) uvw * uvh;
+    Uint8 *p;
+
+    BeginRecord(capture, CAPTURE_UPDATE_TEXTURE_YUV);
+    p = Reserve(capture, 5 * 4 + size);
+    if (p) {
+        p = Put32(p, texture->capture_id);
+        p = PutRect(p, rect);
+        p = PutPlane(p, Yplane, Ypitch, rect->w, rect->h);
+        p = PutPlane(p, Uplane, Upitch, uvw, uvh);
+        PutPlane(p, Vplane, Vpitch, uvw, uvh);
+    }
+    EndRecord(renderer);
+}
+
+void
+SDL_CaptureUnlockTexture(SDL_Texture *texture)
+{
+    if (!texture->capture_pixels) {
+        return;
+    }
+
+    /* The planes of a YUV texture don't follow a locked rect, they are laid
+       out for the whole texture, so only whole texture locks are recorded. */
+    if (!SDL_ISPIXELFORMAT_FOURCC(texture->format) ||
+        (texture->capture_rect.x == 0 && texture->capture_rect.y == 0 &&
+         texture->capture_rect.w == texture->w && texture->capture_rect.h == texture->h)) {
+        SDL_CaptureUpdateTexture(texture, &texture->capture_rect, texture->capture_pixels, texture->capture_pitch);
+    }
+    texture->capture_pixels = NULL;
+}
+
+void
+SDL_CaptureSetTarget(SDL_Renderer *renderer, SDL_Texture *texture)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+    Uint8 *p;
+
+    BeginRecord(capture, CAPTURE_SET_TARGET);
+    p = Reserve(capture, 4);
+    if (p) {
+        Put32(p, texture ? texture->capture_id : 0);
+    }
+
+    /* Setting the target resets the viewport and clipping */
+    capture->viewport_recorded = SDL_FALSE;
+    capture->cliprect_recorded = SDL_FALSE;
+
+    EndRecord(renderer);
+}
+
+void
+SDL_CaptureViewport(SDL_Renderer *renderer)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+    Uint8 *p;
+
+    if (capture->viewport_recorded &&
+        SDL_memcmp(&capture->viewport, &renderer->viewport, sizeof (SDL_Rect)) == 0) {
+        return;
+    }
+    capture->viewport = renderer->viewport;
+    capture->viewport_recorded = SDL_TRUE;
+
+    BeginRecord(capture, CAPTURE_VIEWPORT);
+    p = Reserve(capture, 4 * 4);
+    if (p) {
+        PutRect(p, &renderer->viewport);
+    }
+    EndRecord(renderer);
+}
+
+void
+SDL_CaptureClipRect(SDL_Renderer *renderer)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+    Uint8 *p;
+
+    if (capture->cliprect_recorded &&
+        capture->clipping_enabled == renderer->clipping_enabled &&
+        SDL_memcmp(&capture->clip_rect, &renderer->clip_rect, sizeof (SDL_Rect)) == 0) {
+        return;
+    }
+    capture->clipping_enabled = renderer->clipping_enabled;
+    capture->clip_rect = renderer->clip_rect;
+    capture->cliprect_recorded = SDL_TRUE;
+
+    BeginRecord(capture, CAPTURE_CLIPRECT);
+    p = Reserve(capture, 1 + 4 * 4);
+    if (p) {
+        *p++ = renderer->clipping_enabled ? 1 : 0;
+        PutRect(p, &renderer->clip_rect);
+    }
+    EndRecord(renderer);
+}
+
+void
+SDL_CapturePresent(SDL_Renderer *renderer)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+
+    BeginRecord(capture, CAPTURE_PRESENT);
+    EndRecord(renderer);
+
+    /* EndRecord() stops recording if writing failed */
+    if (renderer->capture && capture->frames_left && --capture->frames_left == 0) {
+        SDL_StopRenderCapture(renderer);
+    }
+}
+
+void
+SDL_CaptureClear(SDL_Renderer *renderer, const SDL_RenderCommand *cmd)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+    Uint8 *p;
+
+    BeginRecord(capture, CAPTURE_CLEAR);
+    p = Reserve(capture, 4);
+    if (p) {
+        p[0] = cmd->data.color.r;
+        p[1] = cmd->data.color.g;
+        p[2] = cmd->data.color.b;
+        p[3] = cmd->data.color.a;
+    }
+    EndRecord(renderer);
+}
+
+void
+SDL_CapturePoints(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, const SDL_FPoint *points, int count)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+    const size_t size = 4 + (size_t) count * 2 * 4;
+    const CaptureOp op = (cmd->command == SDL_RENDERCMD_DRAW_LINES) ? CAPTURE_DRAW_LINES : CAPTURE_DRAW_POINTS;
+    Uint8 *p;
+    int i;
+
+    BeginRecord(capture, op);
+    AppendDrawState(capture, cmd);
+    p = Reserve(capture, size);
+    if (p) {
+        p = Put32(p, (Uint32) count);
+        for (i = 0; i < count; ++i) {
+            p = PutFloat(p, points[i].x);
+            p = PutFloat(p, points[i].y);
+        }
+    }
+    EndRecord(renderer);
+}
+
+void
+SDL_CaptureRects(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, const SDL_FRect *rects, int count)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+    const size_t size = 4 + (size_t) count * 4 * 4;
+    Uint8 *p;
+    int i;
+
+    BeginRecord(capture, CAPTURE_FILL_RECTS);
+    AppendDrawState(capture, cmd);
+    p = Reserve(capture, size);
+    if (p) {
+        p = Put32(p, (Uint32) count);
+        for (i = 0; i < count; ++i) {
+            p = PutFRect(p, &rects[i]);
+        }
+    }
+    EndRecord(renderer);
+}
+
+void
+SDL_CaptureCopies(SDL_Renderer *renderer, const SDL_RenderCommand *cmd,
+                  const SDL_Rect *srcrects, const SDL_FRect *dstrects, int count)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+    const size_t size = 4 + (size_t) count * 8 * 4;
+    Uint8 *p;
+    int i;
+
+    BeginRecord(capture, CAPTURE_COPY);
+    AppendDrawState(capture, cmd);
+    p = Reserve(capture, size);
+    if (p) {
+        p = Put32(p, (Uint32) count);
+        for (i = 0; i < count; ++i) {
+            p = PutRect(p, &srcrects[i]);
+            p = PutFRect(p, &dstrects[i]);
+        }
+    }
+    EndRecord(renderer);
+}
+
+void
+SDL_CaptureCopyEx(SDL_Renderer *renderer, const SDL_RenderCommand *cmd,
+                  const SDL_Rect *srcrect, const SDL_FRect *dstrect,
+                  double angle, const SDL_FPoint *center, SDL_RendererFlip flip)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+    const size_t size = 8 * 4 + 8 + 2 * 4 + 4;
+    union { double d; Uint64 u; } cast;
+    Uint8 *p;
+
+    BeginRecord(capture, CAPTURE_COPY_EX);
+    AppendDrawState(capture, cmd);
+    p = Reserve(capture, size);
+    if (p) {
+        cast.d = angle;
+        p = PutRect(p, srcrect);
+        p = PutFRect(p, dstrect);
+        p = Put32(p, (Uint32) cast.u);
+        p = Put32(p, (Uint32) (cast.u >> 32));
+        p = PutFloat(p, center->x);
+        p = PutFloat(p, center->y);
+        Put32(p, (Uint32) flip);
+    }
+    EndRecord(renderer);
+}
+
+void
+SDL_CaptureGeometry(SDL_Renderer *renderer, const SDL_RenderCommand *cmd,
+                    const SDL_Vertex *vertices, int num_vertices,
+                    const int *indices, int num_indices)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+    const size_t size = 2 * 4 + (size_t) num_vertices * VERTEX_SIZE + (size_t) num_indices * 4;
+    Uint8 *p;
+    int i;
+
+    BeginRecord(capture, CAPTURE_GEOMETRY);
+    AppendDrawState(capture, cmd);
+    p = Reserve(capture, size);
+    if (p) {
+        p = Put32(p, (Uint32) num_vertices);
+        p = Put32(p, (Uint32) num_indices);
+        for (i = 0; i < num_vertices; ++i) {
+            const SDL_Vertex *v = &vertices[i];
+            p = PutFloat(p, v->position.x * renderer->scale.x);
+            p = PutFloat(p, v->position.y * renderer->scale.y);
+            *p++ = v->color.r;
+            *p++ = v->color.g;
+            *p++ = v->color.b;
+            *p++ = v->color.a;
+            p = PutFloat(p, v->tex_coord.x);
+            p = PutFloat(p, v->tex_coord.y);
+        }
+        for (i = 0; i < num_indices; ++i) {
+            p = Put32(p, (Uint32) indices[i]);
+        }
+    }
+    EndRecord(renderer);
+}
+
+
+struct SDL_RenderReplay
+{
+    SDL_RWops *src;
+    int freesrc;
+    SDL_Renderer *renderer;
+    SDL_Texture **textures;     /* indexed by the texture ids of the capture */
+    Uint32 num_textures;
+    Uint8 *record;
+    Uint32 record_allocation;
+    void *scratch;              /* for the decoded data of a record */
+    size_t scratch_allocation;
+};
+
+/* Reads the data of a record, setting overrun if it's too short */
+typedef struct
+{
+    const Uint8 *p;
+    const Uint8 *end;
+    SDL_bool overrun;
+} CaptureReader;
+
+static SDL_bool
+HasData(CaptureReader *reader, size_t size)
+{
+    if ((size_t) (reader->end - reader->p) < size) {
+        reader->overrun = SDL_TRUE;
+        reader->p = reader->end;
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static Uint8
+Get8(CaptureReader *reader)
+{
+    if (!HasData(reader, 1)) {
+        return 0;
+    }
+    return *reader->p++;
+}
+
+static Uint32
+Get32(CaptureReader *reader)
+{
+    const Uint8 *p = reader->p;
+    if (!HasData(reader, 4)) {
+        return 0;
+    }
+    reader->p += 4;
+    return (Uint32) p[0] | ((Uint32) p[1] << 8) | ((Uint32) p[2] << 16) | ((Uint32) p[3] << 24);
+}
+
+static float
+GetFloat(CaptureReader *reader)
+{
+    union { float f; Uint32 u; } cast;
+    cast.u = Get32(reader);
+    return cast.f;
+}
+
+static void
+GetRect(CaptureReader *reader, SDL_Rect *rect)
+{
+    rect->x = (int) Get32(reader);
+    rect->y = (int) Get32(reader);
+    rect->w = (int) Get32(reader);
+    rect->h = (int) Get32(reader);
+}
+
+static void
+GetFRect(CaptureReader *reader, SDL_FRect *rect)
+{
+    rect->x = GetFloat(reader);
+    rect->y = GetFloat(reader);
+    rect->w = GetFloat(reader);
+    rect->h = GetFloat(reader);
+}
+
+/* Gets an array count, checking that the record holds that many elements */
+static int
+GetCount(CaptureReader *reader, size_t element_size)
+{
+    const Uint32 count = Get32(reader);
+    if ((size_t) count > (size_t) (reader->end - reader->p) / element_size) {
+        reader->overrun = SDL_TRUE;
+        return 0;
+    }
+    return (int) count;
+}
+
+static void *
+GetScratch(SDL_RenderReplay *replay, size_t size)
+{
+    if (size > replay->scratch_allocation) {
+        void *scratch = SDL_realloc(replay->scratch, size);
+        if (!scratch) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        replay->scratch = scratch;
+        replay->scratch_allocation = size;
+    }
+    return replay->scratch;
+}
+
+static SDL_Texture *
+GetTexture(SDL_RenderReplay *replay, Uint32 id)
+{
+    if (id >= replay->num_textures || !replay->textures[id]) {
+        SDL_SetError("Render capture uses an unknown texture");
+        return NULL;
+    }
+    return replay->textures[id];
+}
+
+/* Checks that an update of the texture stays inside of it */
+static SDL_bool
+IsValidUpdate(SDL_Texture *texture, const SDL_Rect *rect)
+{
+    return (rect->x >= 0 && rect->y >= 0 && rect->w > 0 && rect->h > 0 &&
+            rect->w <= texture->w - rect->x && rect->h <= texture->h - rect->y);
+}
+
+/* Sets up the renderer or the texture to draw like the captured draw did */
+static int
+ReplayDrawState(SDL_RenderReplay *replay, CaptureReader *reader, SDL_Texture **texture)
+{
+    const Uint32 id = Get32(reader);
+    const Uint8 r = Get8(reader);
+    const Uint8 g = Get8(reader);
+    const Uint8 b = Get8(reader);
+    const Uint8 a = Get8(reader);
+    const SDL_BlendMode blendMode = (SDL_BlendMode) Get32(reader);
+
+    *texture = NULL;
+    if (id) {
+        *texture = GetTexture(replay, id);
+        if (!*texture ||
+            SDL_SetTextureColorMod(*texture, r, g, b) < 0 ||
+            SDL_SetTextureAlphaMod(*texture, a) < 0 ||
+            SDL_SetTextureBlendMode(*texture, blendMode) < 0) {
+            return -1;
+        }
+    } else {
+        if (SDL_SetRenderDrawColor(replay->renderer, r, g, b, a) < 0 ||
+            SDL_SetRenderDrawBlendMode(replay->renderer, blendMode) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int
+ReplayCreateTexture(SDL_RenderReplay *replay, CaptureReader *reader)
+{
+    const Uint32 id = Get32(reader);
+    const Uint32 format = Get32(reader);
+    const int access = (int) Get32(reader);
+    const int w = (int) Get32(reader);
+    const int h = (int) Get32(reader);
+    const SDL_ScaleMode scaleMode = (SDL_ScaleMode) Get32(reader);
+    SDL_Texture *texture;
+
+    if (reader->overrun || id == 0 || id > MAX_TEXTURE_ID) {
+        return SDL_SetError("Corrupt render capture");
+    }
+    if (id >= replay->num_textures) {
+        const Uint32 num_textures = SDL_max(id + 1, replay->num_textures * 2);
+        SDL_Texture **textures = (SDL_Texture **) SDL_realloc(replay->textures, num_textures * sizeof (*textures));
+        if (!textures) {
+            return SDL_OutOfMemory();
+        }
+        SDL_memset(&textures[replay->num_textures], 0, (num_textures - replay->num_textures) * sizeof (*textures));
+        replay->textures = textures;
+        replay->num_textures = num_textures;
+    }
+
+    texture = SDL_CreateTextureWithScaleMode(replay->renderer, format, access, w, h, scaleMode);
+    if (!texture) {
+        return -1;
+    }
+    if (replay->textures[id]) {
+        SDL_DestroyTexture(replay->textures[id]);
+    }
+    replay->textures[id] = texture;
+    return 0;
+}
+
+static int
+ReplayUpdateTexture(SDL_RenderReplay *replay, CaptureReader *reader)
+{
+    SDL_Texture *texture = GetTexture(replay, Get32(reader));
+    SDL_Rect rect;
+    int pitch;
+    size_t size;
+    void *pixels;
+
+    if (!texture) {
+        return -1;
+    }
+    GetRect(reader, &rect);
+    pitch = (int) Get32(reader);
+    if (reader->overrun || !IsValidUpdate(texture, &rect) || pitch < rect.w * SDL_BYTESPERPIXEL(texture->format)) {
+        return SDL_SetError("Corrupt render capture");
+    }
+    size = GetPixelDataSize(texture->format, rect.w, rect.h, pitch);
+    if (!HasData(reader, size)) {
+        return SDL_SetError("Corrupt render capture");
+    }
+
+    /* The record data isn't aligned for the pixels */
+    pixels = GetScratch(replay, size);
+    if (!pixels) {
+        return -1;
+    }
+    SDL_memcpy(pixels, reader->p, size);
+    return SDL_UpdateTexture(texture, &rect, pixels, pitch);
+}
+
+static int
+ReplayUpdateTextureYUV(SDL_RenderReplay *replay, CaptureReader *reader)
+{
+    SDL_Texture *texture = GetTexture(replay, Get32(reader));
+    SDL_Rect rect;
+    int uvw, uvh;
+    size_t size;
+    Uint8 *pixels;
+
+    if (!texture) {
+        return -1;
+    }
+    GetRect(reader, &rect);
+    if (reader->overrun || !IsValidUpdate(texture, &rect)) {
+        return SDL_SetError("Corrupt render capture");
+    }
+    uvw = (rect.w + 1) / 2;
+    uvh = (rect.h + 1) / 2;
+    size = (size_t) rect.w * rect.h + 2 * (size_t) uvw * uvh;
+    if (!HasData(reader, size)) {
+        return SDL_SetError("Corrupt render capture");
+    }
+    pixels = (Uint8 *) GetScratch(replay, size);
+    if (!pixels) {
+        return -1;
+    }
+    SDL_memcpy(pixels, reader->p, size);
+    return SDL_UpdateYUVTexture(texture, &rect,
+                                pixels, rect.w,
+                                pixels + rect.w * rect.h, uvw,
+                                pixels + rect.w * rect.h + uvw * uvh, uvw);
+}
+
+static int
+ReplayPoints(SDL_RenderReplay *replay, CaptureReader *reader, SDL_bool lines)
+{
+    SDL_Texture *texture;
+    SDL_FPoint *points;
+    int count, i;
+
+    if (ReplayDrawState(replay, reader, &texture) < 0) {
+        return -1;
+    }
+    count = GetCount(reader, 2 * 4);
+    points = (SDL_FPoint *) GetScratch(replay, (size_t) count * sizeof (*points) + 1);
+    if (!points) {
+        return -1;
+    }
+    for (i = 0; i < count; ++i) {
+        points[i].x = GetFloat(reader);
+        points[i].y = GetFloat(reader);
+    }
+    if (reader->overrun) {
+        return SDL_SetError("Corrupt render capture");
+    }
+    if (lines) {
+        return SDL_RenderDrawLinesF(replay->renderer, points, count);
+    }
+    return SDL_RenderDrawPointsF(replay->renderer, points, count);
+}
+
+static int
+ReplayRects(SDL_RenderReplay *replay, CaptureReader *reader)
+{
+    SDL_Texture *texture;
+    SDL_FRect *rects;
+    int count, i;
+
+    if (ReplayDrawState(replay, reader, &texture) < 0) {
+        return -1;
+    }
+    count = GetCount(reader, 4 * 4);
+    rects = (SDL_FRect *) GetScratch(replay, (size_t) count * sizeof (*rects) + 1);
+    if (!rects) {
+        return -1;
+    }
+    for (i = 0; i < count; ++i) {
+        GetFRect(reader, &rects[i]);
+    }
+    if (reader->overrun) {
+        return SDL_SetError("Corrupt render capture");
+    }
+    return SDL_RenderFillRectsF(replay->renderer, rects, count);
+}
+
+static int
+ReplayCopies(SDL_RenderReplay *replay, CaptureReader *reader)
+{
+    SDL_Texture *texture;
+    SDL_Rect *srcrects;
+    SDL_FRect *dstrects;
+    int count, i;
+
+    if (ReplayDrawState(replay, reader, &texture) < 0) {
+        return -1;
+    }
+    if (!texture) {
+        return SDL_SetError("Corrupt render capture");
+    }
+    count = GetCount(reader, 8 * 4);
+    dstrects = (SDL_FRect *) GetScratch(replay, (size_t) count * (sizeof (SDL_FRect) + sizeof (SDL_Rect)) + 1);
+    if (!dstrects) {
+        return -1;
+    }
+    srcrects = (SDL_Rect *) &dstrects[count];
+    for (i = 0; i < count; ++i) {
+        GetRect(reader, &srcrects[i]);
+        GetFRect(reader, &dstrects[i]);
+    }
+    if (reader->overrun) {
+        return SDL_SetError("Corrupt render capture");
+    }
+    return SDL_RenderCopyBatchF(replay->renderer, texture, srcrects, dstrects, NULL, count);
+}
+
+static int
+ReplayCopyEx(SDL_RenderReplay *replay, CaptureReader *reader)
+{
+    SDL_Texture *texture;
+    SDL_Rect srcrect;
+    SDL_FRect dstrect;
+    SDL_FPoint center;
+    SDL_RendererFlip flip;
+    union { double d; Uint64 u; } cast;
+
+    if (ReplayDrawState(replay, reader, &texture) < 0) {
+        return -1;
+    }
+    GetRect(reader, &srcrect);
+    GetFRect(reader, &dstrect);
+    cast.u = Get32(reader);
+    cast.u |= (Uint64) Get32(reader) << 32;
+    center.x = GetFloat(reader);
+    center.y = GetFloat(reader);
+    flip = (SDL_RendererFlip) Get32(reader);
+    if (reader->overrun || !texture) {
+        return SDL_SetError("Corrupt render capture");
+    }
+    return SDL_RenderCopyExF(replay->renderer, texture, &srcrect, &dstrect, cast.d, &center, flip);
+}
+
+static int
+ReplayGeometry(SDL_RenderReplay *replay, CaptureReader *reader)
+{
+    SDL_Texture *texture;
+    SDL_Vertex *vertices;
+    int *indices;
+    int num_vertices, num_indices, i;
+
+    if (ReplayDrawState(replay, reader, &texture) < 0) {
+        return -1;
+    }
+    num_vertices = GetCount(reader, VERTEX_SIZE);
+    num_indices = GetCount(reader, 4);
+    if (!HasData(reader, (size_t) num_vertices * VERTEX_SIZE + (size_t) num_indices * 4)) {
+        return SDL_SetError("Corrupt render capture");
+    }
+    vertices = (SDL_Vertex *) GetScratch(replay, (size_t) num_vertices * sizeof (SDL_Vertex) + (size_t) num_indices * sizeof (int) + 1);
+    if (!vertices) {
+        return -1;
+    }
+    indices = (int *) &vertices[num_vertices];
+    for (i = 0; i < num_vertices; ++i) {
+        SDL_Vertex *v = &vertices[i];
+        v->position.x = GetFloat(reader);
+        v->position.y = GetFloat(reader);
+        v->color.r = Get8(reader);
+        v->color.g = Get8(reader);
+        v->color.b = Get8(reader);
+        v->color.a = Get8(reader);
+        v->tex_coord.x = GetFloat(reader);
+        v->tex_coord.y = GetFloat(reader);
+    }
+    for (i = 0; i < num_indices; ++i) {
+        indices[i] = (int) Get32(reader);
+    }
+    if (reader->overrun) {
+        return SDL_SetError("Corrupt render capture");
+    }
+    return SDL_RenderGeometry(replay->renderer, texture, vertices, num_vertices,
+                              num_indices ? indices : NULL, num_indices);
+}
+
+SDL_RenderReplay *
+SDL_RenderOpenReplay(SDL_RWops * src, int freesrc, int *w, int *h)
+{
+    SDL_RenderReplay *replay = NULL;
+    Uint8 header[CAPTURE_HEADER_SIZE];
+    CaptureReader reader;
+
+    if (!src) {
+        SDL_InvalidParamError("src");
+        return NULL;
+    }
+
+    if (SDL_RWread(src, header, sizeof (header), 1) != 1 ||
+        SDL_memcmp(header, CAPTURE_MAGIC, 8) != 0) {
+        SDL_SetError("Not a render capture");
+    } else {
+        reader.p = header + 8;
+        reader.end = header + sizeof (header);
+        reader.overrun = SDL_FALSE;
+        if (Get32(&reader) != CAPTURE_VERSION) {
+            SDL_SetError("Unsupported render capture version");
+        } else {
+            replay = (SDL_RenderReplay *) SDL_calloc(1, sizeof (*replay));
+            if (!replay) {
+                SDL_OutOfMemory();
+            } else {
+                const int output_w = (int) Get32(&reader);
+                const int output_h = (int) Get32(&reader);
+                if (w) {
+                    *w = output_w;
+                }
+                if (h) {
+                    *h = output_h;
+                }
+                replay->src = src;
+                replay->freesrc = freesrc;
+            }
+        }
+    }
+
+    if (!replay && freesrc) {
+        SDL_RWclose(src);
+    }
+    return replay;
+}
+
+int
+SDL_RenderReplayFrame(SDL_RenderReplay * replay, SDL_Renderer * renderer)
+{
+    if (!replay) {
+        return SDL_InvalidParamError("replay");
+    }
+    if (!renderer) {
+        return SDL_InvalidParamError("renderer");
+    }
+    if (!replay->renderer) {
+        replay->renderer = renderer;
+    } else if (renderer != replay->renderer) {
+        return SDL_SetError("A render capture can only be replayed with one renderer");
+    }
+
+    for ( ; ; ) {
+        Uint8 header[RECORD_HEADER_SIZE];
+        CaptureReader reader;
+        Uint32 length;
+        SDL_Rect rect;
+        SDL_bool enabled;
+        Uint8 r, g, b, a;
+        int retval = 0;
+
+        if (SDL_RWread(replay->src, header, sizeof (header), 1) != 1) {
+            return 0;  /* the end of the capture */
+        }
+        reader.p = header + 1;
+        reader.end = header + sizeof (header);
+        reader.overrun = SDL_FALSE;
+        length = Get32(&reader);
+
+        if (length > replay->record_allocation) {
+            Uint8 *record = (Uint8 *) SDL_realloc(replay->record, length);
+            if (!record) {
+                return SDL_OutOfMemory();
+            }
+            replay->record = record;
+            replay->record_allocation = length;
+        }
+        if (length && SDL_RWread(replay->src, replay->record, length, 1) != 1) {
+            return SDL_SetError("Truncated render capture");
+        }
+        reader.p = replay->record;
+        reader.end = replay->record + length;
+
+        switch ((CaptureOp) header[0]) {
+        case CAPTURE_PRESENT:
+            return 1;
+
+        case CAPTURE_CREATE_TEXTURE:
+            retval = ReplayCreateTexture(replay, &reader);
+            break;
+
+        case CAPTURE_DESTROY_TEXTURE: {
+            const Uint32 id = Get32(&reader);
+            if (GetTexture(replay, id)) {
+                SDL_DestroyTexture(replay->textures[id]);
+                replay->textures[id] = NULL;
+            }
+            break;
+        }
+
+        case CAPTURE_UPDATE_TEXTURE:
+            retval = ReplayUpdateTexture(replay, &reader);
+            break;
+
+        case CAPTURE_UPDATE_TEXTURE_YUV:
+            retval = ReplayUpdateTextureYUV(replay, &reader);
+            break;
+
+        case CAPTURE_SET_TARGET: {
+            const Uint32 id = Get32(&reader);
+            if (id == 0) {
+                retval = SDL_SetRenderTarget(renderer, NULL);
+            } else if (GetTexture(replay, id)) {
+                retval = SDL_SetRenderTarget(renderer, replay->textures[id]);
+            } else {
+                retval = -1;
+            }
+            break;
+        }
+
+        case CAPTURE_VIEWPORT:
+            GetRect(&reader, &rect);
+            retval = SDL_RenderSetViewport(renderer, &rect);
+            break;
+
+        case CAPTURE_CLIPRECT:
+            enabled = Get8(&reader) ? SDL_TRUE : SDL_FALSE;
+            GetRect(&reader, &rect);
+            retval = SDL_RenderSetClipRect(renderer, enabled ? &rect : NULL);
+            break;
+
+        case CAPTURE_CLEAR:
+            r = Get8(&reader);
+            g = Get8(&reader);
+            b = Get8(&reader);
+            a = Get8(&reader);
+            retval = SDL_SetRenderDrawColor(renderer, r, g, b, a);
+            if (retval == 0) {
+                retval = SDL_RenderClear(renderer);
+            }
+            break;
+
+        case CAPTURE_DRAW_POINTS:
+            retval = ReplayPoints(replay, &reader, SDL_FALSE);
+            break;
+
+        case CAPTURE_DRAW_LINES:
+            retval = ReplayPoints(replay, &reader, SDL_TRUE);
+            break;
+
+        case CAPTURE_FILL_RECTS:
+            retval = ReplayRects(replay, &reader);
+            break;
+
+        case CAPTURE_COPY:
+            retval = ReplayCopies(replay, &reader);
+            break;
+
+        case CAPTURE_COPY_EX:
+            retval = ReplayCopyEx(replay, &reader);
+            break;
+
+        case CAPTURE_GEOMETRY:
+            retval = ReplayGeometry(replay, &reader);
+            break;
+
+        default:
+            break;  /* skip records this version doesn't know */
+        }
+
+        if (retval < 0) {
+            return -1;
+        }
+        if (reader.overrun) {
+            return SDL_SetError("Corrupt render capture");
+        }
+    }
+}
+
+void
+SDL_RenderCloseReplay(SDL_RenderReplay * replay)
+{
+    Uint32 i;
+
+    if (!replay) {
+        return;
+    }
+    for (i = 0; i < replay->num_textures; ++i) {
+        if (replay->textures[i]) {
+            SDL_DestroyTexture(replay->textures[i]);
+        }
+    }
+    if (replay->freesrc) {
+        SDL_RWclose(replay->src);
+    }
+    SDL_free(replay->textures);
+    SDL_free(replay->record);
+    SDL_free(replay->scratch);
+    SDL_free(replay);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
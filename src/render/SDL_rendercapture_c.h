@@ -0,0 +1,77 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef SDL_rendercapture_c_h_
+#define SDL_rendercapture_c_h_
+
+#include "../SDL_internal.h"
+
+#include "SDL_sysrender.h"
+
+/* This records the render commands of a renderer into the file named by
+   SDL_HINT_RENDER_CAPTURE_FILE, to be played back with SDL_RenderOpenReplay().
+
+   Draws are recorded as they are queued, in output pixels, and texture
+   uploads as they are passed to the backend, so a texture the backend can't
+   use directly is recorded as the native texture it is converted to.
+   Except for SDL_StartRenderCapture(), these are only called while
+   renderer->capture is set.
+ */
+
+typedef struct SDL_RenderCapture SDL_RenderCapture;
+
+/* Starts recording if SDL_HINT_RENDER_CAPTURE_FILE is set, and stops it */
+extern void SDL_StartRenderCapture(SDL_Renderer *renderer);
+extern void SDL_StopRenderCapture(SDL_Renderer *renderer);
+
+/* Textures */
+extern void SDL_CaptureCreateTexture(SDL_Texture *texture);
+extern void SDL_CaptureDestroyTexture(SDL_Texture *texture);
+extern void SDL_CaptureUpdateTexture(SDL_Texture *texture, const SDL_Rect *rect, const void *pixels, int pitch);
+extern void SDL_CaptureUpdateTextureYUV(SDL_Texture *texture, const SDL_Rect *rect,
+                                        const Uint8 *Yplane, int Ypitch,
+                                        const Uint8 *Uplane, int Upitch,
+                                        const Uint8 *Vplane, int Vpitch);
+extern void SDL_CaptureUnlockTexture(SDL_Texture *texture);
+
+/* State */
+extern void SDL_CaptureSetTarget(SDL_Renderer *renderer, SDL_Texture *texture);
+extern void SDL_CaptureViewport(SDL_Renderer *renderer);
+extern void SDL_CaptureClipRect(SDL_Renderer *renderer);
+extern void SDL_CapturePresent(SDL_Renderer *renderer);
+
+/* Queued commands, with the color, blend mode and texture of cmd */
+extern void SDL_CaptureClear(SDL_Renderer *renderer, const SDL_RenderCommand *cmd);
+extern void SDL_CapturePoints(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, const SDL_FPoint *points, int count);
+extern void SDL_CaptureRects(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, const SDL_FRect *rects, int count);
+extern void SDL_CaptureCopies(SDL_Renderer *renderer, const SDL_RenderCommand *cmd,
+                              const SDL_Rect *srcrects, const SDL_FRect *dstrects, int count);
+extern void SDL_CaptureCopyEx(SDL_Renderer *renderer, const SDL_RenderCommand *cmd,
+                              const SDL_Rect *srcrect, const SDL_FRect *dstrect,
+                              double angle, const SDL_FPoint *center, SDL_RendererFlip flip);
+extern void SDL_CaptureGeometry(SDL_Renderer *renderer, const SDL_RenderCommand *cmd,
+                                const SDL_Vertex *vertices, int num_vertices,
+                                const int *indices, int num_indices);
+
+#endif /* SDL_rendercapture_c_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -61,8 +61,17 @@ struct SDL_Texture
     int pitch;
     SDL_Rect locked_rect;
 
+    /* Support for streaming textures with more than one buffer, native is the one in use */
+    SDL_Texture **buffers;
+    int num_buffers;
+
     Uint32 last_command_generation; /* last command queue generation this texture was in. */
 
+    Uint32 capture_id;          /* the id of this texture in the render capture, 0 if it has none */
+    void *capture_pixels;       /* the locked pixels, recorded when the texture is unlocked */
+    int capture_pitch;
+    SDL_Rect capture_rect;
+
     void *driverdata;           /**< Driver specific texture representation */
 
     SDL_Texture *prev;
@@ -80,7 +89,8 @@ typedef enum
     SDL_RENDERCMD_DRAW_LINES,
     SDL_RENDERCMD_FILL_RECTS,
     SDL_RENDERCMD_COPY,
-    SDL_RENDERCMD_COPY_EX
+    SDL_RENDERCMD_COPY_EX,
+    SDL_RENDERCMD_GEOMETRY
 } SDL_RenderCommandType;
 
 typedef struct SDL_RenderCommand
@@ -110,13 +120,6 @@ typedef struct SDL_RenderCommand
     struct SDL_RenderCommand *next;
 } SDL_RenderCommand;
 
-typedef struct SDL_AllocVertGap
-{
-    size_t offset;
-    size_t len;
-    struct SDL_AllocVertGap *next;
-} SDL_AllocVertGap;
-
 
 /* Define the SDL renderer structure */
 struct SDL_Renderer
@@ -137,9 +140,14 @@ struct SDL_Renderer
                             int count);
     int (*QueueCopy) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
                        const SDL_Rect * srcrect, const SDL_FRect * dstrect);
+    int (*QueueCopyBatch) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                            const SDL_Rect * srcrects, const SDL_FRect * dstrects, int count);
     int (*QueueCopyEx) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
                         const SDL_Rect * srcquad, const SDL_FRect * dstrect,
                         const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip);
+    int (*QueueGeometry) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                          const SDL_Vertex * vertices, int num_vertices, const int * indices, int num_indices,
+                          float scale_x, float scale_y);
     int (*RunCommandQueue) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize);
     int (*UpdateTexture) (SDL_Renderer * renderer, SDL_Texture * texture,
                           const SDL_Rect * rect, const void *pixels,
@@ -156,6 +164,7 @@ struct SDL_Renderer
     int (*RenderReadPixels) (SDL_Renderer * renderer, const SDL_Rect * rect,
                              Uint32 format, void * pixels, int pitch);
     void (*RenderPresent) (SDL_Renderer * renderer);
+    int (*GetDamageRects) (SDL_Renderer * renderer, SDL_Rect * rects, int maxrects);
     void (*DestroyTexture) (SDL_Renderer * renderer, SDL_Texture * texture);
 
     void (*DestroyRenderer) (SDL_Renderer * renderer);
@@ -222,12 +231,22 @@ struct SDL_Renderer
     SDL_bool color_queued;
     SDL_bool viewport_queued;
     SDL_bool cliprect_queued;
+    SDL_RenderCommand *merge_command;   /* the draw command the one being queued may be merged into */
+    size_t merge_vertex_end;            /* where the vertex data of merge_command ends */
 
-    void *vertex_data;
+    void *vertex_data;              /* bump allocated, and reset when the queue is flushed */
     size_t vertex_data_used;
     size_t vertex_data_allocation;
-    SDL_AllocVertGap vertex_data_gaps;
-    SDL_AllocVertGap *vertex_data_gaps_pool;
+
+    SDL_RenderStats stats;          /* the frame being rendered, the times are in counter ticks */
+    SDL_RenderStats last_stats;     /* the last frame presented */
+    Uint32 num_render_commands;     /* the length of the command queue */
+
+    struct SDL_RenderCapture *capture;  /* recording the render commands, see SDL_HINT_RENDER_CAPTURE_FILE */
+
+    /* Pixels to read once the commands queued before them are drawn, see SDL_RenderReadPixelsAsync() */
+    struct SDL_RenderReadback *readbacks;
+    struct SDL_RenderReadback *readbacks_tail;
 
     void *driverdata;
 };
@@ -265,6 +284,9 @@ extern SDL_BlendOperation SDL_GetBlendModeAlphaOperation(SDL_BlendMode blendMode
    the next call, because it might be in an array that gets realloc()'d. */
 extern void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes, const size_t alignment, size_t *offset);
 
+/* SDL_CreateTexture() with a scale mode other than the one SDL_HINT_RENDER_SCALE_QUALITY sets. */
+extern SDL_Texture *SDL_CreateTextureWithScaleMode(SDL_Renderer *renderer, Uint32 format, int access, int w, int h, SDL_ScaleMode scaleMode);
+
 #endif /* SDL_sysrender_h_ */
 
 /* vi: set ts=4 sw=4 expandtab: */
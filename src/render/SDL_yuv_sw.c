@@ -25,6 +25,7 @@
 #include "SDL_assert.h"
 
 #include "SDL_yuv_sw_c.h"
+#include "../video/SDL_yuv_c.h"
 
 
 SDL_SW_YUVTexture *
@@ -240,6 +241,7 @@ SDL_SW_UpdateYUVTexture(SDL_SW_YUVTexture * swdata, const SDL_Rect * rect,
             }
         }
     }
+    swdata->converted_dirty = SDL_TRUE;
     return 0;
 }
 
@@ -295,6 +297,7 @@ SDL_SW_UpdateYUVTexturePlanar(SDL_SW_YUVTexture * swdata, const SDL_Rect * rect,
         src += Vpitch;
         dst += (swdata->w + 1)/2;
     }
+    swdata->converted_dirty = SDL_TRUE;
     return 0;
 }
 
@@ -322,6 +325,7 @@ SDL_SW_LockYUVTexture(SDL_SW_YUVTexture * swdata, const SDL_Rect * rect,
         *pixels = swdata->planes[0];
     }
     *pitch = swdata->pitches[0];
+    swdata->converted_dirty = SDL_TRUE;
     return 0;
 }
 
@@ -400,6 +404,172 @@ SDL_SW_CopyYUVToRGB(SDL_SW_YUVTexture * swdata, const SDL_Rect * srcrect,
     return 0;
 }
 
+/* Whether the YUV converters can write this RGB format directly */
+SDL_bool
+SDL_SW_CanBlitYUVTexture(Uint32 dst_format)
+{
+    switch (dst_format) {
+    case SDL_PIXELFORMAT_RGB565:
+    case SDL_PIXELFORMAT_RGB24:
+    case SDL_PIXELFORMAT_RGBX8888:
+    case SDL_PIXELFORMAT_RGBA8888:
+    case SDL_PIXELFORMAT_BGRX8888:
+    case SDL_PIXELFORMAT_BGRA8888:
+    case SDL_PIXELFORMAT_RGB888:
+    case SDL_PIXELFORMAT_ARGB8888:
+    case SDL_PIXELFORMAT_BGR888:
+    case SDL_PIXELFORMAT_ABGR8888:
+        return SDL_TRUE;
+    default:
+        return SDL_FALSE;
+    }
+}
+
+/* Convert and scale (nearest neighbor) a part of the texture straight into
+   the destination surface, clipped to its clip rectangle. This returns -1
+   without touching the destination if there's no direct conversion to its
+   format, so the caller can fall back to SDL_SW_GetYUVTextureSurface().
+ */
+int
+SDL_SW_BlitYUVTexture(SDL_SW_YUVTexture * swdata, const SDL_Rect * srcrect,
+                      SDL_Surface * dst, const SDL_Rect * dstrect)
+{
+    const Uint32 dst_format = dst->format->format;
+    const int bpp = dst->format->BytesPerPixel;
+    SDL_Rect clipped, rect;
+    int incx, incy, posx, posy, first_col, last_col, row, col, pair;
+    int rows_pitch, retval = 0;
+    Uint8 *rows, *dst_row;
+
+    if (srcrect->w <= 0 || srcrect->h <= 0 ||
+        !SDL_IntersectRect(dstrect, &dst->clip_rect, &clipped)) {
+        return 0;
+    }
+
+    if (SDL_MUSTLOCK(dst) && SDL_LockSurface(dst) < 0) {
+        return -1;
+    }
+    dst_row = (Uint8 *) dst->pixels + clipped.y * dst->pitch + clipped.x * bpp;
+
+    /* Without scaling, whole runs of pixel pairs can be converted in place */
+    if (srcrect->w == dstrect->w && srcrect->h == dstrect->h) {
+        rect.x = srcrect->x + (clipped.x - dstrect->x);
+        rect.y = srcrect->y + (clipped.y - dstrect->y);
+        rect.w = clipped.w;
+        rect.h = clipped.h;
+        if (!(rect.x & 1) && !(rect.y & 1)) {
+            retval = SDL_ConvertPixels_YUV_to_RGB_Rect(swdata->w, swdata->h, swdata->format,
+                                                       swdata->planes[0], swdata->pitches[0], &rect,
+                                                       dst_format, dst_row, dst->pitch);
+            if (SDL_MUSTLOCK(dst)) {
+                SDL_UnlockSurface(dst);
+            }
+            return retval;
+        }
+    }
+
+    /* Otherwise convert the needed part of each source row pair into a
+       small buffer, and pick the destination pixels from there. */
+    incx = (srcrect->w << 16) / dstrect->w;
+    incy = (srcrect->h << 16) / dstrect->h;
+    first_col = clipped.x - dstrect->x;
+    last_col = first_col + clipped.w - 1;
+    rect.x = (srcrect->x + ((first_col * incx + incx / 2) >> 16)) & ~1;
+    rect.w = srcrect->x + ((last_col * incx + incx / 2) >> 16) - rect.x + 1;
+
+    rows_pitch = rect.w * bpp;
+    rows = (Uint8 *) SDL_malloc(2 * rows_pitch);
+    if (!rows) {
+        if (SDL_MUSTLOCK(dst)) {
+            SDL_UnlockSurface(dst);
+        }
+        return SDL_OutOfMemory();
+    }
+
+    pair = -1;
+    posy = (clipped.y - dstrect->y) * incy + incy / 2;
+    for (row = 0; row < clipped.h; ++row, posy += incy) {
+        const int sy = srcrect->y + (posy >> 16);
+        const Uint8 *src_row;
+
+        if ((sy & ~1) != pair) {
+            pair = (sy & ~1);
+            rect.y = pair;
+            rect.h = SDL_min(2, swdata->h - pair);
+            if (SDL_ConvertPixels_YUV_to_RGB_Rect(swdata->w, swdata->h, swdata->format,
+                                                  swdata->planes[0], swdata->pitches[0], &rect,
+                                                  dst_format, rows, rows_pitch) < 0) {
+                /* This can only fail on the first pair, before anything is drawn */
+                retval = -1;
+                break;
+            }
+        }
+        src_row = rows + (sy - pair) * rows_pitch;
+
+        posx = first_col * incx + incx / 2;
+        if (incx == 0x10000) {
+            SDL_memcpy(dst_row, src_row + (srcrect->x + (posx >> 16) - rect.x) * bpp, clipped.w * bpp);
+        } else {
+            switch (bpp) {
+            case 2:
+                for (col = 0; col < clipped.w; ++col, posx += incx) {
+                    ((Uint16 *) dst_row)[col] = ((const Uint16 *) src_row)[srcrect->x + (posx >> 16) - rect.x];
+                }
+                break;
+            case 3:
+                for (col = 0; col < clipped.w; ++col, posx += incx) {
+                    const Uint8 *src = src_row + (srcrect->x + (posx >> 16) - rect.x) * 3;
+                    dst_row[col * 3 + 0] = src[0];
+                    dst_row[col * 3 + 1] = src[1];
+                    dst_row[col * 3 + 2] = src[2];
+                }
+                break;
+            case 4:
+                for (col = 0; col < clipped.w; ++col, posx += incx) {
+                    ((Uint32 *) dst_row)[col] = ((const Uint32 *) src_row)[srcrect->x + (posx >> 16) - rect.x];
+                }
+                break;
+            default:
+                SDL_assert(0 && "YUV conversion to unexpected pixel size");
+                break;
+            }
+        }
+        dst_row += dst->pitch;
+    }
+    SDL_free(rows);
+
+    if (SDL_MUSTLOCK(dst)) {
+        SDL_UnlockSurface(dst);
+    }
+    return retval;
+}
+
+SDL_Surface *
+SDL_SW_GetYUVTextureSurface(SDL_SW_YUVTexture * swdata, Uint32 target_format)
+{
+    if (swdata->converted && swdata->converted->format->format != target_format) {
+        SDL_FreeSurface(swdata->converted);
+        swdata->converted = NULL;
+    }
+    if (!swdata->converted) {
+        swdata->converted = SDL_CreateRGBSurfaceWithFormat(0, swdata->w, swdata->h, 0, target_format);
+        if (!swdata->converted) {
+            return NULL;
+        }
+        swdata->converted_dirty = SDL_TRUE;
+    }
+    if (swdata->converted_dirty) {
+        if (SDL_ConvertPixels(swdata->w, swdata->h, swdata->format,
+                              swdata->planes[0], swdata->pitches[0],
+                              target_format, swdata->converted->pixels,
+                              swdata->converted->pitch) < 0) {
+            return NULL;
+        }
+        swdata->converted_dirty = SDL_FALSE;
+    }
+    return swdata->converted;
+}
+
 void
 SDL_SW_DestroyYUVTexture(SDL_SW_YUVTexture * swdata)
 {
@@ -407,6 +577,7 @@ SDL_SW_DestroyYUVTexture(SDL_SW_YUVTexture * swdata)
         SDL_free(swdata->pixels);
         SDL_FreeSurface(swdata->stretch);
         SDL_FreeSurface(swdata->display);
+        SDL_FreeSurface(swdata->converted);
         SDL_free(swdata);
     }
 }
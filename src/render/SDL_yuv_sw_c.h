@@ -42,6 +42,10 @@ struct SDL_SW_YUVTexture
     /* This is a temporary surface in case we have to stretch copy */
     SDL_Surface *stretch;
     SDL_Surface *display;
+
+    /* This is the whole texture in RGB, for blits that can't be done from YUV */
+    SDL_Surface *converted;
+    SDL_bool converted_dirty;
 };
 
 typedef struct SDL_SW_YUVTexture SDL_SW_YUVTexture;
@@ -61,6 +65,11 @@ void SDL_SW_UnlockYUVTexture(SDL_SW_YUVTexture * swdata);
 int SDL_SW_CopyYUVToRGB(SDL_SW_YUVTexture * swdata, const SDL_Rect * srcrect,
                         Uint32 target_format, int w, int h, void *pixels,
                         int pitch);
+SDL_bool SDL_SW_CanBlitYUVTexture(Uint32 dst_format);
+int SDL_SW_BlitYUVTexture(SDL_SW_YUVTexture * swdata, const SDL_Rect * srcrect,
+                          SDL_Surface * dst, const SDL_Rect * dstrect);
+SDL_Surface *SDL_SW_GetYUVTextureSurface(SDL_SW_YUVTexture * swdata,
+                                         Uint32 target_format);
 void SDL_SW_DestroyYUVTexture(SDL_SW_YUVTexture * swdata);
 
 /* FIXME: This breaks on various versions of GCC and should be rewritten using intrinsics */
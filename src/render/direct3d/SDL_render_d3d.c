@@ -856,66 +856,76 @@ D3D_QueueFillRects(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FR
 }
 
 static int
-D3D_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
-                          const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+D3D_QueueCopyBatch(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                   const SDL_Rect * srcrects, const SDL_FRect * dstrects, int count)
 {
     const DWORD color = D3DCOLOR_ARGB(cmd->data.draw.a, cmd->data.draw.r, cmd->data.draw.g, cmd->data.draw.b);
     float minx, miny, maxx, maxy;
     float minu, maxu, minv, maxv;
-    const size_t vertslen = sizeof (Vertex) * 4;
+    const size_t vertslen = sizeof (Vertex) * 4 * count;
     Vertex *verts = (Vertex *) SDL_AllocateRenderVertices(renderer, vertslen, 0, &cmd->data.draw.first);
+    int i;
 
     if (!verts) {
         return -1;
     }
 
-    cmd->data.draw.count = 1;
+    cmd->data.draw.count = count;
 
-    minx = dstrect->x - 0.5f;
-    miny = dstrect->y - 0.5f;
-    maxx = dstrect->x + dstrect->w - 0.5f;
-    maxy = dstrect->y + dstrect->h - 0.5f;
+    for (i = 0; i < count; i++, srcrects++, dstrects++) {
+        minx = dstrects->x - 0.5f;
+        miny = dstrects->y - 0.5f;
+        maxx = dstrects->x + dstrects->w - 0.5f;
+        maxy = dstrects->y + dstrects->h - 0.5f;
 
-    minu = (float) srcrect->x / texture->w;
-    maxu = (float) (srcrect->x + srcrect->w) / texture->w;
-    minv = (float) srcrect->y / texture->h;
-    maxv = (float) (srcrect->y + srcrect->h) / texture->h;
+        minu = (float) srcrects->x / texture->w;
+        maxu = (float) (srcrects->x + srcrects->w) / texture->w;
+        minv = (float) srcrects->y / texture->h;
+        maxv = (float) (srcrects->y + srcrects->h) / texture->h;
 
-    verts->x = minx;
-    verts->y = miny;
-    verts->z = 0.0f;
-    verts->color = color;
-    verts->u = minu;
-    verts->v = minv;
-    verts++;
+        verts->x = minx;
+        verts->y = miny;
+        verts->z = 0.0f;
+        verts->color = color;
+        verts->u = minu;
+        verts->v = minv;
+        verts++;
 
-    verts->x = maxx;
-    verts->y = miny;
-    verts->z = 0.0f;
-    verts->color = color;
-    verts->u = maxu;
-    verts->v = minv;
-    verts++;
+        verts->x = maxx;
+        verts->y = miny;
+        verts->z = 0.0f;
+        verts->color = color;
+        verts->u = maxu;
+        verts->v = minv;
+        verts++;
 
-    verts->x = maxx;
-    verts->y = maxy;
-    verts->z = 0.0f;
-    verts->color = color;
-    verts->u = maxu;
-    verts->v = maxv;
-    verts++;
+        verts->x = maxx;
+        verts->y = maxy;
+        verts->z = 0.0f;
+        verts->color = color;
+        verts->u = maxu;
+        verts->v = maxv;
+        verts++;
 
-    verts->x = minx;
-    verts->y = maxy;
-    verts->z = 0.0f;
-    verts->color = color;
-    verts->u = minu;
-    verts->v = maxv;
-    verts++;
+        verts->x = minx;
+        verts->y = maxy;
+        verts->z = 0.0f;
+        verts->color = color;
+        verts->u = minu;
+        verts->v = maxv;
+        verts++;
+    }
 
     return 0;
 }
 
+static int
+D3D_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                          const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+{
+    return D3D_QueueCopyBatch(renderer, cmd, texture, srcrect, dstrect, 1);
+}
+
 static int
 D3D_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
                         const SDL_Rect * srcquad, const SDL_FRect * dstrect,
@@ -1402,6 +1412,7 @@ D3D_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *verti
                 break;
             }
 
+            case SDL_RENDERCMD_GEOMETRY:  /* QueueGeometry isn't implemented. */
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
@@ -1675,6 +1686,7 @@ D3D_CreateRenderer(SDL_Window * window, Uint32 flags)
     renderer->QueueDrawLines = D3D_QueueDrawPoints;  /* lines and points queue vertices the same way. */
     renderer->QueueFillRects = D3D_QueueFillRects;
     renderer->QueueCopy = D3D_QueueCopy;
+    renderer->QueueCopyBatch = D3D_QueueCopyBatch;
     renderer->QueueCopyEx = D3D_QueueCopyEx;
     renderer->RunCommandQueue = D3D_RunCommandQueue;
     renderer->RenderReadPixels = D3D_RenderReadPixels;
@@ -1649,72 +1649,84 @@ D3D11_QueueFillRects(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_
 }
 
 static int
-D3D11_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
-             const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+D3D11_QueueCopyBatch(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                     const SDL_Rect * srcrects, const SDL_FRect * dstrects, int count)
 {
-    VertexPositionColor *verts = (VertexPositionColor *) SDL_AllocateRenderVertices(renderer, 4 * sizeof (VertexPositionColor), 0, &cmd->data.draw.first);
+    VertexPositionColor *verts = (VertexPositionColor *) SDL_AllocateRenderVertices(renderer, count * 4 * sizeof (VertexPositionColor), 0, &cmd->data.draw.first);
     const float r = (float)(cmd->data.draw.r / 255.0f);
     const float g = (float)(cmd->data.draw.g / 255.0f);
     const float b = (float)(cmd->data.draw.b / 255.0f);
     const float a = (float)(cmd->data.draw.a / 255.0f);
-    const float minu = (float) srcrect->x / texture->w;
-    const float maxu = (float) (srcrect->x + srcrect->w) / texture->w;
-    const float minv = (float) srcrect->y / texture->h;
-    const float maxv = (float) (srcrect->y + srcrect->h) / texture->h;
+    float minu, maxu, minv, maxv;
+    int i;
 
     if (!verts) {
         return -1;
     }
 
-    cmd->data.draw.count = 1;
+    cmd->data.draw.count = count;
 
-    verts->pos.x = dstrect->x;
-    verts->pos.y = dstrect->y;
-    verts->pos.z = 0.0f;
-    verts->tex.x = minu;
-    verts->tex.y = minv;
-    verts->color.x = r;
-    verts->color.y = g;
-    verts->color.z = b;
-    verts->color.w = a;
-    verts++;
+    for (i = 0; i < count; i++, srcrects++, dstrects++) {
+        minu = (float) srcrects->x / texture->w;
+        maxu = (float) (srcrects->x + srcrects->w) / texture->w;
+        minv = (float) srcrects->y / texture->h;
+        maxv = (float) (srcrects->y + srcrects->h) / texture->h;
 
-    verts->pos.x = dstrect->x;
-    verts->pos.y = dstrect->y + dstrect->h;
-    verts->pos.z = 0.0f;
-    verts->tex.x = minu;
-    verts->tex.y = maxv;
-    verts->color.x = r;
-    verts->color.y = g;
-    verts->color.z = b;
-    verts->color.w = a;
-    verts++;
+        verts->pos.x = dstrects->x;
+        verts->pos.y = dstrects->y;
+        verts->pos.z = 0.0f;
+        verts->tex.x = minu;
+        verts->tex.y = minv;
+        verts->color.x = r;
+        verts->color.y = g;
+        verts->color.z = b;
+        verts->color.w = a;
+        verts++;
 
-    verts->pos.x = dstrect->x + dstrect->w;
-    verts->pos.y = dstrect->y;
-    verts->pos.z = 0.0f;
-    verts->tex.x = maxu;
-    verts->tex.y = minv;
-    verts->color.x = r;
-    verts->color.y = g;
-    verts->color.z = b;
-    verts->color.w = a;
-    verts++;
+        verts->pos.x = dstrects->x;
+        verts->pos.y = dstrects->y + dstrects->h;
+        verts->pos.z = 0.0f;
+        verts->tex.x = minu;
+        verts->tex.y = maxv;
+        verts->color.x = r;
+        verts->color.y = g;
+        verts->color.z = b;
+        verts->color.w = a;
+        verts++;
 
-    verts->pos.x = dstrect->x + dstrect->w;
-    verts->pos.y = dstrect->y + dstrect->h;
-    verts->pos.z = 0.0f;
-    verts->tex.x = maxu;
-    verts->tex.y = maxv;
-    verts->color.x = r;
-    verts->color.y = g;
-    verts->color.z = b;
-    verts->color.w = a;
-    verts++;
+        verts->pos.x = dstrects->x + dstrects->w;
+        verts->pos.y = dstrects->y;
+        verts->pos.z = 0.0f;
+        verts->tex.x = maxu;
+        verts->tex.y = minv;
+        verts->color.x = r;
+        verts->color.y = g;
+        verts->color.z = b;
+        verts->color.w = a;
+        verts++;
+
+        verts->pos.x = dstrects->x + dstrects->w;
+        verts->pos.y = dstrects->y + dstrects->h;
+        verts->pos.z = 0.0f;
+        verts->tex.x = maxu;
+        verts->tex.y = maxv;
+        verts->color.x = r;
+        verts->color.y = g;
+        verts->color.z = b;
+        verts->color.w = a;
+        verts++;
+    }
 
     return 0;
 }
 
+static int
+D3D11_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+             const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+{
+    return D3D11_QueueCopyBatch(renderer, cmd, texture, srcrect, dstrect, 1);
+}
+
 static int
 D3D11_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
                const SDL_Rect * srcrect, const SDL_FRect * dstrect,
@@ -2264,10 +2276,13 @@ D3D11_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *ver
             }
 
             case SDL_RENDERCMD_COPY: {
+                const size_t count = cmd->data.draw.count;
                 const size_t first = cmd->data.draw.first;
                 const size_t start = first / sizeof (VertexPositionColor);
                 D3D11_SetCopyState(renderer, cmd, NULL);
-                D3D11_DrawPrimitives(renderer, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP, start, 4);
+                for (i = 0; i < count; i++) {
+                    D3D11_DrawPrimitives(renderer, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP, start + (i * 4), 4);
+                }
                 break;
             }
 
@@ -2285,6 +2300,7 @@ D3D11_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *ver
                 break;
             }
 
+            case SDL_RENDERCMD_GEOMETRY:  /* QueueGeometry isn't implemented. */
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
@@ -2493,6 +2509,7 @@ D3D11_CreateRenderer(SDL_Window * window, Uint32 flags)
     renderer->QueueDrawLines = D3D11_QueueDrawPoints;  /* lines and points queue vertices the same way. */
     renderer->QueueFillRects = D3D11_QueueFillRects;
     renderer->QueueCopy = D3D11_QueueCopy;
+    renderer->QueueCopyBatch = D3D11_QueueCopyBatch;
     renderer->QueueCopyEx = D3D11_QueueCopyEx;
     renderer->RunCommandQueue = D3D11_RunCommandQueue;
     renderer->RenderReadPixels = D3D11_RenderReadPixels;
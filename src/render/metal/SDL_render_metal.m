@@ -986,23 +986,38 @@ METAL_QueueDrawPoints(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL
 static int
 METAL_QueueFillRects(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FRect * rects, int count)
 {
-    const size_t vertlen = (sizeof (float) * 8) * count;
-    float *verts = (float *) SDL_AllocateRenderVertices(renderer, vertlen, 0, &cmd->data.draw.first);
+    size_t vertlen;
+    float *verts;
+    int numrects = 0;
+
+    /* Only allocate for the rects that are drawn, so the vertex data holds
+     * exactly draw.count quads and the command can be merged with others. */
+    for (int i = 0; i < count; i++) {
+        if ((rects[i].w > 0.0f) && (rects[i].h > 0.0f)) {
+            numrects++;
+        }
+    }
+
+    cmd->data.draw.count = numrects;
+
+    if (numrects == 0) {
+        cmd->command = SDL_RENDERCMD_NO_OP;  // nothing to do, just skip this one later.
+        return 0;
+    }
+
+    vertlen = (sizeof (float) * 8) * numrects;
+    verts = (float *) SDL_AllocateRenderVertices(renderer, vertlen, 0, &cmd->data.draw.first);
     if (!verts) {
         return -1;
     }
 
-    cmd->data.draw.count = count;
-
     /* Quads in the following vertex order (matches the quad index buffer):
      * 1---3
      * | \ |
      * 0---2
      */
     for (int i = 0; i < count; i++, rects++) {
-        if ((rects->w <= 0.0f) || (rects->h <= 0.0f)) {
-            cmd->data.draw.count--;
-        } else {
+        if ((rects->w > 0.0f) && (rects->h > 0.0f)) {
             *(verts++) = rects->x;
             *(verts++) = rects->y + rects->h;
             *(verts++) = rects->x;
@@ -1014,10 +1029,6 @@ METAL_QueueFillRects(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_
         }
     }
 
-    if (cmd->data.draw.count == 0) {
-        cmd->command = SDL_RENDERCMD_NO_OP;  // nothing to do, just skip this one later.
-    }
-
     return 0;
 }
 
@@ -1383,6 +1394,7 @@ METAL_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *ver
                 break;
             }
 
+            case SDL_RENDERCMD_GEOMETRY:  /* QueueGeometry isn't implemented. */
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
@@ -580,55 +580,65 @@ GLES_QueueFillRects(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_F
 }
 
 static int
-GLES_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
-                          const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+GLES_QueueCopyBatch(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                    const SDL_Rect * srcrects, const SDL_FRect * dstrects, int count)
 {
     GLES_TextureData *texturedata = (GLES_TextureData *) texture->driverdata;
     GLfloat minx, miny, maxx, maxy;
     GLfloat minu, maxu, minv, maxv;
-    GLfloat *verts = (GLfloat *) SDL_AllocateRenderVertices(renderer, 16 * sizeof (GLfloat), 0, &cmd->data.draw.first);
+    GLfloat *verts = (GLfloat *) SDL_AllocateRenderVertices(renderer, count * 16 * sizeof (GLfloat), 0, &cmd->data.draw.first);
+    int i;
 
     if (!verts) {
         return -1;
     }
 
-    cmd->data.draw.count = 1;
+    cmd->data.draw.count = count;
 
-    minx = dstrect->x;
-    miny = dstrect->y;
-    maxx = dstrect->x + dstrect->w;
-    maxy = dstrect->y + dstrect->h;
+    for (i = 0; i < count; i++, srcrects++, dstrects++) {
+        minx = dstrects->x;
+        miny = dstrects->y;
+        maxx = dstrects->x + dstrects->w;
+        maxy = dstrects->y + dstrects->h;
+
+        minu = (GLfloat) srcrects->x / texture->w;
+        minu *= texturedata->texw;
+        maxu = (GLfloat) (srcrects->x + srcrects->w) / texture->w;
+        maxu *= texturedata->texw;
+        minv = (GLfloat) srcrects->y / texture->h;
+        minv *= texturedata->texh;
+        maxv = (GLfloat) (srcrects->y + srcrects->h) / texture->h;
+        maxv *= texturedata->texh;
 
-    minu = (GLfloat) srcrect->x / texture->w;
-    minu *= texturedata->texw;
-    maxu = (GLfloat) (srcrect->x + srcrect->w) / texture->w;
-    maxu *= texturedata->texw;
-    minv = (GLfloat) srcrect->y / texture->h;
-    minv *= texturedata->texh;
-    maxv = (GLfloat) (srcrect->y + srcrect->h) / texture->h;
-    maxv *= texturedata->texh;
-
-    *(verts++) = minx;
-    *(verts++) = miny;
-    *(verts++) = maxx;
-    *(verts++) = miny;
-    *(verts++) = minx;
-    *(verts++) = maxy;
-    *(verts++) = maxx;
-    *(verts++) = maxy;
+        *(verts++) = minx;
+        *(verts++) = miny;
+        *(verts++) = maxx;
+        *(verts++) = miny;
+        *(verts++) = minx;
+        *(verts++) = maxy;
+        *(verts++) = maxx;
+        *(verts++) = maxy;
 
-    *(verts++) = minu;
-    *(verts++) = minv;
-    *(verts++) = maxu;
-    *(verts++) = minv;
-    *(verts++) = minu;
-    *(verts++) = maxv;
-    *(verts++) = maxu;
-    *(verts++) = maxv;
+        *(verts++) = minu;
+        *(verts++) = minv;
+        *(verts++) = maxu;
+        *(verts++) = minv;
+        *(verts++) = minu;
+        *(verts++) = maxv;
+        *(verts++) = maxu;
+        *(verts++) = maxv;
+    }
 
     return 0;
 }
 
+static int
+GLES_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                          const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+{
+    return GLES_QueueCopyBatch(renderer, cmd, texture, srcrect, dstrect, 1);
+}
+
 static int
 GLES_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
                         const SDL_Rect * srcquad, const SDL_FRect * dstrect,
@@ -915,10 +925,14 @@ GLES_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vert
 
             case SDL_RENDERCMD_COPY: {
                 const GLfloat *verts = (GLfloat *) (((Uint8 *) vertices) + cmd->data.draw.first);
+                const size_t count = cmd->data.draw.count;
                 SetCopyState(data, cmd);
                 data->glVertexPointer(2, GL_FLOAT, 0, verts);
                 data->glTexCoordPointer(2, GL_FLOAT, 0, verts + 8);
-                data->glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+                /* each copy is 8 vertices long, the positions followed by the texture coordinates */
+                for (i = 0; i < count; i++) {
+                    data->glDrawArrays(GL_TRIANGLE_STRIP, (GLint) (i * 8), 4);
+                }
                 break;
             }
 
@@ -940,6 +954,7 @@ GLES_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vert
                 break;
             }
 
+            case SDL_RENDERCMD_GEOMETRY:  /* QueueGeometry isn't implemented. */
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
@@ -1148,6 +1163,7 @@ GLES_CreateRenderer(SDL_Window * window, Uint32 flags)
     renderer->QueueDrawLines = GLES_QueueDrawPoints;  /* lines and points queue vertices the same way. */
     renderer->QueueFillRects = GLES_QueueFillRects;
     renderer->QueueCopy = GLES_QueueCopy;
+    renderer->QueueCopyBatch = GLES_QueueCopyBatch;
     renderer->QueueCopyEx = GLES_QueueCopyEx;
     renderer->RunCommandQueue = GLES_RunCommandQueue;
     renderer->RenderReadPixels = GLES_RenderReadPixels;
@@ -23,9 +23,12 @@
 #if !SDL_RENDER_DISABLED
 
 #include "../SDL_sysrender.h"
+#include "../SDL_yuv_sw_c.h"
 #include "SDL_render_sw_c.h"
 #include "SDL_hints.h"
 #include "SDL_assert.h"
+#include "SDL_cpuinfo.h"
+#include "../../SDL_workerpool.h"
 
 #include "SDL_draw.h"
 #include "SDL_blendfillrect.h"
@@ -34,13 +37,89 @@
 #include "SDL_drawline.h"
 #include "SDL_drawpoint.h"
 #include "SDL_rotate.h"
+#include "SDL_triangle.h"
 
 /* SDL surface based renderer implementation */
 
+typedef struct SW_TileCommand SW_TileCommand;
+
+/* The changed parts of the window are kept as up to this many rectangles */
+#define SW_MAX_DAMAGE_RECTS             8
+
+/* A rotated copy of a texture, see SW_RenderCopyEx() */
+#define SW_ROTATED_CACHE_SIZE           16
+#define SW_ROTATED_CACHE_MAX_PIXELS     (512 * 512)
+
+typedef struct
+{
+    SDL_Texture *texture;       /* NULL if the entry is unused */
+    SDL_Rect srcrect;
+    int w, h;
+    double angle;
+    SDL_RendererFlip flip;
+    SDL_ScaleMode scaleMode;
+    SDL_BlendMode blendmode;
+    Uint32 modulation;          /* the RGBA modulation applied before the rotation */
+    SDL_Surface *rotated;
+    SDL_Surface *mask;          /* the rotated mask for the NONE blend mode, or NULL */
+    Uint32 last_used;
+} SW_RotatedSurface;
+
+/* An ARGB8888 copy of a texture drawn as geometry, see SW_GetTriangleSource() */
+#define SW_CONVERTED_CACHE_SIZE         16
+
+typedef struct
+{
+    SDL_Texture *texture;       /* NULL if the entry is unused */
+    SDL_Surface *converted;
+} SW_ConvertedSurface;
+
+/* The vertex data of a viewport command, see SW_QueueSetViewport() */
+typedef struct
+{
+    SDL_Rect rect;              /* the viewport in the pixels of the surface drawn to */
+    int upscale;                /* the scale the drawing is upscaled by, or 0 */
+    SDL_Rect upscale_rect;      /* where the upscaled drawing goes in the window */
+} SW_Viewport;
+
 typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+
+    /* Tiled rendering on worker threads */
+    SDL_WorkerPool *pool;
+    int threads;
+    SW_TileCommand *tile_cmds;
+    int tile_cmds_max;
+    int *tile_bins;
+    int tile_bins_max;
+    int *tile_items;
+    int tile_items_max;
+
+    /* Rotated copies of textures */
+    SW_RotatedSurface rotated_cache[SW_ROTATED_CACHE_SIZE];
+    Uint32 rotated_clock;
+
+    /* Textures converted for the triangle rasterizer */
+    SW_ConvertedSurface converted_cache[SW_CONVERTED_CACHE_SIZE];
+
+    /* The parts of the window drawn to since the last present, see SW_AddDamage() */
+    SDL_Rect damage[SW_MAX_DAMAGE_RECTS];
+    int num_damage;
+    SDL_bool damage_all;    /* the whole window has to be presented */
+    SDL_Rect presented_damage[SW_MAX_DAMAGE_RECTS];
+    int num_presented_damage;
+
+    /* Drawing at the logical size, see SW_GetUpscale() */
+    SDL_bool upscale_enabled;
+    SW_Viewport queue_viewport; /* the viewport the commands are queued for */
+    SDL_Surface *upscale;
+    int upscale_factor;
+    SDL_Rect upscale_rect;
+    SDL_Rect upscale_damage[SW_MAX_DAMAGE_RECTS];
+    int num_upscale_damage;
+    SDL_bool upscale_damage_all;
 } SW_RenderData;
 
 
@@ -69,6 +148,10 @@ SW_WindowEvent(SDL_Renderer * renderer, const SDL_WindowEvent *event)
     if (event->event == SDL_WINDOWEVENT_SIZE_CHANGED) {
         data->surface = NULL;
         data->window = NULL;
+        data->damage_all = SDL_TRUE;
+    } else if (event->event == SDL_WINDOWEVENT_EXPOSED) {
+        /* The window system may have lost what was presented before */
+        data->damage_all = SDL_TRUE;
     }
 }
 
@@ -91,12 +174,70 @@ SW_GetOutputSize(SDL_Renderer * renderer, int *w, int *h)
     }
 }
 
+/* YUV textures are kept as YUV data, so they can be converted directly to the
+   render target. This returns an RGB copy of them for the blits that need one.
+ */
+static SDL_Surface *
+SW_GetTextureSurface(SDL_Texture * texture)
+{
+    if (SDL_ISPIXELFORMAT_FOURCC(texture->format)) {
+        return SDL_SW_GetYUVTextureSurface((SDL_SW_YUVTexture *) texture->driverdata,
+                                           SDL_PIXELFORMAT_ARGB8888);
+    }
+    return (SDL_Surface *) texture->driverdata;
+}
+
+static void
+SW_FreeRotatedSurface(SW_RotatedSurface *entry)
+{
+    SDL_FreeSurface(entry->rotated);
+    SDL_FreeSurface(entry->mask);
+    SDL_zerop(entry);
+}
+
+static void
+SW_FreeConvertedSurface(SW_ConvertedSurface *entry)
+{
+    SDL_FreeSurface(entry->converted);
+    SDL_zerop(entry);
+}
+
+/* Drops the cached rotated and converted copies of a texture, its pixels have changed */
+static void
+SW_InvalidateTextureCaches(SDL_Renderer * renderer, const SDL_Texture * texture)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    int i;
+
+    for (i = 0; i < SW_ROTATED_CACHE_SIZE; ++i) {
+        if (data->rotated_cache[i].texture == texture) {
+            SW_FreeRotatedSurface(&data->rotated_cache[i]);
+        }
+    }
+    for (i = 0; i < SW_CONVERTED_CACHE_SIZE; ++i) {
+        if (data->converted_cache[i].texture == texture) {
+            SW_FreeConvertedSurface(&data->converted_cache[i]);
+        }
+    }
+}
+
 static int
 SW_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 {
     int bpp;
     Uint32 Rmask, Gmask, Bmask, Amask;
 
+    if (SDL_ISPIXELFORMAT_FOURCC(texture->format)) {
+        if (texture->access == SDL_TEXTUREACCESS_TARGET) {
+            return SDL_SetError("YUV textures can't be render targets");
+        }
+        texture->driverdata = SDL_SW_CreateYUVTexture(texture->format, texture->w, texture->h);
+        if (!texture->driverdata) {
+            return -1;
+        }
+        return 0;
+    }
+
     if (!SDL_PixelFormatEnumToMasks
         (texture->format, &bpp, &Rmask, &Gmask, &Bmask, &Amask)) {
         return SDL_SetError("Unknown texture format");
@@ -132,6 +273,12 @@ SW_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
     int row;
     size_t length;
 
+    SW_InvalidateTextureCaches(renderer, texture);
+
+    if (SDL_ISPIXELFORMAT_FOURCC(texture->format)) {
+        return SDL_SW_UpdateYUVTexture((SDL_SW_YUVTexture *) texture->driverdata, rect, pixels, pitch);
+    }
+
     if(SDL_MUSTLOCK(surface))
         SDL_LockSurface(surface);
     src = (Uint8 *) pixels;
@@ -149,12 +296,31 @@ SW_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
     return 0;
 }
 
+static int
+SW_UpdateTextureYUV(SDL_Renderer * renderer, SDL_Texture * texture,
+                    const SDL_Rect * rect,
+                    const Uint8 *Yplane, int Ypitch,
+                    const Uint8 *Uplane, int Upitch,
+                    const Uint8 *Vplane, int Vpitch)
+{
+    SW_InvalidateTextureCaches(renderer, texture);
+
+    return SDL_SW_UpdateYUVTexturePlanar((SDL_SW_YUVTexture *) texture->driverdata, rect,
+                                         Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
+}
+
 static int
 SW_LockTexture(SDL_Renderer * renderer, SDL_Texture * texture,
                const SDL_Rect * rect, void **pixels, int *pitch)
 {
     SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
 
+    SW_InvalidateTextureCaches(renderer, texture);
+
+    if (SDL_ISPIXELFORMAT_FOURCC(texture->format)) {
+        return SDL_SW_LockYUVTexture((SDL_SW_YUVTexture *) texture->driverdata, rect, pixels, pitch);
+    }
+
     *pixels =
         (void *) ((Uint8 *) surface->pixels + rect->y * surface->pitch +
                   rect->x * surface->format->BytesPerPixel);
@@ -165,6 +331,11 @@ SW_LockTexture(SDL_Renderer * renderer, SDL_Texture * texture,
 static void
 SW_UnlockTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 {
+    SW_InvalidateTextureCaches(renderer, texture);
+
+    if (SDL_ISPIXELFORMAT_FOURCC(texture->format)) {
+        SDL_SW_UnlockYUVTexture((SDL_SW_YUVTexture *) texture->driverdata);
+    }
 }
 
 static int
@@ -180,8 +351,82 @@ SW_SetRenderTarget(SDL_Renderer * renderer, SDL_Texture * texture)
     return 0;
 }
 
+/* Drawing with an integer scale at the logical size can go to a surface of
+   the logical size instead, which is upscaled to the window when it's shown.
+   This returns the scale for the current viewport, or 0 to draw directly.
+ */
+static int
+SW_GetUpscale(SDL_Renderer * renderer, SDL_Rect *upscale_rect)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    const SDL_Rect *viewport = &renderer->viewport;
+    SDL_Surface *window;
+    int upscale;
+
+    if (!data->upscale_enabled || renderer->target ||
+        !renderer->logical_w || !renderer->logical_h || !renderer->integer_scale) {
+        return 0;
+    }
+    upscale = (int) renderer->scale.x;
+    if (upscale < 2 || renderer->scale.x != (float) upscale || renderer->scale.y != (float) upscale) {
+        return 0;
+    }
+
+    window = SW_ActivateRenderer(renderer);
+    if (!window || SDL_MUSTLOCK(window) || SDL_ISPIXELFORMAT_INDEXED(window->format->format)) {
+        return 0;
+    }
+
+    /* This is where SDL_RenderSetLogicalSize() puts the logical output */
+    upscale_rect->w = renderer->logical_w * upscale;
+    upscale_rect->h = renderer->logical_h * upscale;
+    upscale_rect->x = (window->w - upscale_rect->w) / 2;
+    upscale_rect->y = (window->h - upscale_rect->h) / 2;
+    if (upscale_rect->x < 0 || upscale_rect->y < 0) {
+        return 0;
+    }
+
+    /* The viewport has to be inside it, on whole logical pixels */
+    if (viewport->x < upscale_rect->x || viewport->y < upscale_rect->y ||
+        viewport->x + viewport->w > upscale_rect->x + upscale_rect->w ||
+        viewport->y + viewport->h > upscale_rect->y + upscale_rect->h ||
+        ((viewport->x - upscale_rect->x) % upscale) != 0 ||
+        ((viewport->y - upscale_rect->y) % upscale) != 0 ||
+        (viewport->w % upscale) != 0 || (viewport->h % upscale) != 0) {
+        return 0;
+    }
+    return upscale;
+}
+
 static int
 SW_QueueSetViewport(SDL_Renderer * renderer, SDL_RenderCommand *cmd)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SW_Viewport *verts = (SW_Viewport *) SDL_AllocateRenderVertices(renderer, sizeof (SW_Viewport), 0, &cmd->data.viewport.first);
+
+    if (!verts) {
+        return -1;
+    }
+
+    SDL_zerop(verts);
+    verts->upscale = SW_GetUpscale(renderer, &verts->upscale_rect);
+    if (verts->upscale) {
+        verts->rect.x = (renderer->viewport.x - verts->upscale_rect.x) / verts->upscale;
+        verts->rect.y = (renderer->viewport.y - verts->upscale_rect.y) / verts->upscale;
+        verts->rect.w = renderer->viewport.w / verts->upscale;
+        verts->rect.h = renderer->viewport.h / verts->upscale;
+    } else {
+        verts->rect = renderer->viewport;
+    }
+
+    /* The commands queued next are drawn in this viewport */
+    data->queue_viewport = *verts;
+
+    return 0;
+}
+
+static int
+SW_QueueSetDrawColor(SDL_Renderer * renderer, SDL_RenderCommand *cmd)
 {
     return 0;  /* nothing to do in this backend. */
 }
@@ -189,6 +434,7 @@ SW_QueueSetViewport(SDL_Renderer * renderer, SDL_RenderCommand *cmd)
 static int
 SW_QueueDrawPoints(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FPoint * points, int count)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Point *verts = (SDL_Point *) SDL_AllocateRenderVertices(renderer, count * sizeof (SDL_Point), 0, &cmd->data.draw.first);
     int i;
 
@@ -198,7 +444,15 @@ SW_QueueDrawPoints(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FP
 
     cmd->data.draw.count = count;
 
-    if (renderer->viewport.x || renderer->viewport.y) {
+    if (data->queue_viewport.upscale) {
+        const float x = (float) data->queue_viewport.rect.x;
+        const float y = (float) data->queue_viewport.rect.y;
+        const float upscale = (float) data->queue_viewport.upscale;
+        for (i = 0; i < count; i++, verts++, points++) {
+            verts->x = (int)(x + points->x / upscale);
+            verts->y = (int)(y + points->y / upscale);
+        }
+    } else if (renderer->viewport.x || renderer->viewport.y) {
         const int x = renderer->viewport.x;
         const int y = renderer->viewport.y;
         for (i = 0; i < count; i++, verts++, points++) {
@@ -218,6 +472,7 @@ SW_QueueDrawPoints(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FP
 static int
 SW_QueueFillRects(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FRect * rects, int count)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Rect *verts = (SDL_Rect *) SDL_AllocateRenderVertices(renderer, count * sizeof (SDL_Rect), 0, &cmd->data.draw.first);
     int i;
 
@@ -227,7 +482,18 @@ SW_QueueFillRects(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FRe
 
     cmd->data.draw.count = count;
 
-    if (renderer->viewport.x || renderer->viewport.y) {
+    if (data->queue_viewport.upscale) {
+        const float x = (float) data->queue_viewport.rect.x;
+        const float y = (float) data->queue_viewport.rect.y;
+        const float upscale = (float) data->queue_viewport.upscale;
+
+        for (i = 0; i < count; i++, verts++, rects++) {
+            verts->x = (int)(x + rects->x / upscale);
+            verts->y = (int)(y + rects->y / upscale);
+            verts->w = SDL_max((int)(rects->w / upscale), 1);
+            verts->h = SDL_max((int)(rects->h / upscale), 1);
+        }
+    } else if (renderer->viewport.x || renderer->viewport.y) {
         const int x = renderer->viewport.x;
         const int y = renderer->viewport.y;
 
@@ -250,33 +516,53 @@ SW_QueueFillRects(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FRe
 }
 
 static int
-SW_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
-             const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+SW_QueueCopyBatch(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                  const SDL_Rect * srcrects, const SDL_FRect * dstrects, int count)
 {
-    SDL_Rect *verts = (SDL_Rect *) SDL_AllocateRenderVertices(renderer, 2 * sizeof (SDL_Rect), 0, &cmd->data.draw.first);
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SDL_Rect *verts = (SDL_Rect *) SDL_AllocateRenderVertices(renderer, count * 2 * sizeof (SDL_Rect), 0, &cmd->data.draw.first);
+    int i;
 
     if (!verts) {
         return -1;
     }
 
-    cmd->data.draw.count = 1;
+    cmd->data.draw.count = count;
 
-    SDL_memcpy(verts, srcrect, sizeof (SDL_Rect));
-    verts++;
+    for (i = 0; i < count; i++, srcrects++, dstrects++) {
+        SDL_memcpy(verts, srcrects, sizeof (SDL_Rect));
+        verts++;
 
-    if (renderer->viewport.x || renderer->viewport.y) {
-        verts->x = (int)(renderer->viewport.x + dstrect->x);
-        verts->y = (int)(renderer->viewport.y + dstrect->y);
-    } else {
-        verts->x = (int)dstrect->x;
-        verts->y = (int)dstrect->y;
+        if (data->queue_viewport.upscale) {
+            const float upscale = (float) data->queue_viewport.upscale;
+            verts->x = (int)(data->queue_viewport.rect.x + dstrects->x / upscale);
+            verts->y = (int)(data->queue_viewport.rect.y + dstrects->y / upscale);
+            verts->w = (int)(dstrects->w / upscale);
+            verts->h = (int)(dstrects->h / upscale);
+        } else {
+            if (renderer->viewport.x || renderer->viewport.y) {
+                verts->x = (int)(renderer->viewport.x + dstrects->x);
+                verts->y = (int)(renderer->viewport.y + dstrects->y);
+            } else {
+                verts->x = (int)dstrects->x;
+                verts->y = (int)dstrects->y;
+            }
+            verts->w = (int)dstrects->w;
+            verts->h = (int)dstrects->h;
+        }
+        verts++;
     }
-    verts->w = (int)dstrect->w;
-    verts->h = (int)dstrect->h;
 
     return 0;
 }
 
+static int
+SW_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+             const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+{
+    return SW_QueueCopyBatch(renderer, cmd, texture, srcrect, dstrect, 1);
+}
+
 typedef struct CopyExData
 {
     SDL_Rect srcrect;
@@ -291,6 +577,7 @@ SW_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * te
                const SDL_Rect * srcrect, const SDL_FRect * dstrect,
                const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     CopyExData *verts = (CopyExData *) SDL_AllocateRenderVertices(renderer, sizeof (CopyExData), 0, &cmd->data.draw.first);
 
     if (!verts) {
@@ -301,42 +588,294 @@ SW_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * te
 
     SDL_memcpy(&verts->srcrect, srcrect, sizeof (SDL_Rect));
 
-    if (renderer->viewport.x || renderer->viewport.y) {
-        verts->dstrect.x = (int)(renderer->viewport.x + dstrect->x);
-        verts->dstrect.y = (int)(renderer->viewport.y + dstrect->y);
+    if (data->queue_viewport.upscale) {
+        const float upscale = (float) data->queue_viewport.upscale;
+        verts->dstrect.x = (int)(data->queue_viewport.rect.x + dstrect->x / upscale);
+        verts->dstrect.y = (int)(data->queue_viewport.rect.y + dstrect->y / upscale);
+        verts->dstrect.w = (int)(dstrect->w / upscale);
+        verts->dstrect.h = (int)(dstrect->h / upscale);
+        verts->center.x = center->x / upscale;
+        verts->center.y = center->y / upscale;
     } else {
-        verts->dstrect.x = (int)dstrect->x;
-        verts->dstrect.y = (int)dstrect->y;
+        if (renderer->viewport.x || renderer->viewport.y) {
+            verts->dstrect.x = (int)(renderer->viewport.x + dstrect->x);
+            verts->dstrect.y = (int)(renderer->viewport.y + dstrect->y);
+        } else {
+            verts->dstrect.x = (int)dstrect->x;
+            verts->dstrect.y = (int)dstrect->y;
+        }
+        verts->dstrect.w = (int)dstrect->w;
+        verts->dstrect.h = (int)dstrect->h;
+        SDL_memcpy(&verts->center, center, sizeof (SDL_FPoint));
     }
-    verts->dstrect.w = (int)dstrect->w;
-    verts->dstrect.h = (int)dstrect->h;
     verts->angle = angle;
-    SDL_memcpy(&verts->center, center, sizeof (SDL_FPoint));
     verts->flip = flip;
 
     return 0;
 }
 
 static int
-SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * texture,
-                const SDL_Rect * srcrect, const SDL_Rect * final_rect,
-                const double angle, const SDL_FPoint * center, const SDL_RendererFlip flip)
+SW_QueueGeometry(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                 const SDL_Vertex * vertices, int num_vertices, const int * indices, int num_indices,
+                 float scale_x, float scale_y)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    const int count = indices ? num_indices : num_vertices;
+    SDL_TriangleVertex *verts = (SDL_TriangleVertex *) SDL_AllocateRenderVertices(renderer, count * sizeof (SDL_TriangleVertex), 0, &cmd->data.draw.first);
+    float x = (float) renderer->viewport.x;
+    float y = (float) renderer->viewport.y;
+    int i;
+
+    if (!verts) {
+        return -1;
+    }
+
+    if (data->queue_viewport.upscale) {
+        x = (float) data->queue_viewport.rect.x;
+        y = (float) data->queue_viewport.rect.y;
+        scale_x /= data->queue_viewport.upscale;
+        scale_y /= data->queue_viewport.upscale;
+    }
+
+    cmd->data.draw.count = count / 3;
+
+    for (i = 0; i < count; i++, verts++) {
+        const SDL_Vertex *vertex = &vertices[indices ? indices[i] : i];
+
+        verts->x = x + vertex->position.x * scale_x;
+        verts->y = y + vertex->position.y * scale_y;
+        if (texture) {
+            verts->color.r = (Uint8) ((vertex->color.r * cmd->data.draw.r) / 255);
+            verts->color.g = (Uint8) ((vertex->color.g * cmd->data.draw.g) / 255);
+            verts->color.b = (Uint8) ((vertex->color.b * cmd->data.draw.b) / 255);
+            verts->color.a = (Uint8) ((vertex->color.a * cmd->data.draw.a) / 255);
+            verts->u = vertex->tex_coord.x * texture->w;
+            verts->v = vertex->tex_coord.y * texture->h;
+        } else {
+            verts->color = vertex->color;
+            verts->u = 0.0f;
+            verts->v = 0.0f;
+        }
+    }
+
+    return 0;
+}
+
+static SW_RotatedSurface *
+SW_FindRotatedSurface(SW_RenderData *data, const SW_RotatedSurface *key)
+{
+    int i;
+
+    for (i = 0; i < SW_ROTATED_CACHE_SIZE; ++i) {
+        SW_RotatedSurface *entry = &data->rotated_cache[i];
+        if (entry->texture == key->texture &&
+            SDL_memcmp(&entry->srcrect, &key->srcrect, sizeof (SDL_Rect)) == 0 &&
+            entry->w == key->w && entry->h == key->h &&
+            entry->angle == key->angle && entry->flip == key->flip &&
+            entry->scaleMode == key->scaleMode && entry->blendmode == key->blendmode &&
+            entry->modulation == key->modulation) {
+            entry->last_used = ++data->rotated_clock;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/* Stores a rotated copy in the cache, replacing the least recently used one */
+static SW_RotatedSurface *
+SW_AddRotatedSurface(SW_RenderData *data, const SW_RotatedSurface *key,
+                     SDL_Surface *rotated, SDL_Surface *mask)
+{
+    SW_RotatedSurface *entry = &data->rotated_cache[0];
+    int i;
+
+    for (i = 1; i < SW_ROTATED_CACHE_SIZE && entry->texture; ++i) {
+        SW_RotatedSurface *other = &data->rotated_cache[i];
+        if (!other->texture || other->last_used < entry->last_used) {
+            entry = other;
+        }
+    }
+    if (entry->texture) {
+        SW_FreeRotatedSurface(entry);
+    }
+    *entry = *key;
+    entry->rotated = rotated;
+    entry->mask = mask;
+    entry->last_used = ++data->rotated_clock;
+    return entry;
+}
+
+/* Gets the rectangle a rotated copy is blitted to, dstwidth by dstheight
+   pixels around the center of the final rectangle.
+ */
+static void
+SW_GetRotatedRect(const SDL_Rect * final_rect, const SDL_FPoint * center,
+                  double cangle, double sangle, int dstwidth, int dstheight, SDL_Rect *rect)
+{
+    double px, py, p1x, p1y, p2x, p2y, p3x, p3y, p4x, p4y;
+    /* Find out where the new origin is by rotating the four final_rect points around the center and then taking the extremes */
+    const int abscenterx = final_rect->x + (int)center->x;
+    const int abscentery = final_rect->y + (int)center->y;
+
+    /* Compensate the angle inversion to match the behaviour of the other backends */
+    sangle = -sangle;
+
+    /* Top Left */
+    px = final_rect->x - abscenterx;
+    py = final_rect->y - abscentery;
+    p1x = px * cangle - py * sangle + abscenterx;
+    p1y = px * sangle + py * cangle + abscentery;
+
+    /* Top Right */
+    px = final_rect->x + final_rect->w - abscenterx;
+    py = final_rect->y - abscentery;
+    p2x = px * cangle - py * sangle + abscenterx;
+    p2y = px * sangle + py * cangle + abscentery;
+
+    /* Bottom Left */
+    px = final_rect->x - abscenterx;
+    py = final_rect->y + final_rect->h - abscentery;
+    p3x = px * cangle - py * sangle + abscenterx;
+    p3y = px * sangle + py * cangle + abscentery;
+
+    /* Bottom Right */
+    px = final_rect->x + final_rect->w - abscenterx;
+    py = final_rect->y + final_rect->h - abscentery;
+    p4x = px * cangle - py * sangle + abscenterx;
+    p4y = px * sangle + py * cangle + abscentery;
+
+    rect->x = (int)MIN(MIN(p1x, p2x), MIN(p3x, p4x));
+    rect->y = (int)MIN(MIN(p1y, p2y), MIN(p3y, p4y));
+    rect->w = dstwidth;
+    rect->h = dstheight;
+}
+
+/* Flips and rotations by a multiple of 90 degrees that are plain copies, with
+   the same pixel format, no scaling, modulation or blending, are done in one
+   pass, reading the source with the strides of the rotation. This gives the
+   same pixels as the rotated surface. Returns SDL_FALSE if the copy has to
+   go through SDLgfx_rotateSurface.
+ */
+static SDL_bool
+SW_CopyRotated90(SDL_Surface *surface, SDL_Surface *src, const SDL_Rect * srcrect,
+                 const SDL_Rect * final_rect, const double angle,
+                 const SDL_FPoint * center, const SDL_RendererFlip flip)
+{
+    const int bpp = src->format->BytesPerPixel;
+    const int w = srcrect->w, h = srcrect->h;
+    int angle90 = (int)(angle/90);
+    int x0, y0, dxu, dyu, dxv, dyv, stepu, stepv, dstwidth, dstheight, x, y;
+    double cangle, sangle;
+    SDL_BlendMode blendmode;
+    Uint8 alphaMod, rMod, gMod, bMod;
+    SDL_Rect rotated_rect, rect;
+    const Uint8 *srcrow;
+    Uint8 *dstrow;
+
+    if (angle90 != angle/90) {
+        return SDL_FALSE;
+    }
+    if (srcrect->w != final_rect->w || srcrect->h != final_rect->h) {
+        return SDL_FALSE;
+    }
+    if (src->format->format != surface->format->format || (bpp != 2 && bpp != 4)) {
+        return SDL_FALSE;
+    }
+    SDL_GetSurfaceBlendMode(src, &blendmode);
+    SDL_GetSurfaceAlphaMod(src, &alphaMod);
+    SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
+    if ((alphaMod & rMod & gMod & bMod) != 255) {
+        return SDL_FALSE;
+    }
+    if (blendmode != SDL_BLENDMODE_NONE &&
+        (blendmode != SDL_BLENDMODE_BLEND || src->format->Amask)) {
+        return SDL_FALSE;
+    }
+
+    SDLgfx_rotozoomSurfaceSizeTrig(w, h, angle, &dstwidth, &dstheight, &cangle, &sangle);
+    SW_GetRotatedRect(final_rect, center, cangle, sangle, dstwidth, dstheight, &rotated_rect);
+    if (!SDL_IntersectRect(&rotated_rect, &surface->clip_rect, &rect)) {
+        return SDL_TRUE;
+    }
+
+    /* The source pixel of the rotated pixel (u, v) is (x0 + u*dxu + v*dxv, y0 + u*dyu + v*dyv),
+       matching the clockwise rotation of SDLgfx_rotateSurface.
+     */
+    angle90 %= 4;
+    if (angle90 < 0) {
+        angle90 += 4;
+    }
+    switch (angle90) {
+    case 0: x0 = 0;     y0 = 0;     dxu = 1;  dyu = 0;  dxv = 0;  dyv = 1;  break;
+    case 1: x0 = 0;     y0 = h - 1; dxu = 0;  dyu = -1; dxv = 1;  dyv = 0;  break;
+    case 2: x0 = w - 1; y0 = h - 1; dxu = -1; dyu = 0;  dxv = 0;  dyv = -1; break;
+    default: x0 = w - 1; y0 = 0;    dxu = 0;  dyu = 1;  dxv = -1; dyv = 0;  break;
+    }
+    if (flip & SDL_FLIP_HORIZONTAL) {
+        x0 = w - 1 - x0;
+        dxu = -dxu;
+        dxv = -dxv;
+    }
+    if (flip & SDL_FLIP_VERTICAL) {
+        y0 = h - 1 - y0;
+        dyu = -dyu;
+        dyv = -dyv;
+    }
+    stepu = dxu * bpp + dyu * src->pitch;
+    stepv = dxv * bpp + dyv * src->pitch;
+
+    if (SDL_MUSTLOCK(src)) {
+        SDL_LockSurface(src);
+    }
+    srcrow = (const Uint8 *) src->pixels + (srcrect->y + y0) * src->pitch + (srcrect->x + x0) * bpp;
+    srcrow += (rect.x - rotated_rect.x) * stepu + (rect.y - rotated_rect.y) * stepv;
+    dstrow = (Uint8 *) surface->pixels + rect.y * surface->pitch + rect.x * bpp;
+
+    for (y = 0; y < rect.h; ++y) {
+        const Uint8 *sp = srcrow;
+        if (stepu == bpp) {
+            SDL_memcpy(dstrow, sp, rect.w * bpp);
+        } else if (bpp == 4) {
+            Uint32 *dp = (Uint32 *) dstrow;
+            for (x = 0; x < rect.w; ++x, sp += stepu) {
+                *dp++ = *(const Uint32 *) sp;
+            }
+        } else {
+            Uint16 *dp = (Uint16 *) dstrow;
+            for (x = 0; x < rect.w; ++x, sp += stepu) {
+                *dp++ = *(const Uint16 *) sp;
+            }
+        }
+        srcrow += stepv;
+        dstrow += surface->pitch;
+    }
+
+    if (SDL_MUSTLOCK(src)) {
+        SDL_UnlockSurface(src);
+    }
+    return SDL_TRUE;
+}
+
+/* Scales, modulates and rotates the source of a rotated copy, and rotates the
+   mask needed for the NONE blend mode along with it.
+ */
+static int
+SW_RotateCopySource(SDL_Surface *src, SDL_Texture * texture, const SDL_Rect * srcrect,
+                    const SDL_Rect * final_rect, const double angle, const SDL_RendererFlip flip,
+                    int applyModulation, int isOpaque,
+                    SDL_Surface **src_rotated, SDL_Surface **mask_rotated)
 {
-    SDL_Surface *src = (SDL_Surface *) texture->driverdata;
     SDL_Rect tmp_rect;
-    SDL_Surface *src_clone, *src_rotated, *src_scaled;
-    SDL_Surface *mask = NULL, *mask_rotated = NULL;
-    int retval = 0, dstwidth, dstheight, abscenterx, abscentery;
-    double cangle, sangle, px, py, p1x, p1y, p2x, p2y, p3x, p3y, p4x, p4y;
+    SDL_Surface *src_clone, *src_scaled;
+    SDL_Surface *mask = NULL;
+    int retval = 0, dstwidth, dstheight;
+    double cangle, sangle;
     SDL_BlendMode blendmode;
     Uint8 alphaMod, rMod, gMod, bMod;
-    int applyModulation = SDL_FALSE;
     int blitRequired = SDL_FALSE;
-    int isOpaque = SDL_FALSE;
 
-    if (!surface) {
-        return -1;
-    }
+    *src_rotated = NULL;
+    *mask_rotated = NULL;
 
     tmp_rect.x = 0;
     tmp_rect.y = 0;
@@ -383,17 +922,11 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
     }
 
     /* The color and alpha modulation has to be applied before the rotation when using the NONE and MOD blend modes. */
-    if ((blendmode == SDL_BLENDMODE_NONE || blendmode == SDL_BLENDMODE_MOD) && (alphaMod & rMod & gMod & bMod) != 255) {
-        applyModulation = SDL_TRUE;
+    if (applyModulation) {
         SDL_SetSurfaceAlphaMod(src_clone, alphaMod);
         SDL_SetSurfaceColorMod(src_clone, rMod, gMod, bMod);
     }
 
-    /* Opaque surfaces are much easier to handle with the NONE blend mode. */
-    if (blendmode == SDL_BLENDMODE_NONE && !src->format->Amask && alphaMod == 255) {
-        isOpaque = SDL_TRUE;
-    }
-
     /* The NONE blend mode requires a mask for non-opaque surfaces. This mask will be used
      * to clear the pixels in the destination surface. The other steps are explained below.
      */
@@ -418,7 +951,8 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
             retval = -1;
         } else {
             SDL_SetSurfaceBlendMode(src_clone, SDL_BLENDMODE_NONE);
-            retval = SDL_BlitScaled(src_clone, srcrect, src_scaled, &scale_rect);
+            retval = SDL_PrivateUpperBlitScaled(src_clone, srcrect, src_scaled, &scale_rect,
+                                                (texture->scaleMode == SDL_ScaleModeNearest) ? SDL_COPY_NEAREST : SDL_COPY_LINEAR);
             SDL_FreeSurface(src_clone);
             src_clone = src_scaled;
             src_scaled = NULL;
@@ -430,106 +964,17 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
 
     if (!retval) {
         SDLgfx_rotozoomSurfaceSizeTrig(tmp_rect.w, tmp_rect.h, angle, &dstwidth, &dstheight, &cangle, &sangle);
-        src_rotated = SDLgfx_rotateSurface(src_clone, angle, dstwidth/2, dstheight/2, (texture->scaleMode == SDL_ScaleModeNearest) ? 0 : 1, flip & SDL_FLIP_HORIZONTAL, flip & SDL_FLIP_VERTICAL, dstwidth, dstheight, cangle, sangle);
-        if (src_rotated == NULL) {
+        *src_rotated = SDLgfx_rotateSurface(src_clone, angle, dstwidth/2, dstheight/2, (texture->scaleMode == SDL_ScaleModeNearest) ? 0 : 1, flip & SDL_FLIP_HORIZONTAL, flip & SDL_FLIP_VERTICAL, dstwidth, dstheight, cangle, sangle);
+        if (*src_rotated == NULL) {
             retval = -1;
         }
         if (!retval && mask != NULL) {
             /* The mask needed for the NONE blend mode gets rotated with the same parameters. */
-            mask_rotated = SDLgfx_rotateSurface(mask, angle, dstwidth/2, dstheight/2, SDL_FALSE, 0, 0, dstwidth, dstheight, cangle, sangle);
-            if (mask_rotated == NULL) {
+            *mask_rotated = SDLgfx_rotateSurface(mask, angle, dstwidth/2, dstheight/2, SDL_FALSE, 0, 0, dstwidth, dstheight, cangle, sangle);
+            if (*mask_rotated == NULL) {
                 retval = -1;
             }
         }
-        if (!retval) {
-            /* Find out where the new origin is by rotating the four final_rect points around the center and then taking the extremes */
-            abscenterx = final_rect->x + (int)center->x;
-            abscentery = final_rect->y + (int)center->y;
-            /* Compensate the angle inversion to match the behaviour of the other backends */
-            sangle = -sangle;
-
-            /* Top Left */
-            px = final_rect->x - abscenterx;
-            py = final_rect->y - abscentery;
-            p1x = px * cangle - py * sangle + abscenterx;
-            p1y = px * sangle + py * cangle + abscentery;
-
-            /* Top Right */
-            px = final_rect->x + final_rect->w - abscenterx;
-            py = final_rect->y - abscentery;
-            p2x = px * cangle - py * sangle + abscenterx;
-            p2y = px * sangle + py * cangle + abscentery;
-
-            /* Bottom Left */
-            px = final_rect->x - abscenterx;
-            py = final_rect->y + final_rect->h - abscentery;
-            p3x = px * cangle - py * sangle + abscenterx;
-            p3y = px * sangle + py * cangle + abscentery;
-
-            /* Bottom Right */
-            px = final_rect->x + final_rect->w - abscenterx;
-            py = final_rect->y + final_rect->h - abscentery;
-            p4x = px * cangle - py * sangle + abscenterx;
-            p4y = px * sangle + py * cangle + abscentery;
-
-            tmp_rect.x = (int)MIN(MIN(p1x, p2x), MIN(p3x, p4x));
-            tmp_rect.y = (int)MIN(MIN(p1y, p2y), MIN(p3y, p4y));
-            tmp_rect.w = dstwidth;
-            tmp_rect.h = dstheight;
-
-            /* The NONE blend mode needs some special care with non-opaque surfaces.
-             * Other blend modes or opaque surfaces can be blitted directly.
-             */
-            if (blendmode != SDL_BLENDMODE_NONE || isOpaque) {
-                if (applyModulation == SDL_FALSE) {
-                    /* If the modulation wasn't already applied, make it happen now. */
-                    SDL_SetSurfaceAlphaMod(src_rotated, alphaMod);
-                    SDL_SetSurfaceColorMod(src_rotated, rMod, gMod, bMod);
-                }
-                retval = SDL_BlitSurface(src_rotated, NULL, surface, &tmp_rect);
-            } else {
-                /* The NONE blend mode requires three steps to get the pixels onto the destination surface.
-                 * First, the area where the rotated pixels will be blitted to get set to zero.
-                 * This is accomplished by simply blitting a mask with the NONE blend mode.
-                 * The colorkey set by the rotate function will discard the correct pixels.
-                 */
-                SDL_Rect mask_rect = tmp_rect;
-                SDL_SetSurfaceBlendMode(mask_rotated, SDL_BLENDMODE_NONE);
-                retval = SDL_BlitSurface(mask_rotated, NULL, surface, &mask_rect);
-                if (!retval) {
-                    /* The next step copies the alpha value. This is done with the BLEND blend mode and
-                     * by modulating the source colors with 0. Since the destination is all zeros, this
-                     * will effectively set the destination alpha to the source alpha.
-                     */
-                    SDL_SetSurfaceColorMod(src_rotated, 0, 0, 0);
-                    mask_rect = tmp_rect;
-                    retval = SDL_BlitSurface(src_rotated, NULL, surface, &mask_rect);
-                    if (!retval) {
-                        /* The last step gets the color values in place. The ADD blend mode simply adds them to
-                         * the destination (where the color values are all zero). However, because the ADD blend
-                         * mode modulates the colors with the alpha channel, a surface without an alpha mask needs
-                         * to be created. This makes all source pixels opaque and the colors get copied correctly.
-                         */
-                        SDL_Surface *src_rotated_rgb;
-                        src_rotated_rgb = SDL_CreateRGBSurfaceFrom(src_rotated->pixels, src_rotated->w, src_rotated->h,
-                                                                   src_rotated->format->BitsPerPixel, src_rotated->pitch,
-                                                                   src_rotated->format->Rmask, src_rotated->format->Gmask,
-                                                                   src_rotated->format->Bmask, 0);
-                        if (src_rotated_rgb == NULL) {
-                            retval = -1;
-                        } else {
-                            SDL_SetSurfaceBlendMode(src_rotated_rgb, SDL_BLENDMODE_ADD);
-                            retval = SDL_BlitSurface(src_rotated_rgb, NULL, surface, &tmp_rect);
-                            SDL_FreeSurface(src_rotated_rgb);
-                        }
-                    }
-                }
-                SDL_FreeSurface(mask_rotated);
-            }
-            if (src_rotated != NULL) {
-                SDL_FreeSurface(src_rotated);
-            }
-        }
     }
 
     if (SDL_MUSTLOCK(src)) {
@@ -541,161 +986,1356 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
     if (src_clone != NULL) {
         SDL_FreeSurface(src_clone);
     }
-    return retval;
-}
-
-static void
-PrepTextureForCopy(const SDL_RenderCommand *cmd)
-{
-    const Uint8 r = cmd->data.draw.r;
-    const Uint8 g = cmd->data.draw.g;
-    const Uint8 b = cmd->data.draw.b;
-    const Uint8 a = cmd->data.draw.a;
-    const SDL_BlendMode blend = cmd->data.draw.blend;
-    SDL_Texture *texture = cmd->data.draw.texture;
-    SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
-    const SDL_bool colormod = ((r & g & b) != 0xFF);
-    const SDL_bool alphamod = (a != 0xFF);
-    const SDL_bool blending = ((blend == SDL_BLENDMODE_ADD) || (blend == SDL_BLENDMODE_MOD));
-
-    if (colormod || alphamod || blending) {
-        SDL_SetSurfaceRLE(surface, 0);
+    if (retval < 0) {
+        SDL_FreeSurface(*src_rotated);
+        SDL_FreeSurface(*mask_rotated);
+        *src_rotated = *mask_rotated = NULL;
     }
-
-    /* !!! FIXME: we can probably avoid some of these calls. */
-    SDL_SetSurfaceColorMod(surface, r, g, b);
-    SDL_SetSurfaceAlphaMod(surface, a);
-    SDL_SetSurfaceBlendMode(surface, blend);
+    return retval;
 }
 
+/* Rotated copies are kept in an LRU cache, so a texture drawn with the same
+   rotation every frame is only rotated once. The cache isn't used by the
+   tiles, which are drawn on the worker threads.
+ */
 static int
-SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Surface *src, SDL_Texture * texture,
+                const SDL_Rect * srcrect, const SDL_Rect * final_rect,
+                const double angle, const SDL_FPoint * center, const SDL_RendererFlip flip,
+                SDL_bool use_cache)
 {
     SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
-    SDL_Surface *surface = SW_ActivateRenderer(renderer);
-    const SDL_Rect *viewport = NULL;
-    const SDL_Rect *cliprect = NULL;
+    SW_RotatedSurface key, *entry = NULL;
+    SDL_Rect tmp_rect;
+    SDL_Surface *src_rotated = NULL, *mask_rotated = NULL;
+    int retval = 0, dstwidth, dstheight;
+    double cangle, sangle;
+    SDL_BlendMode blendmode;
+    Uint8 alphaMod, rMod, gMod, bMod;
+    int applyModulation = SDL_FALSE;
+    int isOpaque = SDL_FALSE;
 
-    if (!surface) {
+    if (!surface || !src) {
         return -1;
     }
 
-    while (cmd) {
-        switch (cmd->command) {
-            case SDL_RENDERCMD_SETDRAWCOLOR: {
-                break;  /* Not used in this backend. */
+    if (SW_CopyRotated90(surface, src, srcrect, final_rect, angle, center, flip)) {
+        return 0;
+    }
+
+    SDL_GetSurfaceBlendMode(src, &blendmode);
+    SDL_GetSurfaceAlphaMod(src, &alphaMod);
+    SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
+
+    /* The color and alpha modulation has to be applied before the rotation when using the NONE and MOD blend modes. */
+    if ((blendmode == SDL_BLENDMODE_NONE || blendmode == SDL_BLENDMODE_MOD) && (alphaMod & rMod & gMod & bMod) != 255) {
+        applyModulation = SDL_TRUE;
+    }
+
+    /* Opaque surfaces are much easier to handle with the NONE blend mode. */
+    if (blendmode == SDL_BLENDMODE_NONE && !src->format->Amask && alphaMod == 255) {
+        isOpaque = SDL_TRUE;
+    }
+
+    SDL_zero(key);
+    key.texture = texture;
+    key.srcrect = *srcrect;
+    key.w = final_rect->w;
+    key.h = final_rect->h;
+    key.angle = angle;
+    key.flip = flip;
+    key.scaleMode = texture->scaleMode;
+    key.blendmode = blendmode;
+    key.modulation = applyModulation ? (((Uint32) rMod << 24) | (gMod << 16) | (bMod << 8) | alphaMod) : 0xFFFFFFFF;
+
+    if (use_cache) {
+        entry = SW_FindRotatedSurface(data, &key);
+    }
+    if (entry) {
+        src_rotated = entry->rotated;
+        mask_rotated = entry->mask;
+    } else {
+        retval = SW_RotateCopySource(src, texture, srcrect, final_rect, angle, flip,
+                                     applyModulation, isOpaque, &src_rotated, &mask_rotated);
+        if (!retval && use_cache && src_rotated->w * src_rotated->h <= SW_ROTATED_CACHE_MAX_PIXELS) {
+            entry = SW_AddRotatedSurface(data, &key, src_rotated, mask_rotated);
+        }
+    }
+
+    if (!retval) {
+        SDLgfx_rotozoomSurfaceSizeTrig(final_rect->w, final_rect->h, angle, &dstwidth, &dstheight, &cangle, &sangle);
+        SW_GetRotatedRect(final_rect, center, cangle, sangle, dstwidth, dstheight, &tmp_rect);
+
+        /* The NONE blend mode needs some special care with non-opaque surfaces.
+         * Other blend modes or opaque surfaces can be blitted directly.
+         */
+        if (blendmode != SDL_BLENDMODE_NONE || isOpaque) {
+            if (applyModulation == SDL_FALSE) {
+                /* If the modulation wasn't already applied, make it happen now. */
+                SDL_SetSurfaceAlphaMod(src_rotated, alphaMod);
+                SDL_SetSurfaceColorMod(src_rotated, rMod, gMod, bMod);
+            }
+            retval = SDL_BlitSurface(src_rotated, NULL, surface, &tmp_rect);
+        } else {
+            /* The NONE blend mode requires three steps to get the pixels onto the destination surface.
+             * First, the area where the rotated pixels will be blitted to get set to zero.
+             * This is accomplished by simply blitting a mask with the NONE blend mode.
+             * The colorkey set by the rotate function will discard the correct pixels.
+             */
+            SDL_Rect mask_rect = tmp_rect;
+            SDL_SetSurfaceBlendMode(mask_rotated, SDL_BLENDMODE_NONE);
+            retval = SDL_BlitSurface(mask_rotated, NULL, surface, &mask_rect);
+            if (!retval) {
+                /* The next step copies the alpha value. This is done with the BLEND blend mode and
+                 * by modulating the source colors with 0. Since the destination is all zeros, this
+                 * will effectively set the destination alpha to the source alpha.
+                 */
+                SDL_SetSurfaceColorMod(src_rotated, 0, 0, 0);
+                mask_rect = tmp_rect;
+                retval = SDL_BlitSurface(src_rotated, NULL, surface, &mask_rect);
+                if (!retval) {
+                    /* The last step gets the color values in place. The ADD blend mode simply adds them to
+                     * the destination (where the color values are all zero). However, because the ADD blend
+                     * mode modulates the colors with the alpha channel, a surface without an alpha mask needs
+                     * to be created. This makes all source pixels opaque and the colors get copied correctly.
+                     */
+                    SDL_Surface *src_rotated_rgb;
+                    src_rotated_rgb = SDL_CreateRGBSurfaceFrom(src_rotated->pixels, src_rotated->w, src_rotated->h,
+                                                               src_rotated->format->BitsPerPixel, src_rotated->pitch,
+                                                               src_rotated->format->Rmask, src_rotated->format->Gmask,
+                                                               src_rotated->format->Bmask, 0);
+                    if (src_rotated_rgb == NULL) {
+                        retval = -1;
+                    } else {
+                        SDL_SetSurfaceBlendMode(src_rotated_rgb, SDL_BLENDMODE_ADD);
+                        retval = SDL_BlitSurface(src_rotated_rgb, NULL, surface, &tmp_rect);
+                        SDL_FreeSurface(src_rotated_rgb);
+                    }
+                }
+            }
+        }
+    }
+
+    if (!entry) {
+        SDL_FreeSurface(mask_rotated);
+        SDL_FreeSurface(src_rotated);
+    }
+    return retval;
+}
+
+static void
+PrepTextureForCopy(const SDL_RenderCommand *cmd, SDL_Surface *surface)
+{
+    const Uint8 r = cmd->data.draw.r;
+    const Uint8 g = cmd->data.draw.g;
+    const Uint8 b = cmd->data.draw.b;
+    const Uint8 a = cmd->data.draw.a;
+    const SDL_BlendMode blend = cmd->data.draw.blend;
+    const SDL_bool colormod = ((r & g & b) != 0xFF);
+    const SDL_bool alphamod = (a != 0xFF);
+    const SDL_bool blending = ((blend == SDL_BLENDMODE_ADD) || (blend == SDL_BLENDMODE_MOD));
+
+    if (colormod || alphamod || blending) {
+        SDL_SetSurfaceRLE(surface, 0);
+    }
+
+    /* !!! FIXME: we can probably avoid some of these calls. */
+    SDL_SetSurfaceColorMod(surface, r, g, b);
+    SDL_SetSurfaceAlphaMod(surface, a);
+    SDL_SetSurfaceBlendMode(surface, blend);
+}
+
+/* Whether a YUV texture copy can go straight to the target, without color
+   modulation, blending or filtering. YUV textures have no alpha channel.
+ */
+static SDL_bool
+CanBlitYUVDirectly(const SDL_RenderCommand *cmd, const SDL_Surface *surface,
+                   const SDL_Rect *srcrect, const SDL_Rect *dstrect)
+{
+    const SDL_Texture *texture = cmd->data.draw.texture;
+    const SDL_BlendMode blend = cmd->data.draw.blend;
+
+    if (!SDL_ISPIXELFORMAT_FOURCC(texture->format) ||
+        !SDL_SW_CanBlitYUVTexture(surface->format->format)) {
+        return SDL_FALSE;
+    }
+
+    if ((cmd->data.draw.r & cmd->data.draw.g & cmd->data.draw.b) != 0xFF) {
+        return SDL_FALSE;
+    }
+    if (blend != SDL_BLENDMODE_NONE &&
+        (blend != SDL_BLENDMODE_BLEND || cmd->data.draw.a != 0xFF)) {
+        return SDL_FALSE;
+    }
+    if (texture->scaleMode != SDL_ScaleModeNearest &&
+        (srcrect->w != dstrect->w || srcrect->h != dstrect->h)) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+/* The triangle rasterizer reads ARGB8888 texels straight from an unlocked
+   surface. Other textures are converted once and the copy is kept until the
+   texture changes. Entries are only dropped then, since the tiled path may
+   still hold earlier copies, so a full cache leaves the conversion to
+   SDL_SW_DrawTriangles() again.
+ */
+static SDL_Surface *
+SW_GetTriangleSource(SDL_Renderer * renderer, SDL_Texture * texture, SDL_Surface *src)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SW_ConvertedSurface *entry = NULL;
+    int i;
+
+    if (src->format->format == SDL_PIXELFORMAT_ARGB8888 && !SDL_MUSTLOCK(src)) {
+        return src;
+    }
+
+    for (i = 0; i < SW_CONVERTED_CACHE_SIZE; ++i) {
+        if (data->converted_cache[i].texture == texture) {
+            return data->converted_cache[i].converted;
+        }
+        if (!entry && !data->converted_cache[i].texture) {
+            entry = &data->converted_cache[i];
+        }
+    }
+    if (!entry) {
+        return src;
+    }
+
+    entry->converted = SDL_ConvertSurfaceFormat(src, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (!entry->converted) {
+        return src;
+    }
+    entry->texture = texture;
+    return entry->converted;
+}
+
+/* Gets the surface to blit a texture copy from. This is NULL for YUV
+   textures that are converted straight to the target surface, and for
+   geometry without a texture.
+ */
+static int
+SW_GetCopySource(SDL_Renderer * renderer, const SDL_RenderCommand *cmd, SDL_Surface *surface,
+                 void *vertices, SDL_Surface **src)
+{
+    if (!cmd->data.draw.texture) {
+        *src = NULL;
+        return 0;
+    }
+    if (cmd->command == SDL_RENDERCMD_COPY) {
+        const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
+        const int count = (int) cmd->data.draw.count;
+        int i;
+
+        for (i = 0; i < count; ++i) {
+            if (!CanBlitYUVDirectly(cmd, surface, &verts[2*i], &verts[2*i+1])) {
+                break;
+            }
+        }
+        if (i == count) {
+            *src = NULL;
+            return 0;
+        }
+    }
+    *src = SW_GetTextureSurface(cmd->data.draw.texture);
+    if (*src && cmd->command == SDL_RENDERCMD_GEOMETRY) {
+        *src = SW_GetTriangleSource(renderer, cmd->data.draw.texture, *src);
+    }
+    return *src ? 0 : -1;
+}
+
+static const SW_Viewport *
+SW_GetViewport(const SDL_RenderCommand *cmd, void *vertices)
+{
+    return (const SW_Viewport *) (((Uint8 *) vertices) + cmd->data.viewport.first);
+}
+
+/* Sets the clip rectangle of the surface for the current viewport and clip
+   rectangle. A queue can set the clip rectangle before its first viewport,
+   in which case it's applied once the viewport is known.
+ */
+static void
+SW_SetDrawClip(SDL_Surface *surface, const SW_Viewport *viewport, const SDL_Rect *cliprect)
+{
+    if (!viewport) {
+        return;
+    }
+    if (cliprect) {
+        const int upscale = SDL_max(viewport->upscale, 1);
+        SDL_Rect clip_rect;
+        clip_rect.x = cliprect->x / upscale + viewport->rect.x;
+        clip_rect.y = cliprect->y / upscale + viewport->rect.y;
+        clip_rect.w = cliprect->w / upscale;
+        clip_rect.h = cliprect->h / upscale;
+        SDL_IntersectRect(&viewport->rect, &clip_rect, &clip_rect);
+        SDL_SetClipRect(surface, &clip_rect);
+    } else {
+        SDL_SetClipRect(surface, &viewport->rect);
+    }
+}
+
+/* Draws copies first to first+count-1 of a copy command, clipped to the clip
+   rectangle of the surface.
+ */
+static void
+SW_DrawCopies(SDL_Surface *surface, SDL_Surface *src, const SDL_RenderCommand *cmd,
+              void *vertices, int first, int count)
+{
+    const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first) + 2 * first;
+    SDL_Texture *texture = cmd->data.draw.texture;
+    int i;
+
+    if (!src) {
+        for (i = 0; i < count; ++i, verts += 2) {
+            SDL_Rect dstrect = verts[1];  /* the blits write the clipped rectangle back */
+            SDL_SW_BlitYUVTexture((SDL_SW_YUVTexture *) texture->driverdata,
+                                  &verts[0], surface, &dstrect);
+        }
+        return;
+    }
+
+    PrepTextureForCopy(cmd, src);
+
+    for (i = 0; i < count; ++i, verts += 2) {
+        const SDL_Rect *srcrect = &verts[0];
+        SDL_Rect dstrect = verts[1];
+
+        if ( srcrect->w == dstrect.w && srcrect->h == dstrect.h ) {
+            SDL_BlitSurface(src, srcrect, surface, &dstrect);
+        } else {
+            /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
+             * to avoid potentially frequent RLE encoding/decoding.
+             */
+            SDL_SetSurfaceRLE(surface, 0);
+            SDL_PrivateUpperBlitScaled(src, srcrect, surface, &dstrect,
+                                       (texture->scaleMode == SDL_ScaleModeNearest) ? SDL_COPY_NEAREST : SDL_COPY_LINEAR);
+        }
+    }
+}
+
+/* Draws a command, clipped to the clip rectangle of the surface. A clear
+   fills the whole clip rectangle, the caller has to widen it first.
+ */
+static void
+SW_DrawCommand(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Surface *src,
+               const SDL_RenderCommand *cmd, void *vertices)
+{
+    switch (cmd->command) {
+        case SDL_RENDERCMD_CLEAR: {
+            const Uint8 r = cmd->data.color.r;
+            const Uint8 g = cmd->data.color.g;
+            const Uint8 b = cmd->data.color.b;
+            const Uint8 a = cmd->data.color.a;
+            SDL_FillRect(surface, NULL, SDL_MapRGBA(surface->format, r, g, b, a));
+            break;
+        }
+
+        case SDL_RENDERCMD_DRAW_POINTS: {
+            const Uint8 r = cmd->data.draw.r;
+            const Uint8 g = cmd->data.draw.g;
+            const Uint8 b = cmd->data.draw.b;
+            const Uint8 a = cmd->data.draw.a;
+            const int count = (int) cmd->data.draw.count;
+            const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            const SDL_BlendMode blend = cmd->data.draw.blend;
+            if (blend == SDL_BLENDMODE_NONE) {
+                SDL_DrawPoints(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+            } else {
+                SDL_BlendPoints(surface, verts, count, blend, r, g, b, a);
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_DRAW_LINES: {
+            const Uint8 r = cmd->data.draw.r;
+            const Uint8 g = cmd->data.draw.g;
+            const Uint8 b = cmd->data.draw.b;
+            const Uint8 a = cmd->data.draw.a;
+            const int count = (int) cmd->data.draw.count;
+            const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            const SDL_BlendMode blend = cmd->data.draw.blend;
+            if (blend == SDL_BLENDMODE_NONE) {
+                SDL_DrawLines(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+            } else {
+                SDL_BlendLines(surface, verts, count, blend, r, g, b, a);
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_FILL_RECTS: {
+            const Uint8 r = cmd->data.draw.r;
+            const Uint8 g = cmd->data.draw.g;
+            const Uint8 b = cmd->data.draw.b;
+            const Uint8 a = cmd->data.draw.a;
+            const int count = (int) cmd->data.draw.count;
+            const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            const SDL_BlendMode blend = cmd->data.draw.blend;
+            if (blend == SDL_BLENDMODE_NONE) {
+                SDL_FillRects(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+            } else {
+                SDL_BlendFillRects(surface, verts, count, blend, r, g, b, a);
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_COPY: {
+            SW_DrawCopies(surface, src, cmd, vertices, 0, (int) cmd->data.draw.count);
+            break;
+        }
+
+        case SDL_RENDERCMD_COPY_EX: {
+            const SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+            const CopyExData *copydata = (CopyExData *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            PrepTextureForCopy(cmd, src);
+            /* The tiles draw through their own surfaces, and don't use the cache */
+            SW_RenderCopyEx(renderer, surface, src, cmd->data.draw.texture, &copydata->srcrect,
+                            &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip,
+                            (surface == data->surface));
+            break;
+        }
+
+        case SDL_RENDERCMD_GEOMETRY: {
+            const SDL_Texture *texture = cmd->data.draw.texture;
+            const SDL_TriangleVertex *verts = (SDL_TriangleVertex *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            const SDL_bool smooth = (texture && texture->scaleMode != SDL_ScaleModeNearest);
+            SDL_SW_DrawTriangles(surface, src, smooth, verts, (int) cmd->data.draw.count, cmd->data.draw.blend);
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+/* Counts the pixels a command fills or copies, for SDL_RenderGetStats() */
+static void
+SW_CountPixels(SDL_Renderer * renderer, const SDL_Surface *surface, const SDL_RenderCommand *cmd, void *vertices)
+{
+    SDL_RenderStats *stats = &renderer->stats;
+    SDL_Rect rect;
+    int i;
+
+    switch (cmd->command) {
+        case SDL_RENDERCMD_CLEAR: {
+            stats->pixels_filled += (Uint64) surface->w * surface->h;
+            break;
+        }
+
+        case SDL_RENDERCMD_FILL_RECTS: {
+            const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            for (i = 0; i < (int) cmd->data.draw.count; ++i) {
+                if (SDL_IntersectRect(&verts[i], &surface->clip_rect, &rect)) {
+                    stats->pixels_filled += (Uint64) rect.w * rect.h;
+                }
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_COPY: {
+            const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            for (i = 0; i < (int) cmd->data.draw.count; ++i) {
+                if (SDL_IntersectRect(&verts[2*i+1], &surface->clip_rect, &rect)) {
+                    stats->pixels_copied += (Uint64) rect.w * rect.h;
+                }
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_COPY_EX: {
+            const CopyExData *copydata = (CopyExData *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            if (SDL_IntersectRect(&copydata->dstrect, &surface->clip_rect, &rect)) {
+                stats->pixels_copied += (Uint64) rect.w * rect.h;
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+/* Tiled rendering, see SDL_HINT_RENDER_SOFTWARE_THREADS.
+
+   The commands are sorted into bins for the screen tiles they touch, and the
+   tiles are drawn in parallel, each one in command order. Drawing a command
+   tile by tile must give the same pixels as drawing it at once, which isn't
+   true for diagonal lines, scaled RGB blits and rotated copies, because
+   clipping moves their sampling grid. Those are binned when they fit into a
+   single tile; otherwise the tiles are drawn up to that point, and then the
+   command is drawn on the calling thread. The copies of a batched copy
+   command are binned one by one.
+ */
+#define SW_TILE_SIZE            64
+#define SW_TILED_MIN_PIXELS     (256 * 256)
+#define SW_TILE_SOURCES         8
+
+struct SW_TileCommand
+{
+    const SDL_RenderCommand *cmd;
+    SDL_Surface *src;
+    int item;           /* the copy to draw, for copy commands */
+    SDL_Rect clip;      /* the clip rectangle for the command */
+    SDL_Rect bounds;    /* the part of the clip rectangle it can draw to */
+};
+
+typedef struct
+{
+    SDL_Renderer *renderer;
+    SDL_Surface *surface;
+    void *vertices;
+    const SW_TileCommand *cmds;
+    const int *bins;    /* the commands of tile i are items[bins[i]] to items[bins[i+1]-1] */
+    const int *items;
+    const int *tiles;   /* the tiles that have commands */
+    int tiles_x;
+} SW_TileJobs;
+
+static SDL_bool
+SW_UseTiles(SW_RenderData *data, SDL_Surface *surface)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+    int threads = hint ? SDL_atoi(hint) : 0;
+
+    if (threads < 0) {
+        threads = SDL_GetCPUCount();
+    }
+    if (threads != data->threads) {
+        SDL_DestroyWorkerPool(data->pool);
+        data->pool = NULL;
+        if (threads > 1) {
+            data->pool = SDL_CreateWorkerPool("SDLRenderWorker", threads - 1);
+        }
+        data->threads = threads;
+    }
+
+    if (!data->pool || ((Sint64) surface->w * surface->h) < SW_TILED_MIN_PIXELS) {
+        return SDL_FALSE;
+    }
+    /* The tiles draw through surfaces sharing the target's pixels */
+    if (SDL_MUSTLOCK(surface) || SDL_ISPIXELFORMAT_INDEXED(surface->format->format)) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static SDL_bool
+SW_GrowArray(void **array, int *max, int count, size_t size)
+{
+    if (count > *max) {
+        const int newmax = SDL_max(count, *max * 2);
+        void *newarray = SDL_realloc(*array, newmax * size);
+        if (!newarray) {
+            SDL_OutOfMemory();
+            return SDL_FALSE;
+        }
+        *array = newarray;
+        *max = newmax;
+    }
+    return SDL_TRUE;
+}
+
+/* Draws a binned command, clipped to the clip rectangle of the surface */
+static void
+SW_DrawTileCommand(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Surface *src,
+                   const SW_TileCommand *tcmd, void *vertices)
+{
+    if (tcmd->cmd->command == SDL_RENDERCMD_COPY) {
+        SW_DrawCopies(surface, src, tcmd->cmd, vertices, tcmd->item, 1);
+    } else {
+        SW_DrawCommand(renderer, surface, src, tcmd->cmd, vertices);
+    }
+}
+
+/* Gets the area a command, or one copy of a copy command, can draw to, and
+   whether it can be drawn in tiles. Returns SDL_FALSE if it doesn't draw
+   anything.
+ */
+static SDL_bool
+SW_GetCommandBounds(const SDL_RenderCommand *cmd, void *vertices, const SDL_Surface *src,
+                    int item, SDL_Rect *bounds, SDL_bool *splittable)
+{
+    switch (cmd->command) {
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES: {
+            const int count = (int) cmd->data.draw.count;
+            const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            int i, minx, miny, maxx, maxy;
+
+            if (count <= 0) {
+                return SDL_FALSE;
+            }
+            minx = maxx = verts[0].x;
+            miny = maxy = verts[0].y;
+            /* Clipping only keeps the pixels of horizontal and vertical lines */
+            *splittable = SDL_TRUE;
+            for (i = 1; i < count; ++i) {
+                minx = SDL_min(minx, verts[i].x);
+                maxx = SDL_max(maxx, verts[i].x);
+                miny = SDL_min(miny, verts[i].y);
+                maxy = SDL_max(maxy, verts[i].y);
+                if (cmd->command == SDL_RENDERCMD_DRAW_LINES &&
+                    verts[i].x != verts[i-1].x && verts[i].y != verts[i-1].y) {
+                    *splittable = SDL_FALSE;
+                }
+            }
+            bounds->x = minx;
+            bounds->y = miny;
+            bounds->w = maxx - minx + 1;
+            bounds->h = maxy - miny + 1;
+            return SDL_TRUE;
+        }
+
+        case SDL_RENDERCMD_FILL_RECTS: {
+            const int count = (int) cmd->data.draw.count;
+            const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            int i;
+
+            if (count <= 0) {
+                return SDL_FALSE;
+            }
+            *bounds = verts[0];
+            for (i = 1; i < count; ++i) {
+                SDL_UnionRect(bounds, &verts[i], bounds);
+            }
+            *splittable = SDL_TRUE;
+            return SDL_TRUE;
+        }
+
+        case SDL_RENDERCMD_COPY: {
+            const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first) + 2 * item;
+
+            *bounds = verts[1];
+            /* The direct YUV blit samples relative to the unclipped rectangle */
+            *splittable = (!src || (verts[0].w == verts[1].w && verts[0].h == verts[1].h));
+            return SDL_TRUE;
+        }
+
+        case SDL_RENDERCMD_COPY_EX: {
+            const CopyExData *copydata = (CopyExData *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            const SDL_Rect *dstrect = &copydata->dstrect;
+            const int cx = dstrect->x + (int)copydata->center.x;
+            const int cy = dstrect->y + (int)copydata->center.y;
+            const double dx = SDL_max(SDL_abs(dstrect->x - cx), SDL_abs(dstrect->x + dstrect->w - cx));
+            const double dy = SDL_max(SDL_abs(dstrect->y - cy), SDL_abs(dstrect->y + dstrect->h - cy));
+            /* Wherever it's rotated to, it stays within this distance of the center */
+            const int radius = (int)SDL_ceil(SDL_sqrt(dx * dx + dy * dy)) + 2;
+
+            bounds->x = cx - radius;
+            bounds->y = cy - radius;
+            bounds->w = bounds->h = 2 * radius + 1;
+            *splittable = SDL_FALSE;
+            return SDL_TRUE;
+        }
+
+        case SDL_RENDERCMD_GEOMETRY: {
+            const int count = (int) cmd->data.draw.count * 3;
+            const SDL_TriangleVertex *verts = (SDL_TriangleVertex *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            float minx, miny, maxx, maxy;
+            int i;
+
+            if (count <= 0) {
+                return SDL_FALSE;
+            }
+            minx = maxx = verts[0].x;
+            miny = maxy = verts[0].y;
+            for (i = 1; i < count; ++i) {
+                minx = SDL_min(minx, verts[i].x);
+                maxx = SDL_max(maxx, verts[i].x);
+                miny = SDL_min(miny, verts[i].y);
+                maxy = SDL_max(maxy, verts[i].y);
+            }
+            /* Keep the bounds in range, they're clipped to the surface anyway */
+            minx = SDL_max(minx, -1048576.0f);
+            miny = SDL_max(miny, -1048576.0f);
+            maxx = SDL_min(maxx, 1048576.0f);
+            maxy = SDL_min(maxy, 1048576.0f);
+            bounds->x = (int) SDL_floorf(minx);
+            bounds->y = (int) SDL_floorf(miny);
+            bounds->w = (int) SDL_ceilf(maxx) - bounds->x + 1;
+            bounds->h = (int) SDL_ceilf(maxy) - bounds->y + 1;
+            /* Every pixel is drawn depending on its center only */
+            *splittable = SDL_TRUE;
+            return SDL_TRUE;
+        }
+
+        default:
+            return SDL_FALSE;
+    }
+}
+
+/* Adds a rectangle to the parts of a surface that changed. Overlapping
+   rectangles are merged, and when there are too many, the new one is merged
+   with the one that grows the least, so nothing is presented twice.
+ */
+static void
+SW_AddDamage(SDL_Rect *damage, int *num_damage, const SDL_Rect *rect)
+{
+    SDL_Rect merged = *rect;
+    int i;
+
+    if (merged.w <= 0 || merged.h <= 0) {
+        return;
+    }
+
+    for ( ; ; ) {
+        SDL_Rect best_union;
+        Sint64 best_cost = 0;
+        int best = -1;
+
+        for (i = 0; i < *num_damage; ++i) {
+            if (SDL_HasIntersection(&merged, &damage[i])) {
+                best = i;
+                break;
+            }
+        }
+        if (best < 0 && *num_damage == SW_MAX_DAMAGE_RECTS) {
+            for (i = 0; i < *num_damage; ++i) {
+                const SDL_Rect *other = &damage[i];
+                SDL_Rect area;
+                Sint64 cost;
+
+                SDL_UnionRect(&merged, other, &area);
+                cost = (Sint64) area.w * area.h - (Sint64) other->w * other->h - (Sint64) merged.w * merged.h;
+                if (best < 0 || cost < best_cost) {
+                    best = i;
+                    best_cost = cost;
+                }
+            }
+        }
+        if (best < 0) {
+            break;
+        }
+
+        /* The merged rectangle may overlap others now, so start over */
+        SDL_UnionRect(&merged, &damage[best], &best_union);
+        merged = best_union;
+        damage[best] = damage[--(*num_damage)];
+    }
+    damage[(*num_damage)++] = merged;
+}
+
+/* Adds the area a command draws to the damage, if it draws to the window or
+   to the upscale surface, whose damage is upscaled to the window later.
+ */
+static void
+SW_AddCommandDamage(SW_RenderData *data, const SDL_Surface *surface, const SDL_RenderCommand *cmd, void *vertices)
+{
+    SDL_Rect bounds;
+    SDL_bool splittable;
+    SDL_Rect *damage;
+    int *num_damage;
+    int item, num_items;
+
+    if (surface == data->window && !data->damage_all) {
+        damage = data->damage;
+        num_damage = &data->num_damage;
+    } else if (surface == data->upscale && !data->upscale_damage_all) {
+        damage = data->upscale_damage;
+        num_damage = &data->num_upscale_damage;
+    } else {
+        return;
+    }
+
+    switch (cmd->command) {
+        case SDL_RENDERCMD_CLEAR: {
+            if (surface == data->upscale) {
+                /* This clears the borders around it too, see SW_ClearUpscaleBorders() */
+                data->upscale_damage_all = SDL_TRUE;
+            }
+            data->damage_all = SDL_TRUE;
+            break;
+        }
+
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES:
+        case SDL_RENDERCMD_FILL_RECTS:
+        case SDL_RENDERCMD_COPY:
+        case SDL_RENDERCMD_COPY_EX:
+        case SDL_RENDERCMD_GEOMETRY: {
+            num_items = (cmd->command == SDL_RENDERCMD_COPY) ? (int) cmd->data.draw.count : 1;
+            for (item = 0; item < num_items; ++item) {
+                if (SW_GetCommandBounds(cmd, vertices, NULL, item, &bounds, &splittable) &&
+                    SDL_IntersectRect(&bounds, &surface->clip_rect, &bounds)) {
+                    SW_AddDamage(damage, num_damage, &bounds);
+                }
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+/* Upscaling replicates every pixel of a row upscale times, and then the row
+   upscale times. The SIMD rows do 32 bit pixels with an upscale of 2 or 4.
+ */
+typedef void (*SW_UpscaleRowFunc)(Uint8 *dst, const Uint8 *src, int w, int bpp, int upscale);
+
+static void
+SW_UpscaleRow(Uint8 *dst, const Uint8 *src, int w, int bpp, int upscale)
+{
+    int x, i;
+
+    switch (bpp) {
+        case 4: {
+            const Uint32 *srcp = (const Uint32 *) src;
+            Uint32 *dstp = (Uint32 *) dst;
+            for (x = 0; x < w; ++x) {
+                const Uint32 pixel = srcp[x];
+                for (i = 0; i < upscale; ++i) {
+                    *dstp++ = pixel;
+                }
+            }
+            break;
+        }
+
+        case 2: {
+            const Uint16 *srcp = (const Uint16 *) src;
+            Uint16 *dstp = (Uint16 *) dst;
+            for (x = 0; x < w; ++x) {
+                const Uint16 pixel = srcp[x];
+                for (i = 0; i < upscale; ++i) {
+                    *dstp++ = pixel;
+                }
+            }
+            break;
+        }
+
+        default: {
+            for (x = 0; x < w; ++x, src += bpp) {
+                for (i = 0; i < upscale; ++i, dst += bpp) {
+                    SDL_memcpy(dst, src, bpp);
+                }
+            }
+            break;
+        }
+    }
+}
+
+#ifdef __SSE2__
+static void
+SW_UpscaleRow32x2_SSE2(Uint8 *dst, const Uint8 *src, int w, int bpp, int upscale)
+{
+    int x;
+
+    for (x = 0; x + 4 <= w; x += 4, src += 16, dst += 32) {
+        const __m128i pixels = _mm_loadu_si128((const __m128i *) src);
+        _mm_storeu_si128((__m128i *) dst, _mm_unpacklo_epi32(pixels, pixels));
+        _mm_storeu_si128((__m128i *) (dst + 16), _mm_unpackhi_epi32(pixels, pixels));
+    }
+    if (x < w) {
+        SW_UpscaleRow(dst, src, w - x, 4, 2);
+    }
+}
+
+static void
+SW_UpscaleRow32x4_SSE2(Uint8 *dst, const Uint8 *src, int w, int bpp, int upscale)
+{
+    int x;
+
+    for (x = 0; x + 4 <= w; x += 4, src += 16, dst += 64) {
+        const __m128i pixels = _mm_loadu_si128((const __m128i *) src);
+        _mm_storeu_si128((__m128i *) dst, _mm_shuffle_epi32(pixels, _MM_SHUFFLE(0, 0, 0, 0)));
+        _mm_storeu_si128((__m128i *) (dst + 16), _mm_shuffle_epi32(pixels, _MM_SHUFFLE(1, 1, 1, 1)));
+        _mm_storeu_si128((__m128i *) (dst + 32), _mm_shuffle_epi32(pixels, _MM_SHUFFLE(2, 2, 2, 2)));
+        _mm_storeu_si128((__m128i *) (dst + 48), _mm_shuffle_epi32(pixels, _MM_SHUFFLE(3, 3, 3, 3)));
+    }
+    if (x < w) {
+        SW_UpscaleRow(dst, src, w - x, 4, 4);
+    }
+}
+#endif /* __SSE2__ */
+
+#ifdef __ARM_NEON
+static void
+SW_UpscaleRow32x2_NEON(Uint8 *dst, const Uint8 *src, int w, int bpp, int upscale)
+{
+    int x;
+
+    for (x = 0; x + 4 <= w; x += 4, src += 16, dst += 32) {
+        const uint32x4_t pixels = vld1q_u32((const uint32_t *) src);
+        const uint32x4x2_t pairs = vzipq_u32(pixels, pixels);
+        vst1q_u32((uint32_t *) dst, pairs.val[0]);
+        vst1q_u32((uint32_t *) (dst + 16), pairs.val[1]);
+    }
+    if (x < w) {
+        SW_UpscaleRow(dst, src, w - x, 4, 2);
+    }
+}
+
+static void
+SW_UpscaleRow32x4_NEON(Uint8 *dst, const Uint8 *src, int w, int bpp, int upscale)
+{
+    int x;
+
+    for (x = 0; x + 4 <= w; x += 4, src += 16, dst += 64) {
+        const uint32x4_t pixels = vld1q_u32((const uint32_t *) src);
+        const uint32x4x2_t pairs = vzipq_u32(pixels, pixels);
+        const uint32x4x2_t low = vzipq_u32(pairs.val[0], pairs.val[0]);
+        const uint32x4x2_t high = vzipq_u32(pairs.val[1], pairs.val[1]);
+        vst1q_u32((uint32_t *) dst, low.val[0]);
+        vst1q_u32((uint32_t *) (dst + 16), low.val[1]);
+        vst1q_u32((uint32_t *) (dst + 32), high.val[0]);
+        vst1q_u32((uint32_t *) (dst + 48), high.val[1]);
+    }
+    if (x < w) {
+        SW_UpscaleRow(dst, src, w - x, 4, 4);
+    }
+}
+#endif /* __ARM_NEON */
+
+static SW_UpscaleRowFunc
+SW_ChooseUpscaleRow(int bpp, int upscale)
+{
+    if (bpp == 4 && (upscale == 2 || upscale == 4)) {
+#ifdef __SSE2__
+        if (SDL_HasSSE2()) {
+            return (upscale == 2) ? SW_UpscaleRow32x2_SSE2 : SW_UpscaleRow32x4_SSE2;
+        }
+#endif
+#ifdef __ARM_NEON
+        if (SDL_HasNEON()) {
+            return (upscale == 2) ? SW_UpscaleRow32x2_NEON : SW_UpscaleRow32x4_NEON;
+        }
+#endif
+    }
+    return SW_UpscaleRow;
+}
+
+/* Upscales the parts of the upscale surface drawn since the last time to the
+   window. This has to happen before the window is presented, read, or drawn
+   to directly.
+ */
+static void
+SW_ResolveUpscale(SW_RenderData *data)
+{
+    SDL_Surface *src = data->upscale;
+    SDL_Surface *dst = data->window;
+    const SDL_Rect *upscale_rect = &data->upscale_rect;
+    const int upscale = data->upscale_factor;
+    int i, row, n;
+
+    if (!src || !dst || (!data->upscale_damage_all && data->num_upscale_damage == 0)) {
+        return;
+    }
+    if (data->upscale_damage_all) {
+        data->upscale_damage[0].x = 0;
+        data->upscale_damage[0].y = 0;
+        data->upscale_damage[0].w = src->w;
+        data->upscale_damage[0].h = src->h;
+        data->num_upscale_damage = 1;
+    }
+
+    /* If the window changed size since, it's drawn again anyway */
+    if (src->format->format == dst->format->format &&
+        upscale_rect->x + src->w * upscale <= dst->w &&
+        upscale_rect->y + src->h * upscale <= dst->h) {
+        const int bpp = dst->format->BytesPerPixel;
+        const SW_UpscaleRowFunc upscale_row = SW_ChooseUpscaleRow(bpp, upscale);
+
+        for (i = 0; i < data->num_upscale_damage; ++i) {
+            const SDL_Rect *rect = &data->upscale_damage[i];
+            const size_t length = (size_t) rect->w * upscale * bpp;
+            const Uint8 *srcp = (const Uint8 *) src->pixels + rect->y * src->pitch + rect->x * bpp;
+            Uint8 *dstp;
+            SDL_Rect dstrect;
+
+            dstrect.x = upscale_rect->x + rect->x * upscale;
+            dstrect.y = upscale_rect->y + rect->y * upscale;
+            dstrect.w = rect->w * upscale;
+            dstrect.h = rect->h * upscale;
+            dstp = (Uint8 *) dst->pixels + dstrect.y * dst->pitch + dstrect.x * bpp;
+
+            /* Every row is upscaled once, and copied for the rows after it */
+            for (row = 0; row < rect->h; ++row, srcp += src->pitch) {
+                upscale_row(dstp, srcp, rect->w, bpp, upscale);
+                for (n = 1; n < upscale; ++n) {
+                    SDL_memcpy(dstp + n * dst->pitch, dstp, length);
+                }
+                dstp += upscale * dst->pitch;
+            }
+
+            if (!data->damage_all) {
+                SW_AddDamage(data->damage, &data->num_damage, &dstrect);
+            }
+        }
+    }
+
+    data->num_upscale_damage = 0;
+    data->upscale_damage_all = SDL_FALSE;
+}
+
+/* Returns the upscale surface for a viewport drawn at the logical size */
+static SDL_Surface *
+SW_GetUpscaleSurface(SW_RenderData *data, const SW_Viewport *viewport)
+{
+    SDL_Surface *window = data->window;
+    const int w = viewport->upscale_rect.w / viewport->upscale;
+    const int h = viewport->upscale_rect.h / viewport->upscale;
+
+    if (!window) {
+        SDL_SetError("Software renderer doesn't have an output surface");
+        return NULL;
+    }
+
+    if (data->upscale_factor != viewport->upscale ||
+        !SDL_RectEquals(&data->upscale_rect, &viewport->upscale_rect)) {
+        /* What was drawn so far goes where it was meant to */
+        SW_ResolveUpscale(data);
+        data->upscale_factor = viewport->upscale;
+        data->upscale_rect = viewport->upscale_rect;
+        data->upscale_damage_all = SDL_TRUE;
+    }
+
+    if (data->upscale &&
+        (data->upscale->w != w || data->upscale->h != h ||
+         data->upscale->format->format != window->format->format)) {
+        SDL_FreeSurface(data->upscale);
+        data->upscale = NULL;
+    }
+    if (!data->upscale) {
+        data->upscale = SDL_CreateRGBSurfaceWithFormat(0, w, h, window->format->BitsPerPixel,
+                                                       window->format->format);
+        data->upscale_damage_all = SDL_TRUE;
+    }
+    return data->upscale;
+}
+
+/* A clear of the upscale surface clears the borders around it in the window */
+static void
+SW_ClearUpscaleBorders(SW_RenderData *data, const SDL_Surface *surface, const SDL_RenderCommand *cmd)
+{
+    SDL_Surface *window = data->window;
+    const SDL_Rect *inner = &data->upscale_rect;
+    SDL_Rect borders[4];
+    SDL_Rect clip_rect;
+
+    if (surface != data->upscale || !window) {
+        return;
+    }
+
+    borders[0].x = 0;
+    borders[0].y = 0;
+    borders[0].w = window->w;
+    borders[0].h = inner->y;
+    borders[1].x = 0;
+    borders[1].y = inner->y + inner->h;
+    borders[1].w = window->w;
+    borders[1].h = window->h - borders[1].y;
+    borders[2].x = 0;
+    borders[2].y = inner->y;
+    borders[2].w = inner->x;
+    borders[2].h = inner->h;
+    borders[3].x = inner->x + inner->w;
+    borders[3].y = inner->y;
+    borders[3].w = window->w - borders[3].x;
+    borders[3].h = inner->h;
+
+    clip_rect = window->clip_rect;
+    SDL_SetClipRect(window, NULL);
+    SDL_FillRects(window, borders, SDL_arraysize(borders),
+                  SDL_MapRGBA(window->format, cmd->data.color.r, cmd->data.color.g,
+                              cmd->data.color.b, cmd->data.color.a));
+    SDL_SetClipRect(window, &clip_rect);
+}
+
+static void
+SW_DrawTile(void *userdata, int index)
+{
+    const SW_TileJobs *jobs = (const SW_TileJobs *) userdata;
+    SDL_Surface *surface = jobs->surface;
+    const int tile = jobs->tiles[index];
+    SDL_Surface *sources[SW_TILE_SOURCES], *proxies[SW_TILE_SOURCES];
+    int num_sources = 0, evict = 0, i, j;
+    SDL_Rect tile_rect, clip;
+    SDL_Surface *dst;
+
+    tile_rect.x = (tile % jobs->tiles_x) * SW_TILE_SIZE;
+    tile_rect.y = (tile / jobs->tiles_x) * SW_TILE_SIZE;
+    tile_rect.w = SDL_min(SW_TILE_SIZE, surface->w - tile_rect.x);
+    tile_rect.h = SDL_min(SW_TILE_SIZE, surface->h - tile_rect.y);
+
+    /* Clip rectangles and blit mappings live in the surfaces, so every tile
+       draws through its own surfaces, using the pixels of the real ones.
+     */
+    dst = SDL_CreateRGBSurfaceWithFormatFrom(surface->pixels, surface->w, surface->h,
+                                             surface->format->BitsPerPixel, surface->pitch,
+                                             surface->format->format);
+    if (!dst) {
+        return;
+    }
+
+    for (i = jobs->bins[tile]; i < jobs->bins[tile + 1]; ++i) {
+        const SW_TileCommand *tcmd = &jobs->cmds[jobs->items[i]];
+        SDL_Surface *src = tcmd->src;
+
+        if (src) {
+            for (j = 0; j < num_sources && sources[j] != src; ++j) {
+            }
+            if (j == num_sources) {
+                if (num_sources < SW_TILE_SOURCES) {
+                    ++num_sources;
+                } else {
+                    j = evict;
+                    evict = (evict + 1) % SW_TILE_SOURCES;
+                    SDL_FreeSurface(proxies[j]);
+                }
+                sources[j] = src;
+                proxies[j] = SDL_CreateRGBSurfaceWithFormatFrom(src->pixels, src->w, src->h,
+                                                                src->format->BitsPerPixel, src->pitch,
+                                                                src->format->format);
             }
+            src = proxies[j];
+            if (!src) {
+                continue;
+            }
+        }
+
+        SDL_IntersectRect(&tcmd->clip, &tile_rect, &clip);
+        SDL_SetClipRect(dst, &clip);
+        SW_DrawTileCommand(jobs->renderer, dst, src, tcmd, jobs->vertices);
+    }
+
+    for (j = 0; j < num_sources; ++j) {
+        SDL_FreeSurface(proxies[j]);
+    }
+    SDL_FreeSurface(dst);
+}
+
+static void
+SW_DrawTileCommands(SDL_Renderer * renderer, SDL_Surface *surface, void *vertices, int num_cmds)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    const SW_TileCommand *cmds = data->tile_cmds;
+    const int tiles_x = (surface->w + SW_TILE_SIZE - 1) / SW_TILE_SIZE;
+    const int tiles_y = (surface->h + SW_TILE_SIZE - 1) / SW_TILE_SIZE;
+    const int num_tiles = tiles_x * tiles_y;
+    int *bins, *next, *tiles;
+    int i, x, y, num_active = 0;
+    SW_TileJobs jobs;
+
+    if (num_cmds == 0) {
+        return;
+    }
+
+    if (!SW_GrowArray((void **) &data->tile_bins, &data->tile_bins_max, 3 * num_tiles + 1, sizeof(int))) {
+        goto serial;
+    }
+    bins = data->tile_bins;
+    next = bins + num_tiles + 1;
+    tiles = next + num_tiles;
+
+    /* Count the commands in every tile, and find where each tile's start */
+    SDL_memset(bins, 0, (num_tiles + 1) * sizeof(int));
+    for (i = 0; i < num_cmds; ++i) {
+        const SDL_Rect *r = &cmds[i].bounds;
+        for (y = r->y / SW_TILE_SIZE; y <= (r->y + r->h - 1) / SW_TILE_SIZE; ++y) {
+            for (x = r->x / SW_TILE_SIZE; x <= (r->x + r->w - 1) / SW_TILE_SIZE; ++x) {
+                ++bins[y * tiles_x + x + 1];
+            }
+        }
+    }
+    for (i = 0; i < num_tiles; ++i) {
+        if (bins[i + 1]) {
+            tiles[num_active++] = i;
+        }
+        bins[i + 1] += bins[i];
+    }
+
+    if (!SW_GrowArray((void **) &data->tile_items, &data->tile_items_max, bins[num_tiles], sizeof(int))) {
+        goto serial;
+    }
+    SDL_memcpy(next, bins, num_tiles * sizeof(int));
+    for (i = 0; i < num_cmds; ++i) {
+        const SDL_Rect *r = &cmds[i].bounds;
+        for (y = r->y / SW_TILE_SIZE; y <= (r->y + r->h - 1) / SW_TILE_SIZE; ++y) {
+            for (x = r->x / SW_TILE_SIZE; x <= (r->x + r->w - 1) / SW_TILE_SIZE; ++x) {
+                data->tile_items[next[y * tiles_x + x]++] = i;
+            }
+        }
+    }
+
+    jobs.renderer = renderer;
+    jobs.surface = surface;
+    jobs.vertices = vertices;
+    jobs.cmds = cmds;
+    jobs.bins = bins;
+    jobs.items = data->tile_items;
+    jobs.tiles = tiles;
+    jobs.tiles_x = tiles_x;
+    SDL_RunWorkerPoolJobs(data->pool, SW_DrawTile, &jobs, num_active);
+    return;
+
+serial:
+    {
+        const SDL_Rect clip_rect = surface->clip_rect;
+        for (i = 0; i < num_cmds; ++i) {
+            SDL_SetClipRect(surface, &cmds[i].clip);
+            SW_DrawTileCommand(renderer, surface, cmds[i].src, &cmds[i], vertices);
+        }
+        SDL_SetClipRect(surface, &clip_rect);
+    }
+}
+
+static int
+SW_RunCommandQueueTiled(SDL_Renderer * renderer, SDL_Surface *surface, SDL_RenderCommand *cmd, void *vertices)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    const SW_Viewport *viewport = NULL;
+    const SDL_Rect *cliprect = NULL;
+    int num_cmds = 0;
+
+    /* The clip rectangle of the surface is only used to track the state here */
+    while (cmd) {
+        SW_TileCommand tcmd;
+        SDL_bool splittable = SDL_TRUE;
+        int item, num_items;
+
+        SW_CountPixels(renderer, surface, cmd, vertices);
+        SW_AddCommandDamage(data, surface, cmd, vertices);
 
+        switch (cmd->command) {
             case SDL_RENDERCMD_SETVIEWPORT: {
-                viewport = &cmd->data.viewport.rect;
-                SDL_SetClipRect(data->surface, viewport);
+                viewport = SW_GetViewport(cmd, vertices);
+                SW_SetDrawClip(surface, viewport, cliprect);
                 break;
             }
 
             case SDL_RENDERCMD_SETCLIPRECT: {
-                SDL_assert(viewport != NULL);
                 cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;
-                if (cliprect) {
-                    SDL_Rect clip_rect;
-                    clip_rect.x = cliprect->x + viewport->x;
-                    clip_rect.y = cliprect->y + viewport->y;
-                    clip_rect.w = cliprect->w;
-                    clip_rect.h = cliprect->h;
-                    SDL_IntersectRect(viewport, &clip_rect, &clip_rect);
-                    SDL_SetClipRect(surface, &clip_rect);
-                } else {
-                    SDL_SetClipRect(surface, viewport);
-                }
+                SW_SetDrawClip(surface, viewport, cliprect);
                 break;
             }
 
             case SDL_RENDERCMD_CLEAR: {
-                const Uint8 r = cmd->data.color.r;
-                const Uint8 g = cmd->data.color.g;
-                const Uint8 b = cmd->data.color.b;
-                const Uint8 a = cmd->data.color.a;
-                const SDL_Rect clip_rect = surface->clip_rect;
+                SW_ClearUpscaleBorders(data, surface, cmd);
                 /* By definition the clear ignores the clip rect */
-                SDL_SetClipRect(surface, NULL);
-                SDL_FillRect(surface, NULL, SDL_MapRGBA(surface->format, r, g, b, a));
-                SDL_SetClipRect(surface, &clip_rect);
+                tcmd.cmd = cmd;
+                tcmd.src = NULL;
+                tcmd.item = 0;
+                tcmd.clip.x = tcmd.clip.y = 0;
+                tcmd.clip.w = surface->w;
+                tcmd.clip.h = surface->h;
+                tcmd.bounds = tcmd.clip;
+                if (!SW_GrowArray((void **) &data->tile_cmds, &data->tile_cmds_max, num_cmds + 1, sizeof(tcmd))) {
+                    return -1;
+                }
+                data->tile_cmds[num_cmds++] = tcmd;
                 break;
             }
 
-            case SDL_RENDERCMD_DRAW_POINTS: {
-                const Uint8 r = cmd->data.draw.r;
-                const Uint8 g = cmd->data.draw.g;
-                const Uint8 b = cmd->data.draw.b;
-                const Uint8 a = cmd->data.draw.a;
-                const int count = (int) cmd->data.draw.count;
-                const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const SDL_BlendMode blend = cmd->data.draw.blend;
-                if (blend == SDL_BLENDMODE_NONE) {
-                    SDL_DrawPoints(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
-                } else {
-                    SDL_BlendPoints(surface, verts, count, blend, r, g, b, a);
+            case SDL_RENDERCMD_DRAW_POINTS:
+            case SDL_RENDERCMD_DRAW_LINES:
+            case SDL_RENDERCMD_FILL_RECTS:
+            case SDL_RENDERCMD_COPY:
+            case SDL_RENDERCMD_COPY_EX:
+            case SDL_RENDERCMD_GEOMETRY: {
+                tcmd.cmd = cmd;
+                tcmd.src = NULL;
+                tcmd.clip = surface->clip_rect;
+                if (cmd->command == SDL_RENDERCMD_COPY || cmd->command == SDL_RENDERCMD_COPY_EX ||
+                    cmd->command == SDL_RENDERCMD_GEOMETRY) {
+                    if (SW_GetCopySource(renderer, cmd, surface, vertices, &tcmd.src) < 0) {
+                        break;
+                    }
+                    if (tcmd.src) {
+                        /* The tiles need the raw pixels of the texture */
+                        SDL_SetSurfaceRLE(tcmd.src, 0);
+                    }
+                }
+                num_items = (cmd->command == SDL_RENDERCMD_COPY) ? (int) cmd->data.draw.count : 1;
+                for (item = 0; item < num_items; ++item) {
+                    tcmd.item = item;
+                    if (!SW_GetCommandBounds(cmd, vertices, tcmd.src, item, &tcmd.bounds, &splittable) ||
+                        !SDL_IntersectRect(&tcmd.bounds, &tcmd.clip, &tcmd.bounds)) {
+                        continue;
+                    }
+                    if (splittable ||
+                        ((tcmd.bounds.x / SW_TILE_SIZE) == (tcmd.bounds.x + tcmd.bounds.w - 1) / SW_TILE_SIZE &&
+                         (tcmd.bounds.y / SW_TILE_SIZE) == (tcmd.bounds.y + tcmd.bounds.h - 1) / SW_TILE_SIZE)) {
+                        if (!SW_GrowArray((void **) &data->tile_cmds, &data->tile_cmds_max, num_cmds + 1, sizeof(tcmd))) {
+                            return -1;
+                        }
+                        data->tile_cmds[num_cmds++] = tcmd;
+                    } else {
+                        SW_DrawTileCommands(renderer, surface, vertices, num_cmds);
+                        num_cmds = 0;
+                        SW_DrawTileCommand(renderer, surface, tcmd.src, &tcmd, vertices);
+                    }
                 }
                 break;
             }
 
-            case SDL_RENDERCMD_DRAW_LINES: {
-                const Uint8 r = cmd->data.draw.r;
-                const Uint8 g = cmd->data.draw.g;
-                const Uint8 b = cmd->data.draw.b;
-                const Uint8 a = cmd->data.draw.a;
-                const int count = (int) cmd->data.draw.count;
-                const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const SDL_BlendMode blend = cmd->data.draw.blend;
-                if (blend == SDL_BLENDMODE_NONE) {
-                    SDL_DrawLines(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
-                } else {
-                    SDL_BlendLines(surface, verts, count, blend, r, g, b, a);
-                }
+            default:
                 break;
+        }
+
+        cmd = cmd->next;
+    }
+
+    SW_DrawTileCommands(renderer, surface, vertices, num_cmds);
+
+    return 0;
+}
+
+static int
+SW_RunCommands(SDL_Renderer * renderer, SDL_Surface *surface, SDL_RenderCommand *cmd, void *vertices)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    const SW_Viewport *viewport = NULL;
+    const SDL_Rect *cliprect = NULL;
+
+    if (SW_UseTiles(data, surface)) {
+        return SW_RunCommandQueueTiled(renderer, surface, cmd, vertices);
+    }
+
+    while (cmd) {
+        SW_CountPixels(renderer, surface, cmd, vertices);
+        SW_AddCommandDamage(data, surface, cmd, vertices);
+
+        switch (cmd->command) {
+            case SDL_RENDERCMD_SETDRAWCOLOR: {
+                break;  /* Not used in this backend. */
             }
 
-            case SDL_RENDERCMD_FILL_RECTS: {
-                const Uint8 r = cmd->data.draw.r;
-                const Uint8 g = cmd->data.draw.g;
-                const Uint8 b = cmd->data.draw.b;
-                const Uint8 a = cmd->data.draw.a;
-                const int count = (int) cmd->data.draw.count;
-                const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const SDL_BlendMode blend = cmd->data.draw.blend;
-                if (blend == SDL_BLENDMODE_NONE) {
-                    SDL_FillRects(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
-                } else {
-                    SDL_BlendFillRects(surface, verts, count, blend, r, g, b, a);
-                }
+            case SDL_RENDERCMD_SETVIEWPORT: {
+                viewport = SW_GetViewport(cmd, vertices);
+                SW_SetDrawClip(surface, viewport, cliprect);
                 break;
             }
 
-            case SDL_RENDERCMD_COPY: {
-                SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const SDL_Rect *srcrect = verts;
-                SDL_Rect *dstrect = verts + 1;
-                SDL_Texture *texture = cmd->data.draw.texture;
-                SDL_Surface *src = (SDL_Surface *) texture->driverdata;
+            case SDL_RENDERCMD_SETCLIPRECT: {
+                cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;
+                SW_SetDrawClip(surface, viewport, cliprect);
+                break;
+            }
 
-                PrepTextureForCopy(cmd);
+            case SDL_RENDERCMD_CLEAR: {
+                const SDL_Rect clip_rect = surface->clip_rect;
+                SW_ClearUpscaleBorders(data, surface, cmd);
+                /* By definition the clear ignores the clip rect */
+                SDL_SetClipRect(surface, NULL);
+                SW_DrawCommand(renderer, surface, NULL, cmd, vertices);
+                SDL_SetClipRect(surface, &clip_rect);
+                break;
+            }
 
-                if ( srcrect->w == dstrect->w && srcrect->h == dstrect->h ) {
-                    SDL_BlitSurface(src, srcrect, surface, dstrect);
-                } else {
-                    /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
-                     * to avoid potentially frequent RLE encoding/decoding.
-                     */
-                    SDL_SetSurfaceRLE(surface, 0);
-                    SDL_BlitScaled(src, srcrect, surface, dstrect);
-                }
+            case SDL_RENDERCMD_DRAW_POINTS:
+            case SDL_RENDERCMD_DRAW_LINES:
+            case SDL_RENDERCMD_FILL_RECTS: {
+                SW_DrawCommand(renderer, surface, NULL, cmd, vertices);
                 break;
             }
 
-            case SDL_RENDERCMD_COPY_EX: {
-                const CopyExData *copydata = (CopyExData *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                PrepTextureForCopy(cmd);
-                SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
-                                &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip);
+            case SDL_RENDERCMD_COPY:
+            case SDL_RENDERCMD_COPY_EX:
+            case SDL_RENDERCMD_GEOMETRY: {
+                SDL_Surface *src;
+                if (SW_GetCopySource(renderer, cmd, surface, vertices, &src) == 0) {
+                    SW_DrawCommand(renderer, surface, src, cmd, vertices);
+                }
                 break;
             }
 
@@ -709,10 +2349,78 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
     return 0;
 }
 
+/* Whether two viewports draw to the same surface at the same place */
+static SDL_bool
+SW_SameUpscale(const SW_Viewport *a, const SW_Viewport *b)
+{
+    if (a->upscale != b->upscale) {
+        return SDL_FALSE;
+    }
+    return !a->upscale || SDL_RectEquals(&a->upscale_rect, &b->upscale_rect);
+}
+
+static int
+SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+    SW_Viewport direct;
+
+    if (!surface) {
+        return -1;
+    }
+
+    /* The target texture is about to be drawn to */
+    if (renderer->target) {
+        SW_InvalidateTextureCaches(renderer, renderer->target);
+    }
+
+    /* The viewports drawn at the logical size go to the upscale surface, so
+       the commands are run separately for every change of surface.
+     */
+    SDL_zero(direct);
+    while (cmd) {
+        const SW_Viewport *viewport = &direct;
+        SDL_Surface *run_surface = surface;
+        SDL_RenderCommand *last = cmd, *next;
+        int retval;
+
+        if (cmd->command == SDL_RENDERCMD_SETVIEWPORT) {
+            viewport = SW_GetViewport(cmd, vertices);
+        }
+        while (last->next && (last->next->command != SDL_RENDERCMD_SETVIEWPORT ||
+                              SW_SameUpscale(viewport, SW_GetViewport(last->next, vertices)))) {
+            last = last->next;
+        }
+
+        if (viewport->upscale) {
+            run_surface = SW_GetUpscaleSurface(data, viewport);
+            if (!run_surface) {
+                return -1;
+            }
+        } else if (surface == data->window) {
+            /* Whatever was drawn at the logical size is below this */
+            SW_ResolveUpscale(data);
+        }
+
+        next = last->next;
+        last->next = NULL;
+        retval = SW_RunCommands(renderer, run_surface, cmd, vertices);
+        last->next = next;
+        if (retval < 0) {
+            return retval;
+        }
+        cmd = next;
+    }
+
+    return 0;
+}
+
 static int
 SW_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                     Uint32 format, void * pixels, int pitch)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     Uint32 src_format;
     void *src_pixels;
@@ -721,6 +2429,10 @@ SW_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
         return -1;
     }
 
+    if (surface == data->window) {
+        SW_ResolveUpscale(data);
+    }
+
     /* NOTE: The rect is already adjusted according to the viewport by
      * SDL_RenderReadPixels.
      */
@@ -740,14 +2452,43 @@ SW_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                              format, pixels, pitch);
 }
 
+/* Only the parts of the window that were drawn to are updated */
 static void
 SW_RenderPresent(SDL_Renderer * renderer)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Window *window = renderer->window;
 
-    if (window) {
-        SDL_UpdateWindowSurface(window);
+    SW_ActivateRenderer(renderer);
+    SW_ResolveUpscale(data);
+
+    if (data->damage_all && data->window) {
+        data->damage[0].x = 0;
+        data->damage[0].y = 0;
+        data->damage[0].w = data->window->w;
+        data->damage[0].h = data->window->h;
+        data->num_damage = 1;
+        data->damage_all = SDL_FALSE;
+    }
+
+    if (window && data->num_damage > 0) {
+        SDL_UpdateWindowSurfaceRects(window, data->damage, data->num_damage);
     }
+
+    SDL_memcpy(data->presented_damage, data->damage, data->num_damage * sizeof(SDL_Rect));
+    data->num_presented_damage = data->num_damage;
+    data->num_damage = 0;
+}
+
+static int
+SW_GetDamageRects(SDL_Renderer * renderer, SDL_Rect * rects, int maxrects)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+
+    if (rects) {
+        SDL_memcpy(rects, data->presented_damage, SDL_min(maxrects, data->num_presented_damage) * sizeof(SDL_Rect));
+    }
+    return data->num_presented_damage;
 }
 
 static void
@@ -755,6 +2496,13 @@ SW_DestroyTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 {
     SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
 
+    SW_InvalidateTextureCaches(renderer, texture);
+
+    if (SDL_ISPIXELFORMAT_FOURCC(texture->format)) {
+        SDL_SW_DestroyYUVTexture((SDL_SW_YUVTexture *) texture->driverdata);
+        return;
+    }
+
     SDL_FreeSurface(surface);
 }
 
@@ -763,6 +2511,21 @@ SW_DestroyRenderer(SDL_Renderer * renderer)
 {
     SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
 
+    if (data) {
+        int i;
+
+        for (i = 0; i < SW_ROTATED_CACHE_SIZE; ++i) {
+            SW_FreeRotatedSurface(&data->rotated_cache[i]);
+        }
+        for (i = 0; i < SW_CONVERTED_CACHE_SIZE; ++i) {
+            SW_FreeConvertedSurface(&data->converted_cache[i]);
+        }
+        SDL_DestroyWorkerPool(data->pool);
+        SDL_free(data->tile_cmds);
+        SDL_free(data->tile_bins);
+        SDL_free(data->tile_items);
+        SDL_FreeSurface(data->upscale);
+    }
     SDL_free(data);
     SDL_free(renderer);
 }
@@ -792,24 +2555,30 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     }
     data->surface = surface;
     data->window = surface;
+    data->damage_all = SDL_TRUE;
+    data->upscale_enabled = SDL_GetHintBoolean(SDL_HINT_RENDER_SOFTWARE_UPSCALE, SDL_FALSE);
 
     renderer->WindowEvent = SW_WindowEvent;
     renderer->GetOutputSize = SW_GetOutputSize;
     renderer->CreateTexture = SW_CreateTexture;
     renderer->UpdateTexture = SW_UpdateTexture;
+    renderer->UpdateTextureYUV = SW_UpdateTextureYUV;
     renderer->LockTexture = SW_LockTexture;
     renderer->UnlockTexture = SW_UnlockTexture;
     renderer->SetRenderTarget = SW_SetRenderTarget;
     renderer->QueueSetViewport = SW_QueueSetViewport;
-    renderer->QueueSetDrawColor = SW_QueueSetViewport;  /* SetViewport and SetDrawColor are (currently) no-ops. */
+    renderer->QueueSetDrawColor = SW_QueueSetDrawColor;
     renderer->QueueDrawPoints = SW_QueueDrawPoints;
     renderer->QueueDrawLines = SW_QueueDrawPoints;  /* lines and points queue vertices the same way. */
     renderer->QueueFillRects = SW_QueueFillRects;
     renderer->QueueCopy = SW_QueueCopy;
+    renderer->QueueCopyBatch = SW_QueueCopyBatch;
     renderer->QueueCopyEx = SW_QueueCopyEx;
+    renderer->QueueGeometry = SW_QueueGeometry;
     renderer->RunCommandQueue = SW_RunCommandQueue;
     renderer->RenderReadPixels = SW_RenderReadPixels;
     renderer->RenderPresent = SW_RenderPresent;
+    renderer->GetDamageRects = SW_GetDamageRects;
     renderer->DestroyTexture = SW_DestroyTexture;
     renderer->DestroyRenderer = SW_DestroyRenderer;
     renderer->info = SW_RenderDriver.info;
@@ -837,7 +2606,7 @@ SDL_RenderDriver SW_RenderDriver = {
     {
      "software",
      SDL_RENDERER_SOFTWARE | SDL_RENDERER_TARGETTEXTURE,
-     8,
+     15,
      {
       SDL_PIXELFORMAT_ARGB8888,
       SDL_PIXELFORMAT_ABGR8888,
@@ -846,7 +2615,14 @@ SDL_RenderDriver SW_RenderDriver = {
       SDL_PIXELFORMAT_RGB888,
       SDL_PIXELFORMAT_BGR888,
       SDL_PIXELFORMAT_RGB565,
-      SDL_PIXELFORMAT_RGB555
+      SDL_PIXELFORMAT_RGB555,
+      SDL_PIXELFORMAT_YV12,
+      SDL_PIXELFORMAT_IYUV,
+      SDL_PIXELFORMAT_YUY2,
+      SDL_PIXELFORMAT_UYVY,
+      SDL_PIXELFORMAT_YVYU,
+      SDL_PIXELFORMAT_NV12,
+      SDL_PIXELFORMAT_NV21
      },
      0,
      0}
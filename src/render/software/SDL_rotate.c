@@ -207,6 +207,277 @@ transformSurfaceY90(SDL_Surface * src, SDL_Surface * dst, int angle, int flipx,
 
 #undef TRANSFORM_SURFACE_90
 
+/* !
+\brief Bilinear interpolation of one pixel for the 32 bit rotozoomer.
+
+Leaves the destination pixel alone when the source position is outside of the source surface.
+
+\param src Source surface.
+\param pc Destination pixel.
+\param sdx Horizontal 16.16 fixed point source position.
+\param sdy Vertical 16.16 fixed point source position.
+\param flipx Flag indicating horizontal mirroring should be applied.
+\param flipy Flag indicating vertical mirroring should be applied.
+*/
+SDL_FORCE_INLINE void
+_interpolatePixelRGBA(SDL_Surface * src, tColorRGBA * pc, int sdx, int sdy, int flipx, int flipy)
+{
+    int t1, t2, dx, dy, ex, ey;
+    tColorRGBA c00, c01, c10, c11, cswap;
+    tColorRGBA *sp;
+
+    dx = (sdx >> 16);
+    dy = (sdy >> 16);
+    if (flipx) dx = (src->w - 1) - dx;
+    if (flipy) dy = (src->h - 1) - dy;
+    if ((dx > -1) && (dy > -1) && (dx < (src->w-1)) && (dy < (src->h-1))) {
+        sp = (tColorRGBA *) ((Uint8 *) src->pixels + src->pitch * dy) + dx;
+        c00 = *sp;
+        sp += 1;
+        c01 = *sp;
+        sp += (src->pitch/4);
+        c11 = *sp;
+        sp -= 1;
+        c10 = *sp;
+        if (flipx) {
+            cswap = c00; c00=c01; c01=cswap;
+            cswap = c10; c10=c11; c11=cswap;
+        }
+        if (flipy) {
+            cswap = c00; c00=c10; c10=cswap;
+            cswap = c01; c01=c11; c11=cswap;
+        }
+        /*
+        * Interpolate colors
+        */
+        ex = (sdx & 0xffff);
+        ey = (sdy & 0xffff);
+        t1 = ((((c01.r - c00.r) * ex) >> 16) + c00.r) & 0xff;
+        t2 = ((((c11.r - c10.r) * ex) >> 16) + c10.r) & 0xff;
+        pc->r = (((t2 - t1) * ey) >> 16) + t1;
+        t1 = ((((c01.g - c00.g) * ex) >> 16) + c00.g) & 0xff;
+        t2 = ((((c11.g - c10.g) * ex) >> 16) + c10.g) & 0xff;
+        pc->g = (((t2 - t1) * ey) >> 16) + t1;
+        t1 = ((((c01.b - c00.b) * ex) >> 16) + c00.b) & 0xff;
+        t2 = ((((c11.b - c10.b) * ex) >> 16) + c10.b) & 0xff;
+        pc->b = (((t2 - t1) * ey) >> 16) + t1;
+        t1 = ((((c01.a - c00.a) * ex) >> 16) + c00.a) & 0xff;
+        t2 = ((((c11.a - c10.a) * ex) >> 16) + c10.a) & 0xff;
+        pc->a = (((t2 - t1) * ey) >> 16) + t1;
+    }
+}
+
+/* !
+\brief Interpolates a row of the 32 bit rotozoomer.
+
+\param src Source surface.
+\param pc First destination pixel of the row.
+\param w Number of destination pixels.
+\param sdx Horizontal 16.16 fixed point source position of the first pixel.
+\param sdy Vertical 16.16 fixed point source position of the first pixel.
+\param icos Horizontal source step per destination pixel.
+\param isin Vertical source step per destination pixel.
+\param flipx Flag indicating horizontal mirroring should be applied.
+\param flipy Flag indicating vertical mirroring should be applied.
+*/
+typedef void (*tTransformRowRGBA)(SDL_Surface * src, tColorRGBA * pc, int w, int sdx, int sdy,
+                                  int icos, int isin, int flipx, int flipy);
+
+static void
+_transformRowRGBA(SDL_Surface * src, tColorRGBA * pc, int w, int sdx, int sdy,
+                  int icos, int isin, int flipx, int flipy)
+{
+    int x;
+
+    for (x = 0; x < w; x++) {
+        _interpolatePixelRGBA(src, pc, sdx, sdy, flipx, flipy);
+        sdx += icos;
+        sdy += isin;
+        pc++;
+    }
+}
+
+/*
+ * The SIMD rows give the same pixels as _interpolatePixelRGBA(): every channel is interpolated
+ * as (((c1 - c0) * e) >> 16) + c0 with a 16 bit weight e, rounding down. They do two destination
+ * pixels at a time, and go through _interpolatePixelRGBA() when either of them is near an edge.
+ */
+#ifdef __SSE2__
+/* !
+\brief Computes (a * w) >> 16 for signed 16 bit lanes a and unsigned 16 bit weights w.
+*/
+SDL_FORCE_INLINE __m128i
+_mulhiSSE2(__m128i a, __m128i w)
+{
+    /* The signed multiplication takes w - 65536 for weights from 32768 on, which takes 'a' off the result */
+    return _mm_add_epi16(_mm_mulhi_epi16(a, w), _mm_and_si128(a, _mm_srai_epi16(w, 15)));
+}
+
+/* !
+\brief Interpolates the top and bottom rows of the 2x2 source pixels at (dx, dy) with weight ex.
+*/
+SDL_FORCE_INLINE __m128i
+_lerpRowsSSE2(SDL_Surface * src, int dx, int dy, int ex, int flipx, int flipy)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const Uint8 *sp = (const Uint8 *) src->pixels + src->pitch * dy + dx * 4;
+    __m128i top = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) sp), zero);
+    __m128i bottom = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (sp + src->pitch)), zero);
+    __m128i left, right, swap;
+
+    if (flipx) {
+        top = _mm_shuffle_epi32(top, _MM_SHUFFLE(1, 0, 3, 2));
+        bottom = _mm_shuffle_epi32(bottom, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+    if (flipy) {
+        swap = top; top = bottom; bottom = swap;
+    }
+    left = _mm_unpacklo_epi64(top, bottom);     /* c00, c10 */
+    right = _mm_unpackhi_epi64(top, bottom);    /* c01, c11 */
+    return _mm_add_epi16(_mulhiSSE2(_mm_sub_epi16(right, left), _mm_set1_epi16((short) ex)), left);
+}
+
+static void
+_transformRowRGBA_SSE2(SDL_Surface * src, tColorRGBA * pc, int w, int sdx, int sdy,
+                       int icos, int isin, int flipx, int flipy)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const unsigned sw = src->w - 1, sh = src->h - 1;
+    int x = 0;
+
+    for (; x + 1 < w; x += 2) {
+        int dx0 = (sdx >> 16), dy0 = (sdy >> 16);
+        int dx1 = ((sdx + icos) >> 16), dy1 = ((sdy + isin) >> 16);
+        int ey0, ey1;
+        __m128i a, b, top, bottom, wy;
+
+        if (flipx) {
+            dx0 = sw - dx0;
+            dx1 = sw - dx1;
+        }
+        if (flipy) {
+            dy0 = sh - dy0;
+            dy1 = sh - dy1;
+        }
+        if ((unsigned)dx0 >= sw || (unsigned)dy0 >= sh || (unsigned)dx1 >= sw || (unsigned)dy1 >= sh) {
+            _transformRowRGBA(src, pc, 2, sdx, sdy, icos, isin, flipx, flipy);
+        } else {
+            ey0 = (sdy & 0xffff);
+            ey1 = ((sdy + isin) & 0xffff);
+            a = _lerpRowsSSE2(src, dx0, dy0, (sdx & 0xffff), flipx, flipy);
+            b = _lerpRowsSSE2(src, dx1, dy1, ((sdx + icos) & 0xffff), flipx, flipy);
+            top = _mm_unpacklo_epi64(a, b);
+            bottom = _mm_unpackhi_epi64(a, b);
+            wy = _mm_set_epi16((short) ey1, (short) ey1, (short) ey1, (short) ey1,
+                               (short) ey0, (short) ey0, (short) ey0, (short) ey0);
+            top = _mm_add_epi16(_mulhiSSE2(_mm_sub_epi16(bottom, top), wy), top);
+            _mm_storel_epi64((__m128i *) pc, _mm_packus_epi16(top, zero));
+        }
+        sdx += 2 * icos;
+        sdy += 2 * isin;
+        pc += 2;
+    }
+
+    if (x < w) {
+        _transformRowRGBA(src, pc, w - x, sdx, sdy, icos, isin, flipx, flipy);
+    }
+}
+#endif /* __SSE2__ */
+
+#ifdef __ARM_NEON
+/* !
+\brief Computes (a * w) >> 16 for signed 16 bit lanes a, with weight w0 for the low half and w1 for the high half.
+*/
+SDL_FORCE_INLINE int16x8_t
+_mulhiNEON(int16x8_t a, int w0, int w1)
+{
+    return vcombine_s16(vshrn_n_s32(vmulq_s32(vmovl_s16(vget_low_s16(a)), vdupq_n_s32(w0)), 16),
+                        vshrn_n_s32(vmulq_s32(vmovl_s16(vget_high_s16(a)), vdupq_n_s32(w1)), 16));
+}
+
+/* !
+\brief Interpolates the top and bottom rows of the 2x2 source pixels at (dx, dy) with weight ex.
+*/
+SDL_FORCE_INLINE int16x8_t
+_lerpRowsNEON(SDL_Surface * src, int dx, int dy, int ex, int flipx, int flipy)
+{
+    const Uint8 *sp = (const Uint8 *) src->pixels + src->pitch * dy + dx * 4;
+    int16x8_t top = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(sp)));
+    int16x8_t bottom = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(sp + src->pitch)));
+    int16x8_t left, right, swap;
+
+    if (flipx) {
+        top = vextq_s16(top, top, 4);
+        bottom = vextq_s16(bottom, bottom, 4);
+    }
+    if (flipy) {
+        swap = top; top = bottom; bottom = swap;
+    }
+    left = vcombine_s16(vget_low_s16(top), vget_low_s16(bottom));       /* c00, c10 */
+    right = vcombine_s16(vget_high_s16(top), vget_high_s16(bottom));    /* c01, c11 */
+    return vaddq_s16(_mulhiNEON(vsubq_s16(right, left), ex, ex), left);
+}
+
+static void
+_transformRowRGBA_NEON(SDL_Surface * src, tColorRGBA * pc, int w, int sdx, int sdy,
+                       int icos, int isin, int flipx, int flipy)
+{
+    const unsigned sw = src->w - 1, sh = src->h - 1;
+    int x = 0;
+
+    for (; x + 1 < w; x += 2) {
+        int dx0 = (sdx >> 16), dy0 = (sdy >> 16);
+        int dx1 = ((sdx + icos) >> 16), dy1 = ((sdy + isin) >> 16);
+        int16x8_t a, b, top, bottom;
+
+        if (flipx) {
+            dx0 = sw - dx0;
+            dx1 = sw - dx1;
+        }
+        if (flipy) {
+            dy0 = sh - dy0;
+            dy1 = sh - dy1;
+        }
+        if ((unsigned)dx0 >= sw || (unsigned)dy0 >= sh || (unsigned)dx1 >= sw || (unsigned)dy1 >= sh) {
+            _transformRowRGBA(src, pc, 2, sdx, sdy, icos, isin, flipx, flipy);
+        } else {
+            a = _lerpRowsNEON(src, dx0, dy0, (sdx & 0xffff), flipx, flipy);
+            b = _lerpRowsNEON(src, dx1, dy1, ((sdx + icos) & 0xffff), flipx, flipy);
+            top = vcombine_s16(vget_low_s16(a), vget_low_s16(b));
+            bottom = vcombine_s16(vget_high_s16(a), vget_high_s16(b));
+            top = vaddq_s16(_mulhiNEON(vsubq_s16(bottom, top), (sdy & 0xffff), ((sdy + isin) & 0xffff)), top);
+            vst1_u8((uint8_t *) pc, vqmovun_s16(top));
+        }
+        sdx += 2 * icos;
+        sdy += 2 * isin;
+        pc += 2;
+    }
+
+    if (x < w) {
+        _transformRowRGBA(src, pc, w - x, sdx, sdy, icos, isin, flipx, flipy);
+    }
+}
+#endif /* __ARM_NEON */
+
+static tTransformRowRGBA
+_chooseTransformRowRGBA(void)
+{
+    if (!SDL_GetHintBoolean(SDL_HINT_RENDER_SOFTWARE_SIMD, SDL_TRUE)) {
+        return _transformRowRGBA;
+    }
+#ifdef __SSE2__
+    if (SDL_HasSSE2()) {
+        return _transformRowRGBA_SSE2;
+    }
+#endif
+#ifdef __ARM_NEON
+    if (SDL_HasNEON()) {
+        return _transformRowRGBA_NEON;
+    }
+#endif
+    return _transformRowRGBA;
+}
+
 /* !
 \brief Internal 32 bit rotozoomer with optional anti-aliasing.
 
@@ -229,9 +500,8 @@ Assumes dst surface was allocated with the correct dimensions.
 static void
 _transformSurfaceRGBA(SDL_Surface * src, SDL_Surface * dst, int cx, int cy, int isin, int icos, int flipx, int flipy, int smooth)
 {
-    int x, y, t1, t2, dx, dy, xd, yd, sdx, sdy, ax, ay, ex, ey, sw, sh;
-    tColorRGBA c00, c01, c10, c11, cswap;
-    tColorRGBA *pc, *sp;
+    int x, y, dx, dy, xd, yd, sdx, sdy, ax, ay, sw, sh;
+    tColorRGBA *pc;
     int gap;
 
     /*
@@ -250,55 +520,13 @@ _transformSurfaceRGBA(SDL_Surface * src, SDL_Surface * dst, int cx, int cy, int
     * Switch between interpolating and non-interpolating code
     */
     if (smooth) {
+        const tTransformRowRGBA transformRow = _chooseTransformRowRGBA();
         for (y = 0; y < dst->h; y++) {
             dy = cy - y;
             sdx = (ax + (isin * dy)) + xd;
             sdy = (ay - (icos * dy)) + yd;
-            for (x = 0; x < dst->w; x++) {
-                dx = (sdx >> 16);
-                dy = (sdy >> 16);
-                if (flipx) dx = sw - dx;
-                if (flipy) dy = sh - dy;
-                if ((dx > -1) && (dy > -1) && (dx < (src->w-1)) && (dy < (src->h-1))) {
-                    sp = (tColorRGBA *) ((Uint8 *) src->pixels + src->pitch * dy) + dx;
-                    c00 = *sp;
-                    sp += 1;
-                    c01 = *sp;
-                    sp += (src->pitch/4);
-                    c11 = *sp;
-                    sp -= 1;
-                    c10 = *sp;
-                    if (flipx) {
-                        cswap = c00; c00=c01; c01=cswap;
-                        cswap = c10; c10=c11; c11=cswap;
-                    }
-                    if (flipy) {
-                        cswap = c00; c00=c10; c10=cswap;
-                        cswap = c01; c01=c11; c11=cswap;
-                    }
-                    /*
-                    * Interpolate colors
-                    */
-                    ex = (sdx & 0xffff);
-                    ey = (sdy & 0xffff);
-                    t1 = ((((c01.r - c00.r) * ex) >> 16) + c00.r) & 0xff;
-                    t2 = ((((c11.r - c10.r) * ex) >> 16) + c10.r) & 0xff;
-                    pc->r = (((t2 - t1) * ey) >> 16) + t1;
-                    t1 = ((((c01.g - c00.g) * ex) >> 16) + c00.g) & 0xff;
-                    t2 = ((((c11.g - c10.g) * ex) >> 16) + c10.g) & 0xff;
-                    pc->g = (((t2 - t1) * ey) >> 16) + t1;
-                    t1 = ((((c01.b - c00.b) * ex) >> 16) + c00.b) & 0xff;
-                    t2 = ((((c11.b - c10.b) * ex) >> 16) + c10.b) & 0xff;
-                    pc->b = (((t2 - t1) * ey) >> 16) + t1;
-                    t1 = ((((c01.a - c00.a) * ex) >> 16) + c00.a) & 0xff;
-                    t2 = ((((c11.a - c10.a) * ex) >> 16) + c10.a) & 0xff;
-                    pc->a = (((t2 - t1) * ey) >> 16) + t1;
-                }
-                sdx += icos;
-                sdy += isin;
-                pc++;
-            }
-            pc = (tColorRGBA *) ((Uint8 *) pc + gap);
+            transformRow(src, pc, dst->w, sdx, sdy, icos, isin, flipx, flipy);
+            pc = (tColorRGBA *) ((Uint8 *) pc + dst->pitch);
         }
     } else {
         for (y = 0; y < dst->h; y++) {
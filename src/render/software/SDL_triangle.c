@@ -0,0 +1,499 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+#if !SDL_RENDER_DISABLED
+
+#include "SDL_surface.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_triangle.h"
+
+/* Triangles are drawn a row at a time: the pixels of the row inside the
+   triangle are shaded into an ARGB8888 span, which is blitted to the target,
+   so the blitters take care of the blend modes and the target formats.
+
+   Vertex positions are snapped to 1/16 pixel, and a pixel is drawn if its
+   center is inside the triangle. A pixel center right on an edge belongs to
+   the triangle if the edge is a top or left edge, so triangles sharing an
+   edge never both draw the pixels along it.
+ */
+#define TRIANGLE_SUBPIXEL_BITS  4
+#define TRIANGLE_SUBPIXELS      (1 << TRIANGLE_SUBPIXEL_BITS)
+#define TRIANGLE_MAX_COORD      1048576.0f      /* keeps the edge functions in 64 bits */
+
+typedef struct
+{
+    Sint64 ax, ay;      /* the start of the edge, in subpixels */
+    Sint64 dx, dy;      /* the end of the edge minus the start */
+    Sint64 bias;        /* 0 for top and left edges, -1 for the others */
+} TriangleEdge;
+
+/* Shades count pixels of a span, with the color channels (r, g, b, a) of
+   pixel i at c[j] + dc[j] * i.
+ */
+typedef void (*ShadeSpanFunc)(Uint32 *pixels, int count, const float *c, const float *dc);
+
+static Sint64
+FloorDiv(Sint64 n, Sint64 d)
+{
+    Sint64 q = n / d;   /* d is positive */
+    if ((n % d) != 0 && n < 0) {
+        --q;
+    }
+    return q;
+}
+
+/* Narrows the pixels [x0, x1] of the row with its centers at cy to the ones
+   inside the edge, where the edge function is positive.
+ */
+static void
+ClipRowToEdge(const TriangleEdge *edge, Sint64 cy, int *x0, int *x1)
+{
+    /* The edge function at the center of pixel x is A * x + K */
+    const Sint64 A = -edge->dy * TRIANGLE_SUBPIXELS;
+    const Sint64 K = edge->dx * (cy - edge->ay) - edge->dy * (TRIANGLE_SUBPIXELS / 2 - edge->ax) + edge->bias;
+
+    if (A > 0) {
+        const Sint64 first = -FloorDiv(K, A);
+        if (first > *x0) {
+            *x0 = (int) SDL_min(first, (Sint64) *x1 + 1);
+        }
+    } else if (A < 0) {
+        const Sint64 last = FloorDiv(K, -A);
+        if (last < *x1) {
+            *x1 = (int) SDL_max(last, (Sint64) *x0 - 1);
+        }
+    } else if (K < 0) {
+        *x1 = *x0 - 1;
+    }
+}
+
+static void
+ShadeSpanRange(Uint32 *pixels, int first, int count, const float *c, const float *dc)
+{
+    int i, j;
+
+    for (i = first; i < count; ++i) {
+        Uint32 channels[4];
+        for (j = 0; j < 4; ++j) {
+            float value = c[j] + dc[j] * (float) i;
+            value = SDL_max(value, 0.0f);
+            value = SDL_min(value, 255.0f);
+            channels[j] = (Uint32) value;
+        }
+        pixels[i] = (channels[3] << 24) | (channels[0] << 16) | (channels[1] << 8) | channels[2];
+    }
+}
+
+static void
+ShadeSpan(Uint32 *pixels, int count, const float *c, const float *dc)
+{
+    ShadeSpanRange(pixels, 0, count, c, dc);
+}
+
+#ifdef __SSE2__
+static __m128i
+ShadeChannelSSE2(__m128 c, __m128 dc, __m128 index)
+{
+    __m128 value = _mm_add_ps(c, _mm_mul_ps(dc, index));
+    value = _mm_max_ps(value, _mm_setzero_ps());
+    value = _mm_min_ps(value, _mm_set1_ps(255.0f));
+    return _mm_cvttps_epi32(value);
+}
+
+static void
+ShadeSpan_SSE2(Uint32 *pixels, int count, const float *c, const float *dc)
+{
+    const __m128 cr = _mm_set1_ps(c[0]), dcr = _mm_set1_ps(dc[0]);
+    const __m128 cg = _mm_set1_ps(c[1]), dcg = _mm_set1_ps(dc[1]);
+    const __m128 cb = _mm_set1_ps(c[2]), dcb = _mm_set1_ps(dc[2]);
+    const __m128 ca = _mm_set1_ps(c[3]), dca = _mm_set1_ps(dc[3]);
+    __m128 index = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    int i;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        __m128i pixel = _mm_slli_epi32(ShadeChannelSSE2(ca, dca, index), 24);
+        pixel = _mm_or_si128(pixel, _mm_slli_epi32(ShadeChannelSSE2(cr, dcr, index), 16));
+        pixel = _mm_or_si128(pixel, _mm_slli_epi32(ShadeChannelSSE2(cg, dcg, index), 8));
+        pixel = _mm_or_si128(pixel, ShadeChannelSSE2(cb, dcb, index));
+        _mm_storeu_si128((__m128i *) &pixels[i], pixel);
+        index = _mm_add_ps(index, _mm_set1_ps(4.0f));
+    }
+    ShadeSpanRange(pixels, i, count, c, dc);
+}
+#endif /* __SSE2__ */
+
+#ifdef __ARM_NEON
+static uint32x4_t
+ShadeChannelNEON(float32x4_t c, float32x4_t dc, float32x4_t index)
+{
+    float32x4_t value = vaddq_f32(c, vmulq_f32(dc, index));
+    value = vmaxq_f32(value, vdupq_n_f32(0.0f));
+    value = vminq_f32(value, vdupq_n_f32(255.0f));
+    return vcvtq_u32_f32(value);
+}
+
+static void
+ShadeSpan_NEON(Uint32 *pixels, int count, const float *c, const float *dc)
+{
+    static const float first[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+    const float32x4_t cr = vdupq_n_f32(c[0]), dcr = vdupq_n_f32(dc[0]);
+    const float32x4_t cg = vdupq_n_f32(c[1]), dcg = vdupq_n_f32(dc[1]);
+    const float32x4_t cb = vdupq_n_f32(c[2]), dcb = vdupq_n_f32(dc[2]);
+    const float32x4_t ca = vdupq_n_f32(c[3]), dca = vdupq_n_f32(dc[3]);
+    float32x4_t index = vld1q_f32(first);
+    int i;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        uint32x4_t pixel = vshlq_n_u32(ShadeChannelNEON(ca, dca, index), 24);
+        pixel = vorrq_u32(pixel, vshlq_n_u32(ShadeChannelNEON(cr, dcr, index), 16));
+        pixel = vorrq_u32(pixel, vshlq_n_u32(ShadeChannelNEON(cg, dcg, index), 8));
+        pixel = vorrq_u32(pixel, ShadeChannelNEON(cb, dcb, index));
+        vst1q_u32(&pixels[i], pixel);
+        index = vaddq_f32(index, vdupq_n_f32(4.0f));
+    }
+    ShadeSpanRange(pixels, i, count, c, dc);
+}
+#endif /* __ARM_NEON */
+
+static ShadeSpanFunc
+ChooseShadeSpan(void)
+{
+#ifdef __SSE2__
+    if (SDL_HasSSE2()) {
+        return ShadeSpan_SSE2;
+    }
+#endif
+#ifdef __ARM_NEON
+    if (SDL_HasNEON()) {
+        return ShadeSpan_NEON;
+    }
+#endif
+    return ShadeSpan;
+}
+
+static SDL_INLINE Uint32
+GetTexel(const SDL_Surface *texture, int x, int y)
+{
+    return *((const Uint32 *) ((const Uint8 *) texture->pixels + y * texture->pitch) + x);
+}
+
+/* Gets a texel coordinate for u, clamped to the texture */
+static SDL_INLINE int
+ClampTexel(float u, int size)
+{
+    if (u <= 0.0f) {
+        return 0;
+    } else if (u >= (float) size) {
+        return size - 1;
+    }
+    return SDL_min((int) u, size - 1);
+}
+
+/* Blends two ARGB8888 pixels, weight is 0 to 256 */
+static SDL_INLINE Uint32
+LerpPixel(Uint32 a, Uint32 b, Uint32 weight)
+{
+    const Uint32 rb = ((((a & 0x00FF00FF) * (256 - weight)) + ((b & 0x00FF00FF) * weight)) >> 8) & 0x00FF00FF;
+    const Uint32 ag = ((((a >> 8) & 0x00FF00FF) * (256 - weight)) + (((b >> 8) & 0x00FF00FF) * weight)) & 0xFF00FF00;
+    return rb | ag;
+}
+
+static void
+SampleSpan(Uint32 *pixels, int count, const SDL_Surface *texture,
+           float u, float v, float du, float dv)
+{
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        const int x = ClampTexel(u + du * (float) i, texture->w);
+        const int y = ClampTexel(v + dv * (float) i, texture->h);
+        pixels[i] = GetTexel(texture, x, y);
+    }
+}
+
+static void
+SampleSpanLinear(Uint32 *pixels, int count, const SDL_Surface *texture,
+                 float u, float v, float du, float dv)
+{
+    const int maxx = texture->w - 1;
+    const int maxy = texture->h - 1;
+    int i;
+
+    /* The texel centers are at +0.5 */
+    u -= 0.5f;
+    v -= 0.5f;
+
+    for (i = 0; i < count; ++i) {
+        float su = u + du * (float) i;
+        float sv = v + dv * (float) i;
+        int x0, y0, x1, y1;
+        Uint32 wx, wy, top, bottom;
+
+        su = SDL_min(SDL_max(su, -1.0f), (float) texture->w);
+        sv = SDL_min(SDL_max(sv, -1.0f), (float) texture->h);
+        x0 = (int) (su + 1.0f) - 1;
+        y0 = (int) (sv + 1.0f) - 1;
+        wx = (Uint32) ((su - (float) x0) * 256.0f);
+        wy = (Uint32) ((sv - (float) y0) * 256.0f);
+        x1 = SDL_min(x0 + 1, maxx);
+        y1 = SDL_min(y0 + 1, maxy);
+        x0 = SDL_min(SDL_max(x0, 0), maxx);
+        y0 = SDL_min(SDL_max(y0, 0), maxy);
+
+        top = LerpPixel(GetTexel(texture, x0, y0), GetTexel(texture, x1, y0), wx);
+        bottom = LerpPixel(GetTexel(texture, x0, y1), GetTexel(texture, x1, y1), wx);
+        pixels[i] = LerpPixel(top, bottom, wy);
+    }
+}
+
+/* Multiplies two 8-bit values, rounding to the nearest */
+static SDL_INLINE Uint32
+MulChannel(Uint32 a, Uint32 b)
+{
+    const Uint32 x = a * b + 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+static SDL_INLINE Uint32
+ModulatePixel(Uint32 pixel, Uint32 color)
+{
+    return (MulChannel(pixel >> 24, color >> 24) << 24) |
+           (MulChannel((pixel >> 16) & 0xFF, (color >> 16) & 0xFF) << 16) |
+           (MulChannel((pixel >> 8) & 0xFF, (color >> 8) & 0xFF) << 8) |
+           MulChannel(pixel & 0xFF, color & 0xFF);
+}
+
+static void
+DrawTriangle(SDL_Surface *dst, SDL_Surface *span, Uint32 *shade, const SDL_Surface *texture,
+             SDL_bool smooth, const SDL_TriangleVertex *vertices, ShadeSpanFunc shadeSpan)
+{
+    const SDL_Rect *clip = &dst->clip_rect;
+    Uint32 *pixels = (Uint32 *) span->pixels;
+    const SDL_TriangleVertex *v[3];
+    Sint64 X[3], Y[3], area;
+    TriangleEdge edges[3];
+    float attr[6][3], dadx[6], dady[6];
+    float fx0, fy0, e1x, e1y, e2x, e2y, det;
+    int minx, miny, maxx, maxy, x, y, i, j;
+    Uint32 color = 0;
+    SDL_bool flat;
+
+    v[0] = &vertices[0];
+    v[1] = &vertices[1];
+    v[2] = &vertices[2];
+    for (i = 0; i < 3; ++i) {
+        const float px = SDL_min(SDL_max(v[i]->x, -TRIANGLE_MAX_COORD), TRIANGLE_MAX_COORD);
+        const float py = SDL_min(SDL_max(v[i]->y, -TRIANGLE_MAX_COORD), TRIANGLE_MAX_COORD);
+        X[i] = (Sint64) SDL_floorf(px * TRIANGLE_SUBPIXELS + 0.5f);
+        Y[i] = (Sint64) SDL_floorf(py * TRIANGLE_SUBPIXELS + 0.5f);
+    }
+
+    /* Wind the triangle so the edge functions are positive inside it */
+    area = (X[1] - X[0]) * (Y[2] - Y[0]) - (Y[1] - Y[0]) * (X[2] - X[0]);
+    if (area == 0) {
+        return;
+    }
+    if (area < 0) {
+        const SDL_TriangleVertex *tv = v[1];
+        Sint64 t;
+        v[1] = v[2];
+        v[2] = tv;
+        t = X[1]; X[1] = X[2]; X[2] = t;
+        t = Y[1]; Y[1] = Y[2]; Y[2] = t;
+        area = -area;
+    }
+
+    /* The pixels with their centers in the bounding box, within the clip rect */
+    minx = (int) -FloorDiv(TRIANGLE_SUBPIXELS / 2 - SDL_min(X[0], SDL_min(X[1], X[2])), TRIANGLE_SUBPIXELS);
+    maxx = (int) FloorDiv(SDL_max(X[0], SDL_max(X[1], X[2])) - TRIANGLE_SUBPIXELS / 2, TRIANGLE_SUBPIXELS);
+    miny = (int) -FloorDiv(TRIANGLE_SUBPIXELS / 2 - SDL_min(Y[0], SDL_min(Y[1], Y[2])), TRIANGLE_SUBPIXELS);
+    maxy = (int) FloorDiv(SDL_max(Y[0], SDL_max(Y[1], Y[2])) - TRIANGLE_SUBPIXELS / 2, TRIANGLE_SUBPIXELS);
+    minx = SDL_max(minx, clip->x);
+    maxx = SDL_min(maxx, clip->x + clip->w - 1);
+    miny = SDL_max(miny, clip->y);
+    maxy = SDL_min(maxy, clip->y + clip->h - 1);
+    if (minx > maxx || miny > maxy) {
+        return;
+    }
+
+    for (i = 0; i < 3; ++i) {
+        const int next = (i + 1) % 3;
+        TriangleEdge *edge = &edges[i];
+        edge->ax = X[i];
+        edge->ay = Y[i];
+        edge->dx = X[next] - X[i];
+        edge->dy = Y[next] - Y[i];
+        edge->bias = (edge->dy < 0 || (edge->dy == 0 && edge->dx > 0)) ? 0 : -1;
+    }
+
+    /* Set up the planes of the colors and texture coordinates */
+    flat = (SDL_memcmp(&v[0]->color, &v[1]->color, sizeof (SDL_Color)) == 0 &&
+            SDL_memcmp(&v[0]->color, &v[2]->color, sizeof (SDL_Color)) == 0);
+    if (flat) {
+        color = ((Uint32) v[0]->color.a << 24) | ((Uint32) v[0]->color.r << 16) |
+                ((Uint32) v[0]->color.g << 8) | v[0]->color.b;
+    }
+    for (i = 0; i < 3; ++i) {
+        attr[0][i] = v[i]->color.r;
+        attr[1][i] = v[i]->color.g;
+        attr[2][i] = v[i]->color.b;
+        attr[3][i] = v[i]->color.a;
+        attr[4][i] = v[i]->u;
+        attr[5][i] = v[i]->v;
+    }
+    fx0 = (float) X[0] / TRIANGLE_SUBPIXELS;
+    fy0 = (float) Y[0] / TRIANGLE_SUBPIXELS;
+    e1x = (float) (X[1] - X[0]) / TRIANGLE_SUBPIXELS;
+    e1y = (float) (Y[1] - Y[0]) / TRIANGLE_SUBPIXELS;
+    e2x = (float) (X[2] - X[0]) / TRIANGLE_SUBPIXELS;
+    e2y = (float) (Y[2] - Y[0]) / TRIANGLE_SUBPIXELS;
+    det = (float) area / (TRIANGLE_SUBPIXELS * TRIANGLE_SUBPIXELS);
+    for (j = 0; j < 6; ++j) {
+        const float d1 = attr[j][1] - attr[j][0];
+        const float d2 = attr[j][2] - attr[j][0];
+        dadx[j] = (d1 * e2y - d2 * e1y) / det;
+        dady[j] = (d2 * e1x - d1 * e2x) / det;
+    }
+
+    for (y = miny; y <= maxy; ++y) {
+        const Sint64 cy = (Sint64) y * TRIANGLE_SUBPIXELS + TRIANGLE_SUBPIXELS / 2;
+        int x0 = minx, x1 = maxx, count;
+        float px, py, c[4];
+        SDL_Rect srcrect, dstrect;
+
+        for (i = 0; i < 3; ++i) {
+            ClipRowToEdge(&edges[i], cy, &x0, &x1);
+        }
+        if (x0 > x1) {
+            continue;
+        }
+        count = x1 - x0 + 1;
+
+        /* The offset of the first pixel center from the first vertex */
+        px = (float) x0 + 0.5f - fx0;
+        py = (float) y + 0.5f - fy0;
+        if (!flat) {
+            for (j = 0; j < 4; ++j) {
+                /* +0.5 to round when the channel is truncated */
+                c[j] = attr[j][0] + dadx[j] * px + dady[j] * py + 0.5f;
+            }
+        }
+
+        if (texture) {
+            const float tu = attr[4][0] + dadx[4] * px + dady[4] * py;
+            const float tv = attr[5][0] + dadx[5] * px + dady[5] * py;
+            if (smooth) {
+                SampleSpanLinear(pixels, count, texture, tu, tv, dadx[4], dadx[5]);
+            } else {
+                SampleSpan(pixels, count, texture, tu, tv, dadx[4], dadx[5]);
+            }
+            if (!flat) {
+                shadeSpan(shade, count, c, dadx);
+                for (x = 0; x < count; ++x) {
+                    pixels[x] = ModulatePixel(pixels[x], shade[x]);
+                }
+            } else if (color != 0xFFFFFFFF) {
+                for (x = 0; x < count; ++x) {
+                    pixels[x] = ModulatePixel(pixels[x], color);
+                }
+            }
+        } else if (flat) {
+            SDL_memset4(pixels, color, count);
+        } else {
+            shadeSpan(pixels, count, c, dadx);
+        }
+
+        srcrect.x = 0;
+        srcrect.y = 0;
+        srcrect.w = count;
+        srcrect.h = 1;
+        dstrect.x = x0;
+        dstrect.y = y;
+        dstrect.w = count;
+        dstrect.h = 1;
+        SDL_LowerBlit(span, &srcrect, dst, &dstrect);
+    }
+}
+
+int
+SDL_SW_DrawTriangles(SDL_Surface * dst, SDL_Surface * src, SDL_bool smooth,
+                     const SDL_TriangleVertex * vertices, int count, SDL_BlendMode blendMode)
+{
+    const ShadeSpanFunc shadeSpan = ChooseShadeSpan();
+    SDL_Surface *texture = NULL;
+    SDL_Surface *span = NULL;
+    Uint32 *pixels = NULL;
+    int i, retval = 0;
+
+    if (!dst) {
+        return SDL_SetError("Passed NULL destination surface");
+    }
+    if (count <= 0 || dst->clip_rect.w <= 0 || dst->clip_rect.h <= 0) {
+        return 0;
+    }
+
+    /* The texels are read straight from ARGB8888 surfaces */
+    if (src) {
+        if (src->format->format == SDL_PIXELFORMAT_ARGB8888 && !SDL_MUSTLOCK(src)) {
+            texture = src;
+        } else {
+            texture = SDL_ConvertSurfaceFormat(src, SDL_PIXELFORMAT_ARGB8888, 0);
+            if (!texture) {
+                return -1;
+            }
+        }
+        if (texture->w <= 0 || texture->h <= 0) {
+            goto done;
+        }
+    }
+
+    /* The span, followed by the colors to modulate a textured span with */
+    pixels = (Uint32 *) SDL_malloc(2 * dst->clip_rect.w * sizeof (Uint32));
+    if (!pixels) {
+        retval = SDL_OutOfMemory();
+        goto done;
+    }
+    span = SDL_CreateRGBSurfaceWithFormatFrom(pixels, dst->clip_rect.w, 1, 32,
+                                              dst->clip_rect.w * sizeof (Uint32),
+                                              SDL_PIXELFORMAT_ARGB8888);
+    if (!span) {
+        retval = -1;
+        goto done;
+    }
+    SDL_SetSurfaceBlendMode(span, blendMode);
+
+    for (i = 0; i < count; ++i, vertices += 3) {
+        DrawTriangle(dst, span, pixels + dst->clip_rect.w, texture, smooth, vertices, shadeSpan);
+    }
+
+done:
+    SDL_FreeSurface(span);
+    SDL_free(pixels);
+    if (texture != src) {
+        SDL_FreeSurface(texture);
+    }
+    return retval;
+}
+
+#endif /* !SDL_RENDER_DISABLED */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,40 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_triangle_h_
+#define SDL_triangle_h_
+
+#include "../../SDL_internal.h"
+
+/* A triangle vertex, as queued by the software renderer */
+typedef struct SDL_TriangleVertex
+{
+    float x, y;         /* position in the target surface */
+    SDL_Color color;    /* color, modulated by the texture color and alpha mod */
+    float u, v;         /* position in the texture, in texels */
+} SDL_TriangleVertex;
+
+extern int SDL_SW_DrawTriangles(SDL_Surface * dst, SDL_Surface * src, SDL_bool smooth,
+                                const SDL_TriangleVertex * vertices, int count, SDL_BlendMode blendMode);
+
+#endif /* SDL_triangle_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
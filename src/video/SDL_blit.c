@@ -21,6 +21,8 @@
 #include "../SDL_internal.h"
 
 #include "SDL_video.h"
+#include "SDL_hints.h"
+#include "SDL_timer.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
 #include "SDL_blit_auto.h"
@@ -28,6 +30,153 @@
 #include "SDL_blit_slow.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
+#include "../SDL_workerpool.h"
+
+/* Multithreaded banded blits, see SDL_HINT_BLIT_THREADS */
+
+/* Smaller operations aren't worth waking up the workers for */
+#define SDL_BLIT_THREADS_MIN_PIXELS (256 * 256)
+#define SDL_BLIT_BAND_MIN_ROWS      16
+
+static SDL_SpinLock SDL_blit_pool_lock = 0;
+static SDL_WorkerPool *SDL_blit_pool = NULL;
+static SDL_atomic_t SDL_blit_pool_users;
+static SDL_bool SDL_blit_pool_failed = SDL_FALSE;
+static SDL_bool SDL_blit_hint_watched = SDL_FALSE;
+static SDL_atomic_t SDL_blit_threads;
+
+static void SDLCALL
+SDL_BlitThreadsChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    int threads = hint ? SDL_atoi(hint) : 0;
+    if (threads < 0) {
+        threads = SDL_GetCPUCount();
+    }
+    SDL_AtomicSet(&SDL_blit_threads, threads);
+}
+
+/* Returns the worker pool and how many threads (including the caller) may be
+   used. A pool that isn't NULL has to be given back with
+   SDL_ReleaseBlitWorkerPool(), SDL_QuitBlitThreads() waits for that.
+ */
+static SDL_WorkerPool *
+SDL_GetBlitWorkerPool(int *num_threads)
+{
+    SDL_WorkerPool *pool;
+    int threads;
+
+    SDL_AtomicLock(&SDL_blit_pool_lock);
+    if (!SDL_blit_hint_watched) {
+        SDL_AddHintCallback(SDL_HINT_BLIT_THREADS, SDL_BlitThreadsChanged, NULL);
+        SDL_blit_hint_watched = SDL_TRUE;
+    }
+    threads = SDL_AtomicGet(&SDL_blit_threads);
+    if (threads > 1 && !SDL_blit_pool && !SDL_blit_pool_failed) {
+        SDL_blit_pool = SDL_CreateWorkerPool("SDLBlitWorker", threads - 1);
+        if (!SDL_blit_pool) {
+            /* Don't try again on every blit */
+            SDL_blit_pool_failed = SDL_TRUE;
+        }
+    }
+    pool = SDL_blit_pool;
+    if (pool) {
+        SDL_AtomicAdd(&SDL_blit_pool_users, 1);
+    }
+    SDL_AtomicUnlock(&SDL_blit_pool_lock);
+
+    *num_threads = SDL_min(threads, SDL_GetWorkerPoolThreadCount(pool) + 1);
+    return pool;
+}
+
+static void
+SDL_ReleaseBlitWorkerPool(SDL_WorkerPool *pool)
+{
+    if (pool) {
+        SDL_AtomicAdd(&SDL_blit_pool_users, -1);
+    }
+}
+
+void
+SDL_QuitBlitThreads(void)
+{
+    SDL_WorkerPool *pool;
+
+    SDL_AtomicLock(&SDL_blit_pool_lock);
+    if (SDL_blit_hint_watched) {
+        SDL_DelHintCallback(SDL_HINT_BLIT_THREADS, SDL_BlitThreadsChanged, NULL);
+        SDL_blit_hint_watched = SDL_FALSE;
+    }
+    pool = SDL_blit_pool;
+    SDL_blit_pool = NULL;
+    SDL_blit_pool_failed = SDL_FALSE;
+    SDL_AtomicSet(&SDL_blit_threads, 0);
+    SDL_AtomicUnlock(&SDL_blit_pool_lock);
+
+    /* Blits that got the pool before it was taken away may still be using it */
+    if (pool) {
+        while (SDL_AtomicGet(&SDL_blit_pool_users) > 0) {
+            SDL_Delay(1);
+        }
+        SDL_DestroyWorkerPool(pool);
+    }
+}
+
+typedef struct
+{
+    SDL_BlitBandFunc func;
+    void *data;
+    int h;
+    int count;
+} SDL_BlitBands;
+
+static void
+SDL_RunBlitBand(void *userdata, int index)
+{
+    const SDL_BlitBands *bands = (const SDL_BlitBands *) userdata;
+    const int y0 = (int) (((Sint64) bands->h * index) / bands->count);
+    const int y1 = (int) (((Sint64) bands->h * (index + 1)) / bands->count);
+
+    bands->func(bands->data, y0, y1 - y0);
+}
+
+void
+SDL_RunBlitBands(SDL_BlitBandFunc func, void *data, int w, int h)
+{
+    if (((Sint64) w * h) >= SDL_BLIT_THREADS_MIN_PIXELS && h >= (2 * SDL_BLIT_BAND_MIN_ROWS)) {
+        int threads;
+        SDL_WorkerPool *pool = SDL_GetBlitWorkerPool(&threads);
+        if (pool && threads > 1) {
+            SDL_BlitBands bands;
+            bands.func = func;
+            bands.data = data;
+            bands.h = h;
+            bands.count = SDL_min(threads, h / SDL_BLIT_BAND_MIN_ROWS);
+            SDL_RunWorkerPoolJobs(pool, SDL_RunBlitBand, &bands, bands.count);
+            SDL_ReleaseBlitWorkerPool(pool);
+            return;
+        }
+        SDL_ReleaseBlitWorkerPool(pool);
+    }
+    func(data, 0, h);
+}
+
+typedef struct
+{
+    SDL_BlitFunc blit;
+    const SDL_BlitInfo *info;
+} SDL_SoftBlitData;
+
+static void
+SDL_SoftBlitBand(void *data, int y, int h)
+{
+    const SDL_SoftBlitData *blitdata = (const SDL_SoftBlitData *) data;
+    SDL_BlitInfo info = *blitdata->info;
+
+    info.src += y * info.src_pitch;
+    info.dst += y * info.dst_pitch;
+    info.src_h = info.dst_h = h;
+    blitdata->blit(&info);
+}
 
 /* The general purpose software blit routine */
 static int SDLCALL
@@ -84,8 +233,18 @@ SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
             info->dst_pitch - info->dst_w * info->dst_fmt->BytesPerPixel;
         RunBlit = (SDL_BlitFunc) src->map->data;
 
-        /* Run the actual software blit */
-        RunBlit(info);
+        /* Run the actual software blit, in bands when it isn't scaling
+           and the source and destination pixels don't overlap */
+        if (info->src_w == info->dst_w && info->src_h == info->dst_h &&
+            ((Uint8 *) src->pixels + src->h * src->pitch <= (Uint8 *) dst->pixels ||
+             (Uint8 *) dst->pixels + dst->h * dst->pitch <= (Uint8 *) src->pixels)) {
+            SDL_SoftBlitData blitdata;
+            blitdata.blit = RunBlit;
+            blitdata.info = info;
+            SDL_RunBlitBands(SDL_SoftBlitBand, &blitdata, info->dst_w, info->dst_h);
+        } else {
+            RunBlit(info);
+        }
     }
 
     /* We need to unlock the surfaces if they're locked */
@@ -38,6 +38,7 @@ extern Uint8* SDL_expand_byte[9];
 #define SDL_COPY_MOD                0x00000040
 #define SDL_COPY_COLORKEY           0x00000100
 #define SDL_COPY_NEAREST            0x00000200
+#define SDL_COPY_LINEAR             0x00000400
 #define SDL_COPY_RLE_DESIRED        0x00001000
 #define SDL_COPY_RLE_COLORKEY       0x00002000
 #define SDL_COPY_RLE_ALPHAKEY       0x00004000
@@ -95,17 +96,41 @@ typedef struct SDL_BlitMap
        an invalid mapping */
     Uint32 dst_palette_version;
     Uint32 src_palette_version;
+
+    /* surfaces kept for linear scaled blits through an intermediate surface
+       until the map is invalidated, see SDL_LowerBlitScaledLinearIntermediate() */
+    SDL_Surface *scale_src;
+    SDL_Surface *scale_tmp[2];
 } SDL_BlitMap;
 
 /* Functions found in SDL_blit.c */
 extern int SDL_CalculateBlit(SDL_Surface * surface);
 
+/* Runs func over rows [y, y+h) of a w x h operation, split into horizontal
+   bands on the blit worker threads when SDL_HINT_BLIT_THREADS allows it.
+   The bands must be independent of each other. */
+typedef void (*SDL_BlitBandFunc) (void *data, int y, int h);
+extern void SDL_RunBlitBands(SDL_BlitBandFunc func, void *data, int w, int h);
+/* Stops the worker threads of banded blits, see SDL_HINT_BLIT_THREADS. This
+   waits for blits that are using them. Called by SDL_Quit(). */
+extern void SDL_QuitBlitThreads(void);
+
 /* Functions found in SDL_blit_*.c */
 extern SDL_BlitFunc SDL_CalculateBlit0(SDL_Surface * surface);
 extern SDL_BlitFunc SDL_CalculateBlit1(SDL_Surface * surface);
 extern SDL_BlitFunc SDL_CalculateBlitN(SDL_Surface * surface);
 extern SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface * surface);
 
+/* Functions found in SDL_stretch.c */
+extern SDL_bool SDL_IsLinearStretchFormat(Uint32 format);
+
+/* Functions found in SDL_surface.c
+   scale_flags is either SDL_COPY_NEAREST or SDL_COPY_LINEAR */
+extern int SDL_PrivateUpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
+                                      SDL_Surface * dst, SDL_Rect * dstrect, int scale_flags);
+extern int SDL_PrivateLowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
+                                      SDL_Surface * dst, SDL_Rect * dstrect, int scale_flags);
+
 /*
  * Useful macros for blitting routines
  */
@@ -883,8 +883,26 @@ GetBlitFeatures(void)
 #pragma altivec_model off
 #endif
 #else
-/* Feature 1 is has-MMX */
-#define GetBlitFeatures() ((Uint32)(SDL_HasMMX() ? 1 : 0))
+static Uint32
+GetBlitFeatures(void)
+{
+    static Uint32 features = 0xffffffff;
+    if (features == 0xffffffff) {
+        features = (0
+                    /* Feature 1 is has-MMX */
+                    | ((SDL_HasMMX())? 1 : 0)
+                    /* Feature 8 is has-SSE2 */
+                    | ((SDL_HasSSE2())? 8 : 0)
+#ifdef __SSSE3__
+                    /* Feature 16 is has-SSSE3, the compiler already assumes it */
+                    | 16
+#endif
+                    /* Feature 32 is has-NEON */
+                    | ((SDL_HasNEON())? 32 : 0)
+            );
+    }
+    return features;
+}
 #endif
 
 /* This is now endian dependent */
@@ -3136,6 +3154,606 @@ Blit_3or4_to_3or4__inversed_rgb(SDL_BlitInfo * info)
     return;
 }
 
+/* SIMD versions of the most common RGB <-> RGB conversions.
+
+   The 32-bit kernels work on whole pixels, so they're endian agnostic. The
+   24-bit ones and everything using NEON structure loads depend on the byte
+   order in memory and are only built for little endian targets. Each blitter
+   finishes the last few pixels of a row with plain C.
+*/
+#if defined(__ARM_NEON) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+#define SDL_NEON_BLITTERS 1
+#endif
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+/* Swap the red and blue channels of a pixel with 8 bits per channel */
+#define SWAP_RB_8888(pixel) \
+    (((pixel) & 0xFF00FF00) | (((pixel) >> 16) & 0xFF) | (((pixel) & 0xFF) << 16))
+
+/* The parts of a 4 byte pixel to keep from the source and to add to the
+   destination, for swizzles to a format with 8-8-8 channels */
+static void
+GetAlphaMasks8888(SDL_BlitInfo * info, Uint32 *keep, Uint32 *fill)
+{
+    if (!info->dst_fmt->Amask) {
+        /* NO_ALPHA */
+        *keep = 0x00FFFFFF;
+        *fill = 0;
+    } else if (info->src_fmt->Amask && info->src_fmt->BytesPerPixel == 4) {
+        /* COPY_ALPHA */
+        *keep = 0xFFFFFFFF;
+        *fill = 0;
+    } else {
+        /* SET_ALPHA */
+        *keep = 0x00FFFFFF;
+        *fill = (Uint32) info->a << info->dst_fmt->Ashift;
+    }
+}
+
+/* Unaligned copies for the vector kernels below. Rows of 3 and 2 byte
+   pixels are only byte or word aligned, so these go through memcpy rather
+   than pointer casts; GCC and Clang turn that into a single move. */
+#ifdef __GNUC__
+#define SDL_BLIT_MEMCPY __builtin_memcpy
+#else
+#define SDL_BLIT_MEMCPY SDL_memcpy
+#endif
+
+static SDL_INLINE void
+StoreUnaligned32(void *dst, Uint32 value)
+{
+    SDL_BLIT_MEMCPY(dst, &value, sizeof(value));
+}
+
+#ifdef __MMX__
+static SDL_INLINE __m64
+LoadUnaligned64(const void *src)
+{
+    __m64 value;
+    SDL_BLIT_MEMCPY(&value, src, sizeof(value));
+    return value;
+}
+
+static SDL_INLINE void
+StoreUnaligned64(void *dst, __m64 value)
+{
+    SDL_BLIT_MEMCPY(dst, &value, sizeof(value));
+}
+
+/* MMX RGB 8-8-8 --> RGB 5-6-5, 4 pixels at a time */
+static void
+Blit_RGB888_RGB565MMX(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *src = (Uint32 *) info->src;
+    int srcskip = info->src_skip / 4;
+    Uint16 *dst = (Uint16 *) info->dst;
+    int dstskip = info->dst_skip / 2;
+    const __m64 rmask = _mm_set1_pi32(0x0000F800);
+    const __m64 gmask = _mm_set1_pi32(0x000007E0);
+    const __m64 bmask = _mm_set1_pi32(0x0000001F);
+
+    while (height--) {
+        int n = width;
+        while (n >= 4) {
+            __m64 s0 = LoadUnaligned64(&src[0]);
+            __m64 s1 = LoadUnaligned64(&src[2]);
+            __m64 d0, d1;
+
+            d0 = _mm_or_si64(_mm_or_si64(
+                    _mm_and_si64(_mm_srli_pi32(s0, 8), rmask),
+                    _mm_and_si64(_mm_srli_pi32(s0, 5), gmask)),
+                    _mm_and_si64(_mm_srli_pi32(s0, 3), bmask));
+            d1 = _mm_or_si64(_mm_or_si64(
+                    _mm_and_si64(_mm_srli_pi32(s1, 8), rmask),
+                    _mm_and_si64(_mm_srli_pi32(s1, 5), gmask)),
+                    _mm_and_si64(_mm_srli_pi32(s1, 3), bmask));
+            /* Sign extend so the saturating pack is exact */
+            d0 = _mm_srai_pi32(_mm_slli_pi32(d0, 16), 16);
+            d1 = _mm_srai_pi32(_mm_slli_pi32(d1, 16), 16);
+            StoreUnaligned64(dst, _mm_packs_pi32(d0, d1));
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        while (n--) {
+            RGB888_RGB565(dst, src);
+            ++src;
+            ++dst;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+    _mm_empty();
+}
+
+/* MMX swap of the red and blue channels of 4 byte pixels, 2 pixels at a time */
+static void
+Blit_4to4_SwapRB_MMX(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *src = (Uint32 *) info->src;
+    int srcskip = info->src_skip / 4;
+    Uint32 *dst = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip / 4;
+    Uint32 keep, fill;
+    __m64 rbmask, agmask, fillmask;
+
+    GetAlphaMasks8888(info, &keep, &fill);
+    rbmask = _mm_set1_pi32(0x00FF00FF);
+    agmask = _mm_set1_pi32((int) (keep & 0xFF00FF00));
+    fillmask = _mm_set1_pi32((int) fill);
+
+    while (height--) {
+        int n = width;
+        while (n >= 2) {
+            __m64 s = LoadUnaligned64(src);
+            __m64 rb = _mm_and_si64(s, rbmask);
+            rb = _mm_or_si64(_mm_slli_pi32(rb, 16), _mm_srli_pi32(rb, 16));
+            StoreUnaligned64(dst, _mm_or_si64(_mm_or_si64(rb, fillmask),
+                                              _mm_and_si64(s, agmask)));
+            src += 2;
+            dst += 2;
+            n -= 2;
+        }
+        if (n) {
+            *dst++ = (SWAP_RB_8888(*src) & keep) | fill;
+            ++src;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+    _mm_empty();
+}
+
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+/* MMX 3 byte --> 4 byte pixels, 2 pixels at a time */
+static void
+Blit_3to4_MMX(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint32 *dst = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip / 4;
+    const SDL_bool swap = (info->src_fmt->Rmask != info->dst_fmt->Rmask);
+    Uint32 keep, fill;
+    __m64 lomask, rbmask, gmask, fillmask;
+
+    GetAlphaMasks8888(info, &keep, &fill);
+    lomask = _mm_set_pi32(0, 0x00FFFFFF);
+    rbmask = _mm_set1_pi32(0x00FF00FF);
+    gmask = _mm_set1_pi32(0x0000FF00);
+    fillmask = _mm_set1_pi32((int) fill);
+
+    while (height--) {
+        int n = width;
+        /* 8 byte loads, so stop while there's a whole pixel left */
+        while (n >= 3) {
+            __m64 s = LoadUnaligned64(src);
+            /* Pixel 0 is in bits 0-23, pixel 1 in bits 24-47 */
+            __m64 p = _mm_or_si64(_mm_and_si64(s, lomask),
+                                  _mm_and_si64(_mm_slli_si64(s, 8),
+                                               _mm_slli_si64(lomask, 32)));
+            if (swap) {
+                __m64 rb = _mm_and_si64(p, rbmask);
+                rb = _mm_or_si64(_mm_slli_pi32(rb, 16), _mm_srli_pi32(rb, 16));
+                p = _mm_or_si64(rb, _mm_and_si64(p, gmask));
+            }
+            StoreUnaligned64(dst, _mm_or_si64(p, fillmask));
+            src += 6;
+            dst += 2;
+            n -= 2;
+        }
+        while (n--) {
+            Uint32 p = src[0] | (src[1] << 8) | (src[2] << 16);
+            *dst++ = (swap ? SWAP_RB_8888(p) : p) | fill;
+            src += 3;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+    _mm_empty();
+}
+
+/* MMX 4 byte --> 3 byte pixels, 4 pixels at a time */
+static void
+Blit_4to3_MMX(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *src = (Uint32 *) info->src;
+    int srcskip = info->src_skip / 4;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const SDL_bool swap = (info->src_fmt->Rmask != info->dst_fmt->Rmask);
+    const __m64 lomask = _mm_set_pi32(0, 0x00FFFFFF);
+    const __m64 rbmask = _mm_set1_pi32(0x00FF00FF);
+    const __m64 gmask = _mm_set1_pi32(0x0000FF00);
+
+    while (height--) {
+        int n = width;
+        while (n >= 4) {
+            __m64 s0 = LoadUnaligned64(&src[0]);
+            __m64 s1 = LoadUnaligned64(&src[2]);
+            if (swap) {
+                __m64 rb0 = _mm_and_si64(s0, rbmask);
+                __m64 rb1 = _mm_and_si64(s1, rbmask);
+                rb0 = _mm_or_si64(_mm_slli_pi32(rb0, 16), _mm_srli_pi32(rb0, 16));
+                rb1 = _mm_or_si64(_mm_slli_pi32(rb1, 16), _mm_srli_pi32(rb1, 16));
+                s0 = _mm_or_si64(rb0, _mm_and_si64(s0, gmask));
+                s1 = _mm_or_si64(rb1, _mm_and_si64(s1, gmask));
+            }
+            /* Pack each pair into 48 bits, then the two pairs into 12 bytes */
+            s0 = _mm_or_si64(_mm_and_si64(s0, lomask),
+                             _mm_and_si64(_mm_srli_si64(s0, 8), _mm_slli_si64(lomask, 24)));
+            s1 = _mm_or_si64(_mm_and_si64(s1, lomask),
+                             _mm_and_si64(_mm_srli_si64(s1, 8), _mm_slli_si64(lomask, 24)));
+            StoreUnaligned64(dst, _mm_or_si64(s0, _mm_slli_si64(s1, 48)));
+            StoreUnaligned32(dst + 8, (Uint32) _mm_cvtsi64_si32(_mm_srli_si64(s1, 16)));
+            src += 4;
+            dst += 12;
+            n -= 4;
+        }
+        while (n--) {
+            Uint32 p = swap ? SWAP_RB_8888(*src) : *src;
+            dst[0] = (Uint8) p;
+            dst[1] = (Uint8) (p >> 8);
+            dst[2] = (Uint8) (p >> 16);
+            ++src;
+            dst += 3;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+    _mm_empty();
+}
+#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
+#endif /* __MMX__ */
+
+#ifdef __SSE2__
+/* SSE2 RGB 8-8-8 --> RGB 5-6-5, 8 pixels at a time */
+static void
+Blit_RGB888_RGB565SSE2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *src = (Uint32 *) info->src;
+    int srcskip = info->src_skip / 4;
+    Uint16 *dst = (Uint16 *) info->dst;
+    int dstskip = info->dst_skip / 2;
+    const __m128i rmask = _mm_set1_epi32(0x0000F800);
+    const __m128i gmask = _mm_set1_epi32(0x000007E0);
+    const __m128i bmask = _mm_set1_epi32(0x0000001F);
+
+    while (height--) {
+        int n = width;
+        while (n >= 8) {
+            __m128i s0 = _mm_loadu_si128((const __m128i *) &src[0]);
+            __m128i s1 = _mm_loadu_si128((const __m128i *) &src[4]);
+            __m128i d0, d1;
+
+            d0 = _mm_or_si128(_mm_or_si128(
+                    _mm_and_si128(_mm_srli_epi32(s0, 8), rmask),
+                    _mm_and_si128(_mm_srli_epi32(s0, 5), gmask)),
+                    _mm_and_si128(_mm_srli_epi32(s0, 3), bmask));
+            d1 = _mm_or_si128(_mm_or_si128(
+                    _mm_and_si128(_mm_srli_epi32(s1, 8), rmask),
+                    _mm_and_si128(_mm_srli_epi32(s1, 5), gmask)),
+                    _mm_and_si128(_mm_srli_epi32(s1, 3), bmask));
+            /* Sign extend so the saturating pack is exact */
+            d0 = _mm_srai_epi32(_mm_slli_epi32(d0, 16), 16);
+            d1 = _mm_srai_epi32(_mm_slli_epi32(d1, 16), 16);
+            _mm_storeu_si128((__m128i *) dst, _mm_packs_epi32(d0, d1));
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        while (n--) {
+            RGB888_RGB565(dst, src);
+            ++src;
+            ++dst;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+/* SSE2 swap of the red and blue channels of 4 byte pixels, 4 pixels at a time */
+static void
+Blit_4to4_SwapRB_SSE2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *src = (Uint32 *) info->src;
+    int srcskip = info->src_skip / 4;
+    Uint32 *dst = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip / 4;
+    Uint32 keep, fill;
+    __m128i rbmask, agmask, fillmask;
+
+    GetAlphaMasks8888(info, &keep, &fill);
+    rbmask = _mm_set1_epi32(0x00FF00FF);
+    agmask = _mm_set1_epi32((int) (keep & 0xFF00FF00));
+    fillmask = _mm_set1_epi32((int) fill);
+
+    while (height--) {
+        int n = width;
+        while (n >= 4) {
+            __m128i s = _mm_loadu_si128((const __m128i *) src);
+            __m128i rb = _mm_and_si128(s, rbmask);
+            rb = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+            _mm_storeu_si128((__m128i *) dst,
+                             _mm_or_si128(_mm_or_si128(rb, fillmask),
+                                          _mm_and_si128(s, agmask)));
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        while (n--) {
+            *dst++ = (SWAP_RB_8888(*src) & keep) | fill;
+            ++src;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+#endif /* __SSE2__ */
+
+#ifdef __SSSE3__
+/* SSSE3 3 byte --> 4 byte pixels, 4 pixels at a time */
+static void
+Blit_3to4_SSSE3(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint32 *dst = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip / 4;
+    const SDL_bool swap = (info->src_fmt->Rmask != info->dst_fmt->Rmask);
+    Uint32 keep, fill;
+    __m128i shuffle, fillmask;
+
+    GetAlphaMasks8888(info, &keep, &fill);
+    if (swap) {
+        shuffle = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    } else {
+        shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    }
+    fillmask = _mm_set1_epi32((int) fill);
+
+    while (height--) {
+        int n = width;
+        /* 16 byte loads, so stop while there are two whole pixels left */
+        while (n >= 6) {
+            __m128i s = _mm_loadu_si128((const __m128i *) src);
+            _mm_storeu_si128((__m128i *) dst,
+                             _mm_or_si128(_mm_shuffle_epi8(s, shuffle), fillmask));
+            src += 12;
+            dst += 4;
+            n -= 4;
+        }
+        while (n--) {
+            Uint32 p = src[0] | (src[1] << 8) | (src[2] << 16);
+            *dst++ = (swap ? SWAP_RB_8888(p) : p) | fill;
+            src += 3;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+/* SSSE3 4 byte --> 3 byte pixels, 4 pixels at a time */
+static void
+Blit_4to3_SSSE3(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *src = (Uint32 *) info->src;
+    int srcskip = info->src_skip / 4;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const SDL_bool swap = (info->src_fmt->Rmask != info->dst_fmt->Rmask);
+    __m128i shuffle;
+
+    if (swap) {
+        shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    } else {
+        shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    }
+
+    while (height--) {
+        int n = width;
+        while (n >= 4) {
+            __m128i d = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) src), shuffle);
+            _mm_storel_epi64((__m128i *) dst, d);
+            StoreUnaligned32(dst + 8, (Uint32) _mm_cvtsi128_si32(_mm_srli_si128(d, 8)));
+            src += 4;
+            dst += 12;
+            n -= 4;
+        }
+        while (n--) {
+            Uint32 p = swap ? SWAP_RB_8888(*src) : *src;
+            dst[0] = (Uint8) p;
+            dst[1] = (Uint8) (p >> 8);
+            dst[2] = (Uint8) (p >> 16);
+            ++src;
+            dst += 3;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+#endif /* __SSSE3__ */
+
+#if SDL_NEON_BLITTERS
+/* NEON RGB 8-8-8 --> RGB 5-6-5, 16 pixels at a time */
+static void
+Blit_RGB888_RGB565NEON(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *src = (Uint32 *) info->src;
+    int srcskip = info->src_skip / 4;
+    Uint16 *dst = (Uint16 *) info->dst;
+    int dstskip = info->dst_skip / 2;
+
+    while (height--) {
+        int n = width;
+        while (n >= 16) {
+            /* val[0] is blue, val[1] green and val[2] red */
+            uint8x16x4_t s = vld4q_u8((const uint8_t *) src);
+            uint16x8_t lo, hi;
+
+            lo = vshll_n_u8(vget_low_u8(s.val[2]), 8);
+            lo = vsriq_n_u16(lo, vshll_n_u8(vget_low_u8(s.val[1]), 8), 5);
+            lo = vsriq_n_u16(lo, vshll_n_u8(vget_low_u8(s.val[0]), 8), 11);
+            hi = vshll_n_u8(vget_high_u8(s.val[2]), 8);
+            hi = vsriq_n_u16(hi, vshll_n_u8(vget_high_u8(s.val[1]), 8), 5);
+            hi = vsriq_n_u16(hi, vshll_n_u8(vget_high_u8(s.val[0]), 8), 11);
+            vst1q_u16(dst, lo);
+            vst1q_u16(dst + 8, hi);
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        while (n--) {
+            RGB888_RGB565(dst, src);
+            ++src;
+            ++dst;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+/* NEON swap of the red and blue channels of 4 byte pixels, 16 pixels at a time */
+static void
+Blit_4to4_SwapRB_NEON(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *src = (Uint32 *) info->src;
+    int srcskip = info->src_skip / 4;
+    Uint32 *dst = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip / 4;
+    Uint32 keep, fill;
+    uint8x16_t alpha;
+
+    GetAlphaMasks8888(info, &keep, &fill);
+    alpha = vdupq_n_u8((uint8_t) (fill >> 24));
+
+    while (height--) {
+        int n = width;
+        while (n >= 16) {
+            uint8x16x4_t s = vld4q_u8((const uint8_t *) src);
+            uint8x16_t tmp = s.val[0];
+            s.val[0] = s.val[2];
+            s.val[2] = tmp;
+            if (!(keep & 0xFF000000)) {
+                s.val[3] = alpha;
+            }
+            vst4q_u8((uint8_t *) dst, s);
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        while (n--) {
+            *dst++ = (SWAP_RB_8888(*src) & keep) | fill;
+            ++src;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+/* NEON 3 byte --> 4 byte pixels, 16 pixels at a time */
+static void
+Blit_3to4_NEON(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint32 *dst = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip / 4;
+    const SDL_bool swap = (info->src_fmt->Rmask != info->dst_fmt->Rmask);
+    Uint32 keep, fill;
+    uint8x16_t alpha;
+
+    GetAlphaMasks8888(info, &keep, &fill);
+    alpha = vdupq_n_u8((uint8_t) (fill >> 24));
+
+    while (height--) {
+        int n = width;
+        while (n >= 16) {
+            uint8x16x3_t s = vld3q_u8(src);
+            uint8x16x4_t d;
+            d.val[0] = swap ? s.val[2] : s.val[0];
+            d.val[1] = s.val[1];
+            d.val[2] = swap ? s.val[0] : s.val[2];
+            d.val[3] = alpha;
+            vst4q_u8((uint8_t *) dst, d);
+            src += 48;
+            dst += 16;
+            n -= 16;
+        }
+        while (n--) {
+            Uint32 p = src[0] | (src[1] << 8) | (src[2] << 16);
+            *dst++ = (swap ? SWAP_RB_8888(p) : p) | fill;
+            src += 3;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+/* NEON 4 byte --> 3 byte pixels, 16 pixels at a time */
+static void
+Blit_4to3_NEON(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *src = (Uint32 *) info->src;
+    int srcskip = info->src_skip / 4;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const SDL_bool swap = (info->src_fmt->Rmask != info->dst_fmt->Rmask);
+
+    while (height--) {
+        int n = width;
+        while (n >= 16) {
+            uint8x16x4_t s = vld4q_u8((const uint8_t *) src);
+            uint8x16x3_t d;
+            d.val[0] = swap ? s.val[2] : s.val[0];
+            d.val[1] = s.val[1];
+            d.val[2] = swap ? s.val[0] : s.val[2];
+            vst3q_u8(dst, d);
+            src += 16;
+            dst += 48;
+            n -= 16;
+        }
+        while (n--) {
+            Uint32 p = swap ? SWAP_RB_8888(*src) : *src;
+            dst[0] = (Uint8) p;
+            dst[1] = (Uint8) (p >> 8);
+            dst[2] = (Uint8) (p >> 16);
+            ++src;
+            dst += 3;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+#endif /* SDL_NEON_BLITTERS */
+
 /* Normal N to N optimized blitters */
 #define NO_ALPHA   1
 #define SET_ALPHA  2
@@ -3176,6 +3794,39 @@ static const struct blit_table normal_blit_2[] = {
 };
 
 static const struct blit_table normal_blit_3[] = {
+#if defined(__SSSE3__) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    /* has-SSSE3, 3->4 with same or inversed rgb triplet */
+    {0x000000FF, 0x0000FF00, 0x00FF0000, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
+     16, Blit_3to4_SSSE3, NO_ALPHA | SET_ALPHA},
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     16, Blit_3to4_SSSE3, NO_ALPHA | SET_ALPHA},
+    {0x000000FF, 0x0000FF00, 0x00FF0000, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     16, Blit_3to4_SSSE3, NO_ALPHA | SET_ALPHA},
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
+     16, Blit_3to4_SSSE3, NO_ALPHA | SET_ALPHA},
+#endif
+#if SDL_NEON_BLITTERS
+    /* has-NEON, 3->4 with same or inversed rgb triplet */
+    {0x000000FF, 0x0000FF00, 0x00FF0000, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
+     32, Blit_3to4_NEON, NO_ALPHA | SET_ALPHA},
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     32, Blit_3to4_NEON, NO_ALPHA | SET_ALPHA},
+    {0x000000FF, 0x0000FF00, 0x00FF0000, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     32, Blit_3to4_NEON, NO_ALPHA | SET_ALPHA},
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
+     32, Blit_3to4_NEON, NO_ALPHA | SET_ALPHA},
+#endif
+#if defined(__MMX__) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    /* has-MMX, 3->4 with same or inversed rgb triplet */
+    {0x000000FF, 0x0000FF00, 0x00FF0000, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
+     1, Blit_3to4_MMX, NO_ALPHA | SET_ALPHA},
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     1, Blit_3to4_MMX, NO_ALPHA | SET_ALPHA},
+    {0x000000FF, 0x0000FF00, 0x00FF0000, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     1, Blit_3to4_MMX, NO_ALPHA | SET_ALPHA},
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
+     1, Blit_3to4_MMX, NO_ALPHA | SET_ALPHA},
+#endif
     /* 3->4 with same rgb triplet */
     {0x000000FF, 0x0000FF00, 0x00FF0000, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
      0, Blit_3or4_to_3or4__same_rgb,
@@ -3222,6 +3873,62 @@ static const struct blit_table normal_blit_4[] = {
     /* has-altivec */
     {0x00000000, 0x00000000, 0x00000000, 2, 0x0000F800, 0x000007E0, 0x0000001F,
      2, Blit_RGB888_RGB565Altivec, NO_ALPHA},
+#endif
+#if defined(__SSSE3__) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    /* has-SSSE3, 4->3 with same or inversed rgb triplet */
+    {0x000000FF, 0x0000FF00, 0x00FF0000, 3, 0x000000FF, 0x0000FF00, 0x00FF0000,
+     16, Blit_4to3_SSSE3, NO_ALPHA | SET_ALPHA},
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 3, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     16, Blit_4to3_SSSE3, NO_ALPHA | SET_ALPHA},
+    {0x000000FF, 0x0000FF00, 0x00FF0000, 3, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     16, Blit_4to3_SSSE3, NO_ALPHA | SET_ALPHA},
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 3, 0x000000FF, 0x0000FF00, 0x00FF0000,
+     16, Blit_4to3_SSSE3, NO_ALPHA | SET_ALPHA},
+#endif
+#ifdef __SSE2__
+    /* has-SSE2, RGB 888 to RGB 565 and ABGR8888 <-> ARGB8888 */
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 2, 0x0000F800, 0x000007E0, 0x0000001F,
+     8, Blit_RGB888_RGB565SSE2, NO_ALPHA},
+    {0x000000FF, 0x0000FF00, 0x00FF0000, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     8, Blit_4to4_SwapRB_SSE2, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
+     8, Blit_4to4_SwapRB_SSE2, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+#endif
+#if SDL_NEON_BLITTERS
+    /* has-NEON */
+    {0x000000FF, 0x0000FF00, 0x00FF0000, 3, 0x000000FF, 0x0000FF00, 0x00FF0000,
+     32, Blit_4to3_NEON, NO_ALPHA | SET_ALPHA},
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 3, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     32, Blit_4to3_NEON, NO_ALPHA | SET_ALPHA},
+    {0x000000FF, 0x0000FF00, 0x00FF0000, 3, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     32, Blit_4to3_NEON, NO_ALPHA | SET_ALPHA},
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 3, 0x000000FF, 0x0000FF00, 0x00FF0000,
+     32, Blit_4to3_NEON, NO_ALPHA | SET_ALPHA},
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 2, 0x0000F800, 0x000007E0, 0x0000001F,
+     32, Blit_RGB888_RGB565NEON, NO_ALPHA},
+    {0x000000FF, 0x0000FF00, 0x00FF0000, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     32, Blit_4to4_SwapRB_NEON, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
+     32, Blit_4to4_SwapRB_NEON, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+#endif
+#ifdef __MMX__
+    /* has-MMX */
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    {0x000000FF, 0x0000FF00, 0x00FF0000, 3, 0x000000FF, 0x0000FF00, 0x00FF0000,
+     1, Blit_4to3_MMX, NO_ALPHA | SET_ALPHA},
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 3, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     1, Blit_4to3_MMX, NO_ALPHA | SET_ALPHA},
+    {0x000000FF, 0x0000FF00, 0x00FF0000, 3, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     1, Blit_4to3_MMX, NO_ALPHA | SET_ALPHA},
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 3, 0x000000FF, 0x0000FF00, 0x00FF0000,
+     1, Blit_4to3_MMX, NO_ALPHA | SET_ALPHA},
+#endif
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 2, 0x0000F800, 0x000007E0, 0x0000001F,
+     1, Blit_RGB888_RGB565MMX, NO_ALPHA},
+    {0x000000FF, 0x0000FF00, 0x00FF0000, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
+     1, Blit_4to4_SwapRB_MMX, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+    {0x00FF0000, 0x0000FF00, 0x000000FF, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
+     1, Blit_4to4_SwapRB_MMX, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
 #endif
     /* 4->3 with same rgb triplet */
     {0x000000FF, 0x0000FF00, 0x00FF0000, 3, 0x000000FF, 0x0000FF00, 0x00FF0000,
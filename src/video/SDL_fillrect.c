@@ -230,6 +230,25 @@ SDL_FillRect4(Uint8 * pixels, int pitch, Uint32 color, int w, int h)
     }
 }
 
+typedef void (*SDL_FillRectFunc) (Uint8 * pixels, int pitch, Uint32 color, int w, int h);
+
+typedef struct
+{
+    SDL_FillRectFunc fill;
+    Uint8 *pixels;
+    int pitch;
+    Uint32 color;
+    int w;
+} SDL_FillRectData;
+
+static void
+SDL_FillRectBand(void *data, int y, int h)
+{
+    const SDL_FillRectData *filldata = (const SDL_FillRectData *) data;
+    filldata->fill(filldata->pixels + y * filldata->pitch, filldata->pitch,
+                   filldata->color, filldata->w, h);
+}
+
 /* 
  * This function performs a fast fill of the given rectangle with 'color'
  */
@@ -238,6 +257,8 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
 {
     SDL_Rect clipped;
     Uint8 *pixels;
+    SDL_FillRectFunc fill;
+    SDL_FillRectData filldata;
 
     if (!dst) {
         return SDL_SetError("Passed NULL destination surface");
@@ -278,11 +299,11 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
             color |= (color << 16);
 #ifdef __SSE__
             if (SDL_HasSSE()) {
-                SDL_FillRect1SSE(pixels, dst->pitch, color, rect->w, rect->h);
+                fill = SDL_FillRect1SSE;
                 break;
             }
 #endif
-            SDL_FillRect1(pixels, dst->pitch, color, rect->w, rect->h);
+            fill = SDL_FillRect1;
             break;
         }
 
@@ -291,18 +312,18 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
             color |= (color << 16);
 #ifdef __SSE__
             if (SDL_HasSSE()) {
-                SDL_FillRect2SSE(pixels, dst->pitch, color, rect->w, rect->h);
+                fill = SDL_FillRect2SSE;
                 break;
             }
 #endif
-            SDL_FillRect2(pixels, dst->pitch, color, rect->w, rect->h);
+            fill = SDL_FillRect2;
             break;
         }
 
     case 3:
         /* 24-bit RGB is a slow path, at least for now. */
         {
-            SDL_FillRect3(pixels, dst->pitch, color, rect->w, rect->h);
+            fill = SDL_FillRect3;
             break;
         }
 
@@ -310,15 +331,25 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
         {
 #ifdef __SSE__
             if (SDL_HasSSE()) {
-                SDL_FillRect4SSE(pixels, dst->pitch, color, rect->w, rect->h);
+                fill = SDL_FillRect4SSE;
                 break;
             }
 #endif
-            SDL_FillRect4(pixels, dst->pitch, color, rect->w, rect->h);
+            fill = SDL_FillRect4;
             break;
         }
+
+    default:
+        return SDL_SetError("SDL_FillRect(): Unsupported surface format");
     }
 
+    filldata.fill = fill;
+    filldata.pixels = pixels;
+    filldata.pitch = dst->pitch;
+    filldata.color = color;
+    filldata.w = rect->w;
+    SDL_RunBlitBands(SDL_FillRectBand, &filldata, rect->w, rect->h);
+
     /* We're done! */
     return 0;
 }
@@ -985,6 +985,14 @@ SDL_InvalidateMap(SDL_BlitMap * map)
     map->dst_palette_version = 0;
     SDL_free(map->info.table);
     map->info.table = NULL;
+
+    /* Drop the scaled blit intermediates, so they don't outlive the mapping */
+    SDL_FreeSurface(map->scale_src);
+    map->scale_src = NULL;
+    SDL_FreeSurface(map->scale_tmp[0]);
+    map->scale_tmp[0] = NULL;
+    SDL_FreeSurface(map->scale_tmp[1]);
+    map->scale_tmp[1] = NULL;
 }
 
 int
@@ -196,34 +196,39 @@ copy_row3(Uint8 * src, int src_w, Uint8 * dst, int dst_w)
     }
 }
 
-/* Perform a stretch blit between two surfaces of the same format.
-   NOTE:  This function is not safe to call from multiple threads!
-*/
-int
-SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
-                SDL_Surface * dst, const SDL_Rect * dstrect)
+/* Formats that SDL_LowerSoftStretchLinear() can filter directly */
+SDL_bool
+SDL_IsLinearStretchFormat(Uint32 format)
 {
+    if (format == SDL_PIXELFORMAT_RGB565) {
+        return SDL_TRUE;
+    }
+    return (SDL_BYTESPERPIXEL(format) == 4 &&
+            SDL_PIXELLAYOUT(format) == SDL_PACKEDLAYOUT_8888) ? SDL_TRUE : SDL_FALSE;
+}
+
+static int SDL_LowerSoftStretchNearest(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
+static int SDL_LowerSoftStretchLinear(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
+
+/* Validate the rectangles, lock the surfaces and run the requested stretch */
+static int
+SDL_UpperSoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
+                     SDL_Surface * dst, const SDL_Rect * dstrect, int scale_flags)
+{
+    int ret;
     int src_locked;
     int dst_locked;
-    int pos, inc;
-    int dst_maxrow;
-    int src_row, dst_row;
-    Uint8 *srcp = NULL;
-    Uint8 *dstp;
     SDL_Rect full_src;
     SDL_Rect full_dst;
-#ifdef USE_ASM_STRETCH
-    SDL_bool use_asm = SDL_TRUE;
-#ifdef __GNUC__
-    int u1, u2;
-#endif
-#endif /* USE_ASM_STRETCH */
-    const int bpp = dst->format->BytesPerPixel;
 
     if (src->format->format != dst->format->format) {
         return SDL_SetError("Only works with same format surfaces");
     }
 
+    if ((scale_flags & SDL_COPY_LINEAR) && !SDL_IsLinearStretchFormat(src->format->format)) {
+        return SDL_SetError("Wrong format for linear stretch");
+    }
+
     /* Verify the blit rectangles */
     if (srcrect) {
         if ((srcrect->x < 0) || (srcrect->y < 0) ||
@@ -252,6 +257,10 @@ SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
         dstrect = &full_dst;
     }
 
+    if (dstrect->w <= 0 || dstrect->h <= 0 || srcrect->w <= 0 || srcrect->h <= 0) {
+        return 0;
+    }
+
     /* Lock the destination if it's in hardware */
     dst_locked = 0;
     if (SDL_MUSTLOCK(dst)) {
@@ -272,31 +281,80 @@ SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
         src_locked = 1;
     }
 
-    /* Set up the data... */
-    pos = 0x10000;
-    inc = (srcrect->h << 16) / dstrect->h;
-    src_row = srcrect->y;
-    dst_row = dstrect->y;
+    if (scale_flags & SDL_COPY_LINEAR) {
+        ret = SDL_LowerSoftStretchLinear(src, srcrect, dst, dstrect);
+    } else {
+        ret = SDL_LowerSoftStretchNearest(src, srcrect, dst, dstrect);
+    }
 
-#ifdef USE_ASM_STRETCH
-    /* Write the opcodes for this stretch */
-    if ((bpp == 3) || (generate_rowbytes(srcrect->w, dstrect->w, bpp) < 0)) {
-        use_asm = SDL_FALSE;
+    /* We need to unlock the surfaces if they're locked */
+    if (dst_locked) {
+        SDL_UnlockSurface(dst);
     }
+    if (src_locked) {
+        SDL_UnlockSurface(src);
+    }
+    return ret;
+}
+
+/* Perform a stretch blit between two surfaces of the same format.
+   NOTE:  This function is not safe to call from multiple threads!
+*/
+int
+SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
+                SDL_Surface * dst, const SDL_Rect * dstrect)
+{
+    return SDL_UpperSoftStretch(src, srcrect, dst, dstrect, SDL_COPY_NEAREST);
+}
+
+/* Perform a bilinear filtered stretch blit between two surfaces of the same
+   format. Only 32-bit 8888 formats and RGB565 are supported.
+*/
+int
+SDL_SoftStretchLinear(SDL_Surface * src, const SDL_Rect * srcrect,
+                      SDL_Surface * dst, const SDL_Rect * dstrect)
+{
+    return SDL_UpperSoftStretch(src, srcrect, dst, dstrect, SDL_COPY_LINEAR);
+}
+
+typedef struct
+{
+    SDL_Surface *src;
+    const SDL_Rect *srcrect;
+    SDL_Surface *dst;
+    const SDL_Rect *dstrect;
+    int pos, inc;
+#ifdef USE_ASM_STRETCH
+    SDL_bool use_asm;
 #endif
+} SDL_StretchData;
 
-    /* Perform the stretch blit */
-    for (dst_maxrow = dst_row + dstrect->h; dst_row < dst_maxrow; ++dst_row) {
-        dstp = (Uint8 *) dst->pixels + (dst_row * dst->pitch)
+/* Stretch destination rows [y, y+h) */
+static void
+SDL_StretchNearestBand(void *data, int y, int h)
+{
+    const SDL_StretchData *stretch = (const SDL_StretchData *) data;
+    SDL_Surface *src = stretch->src;
+    SDL_Surface *dst = stretch->dst;
+    const SDL_Rect *srcrect = stretch->srcrect;
+    const SDL_Rect *dstrect = stretch->dstrect;
+    const int bpp = dst->format->BytesPerPixel;
+    int dst_row, src_row;
+    Uint8 *srcp;
+    Uint8 *dstp;
+#if defined(USE_ASM_STRETCH) && defined(__GNUC__)
+    int u1, u2;
+#endif
+
+    for (dst_row = y; dst_row < y + h; ++dst_row) {
+        /* This is the row the 16.16 walk from the top of the rectangle lands on */
+        src_row = srcrect->y + (int) ((0x10000 + (Sint64) dst_row * stretch->inc) >> 16) - 1;
+        srcp = (Uint8 *) src->pixels + (src_row * src->pitch)
+            + (srcrect->x * bpp);
+        dstp = (Uint8 *) dst->pixels + ((dstrect->y + dst_row) * dst->pitch)
             + (dstrect->x * bpp);
-        while (pos >= 0x10000L) {
-            srcp = (Uint8 *) src->pixels + (src_row * src->pitch)
-                + (srcrect->x * bpp);
-            ++src_row;
-            pos -= 0x10000L;
-        }
 #ifdef USE_ASM_STRETCH
-        if (use_asm) {
+        if (stretch->use_asm) {
 #ifdef __GNUC__
             __asm__ __volatile__("call *%4":"=&D"(u1), "=&S"(u2)
                                  :"0"(dstp), "1"(srcp), "r"(copy_row)
@@ -337,17 +395,455 @@ SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
                           (Uint32 *) dstp, dstrect->w);
                 break;
             }
-        pos += inc;
     }
+}
 
-    /* We need to unlock the surfaces if they're locked */
-    if (dst_locked) {
-        SDL_UnlockSurface(dst);
+static int
+SDL_LowerSoftStretchNearest(SDL_Surface *src, const SDL_Rect *srcrect,
+                            SDL_Surface *dst, const SDL_Rect *dstrect)
+{
+    SDL_StretchData stretch;
+
+    /* Set up the data... */
+    stretch.src = src;
+    stretch.srcrect = srcrect;
+    stretch.dst = dst;
+    stretch.dstrect = dstrect;
+    stretch.pos = 0x10000;
+    stretch.inc = (srcrect->h << 16) / dstrect->h;
+
+#ifdef USE_ASM_STRETCH
+    /* Write the opcodes for this stretch */
+    stretch.use_asm = SDL_TRUE;
+    if ((dst->format->BytesPerPixel == 3) ||
+        (generate_rowbytes(srcrect->w, dstrect->w, dst->format->BytesPerPixel) < 0)) {
+        stretch.use_asm = SDL_FALSE;
     }
-    if (src_locked) {
-        SDL_UnlockSurface(src);
+    if (stretch.use_asm) {
+        /* The generated code lives in a static buffer, keep it on one thread */
+        SDL_StretchNearestBand(&stretch, 0, dstrect->h);
+        return 0;
     }
-    return (0);
+#endif
+
+    /* Perform the stretch blit */
+    SDL_RunBlitBands(SDL_StretchNearestBand, &stretch, dstrect->w, dstrect->h);
+    return 0;
+}
+
+/* Bilinear filtering.
+
+   Source coordinates are tracked in 16.16 fixed point and sampled at pixel
+   centers. The fractional part is reduced to an 8-bit weight, which keeps
+   every intermediate product of a channel within 16 bits.
+*/
+
+static void
+get_scale_params(int src_len, int dst_len, int *pos, int *inc)
+{
+    *inc = (int) (((Sint64) src_len << 16) / dst_len);
+    *pos = (*inc / 2) - 0x8000;
+}
+
+/* Clamp a source position to two samples that are both inside the row */
+SDL_FORCE_INLINE void
+get_sample(int pos, int src_len, int *i0, int *i1, int *frac)
+{
+    if (pos <= 0) {
+        *i0 = *i1 = 0;
+        *frac = 0;
+    } else if ((pos >> 16) >= src_len - 1) {
+        *i0 = *i1 = src_len - 1;
+        *frac = 0;
+    } else {
+        *i0 = pos >> 16;
+        *i1 = *i0 + 1;
+        *frac = (pos >> 8) & 0xFF;
+    }
+}
+
+/* Interpolate two 8888 pixels, two channels at a time; frac is 0..256 */
+SDL_FORCE_INLINE Uint32
+INTERPOLATE_8888(Uint32 p0, Uint32 p1, int frac)
+{
+    const Uint32 w0 = 256 - frac;
+    const Uint32 w1 = frac;
+    const Uint32 rb = (((p0 & 0x00FF00FF) * w0 + (p1 & 0x00FF00FF) * w1) >> 8) & 0x00FF00FF;
+    const Uint32 ag = (((p0 >> 8) & 0x00FF00FF) * w0 + ((p1 >> 8) & 0x00FF00FF) * w1) & 0xFF00FF00;
+    return rb | ag;
+}
+
+/* Spread a 565 pixel to 0x07E0F81F so every channel has room for 5-bit weights */
+#define RGB565_EXPAND(p)    ((((Uint32) (p)) | ((Uint32) (p) << 16)) & 0x07E0F81F)
+#define RGB565_PACK(e)      ((Uint16) (((e) & 0xFFFF) | ((e) >> 16)))
+
+SDL_FORCE_INLINE Uint32
+INTERPOLATE_565(Uint32 e0, Uint32 e1, int frac)
+{
+    return ((e0 * (32 - frac) + e1 * frac) >> 5) & 0x07E0F81F;
+}
+
+static void
+scale_row_8888(const Uint32 *row0, const Uint32 *row1, int fy,
+               Uint32 *dst, int dst_w, int posx, int incx, int src_w)
+{
+    int i;
+    for (i = 0; i < dst_w; ++i, posx += incx) {
+        int x0, x1, fx;
+        Uint32 top, bottom;
+        get_sample(posx, src_w, &x0, &x1, &fx);
+        top = INTERPOLATE_8888(row0[x0], row0[x1], fx);
+        bottom = INTERPOLATE_8888(row1[x0], row1[x1], fx);
+        *dst++ = INTERPOLATE_8888(top, bottom, fy);
+    }
+}
+
+static void
+scale_row_565(const Uint16 *row0, const Uint16 *row1, int fy,
+              Uint16 *dst, int dst_w, int posx, int incx, int src_w)
+{
+    int i;
+    fy >>= 3;
+    for (i = 0; i < dst_w; ++i, posx += incx) {
+        int x0, x1, fx;
+        Uint32 top, bottom;
+        get_sample(posx, src_w, &x0, &x1, &fx);
+        fx >>= 3;
+        top = INTERPOLATE_565(RGB565_EXPAND(row0[x0]), RGB565_EXPAND(row0[x1]), fx);
+        bottom = INTERPOLATE_565(RGB565_EXPAND(row1[x0]), RGB565_EXPAND(row1[x1]), fx);
+        *dst++ = RGB565_PACK(INTERPOLATE_565(top, bottom, fy));
+    }
+}
+
+/* The SIMD rows always load two adjacent source pixels, so the left sample
+   is clamped to src_w - 2 and the weight may reach 256 at the right edge.
+*/
+SDL_FORCE_INLINE void
+get_sample_pair(int pos, int src_len, int *i0, int *frac)
+{
+    if (pos <= 0) {
+        *i0 = 0;
+        *frac = 0;
+    } else if ((pos >> 16) >= src_len - 1) {
+        *i0 = src_len - 2;
+        *frac = 256;
+    } else {
+        *i0 = pos >> 16;
+        *frac = (pos >> 8) & 0xFF;
+    }
+}
+
+#ifdef __SSE2__
+static void
+scale_row_8888_SSE2(const Uint32 *row0, const Uint32 *row1, int fy,
+                    Uint32 *dst, int dst_w, int posx, int incx, int src_w)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i wy0 = _mm_set1_epi16((short) (256 - fy));
+    const __m128i wy1 = _mm_set1_epi16((short) fy);
+    int i = 0;
+
+    /* Two destination pixels per iteration */
+    for (; i + 1 < dst_w; i += 2) {
+        int x0, fx0, x1, fx1;
+        __m128i a, b, wx, lo, hi;
+
+        get_sample_pair(posx, src_w, &x0, &fx0);
+        posx += incx;
+        get_sample_pair(posx, src_w, &x1, &fx1);
+        posx += incx;
+
+        /* Vertical pass: [left, right] of each pixel as 16-bit channels */
+        a = _mm_add_epi16(
+                _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) &row0[x0]), zero), wy0),
+                _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) &row1[x0]), zero), wy1));
+        b = _mm_add_epi16(
+                _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) &row0[x1]), zero), wy0),
+                _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) &row1[x1]), zero), wy1));
+        a = _mm_srli_epi16(a, 8);
+        b = _mm_srli_epi16(b, 8);
+
+        /* Horizontal pass */
+        wx = _mm_set_epi16((short) fx0, (short) fx0, (short) fx0, (short) fx0,
+                           (short) (256 - fx0), (short) (256 - fx0), (short) (256 - fx0), (short) (256 - fx0));
+        a = _mm_mullo_epi16(a, wx);
+        wx = _mm_set_epi16((short) fx1, (short) fx1, (short) fx1, (short) fx1,
+                           (short) (256 - fx1), (short) (256 - fx1), (short) (256 - fx1), (short) (256 - fx1));
+        b = _mm_mullo_epi16(b, wx);
+        lo = _mm_unpacklo_epi64(a, b);
+        hi = _mm_unpackhi_epi64(a, b);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, hi), 8);
+        _mm_storel_epi64((__m128i *) &dst[i], _mm_packus_epi16(lo, zero));
+    }
+
+    if (i < dst_w) {
+        scale_row_8888(row0, row1, fy, &dst[i], dst_w - i, posx, incx, src_w);
+    }
+}
+/* Interpolate 16-bit channel lanes with 5-bit weights, like INTERPOLATE_565 */
+SDL_FORCE_INLINE __m128i
+INTERPOLATE_565_SSE2(__m128i c0, __m128i c1, __m128i w1)
+{
+    const __m128i w0 = _mm_sub_epi16(_mm_set1_epi16(32), w1);
+    return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(c0, w0), _mm_mullo_epi16(c1, w1)), 5);
+}
+
+/* Each channel is filtered on its own, which gives the same result as the
+   spread channels of scale_row_565.
+ */
+static void
+scale_row_565_SSE2(const Uint16 *row0, const Uint16 *row1, int fy,
+                   Uint16 *dst, int dst_w, int posx, int incx, int src_w)
+{
+    const __m128i g_mask = _mm_set1_epi16(0x3F);
+    const __m128i b_mask = _mm_set1_epi16(0x1F);
+    const __m128i wy = _mm_set1_epi16((short) (fy >> 3));
+    int i = 0;
+
+    /* Eight destination pixels per iteration, the samples are gathered */
+    for (; i + 7 < dst_w; i += 8) {
+        Uint16 p00[8], p01[8], p10[8], p11[8], w[8];
+        __m128i a, b, c, d, wx, red, green, blue;
+        int k;
+
+        for (k = 0; k < 8; ++k, posx += incx) {
+            int x0, x1, fx;
+            get_sample(posx, src_w, &x0, &x1, &fx);
+            p00[k] = row0[x0];
+            p01[k] = row0[x1];
+            p10[k] = row1[x0];
+            p11[k] = row1[x1];
+            w[k] = (Uint16) (fx >> 3);
+        }
+        a = _mm_loadu_si128((const __m128i *) p00);
+        b = _mm_loadu_si128((const __m128i *) p01);
+        c = _mm_loadu_si128((const __m128i *) p10);
+        d = _mm_loadu_si128((const __m128i *) p11);
+        wx = _mm_loadu_si128((const __m128i *) w);
+
+        red = INTERPOLATE_565_SSE2(
+                INTERPOLATE_565_SSE2(_mm_srli_epi16(a, 11), _mm_srli_epi16(b, 11), wx),
+                INTERPOLATE_565_SSE2(_mm_srli_epi16(c, 11), _mm_srli_epi16(d, 11), wx), wy);
+        green = INTERPOLATE_565_SSE2(
+                INTERPOLATE_565_SSE2(_mm_and_si128(_mm_srli_epi16(a, 5), g_mask),
+                                     _mm_and_si128(_mm_srli_epi16(b, 5), g_mask), wx),
+                INTERPOLATE_565_SSE2(_mm_and_si128(_mm_srli_epi16(c, 5), g_mask),
+                                     _mm_and_si128(_mm_srli_epi16(d, 5), g_mask), wx), wy);
+        blue = INTERPOLATE_565_SSE2(
+                INTERPOLATE_565_SSE2(_mm_and_si128(a, b_mask), _mm_and_si128(b, b_mask), wx),
+                INTERPOLATE_565_SSE2(_mm_and_si128(c, b_mask), _mm_and_si128(d, b_mask), wx), wy);
+        _mm_storeu_si128((__m128i *) &dst[i],
+                         _mm_or_si128(_mm_or_si128(_mm_slli_epi16(red, 11), _mm_slli_epi16(green, 5)), blue));
+    }
+
+    if (i < dst_w) {
+        scale_row_565(row0, row1, fy, &dst[i], dst_w - i, posx, incx, src_w);
+    }
+}
+#endif /* __SSE2__ */
+
+#ifdef __ARM_NEON
+static void
+scale_row_8888_NEON(const Uint32 *row0, const Uint32 *row1, int fy,
+                    Uint32 *dst, int dst_w, int posx, int incx, int src_w)
+{
+    const uint16x8_t wy0 = vdupq_n_u16((uint16_t) (256 - fy));
+    const uint16x8_t wy1 = vdupq_n_u16((uint16_t) fy);
+    int i = 0;
+
+    /* Two destination pixels per iteration */
+    for (; i + 1 < dst_w; i += 2) {
+        int x0, fx0, x1, fx1;
+        uint16x8_t a, b, wx;
+        uint16x4_t r0, r1;
+
+        get_sample_pair(posx, src_w, &x0, &fx0);
+        posx += incx;
+        get_sample_pair(posx, src_w, &x1, &fx1);
+        posx += incx;
+
+        /* Vertical pass: [left, right] of each pixel as 16-bit channels */
+        a = vmulq_u16(vmovl_u8(vld1_u8((const uint8_t *) &row0[x0])), wy0);
+        a = vmlaq_u16(a, vmovl_u8(vld1_u8((const uint8_t *) &row1[x0])), wy1);
+        b = vmulq_u16(vmovl_u8(vld1_u8((const uint8_t *) &row0[x1])), wy0);
+        b = vmlaq_u16(b, vmovl_u8(vld1_u8((const uint8_t *) &row1[x1])), wy1);
+        a = vshrq_n_u16(a, 8);
+        b = vshrq_n_u16(b, 8);
+
+        /* Horizontal pass */
+        wx = vcombine_u16(vdup_n_u16((uint16_t) (256 - fx0)), vdup_n_u16((uint16_t) fx0));
+        a = vmulq_u16(a, wx);
+        wx = vcombine_u16(vdup_n_u16((uint16_t) (256 - fx1)), vdup_n_u16((uint16_t) fx1));
+        b = vmulq_u16(b, wx);
+        r0 = vshr_n_u16(vadd_u16(vget_low_u16(a), vget_high_u16(a)), 8);
+        r1 = vshr_n_u16(vadd_u16(vget_low_u16(b), vget_high_u16(b)), 8);
+        vst1_u8((uint8_t *) &dst[i], vmovn_u16(vcombine_u16(r0, r1)));
+    }
+
+    if (i < dst_w) {
+        scale_row_8888(row0, row1, fy, &dst[i], dst_w - i, posx, incx, src_w);
+    }
+}
+/* Interpolate 16-bit channel lanes with 5-bit weights, like INTERPOLATE_565 */
+SDL_FORCE_INLINE uint16x8_t
+INTERPOLATE_565_NEON(uint16x8_t c0, uint16x8_t c1, uint16x8_t w1)
+{
+    const uint16x8_t w0 = vsubq_u16(vdupq_n_u16(32), w1);
+    return vshrq_n_u16(vmlaq_u16(vmulq_u16(c0, w0), c1, w1), 5);
+}
+
+/* Each channel is filtered on its own, which gives the same result as the
+   spread channels of scale_row_565.
+ */
+static void
+scale_row_565_NEON(const Uint16 *row0, const Uint16 *row1, int fy,
+                   Uint16 *dst, int dst_w, int posx, int incx, int src_w)
+{
+    const uint16x8_t g_mask = vdupq_n_u16(0x3F);
+    const uint16x8_t b_mask = vdupq_n_u16(0x1F);
+    const uint16x8_t wy = vdupq_n_u16((uint16_t) (fy >> 3));
+    int i = 0;
+
+    /* Eight destination pixels per iteration, the samples are gathered */
+    for (; i + 7 < dst_w; i += 8) {
+        Uint16 p00[8], p01[8], p10[8], p11[8], w[8];
+        uint16x8_t a, b, c, d, wx, red, green, blue;
+        int k;
+
+        for (k = 0; k < 8; ++k, posx += incx) {
+            int x0, x1, fx;
+            get_sample(posx, src_w, &x0, &x1, &fx);
+            p00[k] = row0[x0];
+            p01[k] = row0[x1];
+            p10[k] = row1[x0];
+            p11[k] = row1[x1];
+            w[k] = (Uint16) (fx >> 3);
+        }
+        a = vld1q_u16(p00);
+        b = vld1q_u16(p01);
+        c = vld1q_u16(p10);
+        d = vld1q_u16(p11);
+        wx = vld1q_u16(w);
+
+        red = INTERPOLATE_565_NEON(
+                INTERPOLATE_565_NEON(vshrq_n_u16(a, 11), vshrq_n_u16(b, 11), wx),
+                INTERPOLATE_565_NEON(vshrq_n_u16(c, 11), vshrq_n_u16(d, 11), wx), wy);
+        green = INTERPOLATE_565_NEON(
+                INTERPOLATE_565_NEON(vandq_u16(vshrq_n_u16(a, 5), g_mask),
+                                     vandq_u16(vshrq_n_u16(b, 5), g_mask), wx),
+                INTERPOLATE_565_NEON(vandq_u16(vshrq_n_u16(c, 5), g_mask),
+                                     vandq_u16(vshrq_n_u16(d, 5), g_mask), wx), wy);
+        blue = INTERPOLATE_565_NEON(
+                INTERPOLATE_565_NEON(vandq_u16(a, b_mask), vandq_u16(b, b_mask), wx),
+                INTERPOLATE_565_NEON(vandq_u16(c, b_mask), vandq_u16(d, b_mask), wx), wy);
+        vst1q_u16(&dst[i], vorrq_u16(vorrq_u16(vshlq_n_u16(red, 11), vshlq_n_u16(green, 5)), blue));
+    }
+
+    if (i < dst_w) {
+        scale_row_565(row0, row1, fy, &dst[i], dst_w - i, posx, incx, src_w);
+    }
+}
+#endif /* __ARM_NEON */
+
+typedef void (*SDL_ScaleRowFunc8888) (const Uint32 *row0, const Uint32 *row1, int fy,
+                                      Uint32 *dst, int dst_w, int posx, int incx, int src_w);
+
+static SDL_ScaleRowFunc8888
+SDL_ChooseScaleRow8888(int src_w)
+{
+    /* The SIMD rows need at least two source pixels per row */
+    if (src_w < 2) {
+        return scale_row_8888;
+    }
+#ifdef __SSE2__
+    if (SDL_HasSSE2()) {
+        return scale_row_8888_SSE2;
+    }
+#endif
+#ifdef __ARM_NEON
+    if (SDL_HasNEON()) {
+        return scale_row_8888_NEON;
+    }
+#endif
+    return scale_row_8888;
+}
+
+typedef void (*SDL_ScaleRowFunc565) (const Uint16 *row0, const Uint16 *row1, int fy,
+                                     Uint16 *dst, int dst_w, int posx, int incx, int src_w);
+
+static SDL_ScaleRowFunc565
+SDL_ChooseScaleRow565(void)
+{
+#ifdef __SSE2__
+    if (SDL_HasSSE2()) {
+        return scale_row_565_SSE2;
+    }
+#endif
+#ifdef __ARM_NEON
+    if (SDL_HasNEON()) {
+        return scale_row_565_NEON;
+    }
+#endif
+    return scale_row_565;
+}
+
+/* Filter destination rows [y, y+h) */
+static void
+SDL_StretchLinearBand(void *data, int y, int h)
+{
+    const SDL_StretchData *stretch = (const SDL_StretchData *) data;
+    SDL_Surface *src = stretch->src;
+    SDL_Surface *dst = stretch->dst;
+    const SDL_Rect *srcrect = stretch->srcrect;
+    const SDL_Rect *dstrect = stretch->dstrect;
+    const int bpp = dst->format->BytesPerPixel;
+    const Uint8 *src_base = (const Uint8 *) src->pixels + (srcrect->y * src->pitch) + (srcrect->x * bpp);
+    Uint8 *dstp = (Uint8 *) dst->pixels + ((dstrect->y + y) * dst->pitch) + (dstrect->x * bpp);
+    SDL_ScaleRowFunc8888 scale_row = SDL_ChooseScaleRow8888(srcrect->w);
+    SDL_ScaleRowFunc565 scale_row_16 = SDL_ChooseScaleRow565();
+    int posx, incx, posy, incy;
+    int dst_row;
+
+    get_scale_params(srcrect->w, dstrect->w, &posx, &incx);
+    posy = stretch->pos + y * stretch->inc;
+    incy = stretch->inc;
+
+    for (dst_row = y; dst_row < y + h; ++dst_row, posy += incy) {
+        int y0, y1, fy;
+        const Uint8 *row0, *row1;
+
+        get_sample(posy, srcrect->h, &y0, &y1, &fy);
+        row0 = src_base + y0 * src->pitch;
+        row1 = src_base + y1 * src->pitch;
+
+        if (bpp == 4) {
+            scale_row((const Uint32 *) row0, (const Uint32 *) row1, fy,
+                      (Uint32 *) dstp, dstrect->w, posx, incx, srcrect->w);
+        } else {
+            scale_row_16((const Uint16 *) row0, (const Uint16 *) row1, fy,
+                         (Uint16 *) dstp, dstrect->w, posx, incx, srcrect->w);
+        }
+        dstp += dst->pitch;
+    }
+}
+
+static int
+SDL_LowerSoftStretchLinear(SDL_Surface *src, const SDL_Rect *srcrect,
+                           SDL_Surface *dst, const SDL_Rect *dstrect)
+{
+    SDL_StretchData stretch;
+
+    stretch.src = src;
+    stretch.srcrect = srcrect;
+    stretch.dst = dst;
+    stretch.dstrect = dstrect;
+    get_scale_params(srcrect->h, dstrect->h, &stretch.pos, &stretch.inc);
+#ifdef USE_ASM_STRETCH
+    stretch.use_asm = SDL_FALSE;
+#endif
+
+    SDL_RunBlitBands(SDL_StretchLinearBand, &stretch, dstrect->w, dstrect->h);
+    return 0;
 }
 
 /* vi: set ts=4 sw=4 expandtab: */
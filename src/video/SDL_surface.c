@@ -725,6 +725,13 @@ SDL_UpperBlit(SDL_Surface * src, const SDL_Rect * srcrect,
 int
 SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
               SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    return SDL_PrivateUpperBlitScaled(src, srcrect, dst, dstrect, SDL_COPY_NEAREST);
+}
+
+int
+SDL_PrivateUpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
+              SDL_Surface * dst, SDL_Rect * dstrect, int scale_flags)
 {
     double src_x0, src_y0, src_x1, src_y1;
     double dst_x0, dst_y0, dst_x1, dst_y1;
@@ -869,7 +876,7 @@ SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
         return 0;
     }
 
-    return SDL_LowerBlitScaled(src, &final_src, dst, &final_dst);
+    return SDL_PrivateLowerBlitScaled(src, &final_src, dst, &final_dst, scale_flags);
 }
 
 /**
@@ -879,6 +886,153 @@ SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
 int
 SDL_LowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
                 SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    return SDL_PrivateLowerBlitScaled(src, srcrect, dst, dstrect, SDL_COPY_NEAREST);
+}
+
+/* Gets a surface that shares the pixels of src, without its modulation and
+   blend mode. It's kept with the blit map of src until the pixels move.
+ */
+static SDL_Surface *
+SDL_GetScaleSource(SDL_Surface * src)
+{
+    SDL_Surface *view = src->map->scale_src;
+
+    if (view && (view->pixels != src->pixels || view->pitch != src->pitch ||
+                 view->w != src->w || view->h != src->h ||
+                 view->format->format != src->format->format)) {
+        SDL_FreeSurface(view);
+        view = src->map->scale_src = NULL;
+    }
+    if (!view) {
+        view = SDL_CreateRGBSurfaceWithFormatFrom(src->pixels, src->w, src->h, 0,
+                                                  src->pitch, src->format->format);
+        if (!view) {
+            return NULL;
+        }
+        SDL_SetSurfaceBlendMode(view, SDL_BLENDMODE_NONE);
+        src->map->scale_src = view;
+    }
+    if (view->format->palette != src->format->palette) {
+        SDL_SetSurfacePalette(view, src->format->palette);
+    }
+    SDL_SetColorKey(view, SDL_HasColorKey(src), src->map->info.colorkey);
+    return view;
+}
+
+/* Gets an intermediate surface of at least w x h pixels. It grows, so
+   scaling the same source to changing sizes doesn't reallocate it, but is
+   made smaller again when a blit needs less than a quarter of it.
+ */
+static SDL_Surface *
+SDL_GetScaleSurface(SDL_Surface ** cache, int w, int h, Uint32 format)
+{
+    SDL_Surface *surface = *cache;
+
+    if (surface && ((Sint64) w * h * 4 < (Sint64) surface->w * surface->h)) {
+        SDL_FreeSurface(surface);
+        surface = *cache = NULL;
+    }
+    if (surface && (surface->w < w || surface->h < h || surface->format->format != format)) {
+        if (surface->format->format == format) {
+            w = SDL_max(w, surface->w);
+            h = SDL_max(h, surface->h);
+        }
+        SDL_FreeSurface(surface);
+        surface = *cache = NULL;
+    }
+    if (!surface) {
+        surface = *cache = SDL_CreateRGBSurfaceWithFormat(0, w, h, 0, format);
+    }
+    return surface;
+}
+
+/* Filter the source rectangle into an intermediate surface, then blit that
+   with the source's modulation, blend mode and colorkey. The surfaces used
+   on the way are kept with the blit map of the source until it is invalidated.
+ */
+static int
+SDL_LowerBlitScaledLinearIntermediate(SDL_Surface * src, SDL_Rect * srcrect,
+                                      SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    SDL_Surface *view;
+    SDL_Surface *tmp1;
+    SDL_Surface *tmp2;
+    SDL_Rect tmprect1, tmprect2;
+    Uint32 format;
+    Uint8 r, g, b, a;
+    SDL_BlendMode blendMode;
+    SDL_bool colorkey;
+    SDL_bool locked = SDL_FALSE;
+    int retval = -1;
+
+    SDL_GetSurfaceColorMod(src, &r, &g, &b);
+    SDL_GetSurfaceAlphaMod(src, &a);
+    SDL_GetSurfaceBlendMode(src, &blendMode);
+    colorkey = SDL_HasColorKey(src);
+
+    if (SDL_IsLinearStretchFormat(dst->format->format) && dst->format->Amask) {
+        format = dst->format->format;
+    } else {
+        format = SDL_PIXELFORMAT_ARGB8888;
+    }
+
+    /* RLE encoding releases the pixels, locking decodes them again */
+    if (src->flags & SDL_RLEACCEL) {
+        if (SDL_LockSurface(src) < 0) {
+            return -1;
+        }
+        locked = SDL_TRUE;
+    }
+
+    view = SDL_GetScaleSource(src);
+    tmp1 = SDL_GetScaleSurface(&src->map->scale_tmp[0], srcrect->w, srcrect->h, format);
+    tmp2 = SDL_GetScaleSurface(&src->map->scale_tmp[1], dstrect->w, dstrect->h, format);
+    tmprect1.x = 0;
+    tmprect1.y = 0;
+    tmprect1.w = srcrect->w;
+    tmprect1.h = srcrect->h;
+    tmprect2.x = 0;
+    tmprect2.y = 0;
+    tmprect2.w = dstrect->w;
+    tmprect2.h = dstrect->h;
+
+    /* Copy the source rectangle as-is. Colorkeyed pixels are skipped, which
+       leaves them fully transparent once the area is cleared.
+     */
+    if (view && tmp1 && tmp2) {
+        retval = 0;
+        if (colorkey) {
+            retval = SDL_FillRect(tmp1, &tmprect1, 0);
+        }
+        if (retval == 0) {
+            retval = SDL_LowerBlit(view, srcrect, tmp1, &tmprect1);
+        }
+    }
+
+    if (locked) {
+        SDL_UnlockSurface(src);
+    }
+
+    if (retval == 0) {
+        retval = SDL_SoftStretchLinear(tmp1, &tmprect1, tmp2, &tmprect2);
+    }
+
+    if (retval == 0) {
+        if (colorkey && blendMode == SDL_BLENDMODE_NONE) {
+            blendMode = SDL_BLENDMODE_BLEND;
+        }
+        SDL_SetSurfaceColorMod(tmp2, r, g, b);
+        SDL_SetSurfaceAlphaMod(tmp2, a);
+        SDL_SetSurfaceBlendMode(tmp2, blendMode);
+        retval = SDL_LowerBlit(tmp2, &tmprect2, dst, dstrect);
+    }
+    return retval;
+}
+
+int
+SDL_PrivateLowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
+                SDL_Surface * dst, SDL_Rect * dstrect, int scale_flags)
 {
     static const Uint32 complex_copy_flags = (
         SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA |
@@ -886,6 +1040,16 @@ SDL_LowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
         SDL_COPY_COLORKEY
     );
 
+    if (scale_flags & SDL_COPY_LINEAR) {
+        if ( !(src->map->info.flags & complex_copy_flags) &&
+             src->format->format == dst->format->format &&
+             SDL_IsLinearStretchFormat(src->format->format) ) {
+            return SDL_SoftStretchLinear( src, srcrect, dst, dstrect );
+        } else {
+            return SDL_LowerBlitScaledLinearIntermediate( src, srcrect, dst, dstrect );
+        }
+    }
+
     if (!(src->map->info.flags & SDL_COPY_NEAREST)) {
         src->map->info.flags |= SDL_COPY_NEAREST;
         SDL_InvalidateMap(src->map);
@@ -280,6 +280,15 @@ struct SDL_VideoDevice
      */
     void (*PumpEvents) (_THIS);
 
+    /* Optional: block until the windowing system has events for PumpEvents,
+       the timeout (in ms, -1 for forever) expires or SendWakeupEvent is
+       called. Returns 1 if events may be ready, 0 on timeout, -1 on error.
+       Drivers that set this must also implement SendWakeupEvent.
+     */
+    int (*WaitEventTimeout) (_THIS, int timeout);
+    /* Interrupt WaitEventTimeout from another thread */
+    void (*SendWakeupEvent) (_THIS);
+
     /* Suspend the screensaver */
     void (*SuspendScreenSaver) (_THIS);
 
@@ -2836,6 +2836,8 @@ SDL_VideoQuit(void)
     }
     _this->VideoQuit(_this);
 
+    SDL_QuitBlitThreads();
+
     for (i = 0; i < _this->num_displays; ++i) {
         SDL_VideoDisplay *display = &_this->displays[i];
         for (j = display->num_display_modes; j--;) {
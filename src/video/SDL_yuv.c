@@ -179,6 +179,78 @@ static int GetYUVPlanes(int width, int height, Uint32 format, const void *yuv, i
     return 0;
 }
 
+static SDL_bool yuv_rgb_avx2(
+    Uint32 src_format, Uint32 dst_format,
+    Uint32 width, Uint32 height, 
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride, 
+    Uint8 *rgb, Uint32 rgb_stride, 
+    YCbCrType yuv_type)
+{
+#ifdef YUV_RGB_HAVE_AVX2
+    if (!SDL_HasAVX2()) {
+        return SDL_FALSE;
+    }
+
+    /* Packed 4:2:2 and 24-bit RGB are left to the SSE2 path */
+    if (src_format == SDL_PIXELFORMAT_YV12 ||
+        src_format == SDL_PIXELFORMAT_IYUV) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv420_rgb565_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv420_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv420_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv420_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGR888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv420_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_NV12 ||
+        src_format == SDL_PIXELFORMAT_NV21) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuvnv12_rgb565_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuvnv12_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuvnv12_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuvnv12_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGR888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuvnv12_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+#endif
+    return SDL_FALSE;
+}
+
 static SDL_bool yuv_rgb_sse(
     Uint32 src_format, Uint32 dst_format,
     Uint32 width, Uint32 height, 
@@ -411,6 +483,10 @@ SDL_ConvertPixels_YUV_to_RGB(int width, int height,
         return -1;
     }
 
+    if (yuv_rgb_avx2(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8*)dst, dst_pitch, yuv_type)) {
+        return 0;
+    }
+
     if (yuv_rgb_sse(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8*)dst, dst_pitch, yuv_type)) {
         return 0;
     }
@@ -446,6 +522,70 @@ SDL_ConvertPixels_YUV_to_RGB(int width, int height,
     return SDL_SetError("Unsupported YUV conversion");
 }
 
+int
+SDL_ConvertPixels_YUV_to_RGB_Rect(int width, int height,
+         Uint32 src_format, const void *src, int src_pitch, const SDL_Rect *rect,
+         Uint32 dst_format, void *dst, int dst_pitch)
+{
+    const Uint8 *y = NULL;
+    const Uint8 *u = NULL;
+    const Uint8 *v = NULL;
+    Uint32 y_stride = 0;
+    Uint32 uv_stride = 0;
+    YCbCrType yuv_type = YCBCR_601;
+
+    if ((rect->x & 1) || (rect->y & 1)) {
+        return SDL_SetError("YUV rectangle must start on an even pixel");
+    }
+
+    if (GetYUVPlanes(width, height, src_format, src, src_pitch, &y, &u, &v, &y_stride, &uv_stride) < 0) {
+        return -1;
+    }
+
+    /* Use the conversion type of the whole image, so every part of it looks the same */
+    if (GetYUVConversionType(width, height, &yuv_type) < 0) {
+        return -1;
+    }
+
+    switch (src_format) {
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+        y += rect->y * y_stride + rect->x;
+        u += (rect->y / 2) * uv_stride + rect->x / 2;
+        v += (rect->y / 2) * uv_stride + rect->x / 2;
+        break;
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+        y += rect->y * y_stride + rect->x * 2;
+        u += rect->y * uv_stride + rect->x * 2;
+        v += rect->y * uv_stride + rect->x * 2;
+        break;
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        y += rect->y * y_stride + rect->x;
+        u += (rect->y / 2) * uv_stride + rect->x;
+        v += (rect->y / 2) * uv_stride + rect->x;
+        break;
+    default:
+        return SDL_SetError("Unsupported YUV format: %s", SDL_GetPixelFormatName(src_format));
+    }
+
+    if (yuv_rgb_avx2(src_format, dst_format, rect->w, rect->h, y, u, v, y_stride, uv_stride, (Uint8*)dst, dst_pitch, yuv_type)) {
+        return 0;
+    }
+
+    if (yuv_rgb_sse(src_format, dst_format, rect->w, rect->h, y, u, v, y_stride, uv_stride, (Uint8*)dst, dst_pitch, yuv_type)) {
+        return 0;
+    }
+
+    if (yuv_rgb_std(src_format, dst_format, rect->w, rect->h, y, u, v, y_stride, uv_stride, (Uint8*)dst, dst_pitch, yuv_type)) {
+        return 0;
+    }
+
+    return SDL_SetError("Unsupported YUV conversion");
+}
+
 struct RGB2YUVFactors
 {
     int y_offset;
@@ -454,6 +594,210 @@ struct RGB2YUVFactors
     float v[3]; /* Rfactor, Gfactor, Bfactor */
 };
 
+/* The SIMD versions below use the same float math as MAKE_Y/MAKE_U/MAKE_V,
+   so they produce exactly the same output as the C version. They convert as
+   many pixels as they can and return the count, the rest is done in C. */
+#ifdef __SSE2__
+static SDL_INLINE __m128i
+RGBtoYUV_SSE2(__m128i r, __m128i g, __m128i b, const float factors[3], int offset)
+{
+    __m128 sum;
+
+    sum = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(factors[0]), _mm_cvtepi32_ps(r)),
+                     _mm_mul_ps(_mm_set1_ps(factors[1]), _mm_cvtepi32_ps(g)));
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(factors[2]), _mm_cvtepi32_ps(b)));
+    sum = _mm_add_ps(sum, _mm_set1_ps(0.5f));
+
+    /* Truncate and wrap to 8 bits, like the Uint8 cast in the C version */
+    return _mm_and_si128(_mm_add_epi32(_mm_cvttps_epi32(sum), _mm_set1_epi32(offset)), _mm_set1_epi32(0xFF));
+}
+
+static int
+ARGB8888_to_Y_SSE2(const struct RGB2YUVFactors *cvt, const Uint32 *src, Uint8 *dst, int width)
+{
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    int i, k;
+
+    for (i = 0; i + 16 <= width; i += 16) {
+        __m128i y[4];
+
+        for (k = 0; k < 4; ++k) {
+            __m128i p = _mm_loadu_si128((const __m128i *)(src + i + k * 4));
+            __m128i r = _mm_and_si128(_mm_srli_epi32(p, 16), mask);
+            __m128i g = _mm_and_si128(_mm_srli_epi32(p, 8), mask);
+            __m128i b = _mm_and_si128(p, mask);
+            y[k] = RGBtoYUV_SSE2(r, g, b, cvt->y, cvt->y_offset);
+        }
+        _mm_storeu_si128((__m128i *)(dst + i),
+                         _mm_packus_epi16(_mm_packs_epi32(y[0], y[1]), _mm_packs_epi32(y[2], y[3])));
+    }
+    return i;
+}
+
+/* Average 2x2 blocks of the two rows and write count U and V samples.
+   uv_pixel_stride is 1 for planar formats and 2 for interleaved formats. */
+static int
+ARGB8888_to_UV_SSE2(const struct RGB2YUVFactors *cvt, const Uint32 *curr_row, const Uint32 *next_row,
+                    Uint8 *plane_u, Uint8 *plane_v, int uv_pixel_stride, int count)
+{
+    const __m128i mask_rb = _mm_set1_epi32(0x00FF00FF);
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    int i, k;
+
+    for (i = 0; i + 8 <= count; i += 8) {
+        __m128i u[2], v[2];
+
+        for (k = 0; k < 2; ++k) {
+            const int x = 2 * i + k * 8;
+            __m128 c0 = _mm_castsi128_ps(_mm_loadu_si128((const __m128i *)(curr_row + x)));
+            __m128 c1 = _mm_castsi128_ps(_mm_loadu_si128((const __m128i *)(curr_row + x + 4)));
+            __m128 n0 = _mm_castsi128_ps(_mm_loadu_si128((const __m128i *)(next_row + x)));
+            __m128 n1 = _mm_castsi128_ps(_mm_loadu_si128((const __m128i *)(next_row + x + 4)));
+            __m128i p1 = _mm_castps_si128(_mm_shuffle_ps(c0, c1, _MM_SHUFFLE(2, 0, 2, 0)));
+            __m128i p2 = _mm_castps_si128(_mm_shuffle_ps(c0, c1, _MM_SHUFFLE(3, 1, 3, 1)));
+            __m128i p3 = _mm_castps_si128(_mm_shuffle_ps(n0, n1, _MM_SHUFFLE(2, 0, 2, 0)));
+            __m128i p4 = _mm_castps_si128(_mm_shuffle_ps(n0, n1, _MM_SHUFFLE(3, 1, 3, 1)));
+            __m128i rb, g, r, b;
+
+            /* The sums of four 8-bit values can't overflow into the next channel */
+            rb = _mm_add_epi32(_mm_add_epi32(_mm_and_si128(p1, mask_rb), _mm_and_si128(p2, mask_rb)),
+                               _mm_add_epi32(_mm_and_si128(p3, mask_rb), _mm_and_si128(p4, mask_rb)));
+            g = _mm_add_epi32(_mm_add_epi32(_mm_and_si128(_mm_srli_epi32(p1, 8), mask), _mm_and_si128(_mm_srli_epi32(p2, 8), mask)),
+                              _mm_add_epi32(_mm_and_si128(_mm_srli_epi32(p3, 8), mask), _mm_and_si128(_mm_srli_epi32(p4, 8), mask)));
+            r = _mm_srli_epi32(rb, 18);
+            g = _mm_srli_epi32(g, 2);
+            b = _mm_srli_epi32(_mm_and_si128(rb, _mm_set1_epi32(0xFFFF)), 2);
+
+            u[k] = RGBtoYUV_SSE2(r, g, b, cvt->u, 128);
+            v[k] = RGBtoYUV_SSE2(r, g, b, cvt->v, 128);
+        }
+        u[0] = _mm_packus_epi16(_mm_packs_epi32(u[0], u[1]), _mm_setzero_si128());
+        v[0] = _mm_packus_epi16(_mm_packs_epi32(v[0], v[1]), _mm_setzero_si128());
+
+        if (uv_pixel_stride == 1) {
+            _mm_storel_epi64((__m128i *)(plane_u + i), u[0]);
+            _mm_storel_epi64((__m128i *)(plane_v + i), v[0]);
+        } else if (plane_u < plane_v) {
+            _mm_storeu_si128((__m128i *)(plane_u + i * 2), _mm_unpacklo_epi8(u[0], v[0]));
+        } else {
+            _mm_storeu_si128((__m128i *)(plane_v + i * 2), _mm_unpacklo_epi8(v[0], u[0]));
+        }
+    }
+    return i;
+}
+#endif /* __SSE2__ */
+
+#if defined(__ARM_NEON) && SDL_BYTEORDER == SDL_LIL_ENDIAN
+static SDL_INLINE int32x4_t
+RGBtoYUV_NEON(uint32x4_t r, uint32x4_t g, uint32x4_t b, const float factors[3], int offset)
+{
+    float32x4_t sum;
+
+    sum = vaddq_f32(vmulq_n_f32(vcvtq_f32_u32(r), factors[0]), vmulq_n_f32(vcvtq_f32_u32(g), factors[1]));
+    sum = vaddq_f32(sum, vmulq_n_f32(vcvtq_f32_u32(b), factors[2]));
+    sum = vaddq_f32(sum, vdupq_n_f32(0.5f));
+    return vaddq_s32(vcvtq_s32_f32(sum), vdupq_n_s32(offset));
+}
+
+/* Narrowing wraps to 8 bits, like the Uint8 cast in the C version */
+static SDL_INLINE uint8x8_t
+NarrowYUV_NEON(int32x4_t lo, int32x4_t hi)
+{
+    return vmovn_u16(vreinterpretq_u16_s16(vcombine_s16(vmovn_s32(lo), vmovn_s32(hi))));
+}
+
+static int
+ARGB8888_to_Y_NEON(const struct RGB2YUVFactors *cvt, const Uint32 *src, Uint8 *dst, int width)
+{
+    int i;
+
+    for (i = 0; i + 16 <= width; i += 16) {
+        /* ARGB8888 is stored as B, G, R, A in memory on little endian systems */
+        const uint8x16x4_t p = vld4q_u8((const uint8_t *)(src + i));
+        const uint16x8_t r_lo = vmovl_u8(vget_low_u8(p.val[2])), r_hi = vmovl_u8(vget_high_u8(p.val[2]));
+        const uint16x8_t g_lo = vmovl_u8(vget_low_u8(p.val[1])), g_hi = vmovl_u8(vget_high_u8(p.val[1]));
+        const uint16x8_t b_lo = vmovl_u8(vget_low_u8(p.val[0])), b_hi = vmovl_u8(vget_high_u8(p.val[0]));
+        int32x4_t y0, y1, y2, y3;
+
+        y0 = RGBtoYUV_NEON(vmovl_u16(vget_low_u16(r_lo)), vmovl_u16(vget_low_u16(g_lo)), vmovl_u16(vget_low_u16(b_lo)), cvt->y, cvt->y_offset);
+        y1 = RGBtoYUV_NEON(vmovl_u16(vget_high_u16(r_lo)), vmovl_u16(vget_high_u16(g_lo)), vmovl_u16(vget_high_u16(b_lo)), cvt->y, cvt->y_offset);
+        y2 = RGBtoYUV_NEON(vmovl_u16(vget_low_u16(r_hi)), vmovl_u16(vget_low_u16(g_hi)), vmovl_u16(vget_low_u16(b_hi)), cvt->y, cvt->y_offset);
+        y3 = RGBtoYUV_NEON(vmovl_u16(vget_high_u16(r_hi)), vmovl_u16(vget_high_u16(g_hi)), vmovl_u16(vget_high_u16(b_hi)), cvt->y, cvt->y_offset);
+        vst1q_u8(dst + i, vcombine_u8(NarrowYUV_NEON(y0, y1), NarrowYUV_NEON(y2, y3)));
+    }
+    return i;
+}
+
+static int
+ARGB8888_to_UV_NEON(const struct RGB2YUVFactors *cvt, const Uint32 *curr_row, const Uint32 *next_row,
+                    Uint8 *plane_u, Uint8 *plane_v, int uv_pixel_stride, int count)
+{
+    int i;
+
+    for (i = 0; i + 8 <= count; i += 8) {
+        const uint8x16x4_t c = vld4q_u8((const uint8_t *)(curr_row + 2 * i));
+        const uint8x16x4_t n = vld4q_u8((const uint8_t *)(next_row + 2 * i));
+        /* Add horizontal pairs of the first row, then of the second row, and average */
+        const uint16x8_t r = vshrq_n_u16(vpadalq_u8(vpaddlq_u8(c.val[2]), n.val[2]), 2);
+        const uint16x8_t g = vshrq_n_u16(vpadalq_u8(vpaddlq_u8(c.val[1]), n.val[1]), 2);
+        const uint16x8_t b = vshrq_n_u16(vpadalq_u8(vpaddlq_u8(c.val[0]), n.val[0]), 2);
+        const uint32x4_t r_lo = vmovl_u16(vget_low_u16(r)), r_hi = vmovl_u16(vget_high_u16(r));
+        const uint32x4_t g_lo = vmovl_u16(vget_low_u16(g)), g_hi = vmovl_u16(vget_high_u16(g));
+        const uint32x4_t b_lo = vmovl_u16(vget_low_u16(b)), b_hi = vmovl_u16(vget_high_u16(b));
+        uint8x8x2_t uv;
+
+        uv.val[0] = NarrowYUV_NEON(RGBtoYUV_NEON(r_lo, g_lo, b_lo, cvt->u, 128), RGBtoYUV_NEON(r_hi, g_hi, b_hi, cvt->u, 128));
+        uv.val[1] = NarrowYUV_NEON(RGBtoYUV_NEON(r_lo, g_lo, b_lo, cvt->v, 128), RGBtoYUV_NEON(r_hi, g_hi, b_hi, cvt->v, 128));
+
+        if (uv_pixel_stride == 1) {
+            vst1_u8(plane_u + i, uv.val[0]);
+            vst1_u8(plane_v + i, uv.val[1]);
+        } else if (plane_u < plane_v) {
+            vst2_u8(plane_u + i * 2, uv);
+        } else {
+            const uint8x8_t u = uv.val[0];
+            uv.val[0] = uv.val[1];
+            uv.val[1] = u;
+            vst2_u8(plane_v + i * 2, uv);
+        }
+    }
+    return i;
+}
+#endif /* __ARM_NEON */
+
+static int
+ARGB8888_to_Y_SIMD(const struct RGB2YUVFactors *cvt, const Uint8 *src, Uint8 *dst, int width)
+{
+#ifdef __SSE2__
+    if (SDL_HasSSE2()) {
+        return ARGB8888_to_Y_SSE2(cvt, (const Uint32 *)src, dst, width);
+    }
+#endif
+#if defined(__ARM_NEON) && SDL_BYTEORDER == SDL_LIL_ENDIAN
+    if (SDL_HasNEON()) {
+        return ARGB8888_to_Y_NEON(cvt, (const Uint32 *)src, dst, width);
+    }
+#endif
+    return 0;
+}
+
+static int
+ARGB8888_to_UV_SIMD(const struct RGB2YUVFactors *cvt, const Uint8 *curr_row, const Uint8 *next_row,
+                    Uint8 *plane_u, Uint8 *plane_v, int uv_pixel_stride, int count)
+{
+#ifdef __SSE2__
+    if (SDL_HasSSE2()) {
+        return ARGB8888_to_UV_SSE2(cvt, (const Uint32 *)curr_row, (const Uint32 *)next_row, plane_u, plane_v, uv_pixel_stride, count);
+    }
+#endif
+#if defined(__ARM_NEON) && SDL_BYTEORDER == SDL_LIL_ENDIAN
+    if (SDL_HasNEON()) {
+        return ARGB8888_to_UV_NEON(cvt, (const Uint32 *)curr_row, (const Uint32 *)next_row, plane_u, plane_v, uv_pixel_stride, count);
+    }
+#endif
+    return 0;
+}
+
 static int
 SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int src_pitch, Uint32 dst_format, void *dst, int dst_pitch)
 {
@@ -563,7 +907,9 @@ SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int sr
 
             /* Write Y plane */
             for (j = 0; j < height; j++) {
-                for (i = 0; i < width; i++) {
+                i = ARGB8888_to_Y_SIMD(cvt, curr_row, plane_y, width);
+                plane_y += i;
+                for (; i < width; i++) {
                     const Uint32 p1 = ((const Uint32 *)curr_row)[i];
                     const Uint32 r = (p1 & 0x00ff0000) >> 16;
                     const Uint32 g = (p1 & 0x0000ff00) >> 8;
@@ -583,7 +929,10 @@ SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int sr
                 /* Write UV planes, not interleaved */
                 uv_skip = (uv_stride - (width + 1)/2);
                 for (j = 0; j < height_half; j++) {
-                    for (i = 0; i < width_half; i++) {
+                    i = ARGB8888_to_UV_SIMD(cvt, curr_row, next_row, plane_u, plane_v, 1, width_half);
+                    plane_u += i;
+                    plane_v += i;
+                    for (; i < width_half; i++) {
                         READ_2x2_PIXELS;
                         *plane_u++ = MAKE_U(r, g, b);
                         *plane_v++ = MAKE_V(r, g, b);
@@ -617,7 +966,9 @@ SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int sr
             {
                 uv_skip = (uv_stride - ((width + 1)/2)*2);
                 for (j = 0; j < height_half; j++) {
-                    for (i = 0; i < width_half; i++) {
+                    i = ARGB8888_to_UV_SIMD(cvt, curr_row, next_row, plane_interleaved_uv, plane_interleaved_uv + 1, 2, width_half);
+                    plane_interleaved_uv += i * 2;
+                    for (; i < width_half; i++) {
                         READ_2x2_PIXELS;
                         *plane_interleaved_uv++ = MAKE_U(r, g, b);
                         *plane_interleaved_uv++ = MAKE_V(r, g, b);
@@ -648,7 +999,9 @@ SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int sr
             {
                 uv_skip = (uv_stride - ((width + 1)/2)*2);
                 for (j = 0; j < height_half; j++) {
-                    for (i = 0; i < width_half; i++) {
+                    i = ARGB8888_to_UV_SIMD(cvt, curr_row, next_row, plane_interleaved_uv + 1, plane_interleaved_uv, 2, width_half);
+                    plane_interleaved_uv += i * 2;
+                    for (; i < width_half; i++) {
                         READ_2x2_PIXELS;
                         *plane_interleaved_uv++ = MAKE_V(r, g, b);
                         *plane_interleaved_uv++ = MAKE_U(r, g, b);
@@ -964,6 +1317,9 @@ SDL_ConvertPixels_PackUVPlanes_to_NV(int width, int height, const void *src, int
 #ifdef __SSE2__
     const SDL_bool use_SSE2 = SDL_HasSSE2();
 #endif
+#ifdef __ARM_NEON
+    const SDL_bool use_NEON = SDL_HasNEON();
+#endif
 
     /* Skip the Y plane */
     src = (const Uint8 *)src + height * src_pitch;
@@ -1006,6 +1362,20 @@ SDL_ConvertPixels_PackUVPlanes_to_NV(int width, int height, const void *src, int
                 x -= 16;
             }
         }
+#endif
+#ifdef __ARM_NEON
+        if (use_NEON) {
+            while (x >= 16) {
+                uint8x16x2_t uv;
+                uv.val[0] = vld1q_u8(src1);
+                uv.val[1] = vld1q_u8(src2);
+                vst2q_u8(dstUV, uv);
+                src1 += 16;
+                src2 += 16;
+                dstUV += 32;
+                x -= 16;
+            }
+        }
 #endif
         while (x--) {
             *dstUV++ = *src1++;
@@ -1038,6 +1408,9 @@ SDL_ConvertPixels_SplitNV_to_UVPlanes(int width, int height, const void *src, in
 #ifdef __SSE2__
     const SDL_bool use_SSE2 = SDL_HasSSE2();
 #endif
+#ifdef __ARM_NEON
+    const SDL_bool use_NEON = SDL_HasNEON();
+#endif
 
     /* Skip the Y plane */
     src = (const Uint8 *)src + height * src_pitch;
@@ -1085,6 +1458,19 @@ SDL_ConvertPixels_SplitNV_to_UVPlanes(int width, int height, const void *src, in
                 x -= 16;
             }
         }
+#endif
+#ifdef __ARM_NEON
+        if (use_NEON) {
+            while (x >= 16) {
+                uint8x16x2_t uv = vld2q_u8(srcUV);
+                vst1q_u8(dst1, uv.val[0]);
+                vst1q_u8(dst2, uv.val[1]);
+                srcUV += 32;
+                dst1 += 16;
+                dst2 += 16;
+                x -= 16;
+            }
+        }
 #endif
         while (x--) {
             *dst1++ = *srcUV++;
@@ -1116,6 +1502,9 @@ SDL_ConvertPixels_SwapNV(int width, int height, const void *src, int src_pitch,
 #ifdef __SSE2__
     const SDL_bool use_SSE2 = SDL_HasSSE2();
 #endif
+#ifdef __ARM_NEON
+    const SDL_bool use_NEON = SDL_HasNEON();
+#endif
 
     /* Skip the Y plane */
     src = (const Uint8 *)src + height * src_pitch;
@@ -1139,6 +1528,17 @@ SDL_ConvertPixels_SwapNV(int width, int height, const void *src, int src_pitch,
                 x -= 8;
             }
         }
+#endif
+#ifdef __ARM_NEON
+        if (use_NEON) {
+            while (x >= 8) {
+                uint8x16_t uv = vld1q_u8((const uint8_t *)srcUV);
+                vst1q_u8((uint8_t *)dstUV, vrev16q_u8(uv));
+                srcUV += 8;
+                dstUV += 8;
+                x -= 8;
+            }
+        }
 #endif
         while (x--) {
             *dstUV++ = SDL_Swap16(*srcUV++);
@@ -24,6 +24,8 @@
 
 #include "../SDL_internal.h"
 
+#include "SDL_rect.h"
+
 
 /* YUV conversion functions */
 
@@ -31,6 +33,11 @@ extern int SDL_ConvertPixels_YUV_to_RGB(int width, int height, Uint32 src_format
 extern int SDL_ConvertPixels_RGB_to_YUV(int width, int height, Uint32 src_format, const void *src, int src_pitch, Uint32 dst_format, void *dst, int dst_pitch);
 extern int SDL_ConvertPixels_YUV_to_YUV(int width, int height, Uint32 src_format, const void *src, int src_pitch, Uint32 dst_format, void *dst, int dst_pitch);
 
+/* Convert a rectangle of a width x height YUV image directly, without any intermediate buffers.
+   The rectangle must start on an even pixel, and this fails if there is no direct conversion to the RGB format.
+ */
+extern int SDL_ConvertPixels_YUV_to_RGB_Rect(int width, int height, Uint32 src_format, const void *src, int src_pitch, const SDL_Rect *rect, Uint32 dst_format, void *dst, int dst_pitch);
+
 #endif /* SDL_yuv_c_h_ */
 
 /* vi: set ts=4 sw=4 expandtab: */
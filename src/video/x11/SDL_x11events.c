@@ -27,6 +27,10 @@
 #include <signal.h>
 #include <unistd.h>
 #include <limits.h> /* For INT_MAX */
+#include <errno.h>
+#ifdef HAVE_POLL
+#include <poll.h>
+#endif
 
 #include "SDL_x11video.h"
 #include "SDL_x11touch.h"
@@ -1460,6 +1464,111 @@ X11_PumpEvents(_THIS)
 }
 
 
+int
+X11_WaitEventTimeout(_THIS, int timeout)
+{
+    SDL_VideoData *data = (SDL_VideoData *) _this->driverdata;
+    Display *display = data->display;
+    const int x11_fd = ConnectionNumber(display);
+    const int wakeup_fd = data->wakeup_pipe[0];
+    int result;
+
+    /* Events Xlib has already read won't show up on the socket */
+    X11_XFlush(display);
+    if (X11_XEventsQueued(display, QueuedAlready)) {
+        return 1;
+    }
+
+    /* Wake up in time for the work X11_PumpEvents() does on a timer */
+    if (wakeup_fd < 0) {
+        timeout = (timeout < 0) ? 10 : SDL_min(timeout, 10);
+    }
+    if (data->last_mode_change_deadline) {
+        const int left = (int) (data->last_mode_change_deadline - SDL_GetTicks());
+        timeout = (timeout < 0) ? SDL_max(left, 0) : SDL_min(timeout, SDL_max(left, 0));
+    }
+    if (_this->suspend_screensaver && data->screensaver_activity) {
+        const int left = (int) (data->screensaver_activity + 30000 - SDL_GetTicks());
+        timeout = (timeout < 0) ? SDL_max(left, 0) : SDL_min(timeout, SDL_max(left, 0));
+    }
+    /* Focus changes are held back for a while, see X11_HandleFocusChanges() */
+    if (data->windowlist) {
+        int i;
+        for (i = 0; i < data->numwindows; ++i) {
+            const SDL_WindowData *windata = data->windowlist[i];
+            if (windata && windata->pending_focus != PENDING_FOCUS_NONE) {
+                const int left = (int) (windata->pending_focus_time - SDL_GetTicks());
+                timeout = (timeout < 0) ? SDL_max(left, 0) : SDL_min(timeout, SDL_max(left, 0));
+            }
+        }
+    }
+#ifdef SDL_USE_IME
+    /* The input method talks to us over D-Bus, which we can't wait on here */
+    if (SDL_GetEventState(SDL_TEXTINPUT) == SDL_ENABLE) {
+        timeout = (timeout < 0) ? 10 : SDL_min(timeout, 10);
+    }
+#endif
+
+    {
+#ifdef HAVE_POLL
+        struct pollfd info[2];
+        int count = 1;
+
+        info[0].fd = x11_fd;
+        info[0].events = POLLIN | POLLPRI;
+        if (wakeup_fd >= 0) {
+            info[1].fd = wakeup_fd;
+            info[1].events = POLLIN;
+            ++count;
+        }
+        result = poll(info, count, timeout);
+#else
+        fd_set rfdset;
+        struct timeval tv, *tvp = NULL;
+
+        FD_ZERO(&rfdset);
+        FD_SET(x11_fd, &rfdset);
+        if (wakeup_fd >= 0) {
+            FD_SET(wakeup_fd, &rfdset);
+        }
+        if (timeout >= 0) {
+            tv.tv_sec = timeout / 1000;
+            tv.tv_usec = (timeout % 1000) * 1000;
+            tvp = &tv;
+        }
+        result = select(SDL_max(x11_fd, wakeup_fd) + 1, &rfdset, NULL, NULL, tvp);
+#endif /* HAVE_POLL */
+    }
+
+    /* Drain the wakeup pipe so the next wait blocks again */
+    if (wakeup_fd >= 0) {
+        char buf[64];
+        while (read(wakeup_fd, buf, sizeof (buf)) > 0) {
+            continue;
+        }
+    }
+
+    if (result < 0) {
+        /* A signal may have queued an event, let the caller pump */
+        return (errno == EINTR) ? 1 : -1;
+    }
+    return (result > 0) ? 1 : 0;
+}
+
+void
+X11_SendWakeupEvent(_THIS)
+{
+    SDL_VideoData *data = (SDL_VideoData *) _this->driverdata;
+
+    if (data->wakeup_pipe[1] >= 0) {
+        const char c = 0;
+        ssize_t written;
+        /* If the pipe is full a wakeup is already pending, so failure is fine */
+        written = write(data->wakeup_pipe[1], &c, 1);
+        (void) written;
+    }
+}
+
 void
 X11_SuspendScreenSaver(_THIS)
 {
@@ -23,6 +23,7 @@
 #if SDL_VIDEO_DRIVER_X11
 
 #include <unistd.h> /* For getpid() and readlink() */
+#include <fcntl.h>
 
 #include "SDL_video.h"
 #include "SDL_mouse.h"
@@ -182,6 +183,7 @@ X11_CreateDevice(int devindex)
     device->driverdata = data;
 
     data->global_mouse_changed = SDL_TRUE;
+    data->wakeup_pipe[0] = data->wakeup_pipe[1] = -1;
 
     /* FIXME: Do we need this?
        if ( (SDL_strncmp(X11_XDisplayName(display), ":", 1) == 0) ||
@@ -230,6 +232,8 @@ X11_CreateDevice(int devindex)
     device->SetDisplayMode = X11_SetDisplayMode;
     device->SuspendScreenSaver = X11_SuspendScreenSaver;
     device->PumpEvents = X11_PumpEvents;
+    device->WaitEventTimeout = X11_WaitEventTimeout;
+    device->SendWakeupEvent = X11_SendWakeupEvent;
 
     device->CreateSDLWindow = X11_CreateWindow;
     device->CreateSDLWindowFrom = X11_CreateWindowFrom;
@@ -451,6 +455,17 @@ X11_VideoInit(_THIS)
 
     X11_InitTouch(_this);
 
+    /* Lets other threads interrupt X11_WaitEventTimeout() */
+    if (pipe(data->wakeup_pipe) == 0) {
+        int i;
+        for (i = 0; i < 2; ++i) {
+            fcntl(data->wakeup_pipe[i], F_SETFL, fcntl(data->wakeup_pipe[i], F_GETFL) | O_NONBLOCK);
+            fcntl(data->wakeup_pipe[i], F_SETFD, FD_CLOEXEC);
+        }
+    } else {
+        data->wakeup_pipe[0] = data->wakeup_pipe[1] = -1;
+    }
+
 #if SDL_USE_LIBDBUS
     SDL_DBus_Init();
 #endif
@@ -479,6 +494,12 @@ X11_VideoQuit(_THIS)
     X11_QuitMouse(_this);
     X11_QuitTouch(_this);
 
+    if (data->wakeup_pipe[0] >= 0) {
+        close(data->wakeup_pipe[0]);
+        close(data->wakeup_pipe[1]);
+        data->wakeup_pipe[0] = data->wakeup_pipe[1] = -1;
+    }
+
 /* !!! FIXME: other subsystems use D-Bus, so we shouldn't quit it here;
        have SDL.c do this at a higher level, or add refcounting. */
 #if SDL_USE_LIBDBUS
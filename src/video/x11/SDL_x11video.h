@@ -130,6 +130,8 @@ typedef struct SDL_VideoData
 
     Uint32 last_mode_change_deadline;
 
+    int wakeup_pipe[2];  /* written by X11_SendWakeupEvent() */
+
     SDL_bool global_mouse_changed;
     SDL_Point global_mouse_position;
     Uint32 global_mouse_buttons;
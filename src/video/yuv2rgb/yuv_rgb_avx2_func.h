@@ -0,0 +1,280 @@
+// Copyright 2016 Adrien Descamps
+// Distributed under BSD 3-Clause License
+
+/* AVX2 version of yuv_rgb_sse_func.h, converting 32 pixels of two lines per iteration.
+   You need to define the following macros before including this file:
+	AVX2_FUNCTION_NAME
+	STD_FUNCTION_NAME
+	YUV_FORMAT
+	RGB_FORMAT
+*/
+
+/* Most AVX2 unpack and pack instructions work on each 128 bit lane separately,
+   the comments below note which pixels end up in which lane. */
+
+#define UV2RGB_32(U,V,R1,G1,B1,R2,G2,B2) \
+	r_tmp = _mm256_mullo_epi16(V, _mm256_set1_epi16(param->v_r_factor)); \
+	g_tmp = _mm256_add_epi16( \
+		_mm256_mullo_epi16(U, _mm256_set1_epi16(param->u_g_factor)), \
+		_mm256_mullo_epi16(V, _mm256_set1_epi16(param->v_g_factor))); \
+	b_tmp = _mm256_mullo_epi16(U, _mm256_set1_epi16(param->u_b_factor)); \
+	/* move samples 0-3 and 8-11 to the low lane, so the duplication below keeps pixel order */ \
+	r_tmp = _mm256_permute4x64_epi64(r_tmp, 0xD8); \
+	g_tmp = _mm256_permute4x64_epi64(g_tmp, 0xD8); \
+	b_tmp = _mm256_permute4x64_epi64(b_tmp, 0xD8); \
+	/* pixels 0-15 */ \
+	R1 = _mm256_unpacklo_epi16(r_tmp, r_tmp); \
+	G1 = _mm256_unpacklo_epi16(g_tmp, g_tmp); \
+	B1 = _mm256_unpacklo_epi16(b_tmp, b_tmp); \
+	/* pixels 16-31 */ \
+	R2 = _mm256_unpackhi_epi16(r_tmp, r_tmp); \
+	G2 = _mm256_unpackhi_epi16(g_tmp, g_tmp); \
+	B2 = _mm256_unpackhi_epi16(b_tmp, b_tmp); \
+
+#define ADD_Y2RGB_32(Y1,Y2,R1,G1,B1,R2,G2,B2) \
+	Y1 = _mm256_mullo_epi16(_mm256_sub_epi16(Y1, _mm256_set1_epi16(param->y_shift)), _mm256_set1_epi16(param->y_factor)); \
+	Y2 = _mm256_mullo_epi16(_mm256_sub_epi16(Y2, _mm256_set1_epi16(param->y_shift)), _mm256_set1_epi16(param->y_factor)); \
+	\
+	R1 = _mm256_srai_epi16(_mm256_add_epi16(R1, Y1), PRECISION); \
+	G1 = _mm256_srai_epi16(_mm256_add_epi16(G1, Y1), PRECISION); \
+	B1 = _mm256_srai_epi16(_mm256_add_epi16(B1, Y1), PRECISION); \
+	R2 = _mm256_srai_epi16(_mm256_add_epi16(R2, Y2), PRECISION); \
+	G2 = _mm256_srai_epi16(_mm256_add_epi16(G2, Y2), PRECISION); \
+	B2 = _mm256_srai_epi16(_mm256_add_epi16(B2, Y2), PRECISION); \
+
+/* The 8 bit channels coming out of the packs hold pixels 0-7 and 16-23 in
+   the low lane, and pixels 8-15 and 24-31 in the high lane */
+
+#define PACK_RGB565_32(R, G, B, RGB1, RGB2) \
+{ \
+	__m256i red_mask = _mm256_set1_epi16((short)0xF800); \
+	/* pixels 0-15 and 16-31 */ \
+	RGB1 = _mm256_and_si256(_mm256_unpacklo_epi8(_mm256_setzero_si256(), R), red_mask); \
+	RGB2 = _mm256_and_si256(_mm256_unpackhi_epi8(_mm256_setzero_si256(), R), red_mask); \
+	RGB1 = _mm256_or_si256(RGB1, _mm256_slli_epi16(_mm256_srli_epi16(_mm256_unpacklo_epi8(G, _mm256_setzero_si256()), 2), 5)); \
+	RGB2 = _mm256_or_si256(RGB2, _mm256_slli_epi16(_mm256_srli_epi16(_mm256_unpackhi_epi8(G, _mm256_setzero_si256()), 2), 5)); \
+	RGB1 = _mm256_or_si256(RGB1, _mm256_srli_epi16(_mm256_unpacklo_epi8(B, _mm256_setzero_si256()), 3)); \
+	RGB2 = _mm256_or_si256(RGB2, _mm256_srli_epi16(_mm256_unpackhi_epi8(B, _mm256_setzero_si256()), 3)); \
+}
+
+/* C0-C3 are the channels in memory order */
+#define PACK_RGBA_32(C0, C1, C2, C3, RGB1, RGB2, RGB3, RGB4) \
+{ \
+	__m256i lo_01, hi_01, lo_23, hi_23, t1, t2, t3, t4; \
+\
+	lo_01 = _mm256_unpacklo_epi8(C0, C1); \
+	hi_01 = _mm256_unpackhi_epi8(C0, C1); \
+	lo_23 = _mm256_unpacklo_epi8(C2, C3); \
+	hi_23 = _mm256_unpackhi_epi8(C2, C3); \
+	t1 = _mm256_unpacklo_epi16(lo_01, lo_23); /* pixels 0-3 and 8-11 */ \
+	t2 = _mm256_unpackhi_epi16(lo_01, lo_23); /* pixels 4-7 and 12-15 */ \
+	t3 = _mm256_unpacklo_epi16(hi_01, hi_23); /* pixels 16-19 and 24-27 */ \
+	t4 = _mm256_unpackhi_epi16(hi_01, hi_23); /* pixels 20-23 and 28-31 */ \
+	RGB1 = _mm256_permute2x128_si256(t1, t2, 0x20); \
+	RGB2 = _mm256_permute2x128_si256(t1, t2, 0x31); \
+	RGB3 = _mm256_permute2x128_si256(t3, t4, 0x20); \
+	RGB4 = _mm256_permute2x128_si256(t3, t4, 0x31); \
+}
+
+#if RGB_FORMAT == RGB_FORMAT_RGB565
+
+#define PACK_PIXEL \
+	__m256i rgb_1, rgb_2, rgb_3, rgb_4; \
+	\
+	PACK_RGB565_32(r_8_1, g_8_1, b_8_1, rgb_1, rgb_2) \
+	\
+	PACK_RGB565_32(r_8_2, g_8_2, b_8_2, rgb_3, rgb_4) \
+
+#define SAVE_LINE1 \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr1), rgb_1); \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr1+32), rgb_2); \
+
+#define SAVE_LINE2 \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr2), rgb_3); \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr2+32), rgb_4); \
+
+#elif RGB_FORMAT == RGB_FORMAT_RGBA || RGB_FORMAT == RGB_FORMAT_BGRA || \
+      RGB_FORMAT == RGB_FORMAT_ARGB || RGB_FORMAT == RGB_FORMAT_ABGR
+
+#if RGB_FORMAT == RGB_FORMAT_RGBA
+#define PACK_LINE(R, G, B, RGB1, RGB2, RGB3, RGB4) PACK_RGBA_32(a, B, G, R, RGB1, RGB2, RGB3, RGB4)
+#elif RGB_FORMAT == RGB_FORMAT_BGRA
+#define PACK_LINE(R, G, B, RGB1, RGB2, RGB3, RGB4) PACK_RGBA_32(a, R, G, B, RGB1, RGB2, RGB3, RGB4)
+#elif RGB_FORMAT == RGB_FORMAT_ARGB
+#define PACK_LINE(R, G, B, RGB1, RGB2, RGB3, RGB4) PACK_RGBA_32(B, G, R, a, RGB1, RGB2, RGB3, RGB4)
+#else
+#define PACK_LINE(R, G, B, RGB1, RGB2, RGB3, RGB4) PACK_RGBA_32(R, G, B, a, RGB1, RGB2, RGB3, RGB4)
+#endif
+
+#define PACK_PIXEL \
+	__m256i rgb_1, rgb_2, rgb_3, rgb_4, rgb_5, rgb_6, rgb_7, rgb_8; \
+	__m256i a = _mm256_set1_epi8((char)0xFF); \
+	\
+	PACK_LINE(r_8_1, g_8_1, b_8_1, rgb_1, rgb_2, rgb_3, rgb_4) \
+	\
+	PACK_LINE(r_8_2, g_8_2, b_8_2, rgb_5, rgb_6, rgb_7, rgb_8) \
+
+#define SAVE_LINE1 \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr1), rgb_1); \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr1+32), rgb_2); \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr1+64), rgb_3); \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr1+96), rgb_4); \
+
+#define SAVE_LINE2 \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr2), rgb_5); \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr2+32), rgb_6); \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr2+64), rgb_7); \
+	_mm256_storeu_si256((__m256i*)(rgb_ptr2+96), rgb_8); \
+
+#else
+#error PACK_PIXEL unimplemented
+#endif
+
+#if YUV_FORMAT == YUV_FORMAT_420
+
+#define READ_UV	\
+	u_16 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(u_ptr))); \
+	v_16 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(v_ptr))); \
+
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+
+#define READ_UV	\
+	u_16 = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(u_ptr)), _mm256_set1_epi16(0xFF)); \
+	v_16 = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(v_ptr)), _mm256_set1_epi16(0xFF)); \
+
+#else
+#error READ_UV unimplemented
+#endif
+
+#define READ_Y(y_ptr) \
+	y = _mm256_loadu_si256((const __m256i*)(y_ptr)); \
+	y_16_1 = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(y)); \
+	y_16_2 = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(y, 1)); \
+
+#define YUV2RGB_32 \
+	__m256i r_tmp, g_tmp, b_tmp; \
+	__m256i r_16_1, g_16_1, b_16_1, r_16_2, g_16_2, b_16_2; \
+	__m256i r_uv_16_1, g_uv_16_1, b_uv_16_1, r_uv_16_2, g_uv_16_2, b_uv_16_2; \
+	__m256i y, y_16_1, y_16_2, u_16, v_16; \
+	__m256i r_8_1, g_8_1, b_8_1, r_8_2, g_8_2, b_8_2; \
+	\
+	READ_UV \
+	u_16 = _mm256_add_epi16(u_16, _mm256_set1_epi16(-128)); \
+	v_16 = _mm256_add_epi16(v_16, _mm256_set1_epi16(-128)); \
+	\
+	UV2RGB_32(u_16, v_16, r_uv_16_1, g_uv_16_1, b_uv_16_1, r_uv_16_2, g_uv_16_2, b_uv_16_2) \
+	\
+	/* process the 32 pixels of the first line */\
+	r_16_1=r_uv_16_1; g_16_1=g_uv_16_1; b_16_1=b_uv_16_1; \
+	r_16_2=r_uv_16_2; g_16_2=g_uv_16_2; b_16_2=b_uv_16_2; \
+	\
+	READ_Y(y_ptr1) \
+	ADD_Y2RGB_32(y_16_1, y_16_2, r_16_1, g_16_1, b_16_1, r_16_2, g_16_2, b_16_2) \
+	\
+	r_8_1 = _mm256_packus_epi16(r_16_1, r_16_2); \
+	g_8_1 = _mm256_packus_epi16(g_16_1, g_16_2); \
+	b_8_1 = _mm256_packus_epi16(b_16_1, b_16_2); \
+	\
+	/* process the 32 pixels of the second line */\
+	r_16_1=r_uv_16_1; g_16_1=g_uv_16_1; b_16_1=b_uv_16_1; \
+	r_16_2=r_uv_16_2; g_16_2=g_uv_16_2; b_16_2=b_uv_16_2; \
+	\
+	READ_Y(y_ptr2) \
+	ADD_Y2RGB_32(y_16_1, y_16_2, r_16_1, g_16_1, b_16_1, r_16_2, g_16_2, b_16_2) \
+	\
+	r_8_2 = _mm256_packus_epi16(r_16_1, r_16_2); \
+	g_8_2 = _mm256_packus_epi16(g_16_1, g_16_2); \
+	b_8_2 = _mm256_packus_epi16(b_16_1, b_16_2); \
+
+
+AVX2_TARGET void AVX2_FUNCTION_NAME(uint32_t width, uint32_t height,
+	const uint8_t *Y, const uint8_t *U, const uint8_t *V, uint32_t Y_stride, uint32_t UV_stride,
+	uint8_t *RGB, uint32_t RGB_stride,
+	YCbCrType yuv_type)
+{
+	const YUV2RGBParam *const param = &(YUV2RGB[yuv_type]);
+#if YUV_FORMAT == YUV_FORMAT_420
+	const int uv_pixel_stride = 1;
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+	const int uv_pixel_stride = 2;
+#endif
+#if RGB_FORMAT == RGB_FORMAT_RGB565
+	const int rgb_pixel_stride = 2;
+#else
+	const int rgb_pixel_stride = 4;
+#endif
+
+	if (width >= 32) {
+		uint32_t xpos, ypos;
+		for(ypos=0; ypos<(height-1); ypos+=2)
+		{
+			const uint8_t *y_ptr1=Y+ypos*Y_stride,
+				*y_ptr2=Y+(ypos+1)*Y_stride,
+				*u_ptr=U+(ypos/2)*UV_stride,
+				*v_ptr=V+(ypos/2)*UV_stride;
+
+			uint8_t *rgb_ptr1=RGB+ypos*RGB_stride,
+				*rgb_ptr2=RGB+(ypos+1)*RGB_stride;
+
+			for(xpos=0; xpos<(width-31); xpos+=32)
+			{
+				YUV2RGB_32
+				{
+					PACK_PIXEL
+					SAVE_LINE1
+					SAVE_LINE2
+				}
+
+				y_ptr1+=32;
+				y_ptr2+=32;
+				u_ptr+=16*uv_pixel_stride;
+				v_ptr+=16*uv_pixel_stride;
+				rgb_ptr1+=32*rgb_pixel_stride;
+				rgb_ptr2+=32*rgb_pixel_stride;
+			}
+		}
+
+		/* Catch the last line, if needed */
+		if (ypos == (height-1))
+		{
+			const uint8_t *y_ptr=Y+ypos*Y_stride,
+				*u_ptr=U+(ypos/2)*UV_stride,
+				*v_ptr=V+(ypos/2)*UV_stride;
+
+			uint8_t *rgb_ptr=RGB+ypos*RGB_stride;
+
+			STD_FUNCTION_NAME(width, 1, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+		}
+	}
+
+	/* Catch the right column, if needed */
+	{
+		int converted = (width & ~31);
+		if (converted != width)
+		{
+			const uint8_t *y_ptr=Y+converted,
+				*u_ptr=U+converted*uv_pixel_stride/2,
+				*v_ptr=V+converted*uv_pixel_stride/2;
+
+			uint8_t *rgb_ptr=RGB+converted*rgb_pixel_stride;
+
+			STD_FUNCTION_NAME(width-converted, height, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+		}
+	}
+}
+
+#undef AVX2_FUNCTION_NAME
+#undef STD_FUNCTION_NAME
+#undef YUV_FORMAT
+#undef RGB_FORMAT
+#undef UV2RGB_32
+#undef ADD_Y2RGB_32
+#undef PACK_RGB565_32
+#undef PACK_RGBA_32
+#undef PACK_LINE
+#undef PACK_PIXEL
+#undef SAVE_LINE1
+#undef SAVE_LINE2
+#undef READ_Y
+#undef READ_UV
+#undef YUV2RGB_32
@@ -7,6 +7,13 @@
 #include "SDL.h"
 #include "SDL_test.h"
 
+#if defined(__LINUX__) || defined(__MACOSX__)
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define EVENTS_TEST_SIGNALS 1
+#endif
+
 /* ================= Test Case Implementation ================== */
 
 /* Test case functions */
@@ -174,6 +181,559 @@ events_addDelEventWatchWithUserdata(void *arg)
    return TEST_COMPLETED;
 }
 
+/* Thread that pushes a user event after a short delay */
+static int SDLCALL _events_delayedPushThread(void *arg)
+{
+   SDL_Event event;
+
+   SDL_Delay(100);
+   SDL_zero(event);
+   event.type = SDL_USEREVENT;
+   event.user.code = *(int *)arg;
+   SDL_PushEvent(&event);
+   return 0;
+}
+
+/**
+ * @brief Test that waiting for events wakes up for events pushed from other threads and times out otherwise.
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_WaitEventTimeout
+ */
+int
+events_waitEventTimeout(void *arg)
+{
+   SDL_Event event;
+   SDL_Thread *thread;
+   Uint32 start, elapsed;
+   int code = SDLTest_RandomSint32();
+   int result;
+
+   /* Nothing queued: the wait has to run for the full timeout */
+   SDL_PumpEvents();
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   start = SDL_GetTicks();
+   result = SDL_WaitEventTimeout(&event, 50);
+   elapsed = SDL_GetTicks() - start;
+   SDLTest_AssertPass("Call to SDL_WaitEventTimeout() with empty queue");
+   SDLTest_AssertCheck(result == 0, "Check result from SDL_WaitEventTimeout, expected: 0, got: %d", result);
+   SDLTest_AssertCheck(elapsed >= 50, "Check that the wait lasted for the timeout, expected: >= 50, got: %u", (unsigned int)elapsed);
+
+   /* An event pushed from another thread wakes the waiter */
+   thread = SDL_CreateThread(_events_delayedPushThread, "events_delayedPushThread", &code);
+   SDLTest_AssertCheck(thread != NULL, "Check that SDL_CreateThread() succeeded");
+   if (thread == NULL) {
+      return TEST_ABORTED;
+   }
+   start = SDL_GetTicks();
+   do {
+      result = SDL_WaitEventTimeout(&event, 10000);
+   } while (result == 1 && event.type != SDL_USEREVENT);
+   elapsed = SDL_GetTicks() - start;
+   SDL_WaitThread(thread, NULL);
+   SDLTest_AssertPass("Call to SDL_WaitEventTimeout() with event pushed from a thread");
+   SDLTest_AssertCheck(result == 1, "Check result from SDL_WaitEventTimeout, expected: 1, got: %d", result);
+   SDLTest_AssertCheck(event.type == SDL_USEREVENT && event.user.code == code, "Check that the pushed user event was returned");
+   SDLTest_AssertCheck(elapsed < 5000, "Check that the waiter woke up for the event, expected: < 5000, got: %u", (unsigned int)elapsed);
+
+   return TEST_COMPLETED;
+}
+
+#ifdef EVENTS_TEST_SIGNALS
+/* Thread that sends SIGINT to the process after a short delay. SDL threads
+   block signals, so it's handled on the thread that waits for events. */
+static int SDLCALL _events_raiseSignalThread(void *arg)
+{
+   SDL_Delay(100);
+   kill(getpid(), SIGINT);
+   return 0;
+}
+
+/* Waits for the quit event of a SIGINT raised while waiting, returns how long that took or -1 */
+static int
+_waitForSignalQuit(void)
+{
+   SDL_Event event;
+   SDL_Thread *thread;
+   Uint32 start;
+   int result;
+
+   SDL_PumpEvents();
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   thread = SDL_CreateThread(_events_raiseSignalThread, "events_raiseSignalThread", NULL);
+   if (thread == NULL) {
+      return -1;
+   }
+   start = SDL_GetTicks();
+   do {
+      result = SDL_WaitEventTimeout(&event, 3000);
+   } while (result == 1 && event.type != SDL_QUIT);
+   SDL_WaitThread(thread, NULL);
+   return (result == 1) ? (int)(SDL_GetTicks() - start) : -1;
+}
+#endif
+
+/**
+ * @brief Test that a SIGINT wakes up a thread waiting for events, with and without a video device.
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_WaitEventTimeout
+ */
+int
+events_waitEventSignal(void *arg)
+{
+#ifdef EVENTS_TEST_SIGNALS
+   struct sigaction action;
+   const char *driver = SDL_GetCurrentVideoDriver();
+   int elapsed, status = 0;
+   pid_t pid;
+
+   /* Only SDL's own handler turns the signal into a quit event */
+   sigaction(SIGINT, NULL, &action);
+   if (action.sa_handler == SIG_DFL || action.sa_handler == SIG_IGN) {
+      SDLTest_Log("SIGINT isn't handled by SDL, skipping test");
+      return TEST_SKIPPED;
+   }
+
+   elapsed = _waitForSignalQuit();
+   SDLTest_AssertPass("Call to SDL_WaitEventTimeout() while SIGINT is raised");
+   SDLTest_AssertCheck(elapsed >= 0 && elapsed < 1000, "Check that the quit event came in time, expected: < 1000, got: %d", elapsed);
+
+   /* Without a video device the wait is on the event queue alone. The video
+      subsystem is shut down in a child process, so the test harness keeps its
+      windows; that's only harmless for a driver without a display connection. */
+   if (driver == NULL || SDL_strcmp(driver, "dummy") != 0) {
+      SDLTest_Log("Not using the dummy video driver, skipping the check without a video device");
+      return TEST_COMPLETED;
+   }
+   pid = fork();
+   if (pid == 0) {
+      SDL_InitSubSystem(SDL_INIT_EVENTS);
+      SDL_VideoQuit();
+      elapsed = _waitForSignalQuit();
+      _exit((elapsed >= 0 && elapsed < 1000) ? 0 : 1);
+   }
+   SDLTest_AssertCheck(pid > 0, "Check that fork() succeeded");
+   if (pid > 0) {
+      waitpid(pid, &status, 0);
+      SDLTest_AssertCheck(WIFEXITED(status) && WEXITSTATUS(status) == 0, "Check that the quit event came in time without a video device");
+   }
+   return TEST_COMPLETED;
+#else
+   SDLTest_Log("Signals aren't tested on this platform, skipping test");
+   return TEST_SKIPPED;
+#endif
+}
+
+#define EVENTS_PRODUCER_THREADS 8
+#define EVENTS_PER_PRODUCER     2000
+
+/* Thread that pushes a numbered sequence of user events */
+static int SDLCALL _events_producerThread(void *arg)
+{
+   SDL_Event event;
+   int i;
+
+   SDL_zero(event);
+   event.type = SDL_USEREVENT;
+   event.user.code = (int)(intptr_t)arg;
+   for (i = 0; i < EVENTS_PER_PRODUCER; ++i) {
+      event.user.data1 = (void *)(intptr_t)i;
+      while (SDL_PushEvent(&event) <= 0) {
+         SDL_Delay(1);
+      }
+   }
+   return 0;
+}
+
+/* Runs the producer threads and reads their events, pausing for 'pause' ms
+   between reads. Each thread's events must come out in the order it pushed them. */
+static void
+_readFromProducers(Uint32 pause)
+{
+   SDL_Thread *threads[EVENTS_PRODUCER_THREADS];
+   int next[EVENTS_PRODUCER_THREADS];
+   SDL_Event events[64];
+   int i, count, received = 0, ordered = 1;
+   Uint32 start;
+
+   for (i = 0; i < EVENTS_PRODUCER_THREADS; ++i) {
+      next[i] = 0;
+      threads[i] = SDL_CreateThread(_events_producerThread, "events_producerThread", (void *)(intptr_t)i);
+      SDLTest_AssertCheck(threads[i] != NULL, "Check that SDL_CreateThread() succeeded");
+   }
+
+   start = SDL_GetTicks();
+   while (received < EVENTS_PRODUCER_THREADS * EVENTS_PER_PRODUCER && !SDL_TICKS_PASSED(SDL_GetTicks(), start + 30000)) {
+      if (pause) {
+         SDL_Delay(pause);
+      }
+      count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_USEREVENT, SDL_USEREVENT);
+      for (i = 0; i < count; ++i) {
+         const int producer = events[i].user.code;
+         if (producer < 0 || producer >= EVENTS_PRODUCER_THREADS ||
+             (int)(intptr_t)events[i].user.data1 != next[producer]) {
+            ordered = 0;
+         } else {
+            ++next[producer];
+         }
+      }
+      received += SDL_max(count, 0);
+   }
+
+   for (i = 0; i < EVENTS_PRODUCER_THREADS; ++i) {
+      SDL_WaitThread(threads[i], NULL);
+   }
+   SDLTest_AssertPass("Call to SDL_PeepEvents() while pushing from %d threads", EVENTS_PRODUCER_THREADS);
+   SDLTest_AssertCheck(received == EVENTS_PRODUCER_THREADS * EVENTS_PER_PRODUCER, "Check number of events received, expected: %d, got: %d", EVENTS_PRODUCER_THREADS * EVENTS_PER_PRODUCER, received);
+   SDLTest_AssertCheck(ordered, "Check that each thread's events were received in order");
+   SDLTest_AssertCheck(!SDL_HasEvent(SDL_USEREVENT), "Check that no user events are left");
+}
+
+/**
+ * @brief Test pushing events from several threads while the queue is being read.
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PushEvent
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PeepEvents
+ */
+int
+events_pushFromThreads(void *arg)
+{
+   SDL_Event events[2];
+   SDL_Event event;
+   int peeked;
+
+   SDL_PumpEvents();
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+   /* Peeking and type ranges still see events in the order they were pushed */
+   SDL_zero(event);
+   event.type = SDL_USEREVENT + 1;
+   SDL_PushEvent(&event);
+   event.type = SDL_USEREVENT;
+   SDL_PushEvent(&event);
+   peeked = SDL_PeepEvents(events, 2, SDL_PEEKEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(peeked == 2 && events[0].type == SDL_USEREVENT + 1 && events[1].type == SDL_USEREVENT, "Check that SDL_PEEKEVENT returns both events in order");
+   peeked = SDL_PeepEvents(events, 2, SDL_GETEVENT, SDL_USEREVENT, SDL_USEREVENT);
+   SDLTest_AssertCheck(peeked == 1 && events[0].type == SDL_USEREVENT, "Check that SDL_GETEVENT honors the type range");
+   SDLTest_AssertCheck(SDL_HasEvent(SDL_USEREVENT + 1), "Check that the event outside the range is still queued");
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+   _readFromProducers(0);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Test that events keep their order when the producers alternate between a full and an available ring.
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PushEvent
+ */
+int
+events_pushPastFullRing(void *arg)
+{
+   SDL_PumpEvents();
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+   /* Reading with pauses lets the lock-free ring fill up, so the producers
+      fall back to adding events under the lock until the next read empties it */
+   _readFromProducers(1);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Test merging of motion and axis events with SDL_HINT_EVENT_COALESCING.
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PushEvent
+ */
+int
+events_coalesceMotion(void *arg)
+{
+   SDL_Event event, events[8];
+   int i, count;
+
+   SDL_PumpEvents();
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDL_SetHint(SDL_HINT_EVENT_COALESCING, "1");
+   SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_EVENT_COALESCING, \"1\")");
+
+   /* Three moves with interleaved axis changes on two joystick axes */
+   for (i = 1; i <= 3; ++i) {
+      SDL_zero(event);
+      event.type = SDL_MOUSEMOTION;
+      event.motion.which = 1;
+      event.motion.x = i * 10;
+      event.motion.y = i * 20;
+      event.motion.xrel = 10;
+      event.motion.yrel = 20;
+      SDL_PushEvent(&event);
+
+      SDL_zero(event);
+      event.type = SDL_JOYAXISMOTION;
+      event.jaxis.axis = (Uint8)(i % 2);
+      event.jaxis.value = (Sint16)(i * 100);
+      SDL_PushEvent(&event);
+   }
+
+   /* A button press ends the run, so the next move is kept separate */
+   SDL_zero(event);
+   event.type = SDL_MOUSEBUTTONDOWN;
+   event.button.which = 1;
+   SDL_PushEvent(&event);
+   SDL_zero(event);
+   event.type = SDL_MOUSEMOTION;
+   event.motion.which = 1;
+   event.motion.xrel = 1;
+   SDL_PushEvent(&event);
+
+   count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(count == 5, "Check number of queued events, expected: 5, got: %d", count);
+   if (count == 5) {
+      SDLTest_AssertCheck(events[0].type == SDL_MOUSEMOTION && events[0].motion.x == 30 && events[0].motion.y == 60,
+         "Check merged motion position, expected: 30,60, got: %d,%d", events[0].motion.x, events[0].motion.y);
+      SDLTest_AssertCheck(events[0].motion.xrel == 30 && events[0].motion.yrel == 60,
+         "Check merged relative motion, expected: 30,60, got: %d,%d", events[0].motion.xrel, events[0].motion.yrel);
+      SDLTest_AssertCheck(events[1].type == SDL_JOYAXISMOTION && events[1].jaxis.axis == 1 && events[1].jaxis.value == 300,
+         "Check merged axis 1 value, expected: 300, got: %d", (int)events[1].jaxis.value);
+      SDLTest_AssertCheck(events[2].type == SDL_JOYAXISMOTION && events[2].jaxis.axis == 0 && events[2].jaxis.value == 200,
+         "Check axis 0 value, expected: 200, got: %d", (int)events[2].jaxis.value);
+      SDLTest_AssertCheck(events[3].type == SDL_MOUSEBUTTONDOWN, "Check that the button press was kept");
+      SDLTest_AssertCheck(events[4].type == SDL_MOUSEMOTION && events[4].motion.xrel == 1, "Check that motion after the button press was not merged");
+   }
+
+   /* An event of another category between two moves keeps them apart */
+   SDL_zero(event);
+   event.type = SDL_MOUSEMOTION;
+   event.motion.which = 1;
+   event.motion.xrel = 1;
+   SDL_PushEvent(&event);
+   SDL_zero(event);
+   event.type = SDL_USEREVENT;
+   SDL_PushEvent(&event);
+   SDL_zero(event);
+   event.type = SDL_MOUSEMOTION;
+   event.motion.which = 1;
+   event.motion.xrel = 2;
+   SDL_PushEvent(&event);
+   count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(count == 3, "Check number of queued events around a user event, expected: 3, got: %d", count);
+   if (count == 3) {
+      SDLTest_AssertCheck(events[0].type == SDL_MOUSEMOTION && events[0].motion.xrel == 1 &&
+                          events[1].type == SDL_USEREVENT &&
+                          events[2].type == SDL_MOUSEMOTION && events[2].motion.xrel == 2,
+         "Check that the moves around the user event were not merged");
+   }
+
+   /* Without the hint every event is queued */
+   SDL_SetHint(SDL_HINT_EVENT_COALESCING, "0");
+   SDL_zero(event);
+   event.type = SDL_MOUSEMOTION;
+   SDL_PushEvent(&event);
+   SDL_PushEvent(&event);
+   count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(count == 2, "Check number of queued events without coalescing, expected: 2, got: %d", count);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Test retrieving many events at once, by type range and in order.
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PollEvents
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_HasEvent
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_FlushEvents
+ */
+int
+events_pollEventsInRange(void *arg)
+{
+   const Uint32 types[] = {
+      SDL_USEREVENT, SDL_KEYDOWN, SDL_WINDOWEVENT, SDL_JOYDEVICEADDED, SDL_QUIT,
+      SDL_MOUSEMOTION, SDL_USEREVENT + 1, SDL_CONTROLLERDEVICEADDED, SDL_KEYUP, SDL_CLIPBOARDUPDATE
+   };
+   SDL_Event event, events[32];
+   int i, count, ordered;
+
+   SDL_PumpEvents();
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+   for (i = 0; i < SDL_arraysize(types); ++i) {
+      SDL_zero(event);
+      event.type = types[i];
+      event.user.code = i;
+      SDL_PushEvent(&event);
+   }
+
+   SDLTest_AssertCheck(SDL_HasEvent(SDL_CONTROLLERDEVICEADDED), "Check SDL_HasEvent(SDL_CONTROLLERDEVICEADDED)");
+   SDLTest_AssertCheck(!SDL_HasEvent(SDL_KEYMAPCHANGED), "Check !SDL_HasEvent(SDL_KEYMAPCHANGED)");
+   SDLTest_AssertCheck(SDL_HasEvents(SDL_JOYAXISMOTION, SDL_JOYDEVICEREMOVED), "Check SDL_HasEvents() with a range ending in device events");
+
+   /* A range covering input and device events comes back in push order */
+   count = SDL_PollEvents(events, SDL_arraysize(events), SDL_KEYDOWN, SDL_CONTROLLERDEVICEREMAPPED);
+   SDLTest_AssertPass("Call to SDL_PollEvents() for a type range");
+   SDLTest_AssertCheck(count == 5, "Check number of events in range, expected: 5, got: %d", count);
+   ordered = (count == 5);
+   for (i = 0; ordered && i < count; ++i) {
+      const Uint32 expected[] = { SDL_KEYDOWN, SDL_JOYDEVICEADDED, SDL_MOUSEMOTION, SDL_CONTROLLERDEVICEADDED, SDL_KEYUP };
+      ordered = (events[i].type == expected[i]);
+   }
+   SDLTest_AssertCheck(ordered, "Check that the events in range were returned in order");
+
+   /* Flushing one range leaves the others alone */
+   SDL_FlushEvents(SDL_USEREVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(!SDL_HasEvents(SDL_USEREVENT, SDL_LASTEVENT), "Check that user events were flushed");
+
+   count = SDL_PollEvents(events, SDL_arraysize(events), SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(count == 3, "Check number of remaining events, expected: 3, got: %d", count);
+   if (count == 3) {
+      SDLTest_AssertCheck(events[0].type == SDL_WINDOWEVENT && events[1].type == SDL_QUIT && events[2].type == SDL_CLIPBOARDUPDATE,
+         "Check that the remaining events were returned in order");
+   }
+
+   count = SDL_PollEvents(events, SDL_arraysize(events), SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(count == 0, "Check that the queue is empty, got: %d", count);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Test what happens when events are pushed onto a full queue.
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PushEvent
+ */
+int
+events_queueOverflow(void *arg)
+{
+   SDL_Event event;
+   int pushed = 0, result;
+
+   SDL_PumpEvents();
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDL_SetHint(SDL_HINT_EVENT_COALESCING, "0");
+   SDL_SetHint(SDL_HINT_EVENT_QUEUE_OVERFLOW, "error");
+
+   /* One motion event at the front, then user events until the queue is full */
+   SDL_zero(event);
+   event.type = SDL_MOUSEMOTION;
+   event.motion.xrel = 1;
+   SDL_PushEvent(&event);
+   SDL_zero(event);
+   event.type = SDL_USEREVENT;
+   while (pushed < 1000000 && SDL_PushEvent(&event) == 1) {
+      ++pushed;
+   }
+   SDLTest_AssertCheck(pushed > 0 && pushed < 1000000, "Check that the queue filled up, pushed %d events", pushed);
+
+   result = SDL_PushEvent(&event);
+   SDLTest_AssertCheck(result < 0, "Check that pushing onto a full queue fails, expected: <0, got: %d", result);
+
+   /* With drop_oldest the motion event makes room, but nothing else will */
+   SDL_SetHint(SDL_HINT_EVENT_QUEUE_OVERFLOW, "drop_oldest");
+   event.user.code = 1;
+   result = SDL_PushEvent(&event);
+   SDLTest_AssertCheck(result == 1, "Check that the oldest motion event made room, expected: 1, got: %d", result);
+   SDLTest_AssertCheck(!SDL_HasEvent(SDL_MOUSEMOTION), "Check that the motion event was dropped");
+   result = SDL_PushEvent(&event);
+   SDLTest_AssertCheck(result < 0, "Check that user events are never dropped, expected: <0, got: %d", result);
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDL_SetHint(SDL_HINT_EVENT_QUEUE_OVERFLOW, NULL);
+   SDL_ClearError();
+
+   return TEST_COMPLETED;
+}
+
+/* Restarts the event loop, so it picks up SDL_HINT_EVENT_QUEUE_PREALLOCATE */
+static void
+_restartEventLoop(void)
+{
+   int refcount = 0;
+
+   while (SDL_WasInit(SDL_INIT_EVENTS)) {
+      SDL_QuitSubSystem(SDL_INIT_EVENTS);
+      ++refcount;
+   }
+   while (refcount--) {
+      SDL_InitSubSystem(SDL_INIT_EVENTS);
+   }
+}
+
+/* Pushes user events until the queue is full, returns how many fit */
+static int
+_fillEventQueue(void)
+{
+   SDL_Event event;
+   int pushed = 0;
+
+   SDL_zero(event);
+   event.type = SDL_USEREVENT;
+   while (pushed < 1000000 && SDL_PushEvent(&event) == 1) {
+      ++pushed;
+   }
+   return pushed;
+}
+
+/**
+ * @brief Test a preallocated event queue and dropping events when it's full.
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PushEvent
+ */
+int
+events_preallocatedQueue(void *arg)
+{
+   SDL_Event event, events[4];
+   int i, pushed, count;
+
+   SDL_SetHint(SDL_HINT_EVENT_COALESCING, "0");
+   SDL_SetHint(SDL_HINT_EVENT_QUEUE_OVERFLOW, "error");
+
+   /* The queue holds exactly as many events as were preallocated */
+   SDL_SetHint(SDL_HINT_EVENT_QUEUE_PREALLOCATE, "100");
+   _restartEventLoop();
+   SDLTest_AssertPass("Restarted the event loop with SDL_HINT_EVENT_QUEUE_PREALLOCATE set to 100");
+   pushed = _fillEventQueue();
+   SDLTest_AssertCheck(pushed == 100, "Check the size of the preallocated queue, expected: 100, got: %d", pushed);
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+   /* Sizes beyond the queue limit are capped */
+   SDL_SetHint(SDL_HINT_EVENT_QUEUE_PREALLOCATE, "1000000");
+   _restartEventLoop();
+   pushed = _fillEventQueue();
+   SDLTest_AssertCheck(pushed == 65535, "Check the size of a capped preallocated queue, expected: 65535, got: %d", pushed);
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+   /* Dropping a motion event adds its relative motion to the next one of the same mouse */
+   SDL_SetHint(SDL_HINT_EVENT_QUEUE_PREALLOCATE, "100");
+   _restartEventLoop();
+   for (i = 0; i < 3; ++i) {
+      SDL_zero(event);
+      event.type = SDL_MOUSEMOTION;
+      event.motion.which = (i == 1) ? 2 : 1;
+      event.motion.xrel = (i + 1) * 10;
+      event.motion.yrel = (i + 1) * 20;
+      SDL_PushEvent(&event);
+   }
+   pushed = _fillEventQueue();
+   SDLTest_AssertCheck(pushed == 97, "Check the room left after three motion events, expected: 97, got: %d", pushed);
+   SDL_SetHint(SDL_HINT_EVENT_QUEUE_OVERFLOW, "drop_oldest");
+   SDL_zero(event);
+   event.type = SDL_USEREVENT;
+   SDLTest_AssertCheck(SDL_PushEvent(&event) == 1, "Check that the oldest motion event made room");
+   count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_MOUSEMOTION, SDL_MOUSEMOTION);
+   SDLTest_AssertCheck(count == 2, "Check number of motion events left, expected: 2, got: %d", count);
+   if (count == 2) {
+      SDLTest_AssertCheck(events[0].motion.which == 2 && events[0].motion.xrel == 20 && events[0].motion.yrel == 40,
+         "Check that the other mouse kept its motion, expected: 20,40, got: %d,%d", events[0].motion.xrel, events[0].motion.yrel);
+      SDLTest_AssertCheck(events[1].motion.which == 1 && events[1].motion.xrel == 40 && events[1].motion.yrel == 80,
+         "Check that the dropped motion was folded in, expected: 40,80, got: %d,%d", events[1].motion.xrel, events[1].motion.yrel);
+   }
+
+   SDL_SetHint(SDL_HINT_EVENT_QUEUE_PREALLOCATE, NULL);
+   SDL_SetHint(SDL_HINT_EVENT_QUEUE_OVERFLOW, NULL);
+   SDL_SetHint(SDL_HINT_EVENT_COALESCING, NULL);
+   _restartEventLoop();
+   SDL_ClearError();
+
+   return TEST_COMPLETED;
+}
 
 /* ================= Test References ================== */
 
@@ -187,9 +747,33 @@ static const SDLTest_TestCaseReference eventsTest2 =
 static const SDLTest_TestCaseReference eventsTest3 =
         { (SDLTest_TestCaseFp)events_addDelEventWatchWithUserdata, "events_addDelEventWatchWithUserdata", "Adds and deletes an event watch function with userdata", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference eventsTest4 =
+        { (SDLTest_TestCaseFp)events_waitEventTimeout, "events_waitEventTimeout", "Waits for events pushed from another thread and for timeouts", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest5 =
+        { (SDLTest_TestCaseFp)events_pushFromThreads, "events_pushFromThreads", "Pushes events from several threads while reading the queue", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest6 =
+        { (SDLTest_TestCaseFp)events_coalesceMotion, "events_coalesceMotion", "Merges motion and axis events with SDL_HINT_EVENT_COALESCING", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest7 =
+        { (SDLTest_TestCaseFp)events_pollEventsInRange, "events_pollEventsInRange", "Retrieves events in bulk by type range", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest8 =
+        { (SDLTest_TestCaseFp)events_queueOverflow, "events_queueOverflow", "Pushes events onto a full queue with each SDL_HINT_EVENT_QUEUE_OVERFLOW policy", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest9 =
+        { (SDLTest_TestCaseFp)events_preallocatedQueue, "events_preallocatedQueue", "Fills a queue preallocated with SDL_HINT_EVENT_QUEUE_PREALLOCATE and drops motion from it", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest10 =
+        { (SDLTest_TestCaseFp)events_waitEventSignal, "events_waitEventSignal", "Wakes up a thread waiting for events when SIGINT is raised", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest11 =
+        { (SDLTest_TestCaseFp)events_pushPastFullRing, "events_pushPastFullRing", "Pushes events from several threads while the ring alternates between full and available", TEST_ENABLED };
+
 /* Sequence of Events test cases */
 static const SDLTest_TestCaseReference *eventsTests[] =  {
-    &eventsTest1, &eventsTest2, &eventsTest3, NULL
+    &eventsTest1, &eventsTest2, &eventsTest3, &eventsTest4, &eventsTest5, &eventsTest6, &eventsTest7, &eventsTest8, &eventsTest9, &eventsTest10, &eventsTest11, NULL
 };
 
 /* Events test suite (global) */
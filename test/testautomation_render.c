@@ -766,6 +766,1859 @@ render_testBlitBlend (void *arg)
 }
 
 
+/**
+ * @brief Tests copying YUV textures with the software renderer, which
+ * converts them straight into the target.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateSoftwareRenderer
+ * http://wiki.libsdl.org/moin.cgi/SDL_UpdateTexture
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderCopy
+ */
+int
+render_testSoftwareYUVCopy(void *arg)
+{
+   const Uint32 formats[] = { SDL_PIXELFORMAT_YV12, SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_YUY2 };
+   /* Unscaled, unscaled from an odd offset, scaled 2x, and clipped to the left edge */
+   const SDL_Rect srcrects[] = { { 0, 0, 16, 12 }, { 3, 1, 8, 6 }, { 0, 0, 16, 12 }, { 0, 0, 16, 12 } };
+   const SDL_Rect dstrects[] = { { 0, 0, 16, 12 }, { 20, 0, 8, 6 }, { 32, 0, 32, 24 }, { -5, 30, 16, 12 } };
+   const int w = 16, h = 12;
+   SDL_Surface *pattern, *converted, *target, *expected;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture;
+   Uint8 *yuv;
+   int ret, i, j, x, y, pitch;
+
+   pattern = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+   converted = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+   target = SDL_CreateRGBSurfaceWithFormat(0, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, 32, RENDER_COMPARE_FORMAT);
+   expected = SDL_CreateRGBSurfaceWithFormat(0, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, 32, RENDER_COMPARE_FORMAT);
+   yuv = (Uint8 *)SDL_malloc(4 * w * h);
+   SDLTest_AssertCheck(pattern && converted && target && expected && yuv, "Verify test surfaces were created");
+   if (!pattern || !converted || !target || !expected || !yuv) {
+      return TEST_ABORTED;
+   }
+
+   for (y = 0; y < h; y++) {
+      for (x = 0; x < w; x++) {
+         ((Uint32 *)pattern->pixels)[y * w + x] = 0xFF000000 | ((x * 16) << 16) | ((y * 20) << 8) | ((x * y) & 0xFF);
+      }
+   }
+
+   for (i = 0; i < SDL_arraysize(formats); i++) {
+      pitch = (formats[i] == SDL_PIXELFORMAT_YUY2) ? 4 * ((w + 1) / 2) : w;
+      ret = SDL_ConvertPixels(w, h, pattern->format->format, pattern->pixels, pattern->pitch, formats[i], yuv, pitch);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_ConvertPixels to %s, expected: 0, got: %i", SDL_GetPixelFormatName(formats[i]), ret);
+
+      /* The expected result uses the same conversion, followed by a plain copy or 2x scale */
+      ret = SDL_ConvertPixels(w, h, formats[i], yuv, pitch, converted->format->format, converted->pixels, converted->pitch);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_ConvertPixels from %s, expected: 0, got: %i", SDL_GetPixelFormatName(formats[i]), ret);
+      SDL_FillRect(expected, NULL, SDL_MapRGB(expected->format, 0, 0, 0));
+      for (j = 0; j < SDL_arraysize(dstrects); j++) {
+         const SDL_Rect *srcrect = &srcrects[j];
+         const SDL_Rect *dstrect = &dstrects[j];
+         for (y = SDL_max(dstrect->y, 0); y < dstrect->y + dstrect->h; y++) {
+            for (x = SDL_max(dstrect->x, 0); x < dstrect->x + dstrect->w; x++) {
+               const int sx = srcrect->x + (x - dstrect->x) * srcrect->w / dstrect->w;
+               const int sy = srcrect->y + (y - dstrect->y) * srcrect->h / dstrect->h;
+               ((Uint32 *)expected->pixels)[y * (expected->pitch / 4) + x] = ((Uint32 *)converted->pixels)[sy * (converted->pitch / 4) + sx];
+            }
+         }
+      }
+
+      swrenderer = SDL_CreateSoftwareRenderer(target);
+      SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+      if (swrenderer == NULL) {
+         break;
+      }
+      texture = SDL_CreateTexture(swrenderer, formats[i], SDL_TEXTUREACCESS_STREAMING, w, h);
+      SDLTest_AssertCheck(texture != NULL, "Verify result from SDL_CreateTexture(%s) is not NULL", SDL_GetPixelFormatName(formats[i]));
+      if (texture != NULL) {
+         ret = SDL_UpdateTexture(texture, NULL, yuv, pitch);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTexture, expected: 0, got: %i", ret);
+         SDL_SetRenderDrawColor(swrenderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+         SDL_RenderClear(swrenderer);
+         for (j = 0; j < SDL_arraysize(dstrects); j++) {
+            ret = SDL_RenderCopy(swrenderer, texture, &srcrects[j], &dstrects[j]);
+            SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopy, expected: 0, got: %i", ret);
+         }
+         SDL_RenderPresent(swrenderer);
+
+         ret = SDLTest_CompareSurfaces(target, expected, 0);
+         SDLTest_AssertCheck(ret == 0, "Validate %s copies, expected: 0, got: %i", SDL_GetPixelFormatName(formats[i]), ret);
+         SDL_DestroyTexture(texture);
+      }
+      SDL_DestroyRenderer(swrenderer);
+   }
+
+   SDL_free(yuv);
+   SDL_FreeSurface(pattern);
+   SDL_FreeSurface(converted);
+   SDL_FreeSurface(target);
+   SDL_FreeSurface(expected);
+
+   return TEST_COMPLETED;
+}
+
+/* Draws a scene with commands that cross the tiles of the software renderer */
+static void
+_drawThreadsTestScene(SDL_Renderer *swrenderer, SDL_Texture *texture)
+{
+   const SDL_Point polyline[] = { { 5, 5 }, { 300, 20 }, { 150, 230 }, { 150, 60 }, { 10, 60 } };
+   SDL_Rect rect;
+   int i;
+
+   SDL_SetRenderDrawColor(swrenderer, 20, 40, 60, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+
+   /* Blended rectangles and points all over the target */
+   SDL_SetRenderDrawBlendMode(swrenderer, SDL_BLENDMODE_BLEND);
+   for (i = 0; i < 12; i++) {
+      rect.x = (i * 53) % 300;
+      rect.y = (i * 31) % 220;
+      rect.w = 30 + i * 7;
+      rect.h = 20 + i * 5;
+      SDL_SetRenderDrawColor(swrenderer, i * 20, 255 - i * 20, 128, 100 + i * 10);
+      SDL_RenderFillRect(swrenderer, &rect);
+   }
+   for (i = 0; i < 200; i++) {
+      SDL_SetRenderDrawColor(swrenderer, 255, i, 0, 160);
+      SDL_RenderDrawPoint(swrenderer, (i * 37) % 320, (i * 23) % 240);
+   }
+
+   /* Diagonal and straight lines */
+   SDL_SetRenderDrawColor(swrenderer, 255, 255, 255, 200);
+   SDL_RenderDrawLines(swrenderer, polyline, SDL_arraysize(polyline));
+   rect.x = 70; rect.y = 50; rect.w = 120; rect.h = 90;
+   SDL_RenderDrawRect(swrenderer, &rect);
+   SDL_RenderDrawLine(swrenderer, 100, 100, 110, 120);
+
+   /* Plain, modulated, scaled and rotated copies */
+   rect.x = 50; rect.y = 37; rect.w = 40; rect.h = 30;
+   SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   SDL_SetTextureColorMod(texture, 255, 128, 64);
+   SDL_SetTextureAlphaMod(texture, 128);
+   rect.x = 120; rect.y = 110;
+   SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   SDL_SetTextureColorMod(texture, 255, 255, 255);
+   SDL_SetTextureAlphaMod(texture, 255);
+   rect.x = 30; rect.y = 100; rect.w = 70; rect.h = 50;
+   SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   rect.x = 132; rect.y = 132; rect.w = 20; rect.h = 15;
+   SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   rect.x = 190; rect.y = 40; rect.w = 40; rect.h = 30;
+   SDL_RenderCopyEx(swrenderer, texture, NULL, &rect, 30.0, NULL, SDL_FLIP_HORIZONTAL);
+
+   /* The same again, in a viewport and through a clip rectangle */
+   rect.x = 10; rect.y = 10; rect.w = 300; rect.h = 200;
+   SDL_RenderSetViewport(swrenderer, &rect);
+   rect.x = 20; rect.y = 20; rect.w = 200; rect.h = 150;
+   SDL_RenderSetClipRect(swrenderer, &rect);
+   SDL_SetRenderDrawColor(swrenderer, 0, 0, 255, 128);
+   rect.x = 0; rect.y = 0; rect.w = 300; rect.h = 100;
+   SDL_RenderFillRect(swrenderer, &rect);
+   SDL_RenderDrawLines(swrenderer, polyline, SDL_arraysize(polyline));
+   rect.x = 150; rect.y = 90; rect.w = 80; rect.h = 60;
+   SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   SDL_RenderSetClipRect(swrenderer, NULL);
+   SDL_RenderSetViewport(swrenderer, NULL);
+
+   SDL_RenderPresent(swrenderer);
+}
+
+/**
+ * @brief Tests that the software renderer draws the same on several threads
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateSoftwareRenderer
+ */
+int
+render_testSoftwareThreads(void *arg)
+{
+   const char *threads[] = { "1", "4" };
+   SDL_Surface *targets[2], *pattern;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture;
+   int ret, i, x, y;
+
+   pattern = SDL_CreateRGBSurfaceWithFormat(0, 40, 30, 32, SDL_PIXELFORMAT_ARGB8888);
+   targets[0] = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 32, RENDER_COMPARE_FORMAT);
+   targets[1] = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 32, RENDER_COMPARE_FORMAT);
+   SDLTest_AssertCheck(pattern && targets[0] && targets[1], "Verify test surfaces were created");
+   if (!pattern || !targets[0] || !targets[1]) {
+      return TEST_ABORTED;
+   }
+   for (y = 0; y < pattern->h; y++) {
+      for (x = 0; x < pattern->w; x++) {
+         ((Uint32 *)pattern->pixels)[y * (pattern->pitch / 4) + x] = ((x * 6) << 24) | ((x * 6) << 16) | ((y * 8) << 8) | ((x ^ y) * 8);
+      }
+   }
+
+   SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+   for (i = 0; i < SDL_arraysize(threads); i++) {
+      SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, threads[i]);
+      swrenderer = SDL_CreateSoftwareRenderer(targets[i]);
+      SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+      if (swrenderer == NULL) {
+         break;
+      }
+      texture = SDL_CreateTextureFromSurface(swrenderer, pattern);
+      SDLTest_AssertCheck(texture != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+      if (texture != NULL) {
+         SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+         _drawThreadsTestScene(swrenderer, texture);
+         SDL_DestroyTexture(texture);
+      }
+      SDL_DestroyRenderer(swrenderer);
+   }
+   SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, "0");
+
+   ret = SDLTest_CompareSurfaces(targets[1], targets[0], 0);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+
+   SDL_FreeSurface(pattern);
+   SDL_FreeSurface(targets[0]);
+   SDL_FreeSurface(targets[1]);
+
+   return TEST_COMPLETED;
+}
+
+#define COPY_BATCH_COUNT 200
+
+/**
+ * @brief Draws the test items of render_testCopyBatch, in one batch or one by one.
+ */
+static void
+_drawCopyBatchTestScene(SDL_Renderer *swrenderer, SDL_Texture *texture, SDL_bool batch)
+{
+   SDL_Rect srcrects[COPY_BATCH_COUNT], dstrects[COPY_BATCH_COUNT];
+   SDL_Color colors[COPY_BATCH_COUNT];
+   int i;
+
+   for (i = 0; i < COPY_BATCH_COUNT; i++) {
+      /* Some items are partly or completely outside the texture or the target */
+      srcrects[i].x = (i * 7) % 48 - 4;
+      srcrects[i].y = (i * 5) % 34 - 4;
+      srcrects[i].w = 4 + (i % 13);
+      srcrects[i].h = 4 + (i % 11);
+      dstrects[i].x = (i * 37) % 360 - 20;
+      dstrects[i].y = (i * 23) % 280 - 20;
+      /* Every third item is scaled */
+      dstrects[i].w = (i % 3) ? srcrects[i].w : srcrects[i].w * 2 + 1;
+      dstrects[i].h = (i % 3) ? srcrects[i].h : srcrects[i].h * 3 / 2;
+      /* Runs of items share a color */
+      colors[i].r = 255 - (i / 4) * 5;
+      colors[i].g = 128 + (i / 4) * 2;
+      colors[i].b = 255;
+      colors[i].a = 255 - (i / 8) * 9;
+   }
+
+   SDL_SetRenderDrawColor(swrenderer, 20, 40, 60, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+
+   if (batch) {
+      SDL_RenderCopyBatch(swrenderer, texture, srcrects, dstrects, colors, COPY_BATCH_COUNT);
+      SDL_RenderCopyBatch(swrenderer, texture, NULL, dstrects, NULL, COPY_BATCH_COUNT / 4);
+   } else {
+      for (i = 0; i < COPY_BATCH_COUNT; i++) {
+         SDL_SetTextureColorMod(texture, colors[i].r, colors[i].g, colors[i].b);
+         SDL_SetTextureAlphaMod(texture, colors[i].a);
+         SDL_RenderCopy(swrenderer, texture, &srcrects[i], &dstrects[i]);
+      }
+      SDL_SetTextureColorMod(texture, 255, 255, 255);
+      SDL_SetTextureAlphaMod(texture, 255);
+      for (i = 0; i < COPY_BATCH_COUNT / 4; i++) {
+         SDL_RenderCopy(swrenderer, texture, NULL, &dstrects[i]);
+      }
+   }
+
+   SDL_RenderPresent(swrenderer);
+}
+
+/**
+ * @brief Tests drawing a batch of copies against drawing the copies one by one.
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_RenderCopyBatch
+ */
+int
+render_testCopyBatch(void *arg)
+{
+   const char *threads[] = { "1", "1", "4" };
+   SDL_Surface *targets[3], *pattern;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture;
+   int ret, i, x, y;
+
+   pattern = SDL_CreateRGBSurfaceWithFormat(0, 40, 30, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(pattern != NULL, "Verify pattern surface was created");
+   if (!pattern) {
+      return TEST_ABORTED;
+   }
+   for (y = 0; y < pattern->h; y++) {
+      for (x = 0; x < pattern->w; x++) {
+         ((Uint32 *)pattern->pixels)[y * (pattern->pitch / 4) + x] = ((x * 6) << 24) | ((x * 6) << 16) | ((y * 8) << 8) | ((x ^ y) * 8);
+      }
+   }
+
+   /* The first target is drawn with single copies, the others with batches */
+   SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+   for (i = 0; i < SDL_arraysize(targets); i++) {
+      targets[i] = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 32, RENDER_COMPARE_FORMAT);
+      SDLTest_AssertCheck(targets[i] != NULL, "Verify target surface was created");
+      if (targets[i] == NULL) {
+         continue;
+      }
+      SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, threads[i]);
+      swrenderer = SDL_CreateSoftwareRenderer(targets[i]);
+      SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+      if (swrenderer == NULL) {
+         continue;
+      }
+      texture = SDL_CreateTextureFromSurface(swrenderer, pattern);
+      SDLTest_AssertCheck(texture != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+      if (texture != NULL) {
+         SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+         _drawCopyBatchTestScene(swrenderer, texture, (i > 0) ? SDL_TRUE : SDL_FALSE);
+         SDL_DestroyTexture(texture);
+      }
+      SDL_DestroyRenderer(swrenderer);
+   }
+   SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, "0");
+
+   for (i = 1; i < SDL_arraysize(targets); i++) {
+      if (targets[0] && targets[i]) {
+         ret = SDLTest_CompareSurfaces(targets[i], targets[0], 0);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces with %s thread(s), expected: 0, got: %i", threads[i], ret);
+      }
+   }
+
+   SDL_FreeSurface(pattern);
+   for (i = 0; i < SDL_arraysize(targets); i++) {
+      SDL_FreeSurface(targets[i]);
+   }
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Draws the test scene of render_testMergedCommands, with runs of draws that can be merged.
+ */
+static void
+_drawMergeTestScene(SDL_Renderer *swrenderer, SDL_Texture *texture)
+{
+   SDL_Rect rect, clip;
+   int i;
+
+   SDL_SetRenderDrawColor(swrenderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+
+   /* Same colored rects, interrupted by a color change and a clip rect */
+   SDL_SetRenderDrawBlendMode(swrenderer, SDL_BLENDMODE_BLEND);
+   for (i = 0; i < 60; i++) {
+      if (i == 20) {
+         SDL_SetRenderDrawColor(swrenderer, 200, 40, 90, 160);
+      } else if (i == 40) {
+         clip.x = 50;
+         clip.y = 30;
+         clip.w = 200;
+         clip.h = 150;
+         SDL_RenderSetClipRect(swrenderer, &clip);
+      } else if (i == 0) {
+         SDL_SetRenderDrawColor(swrenderer, 30, 200, 90, 128);
+      }
+      rect.x = (i * 29) % 300;
+      rect.y = (i * 17) % 220;
+      rect.w = 10 + (i % 7) * 5;
+      rect.h = 8 + (i % 5) * 6;
+      SDL_RenderFillRect(swrenderer, &rect);
+   }
+   SDL_RenderSetClipRect(swrenderer, NULL);
+
+   /* Points, with lines in between that must not be joined */
+   SDL_SetRenderDrawColor(swrenderer, 255, 255, 0, SDL_ALPHA_OPAQUE);
+   for (i = 0; i < 100; i++) {
+      SDL_RenderDrawPoint(swrenderer, (i * 13) % 320, (i * 7) % 240);
+      if ((i % 25) == 0) {
+         SDL_RenderDrawLine(swrenderer, i, 0, 319 - i, 239);
+         SDL_RenderDrawLine(swrenderer, 0, i, 319, 239 - i);
+      }
+   }
+
+   /* Copies, with a change of texture modulation */
+   for (i = 0; i < 40; i++) {
+      if (i == 25) {
+         SDL_SetTextureAlphaMod(texture, 100);
+      }
+      rect.x = (i * 41) % 300 - 10;
+      rect.y = (i * 31) % 220 - 10;
+      rect.w = 40;
+      rect.h = 30;
+      SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   }
+   SDL_SetTextureAlphaMod(texture, 255);
+
+   SDL_RenderPresent(swrenderer);
+}
+
+/**
+ * @brief Tests that merging draw commands in the batching queue doesn't change what is drawn.
+ */
+int
+render_testMergedCommands(void *arg)
+{
+   const char *batching[] = { "0", "1", "1" };
+   const char *threads[] = { "1", "1", "4" };
+   SDL_Surface *targets[3], *pattern;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture;
+   int ret, i, x, y;
+
+   pattern = SDL_CreateRGBSurfaceWithFormat(0, 40, 30, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(pattern != NULL, "Verify pattern surface was created");
+   if (!pattern) {
+      return TEST_ABORTED;
+   }
+   for (y = 0; y < pattern->h; y++) {
+      for (x = 0; x < pattern->w; x++) {
+         ((Uint32 *)pattern->pixels)[y * (pattern->pitch / 4) + x] = ((x * 6) << 24) | ((y * 8) << 16) | ((x * 6) << 8) | ((x ^ y) * 8);
+      }
+   }
+
+   /* The first target is drawn without batching, so nothing is merged */
+   for (i = 0; i < SDL_arraysize(targets); i++) {
+      targets[i] = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 32, RENDER_COMPARE_FORMAT);
+      SDLTest_AssertCheck(targets[i] != NULL, "Verify target surface was created");
+      if (targets[i] == NULL) {
+         continue;
+      }
+      SDL_SetHint(SDL_HINT_RENDER_BATCHING, batching[i]);
+      SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, threads[i]);
+      swrenderer = SDL_CreateSoftwareRenderer(targets[i]);
+      SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+      if (swrenderer == NULL) {
+         continue;
+      }
+      texture = SDL_CreateTextureFromSurface(swrenderer, pattern);
+      SDLTest_AssertCheck(texture != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+      if (texture != NULL) {
+         SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+         _drawMergeTestScene(swrenderer, texture);
+         SDL_DestroyTexture(texture);
+      }
+      SDL_DestroyRenderer(swrenderer);
+   }
+   SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, "0");
+   SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+
+   for (i = 1; i < SDL_arraysize(targets); i++) {
+      if (targets[0] && targets[i]) {
+         ret = SDLTest_CompareSurfaces(targets[i], targets[0], 0);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces with %s thread(s), expected: 0, got: %i", threads[i], ret);
+      }
+   }
+
+   SDL_FreeSurface(pattern);
+   for (i = 0; i < SDL_arraysize(targets); i++) {
+      SDL_FreeSurface(targets[i]);
+   }
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Draws the rotated and flipped copies of render_testRotatedCopies.
+ */
+static void
+_drawRotatedCopies(SDL_Renderer *swrenderer, SDL_Texture *texture)
+{
+   const double angles[] = { 0.0, 90.0, 180.0, 270.0, -90.0, 450.0 };
+   SDL_Rect srcrect, rect;
+   SDL_Point center;
+   int i;
+
+   SDL_SetRenderDrawColor(swrenderer, 40, 80, 120, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+
+   srcrect.x = 3;
+   srcrect.y = 2;
+   srcrect.w = 30;
+   srcrect.h = 20;
+   center.x = 5;
+   center.y = 7;
+   for (i = 0; i < SDL_arraysize(angles) * 4; i++) {
+      rect.x = (i % 6) * 55 - 10;
+      rect.y = (i / 6) * 60 - 5;
+      rect.w = srcrect.w;
+      rect.h = srcrect.h;
+      SDL_RenderCopyEx(swrenderer, texture, &srcrect, &rect, angles[i % SDL_arraysize(angles)],
+                       (i & 1) ? &center : NULL, (SDL_RendererFlip)(i / 6));
+   }
+
+   SDL_RenderPresent(swrenderer);
+}
+
+/**
+ * @brief Tests the flipped copies and rotations by multiples of 90 degrees of the
+ * software renderer, and the cache of its rotated copies.
+ */
+int
+render_testRotatedCopies(void *arg)
+{
+   const Uint32 formats[] = { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888 };
+   SDL_Surface *targets[2], *pattern;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture;
+   SDL_Rect rect;
+   int ret, i, x, y;
+
+   pattern = SDL_CreateRGBSurfaceWithFormat(0, 40, 30, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(pattern != NULL, "Verify pattern surface was created");
+   if (!pattern) {
+      return TEST_ABORTED;
+   }
+   for (y = 0; y < pattern->h; y++) {
+      for (x = 0; x < pattern->w; x++) {
+         ((Uint32 *)pattern->pixels)[y * (pattern->pitch / 4) + x] = ((x * 6) << 24) | ((y * 8) << 16) | ((x * 6) << 8) | ((x ^ y) * 8);
+      }
+   }
+
+   /* Copies from a texture in the target format are done directly, the others are rotated first */
+   for (i = 0; i < SDL_arraysize(targets); i++) {
+      targets[i] = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 32, RENDER_COMPARE_FORMAT);
+      SDLTest_AssertCheck(targets[i] != NULL, "Verify target surface was created");
+      if (targets[i] == NULL) {
+         continue;
+      }
+      swrenderer = SDL_CreateSoftwareRenderer(targets[i]);
+      SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+      if (swrenderer == NULL) {
+         continue;
+      }
+      texture = SDL_CreateTexture(swrenderer, formats[i], SDL_TEXTUREACCESS_STATIC, pattern->w, pattern->h);
+      SDLTest_AssertCheck(texture != NULL, "Verify result from SDL_CreateTexture is not NULL");
+      if (texture != NULL) {
+         SDL_Surface *converted = SDL_ConvertSurfaceFormat(pattern, formats[i], 0);
+         SDL_UpdateTexture(texture, NULL, converted->pixels, converted->pitch);
+         SDL_FreeSurface(converted);
+         SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+         _drawRotatedCopies(swrenderer, texture);
+         SDL_DestroyTexture(texture);
+      }
+      SDL_DestroyRenderer(swrenderer);
+   }
+   if (targets[0] && targets[1]) {
+      ret = SDLTest_CompareSurfaces(targets[0], targets[1], 0);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces of the direct copies, expected: 0, got: %i", ret);
+   }
+
+   /* A cached rotation must not outlive an update of the texture */
+   for (i = 0; i < SDL_arraysize(targets); i++) {
+      if (targets[i] == NULL) {
+         continue;
+      }
+      swrenderer = SDL_CreateSoftwareRenderer(targets[i]);
+      SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+      if (swrenderer == NULL) {
+         continue;
+      }
+      texture = SDL_CreateTexture(swrenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, pattern->w, pattern->h);
+      SDLTest_AssertCheck(texture != NULL, "Verify result from SDL_CreateTexture is not NULL");
+      if (texture != NULL) {
+         SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+         SDL_SetRenderDrawColor(swrenderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+         SDL_RenderClear(swrenderer);
+         rect.x = 100;
+         rect.y = 80;
+         rect.w = 60;
+         rect.h = 45;
+         if (i == 0) {
+            /* Draw the first pattern rotated twice, which caches it */
+            SDL_UpdateTexture(texture, NULL, pattern->pixels, pattern->pitch);
+            SDL_RenderCopyEx(swrenderer, texture, NULL, &rect, 30.0, NULL, SDL_FLIP_NONE);
+            SDL_RenderPresent(swrenderer);
+            SDL_RenderCopyEx(swrenderer, texture, NULL, &rect, 30.0, NULL, SDL_FLIP_NONE);
+            SDL_RenderPresent(swrenderer);
+            SDL_RenderClear(swrenderer);
+            for (y = 0; y < pattern->h; y++) {
+               for (x = 0; x < pattern->w; x++) {
+                  ((Uint32 *)pattern->pixels)[y * (pattern->pitch / 4) + x] ^= 0x00FFFFFF;
+               }
+            }
+         }
+         /* Both targets get the second pattern, the first one from a texture that was cached before */
+         SDL_UpdateTexture(texture, NULL, pattern->pixels, pattern->pitch);
+         SDL_RenderCopyEx(swrenderer, texture, NULL, &rect, 30.0, NULL, SDL_FLIP_NONE);
+         SDL_RenderPresent(swrenderer);
+         SDL_DestroyTexture(texture);
+      }
+      SDL_DestroyRenderer(swrenderer);
+   }
+   if (targets[0] && targets[1]) {
+      ret = SDLTest_CompareSurfaces(targets[0], targets[1], 0);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces after the texture update, expected: 0, got: %i", ret);
+   }
+
+   SDL_FreeSurface(pattern);
+   for (i = 0; i < SDL_arraysize(targets); i++) {
+      SDL_FreeSurface(targets[i]);
+   }
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests wide lines and convex polygons with the software renderer.
+ */
+int
+render_testWideLines(void *arg)
+{
+   const SDL_FPoint line[] = { { 10.0f, 20.0f }, { 50.0f, 20.0f } };
+   const SDL_FPoint square[] = { { 60.0f, 30.0f }, { 60.0f, 70.0f }, { 100.0f, 70.0f }, { 100.0f, 30.0f } };
+   const SDL_FPoint corner[] = { { 120.0f, 20.0f }, { 200.0f, 60.0f }, { 130.0f, 90.0f } };
+   const SDL_FPoint triangle[] = { { 220.0f, 120.0f }, { 300.0f, 150.0f }, { 240.0f, 220.0f } };
+   SDL_Surface *targets[2];
+   SDL_Renderer *swrenderers[2];
+   SDL_Rect rect;
+   Uint32 pixel;
+   Uint8 r, g, b;
+   int ret, i, x, y, partial = 0, overdrawn = 0;
+
+   for (i = 0; i < SDL_arraysize(targets); i++) {
+      targets[i] = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 32, RENDER_COMPARE_FORMAT);
+      SDLTest_AssertCheck(targets[i] != NULL, "Verify target surface was created");
+      swrenderers[i] = targets[i] ? SDL_CreateSoftwareRenderer(targets[i]) : NULL;
+      SDLTest_AssertCheck(swrenderers[i] != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+      if (swrenderers[i] == NULL) {
+         SDL_FreeSurface(targets[0]);
+         SDL_FreeSurface(targets[1]);
+         return TEST_ABORTED;
+      }
+      SDL_SetRenderDrawColor(swrenderers[i], 0, 0, 0, SDL_ALPHA_OPAQUE);
+      SDL_RenderClear(swrenderers[i]);
+      SDL_SetRenderDrawColor(swrenderers[i], 255, 255, 255, SDL_ALPHA_OPAQUE);
+   }
+
+   /* A horizontal line and a square are rectangles, with and without antialiasing */
+   ret = SDL_RenderDrawWideLinesF(swrenderers[0], line, SDL_arraysize(line), 5.0f, SDL_FALSE);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderDrawWideLinesF, expected: 0, got: %i", ret);
+   SDL_SetRenderDrawBlendMode(swrenderers[0], SDL_BLENDMODE_BLEND);
+   ret = SDL_RenderFillConvexPolygonF(swrenderers[0], square, SDL_arraysize(square), SDL_TRUE);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderFillConvexPolygonF, expected: 0, got: %i", ret);
+   SDL_RenderPresent(swrenderers[0]);
+
+   rect.x = 8; rect.y = 18; rect.w = 45; rect.h = 5;
+   SDL_RenderFillRect(swrenderers[1], &rect);
+   rect.x = 60; rect.y = 30; rect.w = 40; rect.h = 40;
+   SDL_RenderFillRect(swrenderers[1], &rect);
+   SDL_RenderPresent(swrenderers[1]);
+
+   ret = SDLTest_CompareSurfaces(targets[0], targets[1], 0);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+
+   /* Translucent lines are blended once where they join, and get smooth edges */
+   SDL_SetRenderDrawColor(swrenderers[0], 255, 255, 255, 128);
+   ret = SDL_RenderDrawWideLinesF(swrenderers[0], corner, SDL_arraysize(corner), 9.5f, SDL_TRUE);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderDrawWideLinesF, expected: 0, got: %i", ret);
+   ret = SDL_RenderFillConvexPolygonF(swrenderers[0], triangle, SDL_arraysize(triangle), SDL_TRUE);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderFillConvexPolygonF, expected: 0, got: %i", ret);
+   SDL_RenderPresent(swrenderers[0]);
+
+   for (y = 0; y < targets[0]->h; y++) {
+      for (x = 110; x < targets[0]->w; x++) {
+         pixel = ((Uint32 *)targets[0]->pixels)[y * (targets[0]->pitch / 4) + x];
+         SDL_GetRGB(pixel, targets[0]->format, &r, &g, &b);
+         if (r > 128) {
+            overdrawn++;
+         } else if (r > 0 && r < 127) {
+            partial++;
+         }
+      }
+   }
+   SDLTest_AssertCheck(overdrawn == 0, "Validate that no pixels were blended twice, expected: 0, got: %i", overdrawn);
+   SDLTest_AssertCheck(partial > 0, "Validate that edges were antialiased, got: %i pixels", partial);
+
+   for (i = 0; i < SDL_arraysize(targets); i++) {
+      SDL_DestroyRenderer(swrenderers[i]);
+      SDL_FreeSurface(targets[i]);
+   }
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests triangle geometry with the software renderer.
+ */
+int
+render_testGeometry(void *arg)
+{
+   const int indices[] = { 0, 1, 2, 0, 2, 3 };
+   const char *threads[] = { "4", "0" };
+   SDL_Vertex quad[4], textured[4], gradient[4];
+   SDL_Surface *targets[2], *pattern;
+   SDL_Renderer *swrenderers[2];
+   SDL_Texture *texture;
+   SDL_Rect rect;
+   Uint32 pixel;
+   Uint8 r, g, b;
+   int ret, i, x, wrong = 0;
+
+   SDL_zero(quad);
+   SDL_zero(textured);
+   SDL_zero(gradient);
+   for (i = 0; i < 4; i++) {
+      const int right = (i == 1 || i == 2);
+      const int bottom = (i >= 2);
+      quad[i].position.x = right ? 110.0f : 10.0f;
+      quad[i].position.y = bottom ? 70.0f : 10.0f;
+      quad[i].color.r = 255;
+      quad[i].color.a = 128;
+      textured[i].position.x = right ? 182.0f : 150.0f;
+      textured[i].position.y = bottom ? 52.0f : 20.0f;
+      textured[i].color.r = textured[i].color.g = textured[i].color.b = textured[i].color.a = 255;
+      textured[i].tex_coord.x = right ? 1.0f : 0.0f;
+      textured[i].tex_coord.y = bottom ? 1.0f : 0.0f;
+      gradient[i].position.x = right ? 256.0f : 0.0f;
+      gradient[i].position.y = bottom ? 140.0f : 100.0f;
+      gradient[i].color.r = gradient[i].color.g = gradient[i].color.b = right ? 255 : 0;
+      gradient[i].color.a = 255;
+   }
+
+   pattern = SDL_CreateRGBSurfaceWithFormat(0, 32, 32, 32, RENDER_COMPARE_FORMAT);
+   SDLTest_AssertCheck(pattern != NULL, "Verify pattern surface was created");
+   if (pattern == NULL) {
+      return TEST_ABORTED;
+   }
+   for (i = 0; i < 32 * 32; i++) {
+      ((Uint32 *)pattern->pixels)[i] = 0xFF000000 | (i * 2654435761u >> 8);
+   }
+
+   for (i = 0; i < SDL_arraysize(targets); i++) {
+      targets[i] = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 32, RENDER_COMPARE_FORMAT);
+      SDLTest_AssertCheck(targets[i] != NULL, "Verify target surface was created");
+      swrenderers[i] = targets[i] ? SDL_CreateSoftwareRenderer(targets[i]) : NULL;
+      SDLTest_AssertCheck(swrenderers[i] != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+      if (swrenderers[i] == NULL) {
+         SDL_FreeSurface(targets[0]);
+         SDL_FreeSurface(targets[1]);
+         SDL_FreeSurface(pattern);
+         return TEST_ABORTED;
+      }
+      SDL_SetRenderDrawColor(swrenderers[i], 64, 64, 64, SDL_ALPHA_OPAQUE);
+      SDL_RenderClear(swrenderers[i]);
+      SDL_SetRenderDrawColor(swrenderers[i], 255, 0, 0, 128);
+      SDL_SetRenderDrawBlendMode(swrenderers[i], SDL_BLENDMODE_BLEND);
+   }
+
+   /* A translucent quad made of two triangles doesn't blend its diagonal twice,
+      and a textured quad covering whole pixels is a copy, also in tiles */
+   SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, threads[0]);
+   ret = SDL_RenderGeometry(swrenderers[0], NULL, quad, SDL_arraysize(quad), indices, SDL_arraysize(indices));
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGeometry, expected: 0, got: %i", ret);
+   texture = SDL_CreateTextureFromSurface(swrenderers[0], pattern);
+   SDLTest_AssertCheck(texture != NULL, "Verify texture was created");
+   SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+   ret = SDL_RenderGeometry(swrenderers[0], texture, textured, SDL_arraysize(textured), indices, SDL_arraysize(indices));
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGeometry, expected: 0, got: %i", ret);
+   SDL_RenderPresent(swrenderers[0]);
+   SDL_DestroyTexture(texture);
+
+   SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, threads[1]);
+   rect.x = 10; rect.y = 10; rect.w = 100; rect.h = 60;
+   SDL_RenderFillRect(swrenderers[1], &rect);
+   texture = SDL_CreateTextureFromSurface(swrenderers[1], pattern);
+   SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+   rect.x = 150; rect.y = 20; rect.w = 32; rect.h = 32;
+   SDL_RenderCopy(swrenderers[1], texture, NULL, &rect);
+   SDL_RenderPresent(swrenderers[1]);
+   SDL_DestroyTexture(texture);
+
+   /* The blend of the fill and the blitters may round differently */
+   ret = SDLTest_CompareSurfaces(targets[0], targets[1], 2);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+
+   /* Vertex colors are interpolated across the triangles */
+   SDL_SetRenderDrawBlendMode(swrenderers[0], SDL_BLENDMODE_NONE);
+   ret = SDL_RenderGeometry(swrenderers[0], NULL, gradient, SDL_arraysize(gradient), indices, SDL_arraysize(indices));
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGeometry, expected: 0, got: %i", ret);
+   SDL_RenderPresent(swrenderers[0]);
+
+   for (x = 0; x < 256; x++) {
+      pixel = ((Uint32 *)targets[0]->pixels)[120 * (targets[0]->pitch / 4) + x];
+      SDL_GetRGB(pixel, targets[0]->format, &r, &g, &b);
+      if (r != g || r != b || SDL_abs(r - x) > 1) {
+         wrong++;
+      }
+   }
+   SDLTest_AssertCheck(wrong == 0, "Validate the gradient, expected: 0 wrong pixels, got: %i", wrong);
+
+   /* Textures of other formats are converted once, and again after an update */
+   texture = SDL_CreateTexture(swrenderers[0], SDL_PIXELFORMAT_RGB888, SDL_TEXTUREACCESS_STATIC, 32, 32);
+   SDLTest_AssertCheck(texture != NULL, "Verify texture was created");
+   if (texture != NULL) {
+      for (i = 0; i < 2; i++) {
+         const Uint32 color = i ? 0x00FFFFFF : 0x00FF0000;
+         for (x = 0; x < 32 * 32; x++) {
+            ((Uint32 *)pattern->pixels)[x] = color;
+         }
+         SDL_UpdateTexture(texture, NULL, pattern->pixels, pattern->pitch);
+         ret = SDL_RenderGeometry(swrenderers[0], texture, textured, SDL_arraysize(textured), indices, SDL_arraysize(indices));
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGeometry, expected: 0, got: %i", ret);
+         SDL_RenderPresent(swrenderers[0]);
+         pixel = ((Uint32 *)targets[0]->pixels)[36 * (targets[0]->pitch / 4) + 166];
+         SDL_GetRGB(pixel, targets[0]->format, &r, &g, &b);
+         SDLTest_AssertCheck(r == 255 && g == (i ? 255 : 0) && b == (i ? 255 : 0),
+                             "Validate the converted texture, expected: 255,%i,%i, got: %i,%i,%i",
+                             i ? 255 : 0, i ? 255 : 0, r, g, b);
+      }
+      SDL_DestroyTexture(texture);
+   }
+
+   /* Indices have to be in range, and make whole triangles */
+   ret = SDL_RenderGeometry(swrenderers[0], NULL, quad, 3, indices, SDL_arraysize(indices));
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_RenderGeometry with an index out of bounds, expected: -1, got: %i", ret);
+   ret = SDL_RenderGeometry(swrenderers[0], NULL, quad, SDL_arraysize(quad), NULL, 0);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_RenderGeometry with 4 vertices, expected: -1, got: %i", ret);
+
+   for (i = 0; i < SDL_arraysize(targets); i++) {
+      SDL_DestroyRenderer(swrenderers[i]);
+      SDL_FreeSurface(targets[i]);
+   }
+   SDL_FreeSurface(pattern);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests the frame statistics of the software renderer.
+ */
+int
+render_testStats(void *arg)
+{
+   SDL_Surface *target;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture;
+   SDL_RenderStats stats;
+   SDL_Rect rect;
+   Uint32 pixels[16 * 16];
+   int ret;
+
+   SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+   target = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 32, RENDER_COMPARE_FORMAT);
+   SDLTest_AssertCheck(target != NULL, "Verify target surface was created");
+   swrenderer = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(target);
+      return TEST_ABORTED;
+   }
+   texture = SDL_CreateTexture(swrenderer, RENDER_COMPARE_FORMAT, SDL_TEXTUREACCESS_STATIC, 16, 16);
+   SDLTest_AssertCheck(texture != NULL, "Verify texture was created");
+   SDL_memset(pixels, 0xFF, sizeof(pixels));
+
+   ret = SDL_RenderGetStats(swrenderer, &stats);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGetStats, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(stats.flushes == 0, "Validate that no frame was presented, got: %u flushes", stats.flushes);
+
+   /* Start a new frame: a clear, two clipped fills that are merged, and two
+      copies with a texture update in between, which flushes the queue */
+   SDL_RenderPresent(swrenderer);
+   SDL_RenderClear(swrenderer);
+   rect.x = 300; rect.y = 0; rect.w = 40; rect.h = 10;
+   SDL_RenderFillRect(swrenderer, &rect);
+   SDL_RenderFillRect(swrenderer, &rect);
+   rect.x = 0; rect.y = 0; rect.w = 16; rect.h = 16;
+   SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   SDL_UpdateTexture(texture, NULL, pixels, 16 * sizeof(Uint32));
+   SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   SDL_RenderPresent(swrenderer);
+
+   ret = SDL_RenderGetStats(swrenderer, &stats);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGetStats, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(stats.flushes == 2, "Validate flushes, expected: 2, got: %u", stats.flushes);
+   SDLTest_AssertCheck(stats.flush_reasons[SDL_RENDERFLUSH_TEXTURE] == 1 && stats.flush_reasons[SDL_RENDERFLUSH_PRESENT] == 1,
+                       "Validate flush reasons, expected: 1 texture and 1 present, got: %u and %u",
+                       stats.flush_reasons[SDL_RENDERFLUSH_TEXTURE], stats.flush_reasons[SDL_RENDERFLUSH_PRESENT]);
+   SDLTest_AssertCheck(stats.commands_merged == 1, "Validate merged commands, expected: 1, got: %u", stats.commands_merged);
+   SDLTest_AssertCheck(stats.commands_issued == stats.commands_queued - stats.commands_merged,
+                       "Validate issued commands, expected: %u, got: %u",
+                       stats.commands_queued - stats.commands_merged, stats.commands_issued);
+   SDLTest_AssertCheck(stats.vertex_bytes > 0, "Validate that vertex data was used");
+   SDLTest_AssertCheck(stats.texture_updates == 1, "Validate texture updates, expected: 1, got: %u", stats.texture_updates);
+   SDLTest_AssertCheck(stats.pixels_filled == 320 * 240 + 2 * 20 * 10,
+                       "Validate filled pixels, expected: %i, got: %u", 320 * 240 + 2 * 20 * 10, (unsigned int) stats.pixels_filled);
+   SDLTest_AssertCheck(stats.pixels_copied == 2 * 16 * 16,
+                       "Validate copied pixels, expected: %i, got: %u", 2 * 16 * 16, (unsigned int) stats.pixels_copied);
+
+   /* The next frame starts from zero */
+   SDL_RenderPresent(swrenderer);
+   ret = SDL_RenderGetStats(swrenderer, &stats);
+   SDLTest_AssertCheck(ret == 0 && stats.flushes == 0 && stats.commands_queued == 0,
+                       "Validate the stats of an empty frame, got: %u flushes and %u commands", stats.flushes, stats.commands_queued);
+
+   SDL_DestroyTexture(texture);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(target);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Records a render capture with the software renderer and plays it back.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderOpenReplay
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderReplayFrame
+ */
+int
+render_testCapture(void *arg)
+{
+   const char *file = "render_capture_test";
+   SDL_Surface *target;
+   SDL_Surface *frames[2];
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture, *rendertarget;
+   SDL_RenderReplay *replay;
+   SDL_Vertex vertices[3];
+   SDL_FPoint points[3];
+   SDL_Rect rect;
+   Uint32 *pixels;
+   int pitch, ret, i, w, h;
+
+   SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+   SDL_SetHint(SDL_HINT_RENDER_CAPTURE_FILE, file);
+   SDL_SetHint(SDL_HINT_RENDER_CAPTURE_FRAMES, "2");
+   target = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 32, RENDER_COMPARE_FORMAT);
+   SDLTest_AssertCheck(target != NULL, "Verify target surface was created");
+   swrenderer = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+   SDL_SetHint(SDL_HINT_RENDER_CAPTURE_FILE, "");
+   SDL_SetHint(SDL_HINT_RENDER_CAPTURE_FRAMES, "");
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(target);
+      return TEST_ABORTED;
+   }
+
+   /* A streaming texture with a gradient, and a target texture */
+   texture = SDL_CreateTexture(swrenderer, RENDER_COMPARE_FORMAT, SDL_TEXTUREACCESS_STREAMING, 16, 16);
+   rendertarget = SDL_CreateTexture(swrenderer, RENDER_COMPARE_FORMAT, SDL_TEXTUREACCESS_TARGET, 64, 64);
+   SDLTest_AssertCheck(texture != NULL && rendertarget != NULL, "Verify textures were created");
+   ret = SDL_LockTexture(texture, NULL, (void **) &pixels, &pitch);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_LockTexture, expected: 0, got: %i", ret);
+   if (ret == 0) {
+      for (i = 0; i < 16 * 16; ++i) {
+         pixels[(i / 16) * (pitch / 4) + (i % 16)] = 0xFF000000 | ((i % 16) * 0x100010) | ((i / 16) * 0x1000);
+      }
+      SDL_UnlockTexture(texture);
+   }
+   SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+   /* Frame 1: solid draws, copies, geometry, clipping and a scale */
+   SDL_SetRenderDrawColor(swrenderer, 10, 20, 30, 255);
+   SDL_RenderClear(swrenderer);
+   SDL_SetRenderDrawBlendMode(swrenderer, SDL_BLENDMODE_BLEND);
+   SDL_SetRenderDrawColor(swrenderer, 200, 100, 50, 128);
+   rect.x = 20; rect.y = 20; rect.w = 100; rect.h = 60;
+   SDL_RenderFillRect(swrenderer, &rect);
+   SDL_SetRenderDrawColor(swrenderer, 0, 255, 0, 255);
+   SDL_RenderDrawLine(swrenderer, 0, 0, 319, 239);
+   points[0].x = 5.0f; points[0].y = 200.0f;
+   points[1].x = 6.0f; points[1].y = 201.0f;
+   points[2].x = 300.0f; points[2].y = 10.0f;
+   SDL_RenderDrawPointsF(swrenderer, points, 3);
+   SDL_SetTextureColorMod(texture, 255, 128, 255);
+   rect.x = 150; rect.y = 30; rect.w = 48; rect.h = 32;
+   SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   SDL_SetTextureColorMod(texture, 255, 255, 255);
+   rect.x = 220; rect.y = 100; rect.w = 40; rect.h = 40;
+   SDL_RenderCopyEx(swrenderer, texture, NULL, &rect, 30.0, NULL, SDL_FLIP_HORIZONTAL);
+   for (i = 0; i < 3; ++i) {
+      vertices[i].color.r = (Uint8) (i == 0 ? 255 : 0);
+      vertices[i].color.g = (Uint8) (i == 1 ? 255 : 0);
+      vertices[i].color.b = (Uint8) (i == 2 ? 255 : 0);
+      vertices[i].color.a = 255;
+      vertices[i].tex_coord.x = 0.0f;
+      vertices[i].tex_coord.y = 0.0f;
+   }
+   vertices[0].position.x = 40.0f; vertices[0].position.y = 120.0f;
+   vertices[1].position.x = 140.0f; vertices[1].position.y = 130.0f;
+   vertices[2].position.x = 70.0f; vertices[2].position.y = 220.0f;
+   SDL_RenderGeometry(swrenderer, NULL, vertices, 3, NULL, 0);
+   rect.x = 150; rect.y = 150; rect.w = 50; rect.h = 50;
+   SDL_RenderSetClipRect(swrenderer, &rect);
+   SDL_RenderSetScale(swrenderer, 2.0f, 2.0f);
+   SDL_SetRenderDrawColor(swrenderer, 255, 255, 0, 255);
+   rect.x = 80; rect.y = 80; rect.w = 30; rect.h = 30;
+   SDL_RenderFillRect(swrenderer, &rect);
+   SDL_RenderSetScale(swrenderer, 1.0f, 1.0f);
+   SDL_RenderSetClipRect(swrenderer, NULL);
+   SDL_RenderPresent(swrenderer);
+   frames[0] = SDL_ConvertSurface(target, target->format, 0);
+
+   /* Frame 2: a render target and a texture update */
+   SDL_SetRenderTarget(swrenderer, rendertarget);
+   SDL_SetRenderDrawColor(swrenderer, 0, 0, 255, 255);
+   SDL_RenderClear(swrenderer);
+   SDL_RenderCopy(swrenderer, texture, NULL, NULL);
+   SDL_SetRenderTarget(swrenderer, NULL);
+   rect.x = 0; rect.y = 0; rect.w = 8; rect.h = 8;
+   SDL_UpdateTexture(texture, &rect, target->pixels, target->pitch);
+   rect.x = 100; rect.y = 100; rect.w = 128; rect.h = 96;
+   SDL_RenderCopy(swrenderer, rendertarget, NULL, &rect);
+   rect.x = 0; rect.y = 0; rect.w = 32; rect.h = 32;
+   SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   SDL_RenderPresent(swrenderer);
+   frames[1] = SDL_ConvertSurface(target, target->format, 0);
+
+   /* Frame 3 isn't recorded */
+   SDL_RenderClear(swrenderer);
+   SDL_RenderPresent(swrenderer);
+
+   SDL_DestroyTexture(rendertarget);
+   SDL_DestroyTexture(texture);
+   SDL_DestroyRenderer(swrenderer);
+
+   /* Play it back with a new renderer */
+   SDL_FillRect(target, NULL, 0);
+   swrenderer = SDL_CreateSoftwareRenderer(target);
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   w = h = 0;
+   replay = SDL_RenderOpenReplay(SDL_RWFromFile(file, "rb"), 1, &w, &h);
+   SDLTest_AssertCheck(replay != NULL, "Verify result from SDL_RenderOpenReplay is not NULL");
+   SDLTest_AssertCheck(w == 320 && h == 240, "Validate the captured output size, expected: 320x240, got: %ix%i", w, h);
+   if (swrenderer && replay && frames[0] && frames[1]) {
+      for (i = 0; i < 2; ++i) {
+         ret = SDL_RenderReplayFrame(replay, swrenderer);
+         SDLTest_AssertCheck(ret == 1, "Validate result from SDL_RenderReplayFrame, expected: 1, got: %i", ret);
+         SDL_RenderPresent(swrenderer);
+         ret = SDLTest_CompareSurfaces(target, frames[i], 0);
+         SDLTest_AssertCheck(ret == 0, "Validate that frame %i is played back as it was drawn, got: %i", i + 1, ret);
+      }
+      ret = SDL_RenderReplayFrame(replay, swrenderer);
+      SDLTest_AssertCheck(ret == 0, "Validate the end of the capture, expected: 0, got: %i", ret);
+   }
+   SDL_RenderCloseReplay(replay);
+   SDL_FreeSurface(frames[0]);
+   SDL_FreeSurface(frames[1]);
+
+   /* Invalid captures */
+   replay = SDL_RenderOpenReplay(SDL_RWFromConstMem("SDLRCAX\0\1\0\0\0", 12), 1, NULL, NULL);
+   SDLTest_AssertCheck(replay == NULL, "Validate that a file without the magic is rejected");
+   ret = SDL_RenderReplayFrame(NULL, swrenderer);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_RenderReplayFrame with a NULL replay, expected: -1, got: %i", ret);
+
+   if (swrenderer) {
+      SDL_DestroyRenderer(swrenderer);
+   }
+   SDL_FreeSurface(target);
+   remove(file);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests the parts of the output the software renderer presents.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderGetDamageRects
+ */
+int
+render_testDamage(void *arg)
+{
+   SDL_Surface *target;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture, *rendertarget;
+   SDL_Rect rects[8];
+   SDL_Rect rect;
+   int ret;
+
+   target = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 32, RENDER_COMPARE_FORMAT);
+   SDLTest_AssertCheck(target != NULL, "Verify target surface was created");
+   swrenderer = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(target);
+      return TEST_ABORTED;
+   }
+   texture = SDL_CreateTexture(swrenderer, RENDER_COMPARE_FORMAT, SDL_TEXTUREACCESS_STATIC, 16, 16);
+   rendertarget = SDL_CreateTexture(swrenderer, RENDER_COMPARE_FORMAT, SDL_TEXTUREACCESS_TARGET, 16, 16);
+   SDLTest_AssertCheck(texture != NULL && rendertarget != NULL, "Verify textures were created");
+
+   /* The first frame presents everything */
+   SDL_RenderPresent(swrenderer);
+   ret = SDL_RenderGetDamageRects(swrenderer, rects, SDL_arraysize(rects));
+   SDLTest_AssertCheck(ret == 1 && rects[0].x == 0 && rects[0].y == 0 && rects[0].w == 320 && rects[0].h == 240,
+                       "Validate the damage of the first frame, expected: 1 rect of 320x240, got: %i", ret);
+
+   /* Nothing drawn, nothing presented */
+   SDL_RenderPresent(swrenderer);
+   ret = SDL_RenderGetDamageRects(swrenderer, rects, SDL_arraysize(rects));
+   SDLTest_AssertCheck(ret == 0, "Validate the damage of an empty frame, expected: 0, got: %i", ret);
+
+   /* Overlapping draws are merged, separate ones aren't */
+   rect.x = 10; rect.y = 10; rect.w = 20; rect.h = 20;
+   SDL_RenderFillRect(swrenderer, &rect);
+   rect.x = 20; rect.y = 20;
+   SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   rect.x = 200; rect.y = 100; rect.w = 16; rect.h = 16;
+   SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   SDL_RenderPresent(swrenderer);
+   ret = SDL_RenderGetDamageRects(swrenderer, rects, SDL_arraysize(rects));
+   SDLTest_AssertCheck(ret == 2, "Validate the number of damage rects, expected: 2, got: %i", ret);
+   if (ret == 2) {
+      if (rects[0].x != 10) {
+         rect = rects[0]; rects[0] = rects[1]; rects[1] = rect;
+      }
+      SDLTest_AssertCheck(rects[0].x == 10 && rects[0].y == 10 && rects[0].w == 30 && rects[0].h == 30,
+                          "Validate the merged damage rect, expected: 10,10 30x30, got: %i,%i %ix%i",
+                          rects[0].x, rects[0].y, rects[0].w, rects[0].h);
+      SDLTest_AssertCheck(rects[1].x == 200 && rects[1].y == 100 && rects[1].w == 16 && rects[1].h == 16,
+                          "Validate the separate damage rect, expected: 200,100 16x16, got: %i,%i %ix%i",
+                          rects[1].x, rects[1].y, rects[1].w, rects[1].h);
+   }
+
+   /* The damage is clipped, and drawing to a texture doesn't count */
+   rect.x = 0; rect.y = 0; rect.w = 50; rect.h = 50;
+   SDL_RenderSetClipRect(swrenderer, &rect);
+   rect.x = 40; rect.y = 45; rect.w = 100; rect.h = 100;
+   SDL_RenderFillRect(swrenderer, &rect);
+   SDL_RenderSetClipRect(swrenderer, NULL);
+   SDL_SetRenderTarget(swrenderer, rendertarget);
+   SDL_RenderClear(swrenderer);
+   SDL_SetRenderTarget(swrenderer, NULL);
+   SDL_RenderPresent(swrenderer);
+   ret = SDL_RenderGetDamageRects(swrenderer, rects, SDL_arraysize(rects));
+   SDLTest_AssertCheck(ret == 1 && rects[0].x == 40 && rects[0].y == 45 && rects[0].w == 10 && rects[0].h == 5,
+                       "Validate the clipped damage rect, expected: 1 rect at 40,45 10x5, got: %i", ret);
+
+   /* More draws than rects are merged, and a clear covers everything */
+   for (ret = 0; ret < 20; ++ret) {
+      rect.x = ret * 16; rect.y = (ret % 2) * 100; rect.w = 8; rect.h = 8;
+      SDL_RenderFillRect(swrenderer, &rect);
+   }
+   SDL_RenderPresent(swrenderer);
+   ret = SDL_RenderGetDamageRects(swrenderer, NULL, 0);
+   SDLTest_AssertCheck(ret > 0 && ret <= 8, "Validate the number of damage rects, expected: 1 to 8, got: %i", ret);
+   SDL_RenderClear(swrenderer);
+   SDL_RenderPresent(swrenderer);
+   ret = SDL_RenderGetDamageRects(swrenderer, rects, 1);
+   SDLTest_AssertCheck(ret == 1 && rects[0].w == 320 && rects[0].h == 240,
+                       "Validate the damage of a clear, expected: 1 rect of 320x240, got: %i", ret);
+
+   ret = SDL_RenderGetDamageRects(swrenderer, rects, -1);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_RenderGetDamageRects with a negative count, expected: -1, got: %i", ret);
+
+   SDL_DestroyTexture(rendertarget);
+   SDL_DestroyTexture(texture);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(target);
+
+   return TEST_COMPLETED;
+}
+
+/* Fills a streaming texture with one color, through a lock or an update */
+static int
+_fillStreamingTexture(SDL_Texture *texture, Uint32 color, SDL_bool lock)
+{
+   Uint32 pixels[16 * 16];
+   void *locked;
+   int pitch, y, x;
+
+   if (lock) {
+      if (SDL_LockTexture(texture, NULL, &locked, &pitch) < 0) {
+         return -1;
+      }
+      for (y = 0; y < 16; ++y) {
+         for (x = 0; x < 16; ++x) {
+            ((Uint32 *) ((Uint8 *) locked + y * pitch))[x] = color;
+         }
+      }
+      SDL_UnlockTexture(texture);
+      return 0;
+   }
+   for (x = 0; x < SDL_arraysize(pixels); ++x) {
+      pixels[x] = color;
+   }
+   return SDL_UpdateTexture(texture, NULL, pixels, 16 * sizeof(Uint32));
+}
+
+/**
+ * @brief Tests updating streaming textures with more than one buffer while they are queued.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_LockTexture
+ * http://wiki.libsdl.org/moin.cgi/SDL_UpdateTexture
+ */
+int
+render_testStreamingBuffers(void *arg)
+{
+   static const Uint32 colors[4] = { 0xFFFF0000, 0xFF00FF00, 0xFF0000FF, 0xFFFFFFFF };
+   SDL_Surface *target;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture;
+   SDL_RenderStats stats;
+   SDL_Rect rect;
+   Uint32 pixels[16 * 16];
+   Uint32 pixel;
+   int i, ret;
+
+   SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+   SDL_SetHint(SDL_HINT_RENDER_STREAMING_BUFFERS, "2");
+   for (i = 0; i < SDL_arraysize(pixels); ++i) {
+      pixels[i] = colors[0];
+   }
+   target = SDL_CreateRGBSurfaceWithFormat(0, 80, 16, 32, RENDER_COMPARE_FORMAT);
+   SDLTest_AssertCheck(target != NULL, "Verify target surface was created");
+   swrenderer = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_SetHint(SDL_HINT_RENDER_STREAMING_BUFFERS, NULL);
+      SDL_FreeSurface(target);
+      return TEST_ABORTED;
+   }
+   texture = SDL_CreateTexture(swrenderer, RENDER_COMPARE_FORMAT, SDL_TEXTUREACCESS_STREAMING, 16, 16);
+   SDLTest_AssertCheck(texture != NULL, "Verify streaming texture was created");
+   SDL_RenderPresent(swrenderer);
+
+   /* Two buffers take two updates in a frame without a flush, the third
+      update has to wait for the queued copies */
+   rect.y = 0; rect.w = 16; rect.h = 16;
+   for (i = 0; i < 3; ++i) {
+      ret = _fillStreamingTexture(texture, colors[i], (i % 2) ? SDL_TRUE : SDL_FALSE);
+      SDLTest_AssertCheck(ret == 0, "Validate result from updating the texture, expected: 0, got: %i", ret);
+      rect.x = i * 16;
+      SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   }
+
+   /* The next buffer gets the color modulation of the texture */
+   SDL_SetTextureColorMod(texture, 0, 255, 255);
+   _fillStreamingTexture(texture, colors[3], SDL_FALSE);
+   rect.x = 48;
+   SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+
+   /* An update of part of the texture keeps the rest, so it has to flush */
+   rect.x = 0; rect.w = 8;
+   SDL_UpdateTexture(texture, &rect, pixels, 16 * sizeof(Uint32));
+   rect.x = 64; rect.w = 16;
+   SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   SDL_RenderPresent(swrenderer);
+
+   SDL_RenderGetStats(swrenderer, &stats);
+   SDLTest_AssertCheck(stats.flush_reasons[SDL_RENDERFLUSH_TEXTURE] == 2,
+                       "Validate texture flushes, expected: 2, got: %u", stats.flush_reasons[SDL_RENDERFLUSH_TEXTURE]);
+
+   /* Every copy shows the pixels it was queued with */
+   for (i = 0; i < 6; ++i) {
+      static const Uint32 expected[6] = { 0xFFFF0000, 0xFF00FF00, 0xFF0000FF, 0xFF00FFFF, 0xFF000000, 0xFF00FFFF };
+      const int x = (i < 4) ? (i * 16 + 12) : (64 + (i - 4) * 8 + 4);
+      pixel = *(Uint32 *) ((Uint8 *) target->pixels + 8 * target->pitch + x * 4);
+      SDLTest_AssertCheck(pixel == expected[i], "Validate the pixel at %i,8, expected: 0x%.8x, got: 0x%.8x",
+                          x, (unsigned int) expected[i], (unsigned int) pixel);
+   }
+   SDL_DestroyTexture(texture);
+
+   /* Converted formats cycle through the buffers of the converted texture */
+   texture = SDL_CreateTexture(swrenderer, SDL_PIXELFORMAT_IYUV, SDL_TEXTUREACCESS_STREAMING, 16, 16);
+   SDLTest_AssertCheck(texture != NULL, "Verify YUV streaming texture was created");
+   if (texture) {
+      Uint8 yuv[16 * 16 + 2 * 8 * 8];
+
+      /* Black, then white */
+      SDL_RenderPresent(swrenderer);
+      SDL_memset(yuv, 0x80, sizeof(yuv));
+      SDL_memset(yuv, 0x00, 16 * 16);
+      SDL_UpdateTexture(texture, NULL, yuv, 16);
+      rect.x = 0;
+      SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+      SDL_memset(yuv, 0xFF, 16 * 16);
+      SDL_UpdateTexture(texture, NULL, yuv, 16);
+      rect.x = 16;
+      SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+      SDL_RenderPresent(swrenderer);
+
+      SDL_RenderGetStats(swrenderer, &stats);
+      SDLTest_AssertCheck(stats.flush_reasons[SDL_RENDERFLUSH_TEXTURE] == 0,
+                          "Validate texture flushes after YUV updates, expected: 0, got: %u",
+                          stats.flush_reasons[SDL_RENDERFLUSH_TEXTURE]);
+      pixel = *(Uint32 *) ((Uint8 *) target->pixels + 8 * target->pitch + 8 * 4);
+      SDLTest_AssertCheck(((pixel >> 8) & 0xFF) < 0x80, "Validate the pixels of the first YUV copy, got: 0x%.8x", (unsigned int) pixel);
+      pixel = *(Uint32 *) ((Uint8 *) target->pixels + 8 * target->pitch + 24 * 4);
+      SDLTest_AssertCheck(((pixel >> 8) & 0xFF) >= 0x80, "Validate the pixels of the second YUV copy, got: 0x%.8x", (unsigned int) pixel);
+      SDL_DestroyTexture(texture);
+   }
+
+   SDL_SetHint(SDL_HINT_RENDER_STREAMING_BUFFERS, NULL);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(target);
+
+   return TEST_COMPLETED;
+}
+
+/* Records the calls of the SDL_RenderReadPixelsAsync() callback */
+typedef struct
+{
+   int calls;
+   int order;
+   int result;
+   void *pixels;
+} _readPixelsResult;
+
+static int _readPixelsCalls = 0;
+
+static void SDLCALL
+_readPixelsCallback(void *userdata, void *pixels, int result)
+{
+   _readPixelsResult *info = (_readPixelsResult *) userdata;
+
+   info->calls++;
+   info->order = ++_readPixelsCalls;
+   info->result = result;
+   info->pixels = pixels;
+}
+
+/**
+ * @brief Tests reading pixels back without flushing the render commands.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderReadPixelsAsync
+ */
+int
+render_testReadPixelsAsync(void *arg)
+{
+   SDL_Surface *target;
+   SDL_Renderer *swrenderer;
+   SDL_RenderStats stats;
+   _readPixelsResult first, second, outside, destroyed;
+   Uint32 full[64 * 64];
+   Uint32 part[4 * 4];
+   Uint32 pixel;
+   SDL_Rect rect;
+   int i, ret;
+
+   SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+   target = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, RENDER_COMPARE_FORMAT);
+   SDLTest_AssertCheck(target != NULL, "Verify target surface was created");
+   swrenderer = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(target);
+      return TEST_ABORTED;
+   }
+   SDL_zero(first);
+   SDL_zero(second);
+   SDL_zero(outside);
+   SDL_zero(destroyed);
+   SDL_memset(part, 0, sizeof(part));
+   _readPixelsCalls = 0;
+
+   ret = SDL_RenderReadPixelsAsync(swrenderer, NULL, RENDER_COMPARE_FORMAT, full, sizeof(full[0]) * 64, NULL, NULL);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_RenderReadPixelsAsync without a callback, expected: -1, got: %i", ret);
+
+   /* Red, read everything, blue, read a part of it, then green */
+   SDL_RenderPresent(swrenderer);
+   SDL_SetRenderDrawColor(swrenderer, 255, 0, 0, 255);
+   SDL_RenderClear(swrenderer);
+   ret = SDL_RenderReadPixelsAsync(swrenderer, NULL, RENDER_COMPARE_FORMAT, full, sizeof(full[0]) * 64, _readPixelsCallback, &first);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixelsAsync, expected: 0, got: %i", ret);
+   SDL_SetRenderDrawColor(swrenderer, 0, 0, 255, 255);
+   SDL_RenderFillRect(swrenderer, NULL);
+   rect.x = 8; rect.y = 8; rect.w = 4; rect.h = 4;
+   ret = SDL_RenderReadPixelsAsync(swrenderer, &rect, RENDER_COMPARE_FORMAT, part, sizeof(part[0]) * 4, _readPixelsCallback, &second);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixelsAsync, expected: 0, got: %i", ret);
+   rect.x = 100;
+   ret = SDL_RenderReadPixelsAsync(swrenderer, &rect, RENDER_COMPARE_FORMAT, part, sizeof(part[0]) * 4, _readPixelsCallback, &outside);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixelsAsync outside of the target, expected: 0, got: %i", ret);
+   SDL_SetRenderDrawColor(swrenderer, 0, 255, 0, 255);
+   SDL_RenderFillRect(swrenderer, NULL);
+   SDLTest_AssertCheck(_readPixelsCalls == 0, "Validate that no pixels were read before the present, got: %i calls", _readPixelsCalls);
+   SDL_RenderPresent(swrenderer);
+
+   SDLTest_AssertCheck(first.calls == 1 && first.order == 1 && first.result == 0 && first.pixels == full,
+                       "Validate the first callback, got: %i calls, order %i, result %i", first.calls, first.order, first.result);
+   SDLTest_AssertCheck(second.calls == 1 && second.order == 2 && second.result == 0 && second.pixels == part,
+                       "Validate the second callback, got: %i calls, order %i, result %i", second.calls, second.order, second.result);
+   SDLTest_AssertCheck(outside.calls == 1 && outside.order == 3 && outside.result == 0,
+                       "Validate the callback of the read outside of the target, got: %i calls, order %i, result %i",
+                       outside.calls, outside.order, outside.result);
+   for (i = 0; i < SDL_arraysize(full); ++i) {
+      if (full[i] != 0xFFFF0000) {
+         break;
+      }
+   }
+   SDLTest_AssertCheck(i == SDL_arraysize(full), "Validate the first read, expected: 0xffff0000, got: 0x%.8x at %i",
+                       (unsigned int) full[i < SDL_arraysize(full) ? i : 0], i);
+   for (i = 0; i < SDL_arraysize(part); ++i) {
+      if (part[i] != 0xFF0000FF) {
+         break;
+      }
+   }
+   SDLTest_AssertCheck(i == SDL_arraysize(part), "Validate the second read, expected: 0xff0000ff, got: 0x%.8x at %i",
+                       (unsigned int) part[i < SDL_arraysize(part) ? i : 0], i);
+   pixel = *(Uint32 *) target->pixels;
+   SDLTest_AssertCheck(pixel == 0xFF00FF00, "Validate the target, expected: 0xff00ff00, got: 0x%.8x", (unsigned int) pixel);
+
+   /* The reads don't flush the queue */
+   SDL_RenderGetStats(swrenderer, &stats);
+   SDLTest_AssertCheck(stats.flushes == 1 && stats.flush_reasons[SDL_RENDERFLUSH_PRESENT] == 1,
+                       "Validate flushes, expected: 1 present, got: %u", stats.flushes);
+
+   /* Reads still queued when the renderer is destroyed fail */
+   ret = SDL_RenderReadPixelsAsync(swrenderer, NULL, RENDER_COMPARE_FORMAT, full, sizeof(full[0]) * 64, _readPixelsCallback, &destroyed);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixelsAsync, expected: 0, got: %i", ret);
+   SDL_DestroyRenderer(swrenderer);
+   SDLTest_AssertCheck(destroyed.calls == 1 && destroyed.result == -1,
+                       "Validate the callback of a read on a destroyed renderer, got: %i calls, result %i",
+                       destroyed.calls, destroyed.result);
+
+   SDL_FreeSurface(target);
+
+   return TEST_COMPLETED;
+}
+
+/* Draws a scene at a logical size of 320x240. Diagonal lines are left out,
+   they are drawn differently at the logical size. */
+static void
+_drawLogicalTestScene(SDL_Renderer *swrenderer, SDL_Texture *texture)
+{
+   SDL_Rect rect;
+   int i;
+
+   SDL_RenderSetLogicalSize(swrenderer, 320, 240);
+   SDL_RenderSetIntegerScale(swrenderer, SDL_TRUE);
+
+   SDL_SetRenderDrawColor(swrenderer, 20, 40, 60, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+
+   SDL_SetRenderDrawBlendMode(swrenderer, SDL_BLENDMODE_BLEND);
+   for (i = 0; i < 12; i++) {
+      rect.x = (i * 53) % 300;
+      rect.y = (i * 31) % 220;
+      rect.w = 30 + i * 7;
+      rect.h = 20 + i * 5;
+      SDL_SetRenderDrawColor(swrenderer, i * 20, 255 - i * 20, 128, 100 + i * 10);
+      SDL_RenderFillRect(swrenderer, &rect);
+   }
+   for (i = 0; i < 200; i++) {
+      SDL_SetRenderDrawColor(swrenderer, 255, i, 0, 160);
+      SDL_RenderDrawPoint(swrenderer, (i * 37) % 320, (i * 23) % 240);
+   }
+   SDL_SetRenderDrawColor(swrenderer, 255, 255, 255, 200);
+   rect.x = 70; rect.y = 50; rect.w = 120; rect.h = 90;
+   SDL_RenderDrawRect(swrenderer, &rect);
+
+   rect.x = 50; rect.y = 37; rect.w = 40; rect.h = 30;
+   SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   SDL_SetTextureColorMod(texture, 255, 128, 64);
+   SDL_SetTextureAlphaMod(texture, 128);
+   rect.x = 120; rect.y = 110;
+   SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   SDL_SetTextureColorMod(texture, 255, 255, 255);
+   SDL_SetTextureAlphaMod(texture, 255);
+
+   rect.x = 20; rect.y = 20; rect.w = 200; rect.h = 150;
+   SDL_RenderSetClipRect(swrenderer, &rect);
+   SDL_SetRenderDrawColor(swrenderer, 0, 0, 255, 128);
+   rect.x = 0; rect.y = 0; rect.w = 300; rect.h = 100;
+   SDL_RenderFillRect(swrenderer, &rect);
+   rect.x = 200; rect.y = 150; rect.w = 40; rect.h = 30;
+   SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   SDL_RenderSetClipRect(swrenderer, NULL);
+
+   SDL_RenderPresent(swrenderer);
+}
+
+/**
+ * @brief Tests that drawing at the logical size and upscaling gives the same
+ *        pixels as drawing scaled
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderSetLogicalSize
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderSetIntegerScale
+ */
+int
+render_testLogicalUpscale(void *arg)
+{
+   const char *upscale[] = { "0", "1", "1" };
+   const char *threads[] = { "1", "1", "4" };
+   SDL_Surface *targets[3], *pattern;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture;
+   SDL_RenderStats stats[3];
+   Uint32 pixel;
+   int ret, i, x, y;
+
+   /* 320x240 scaled by 2 leaves a border of 10 pixels */
+   pattern = SDL_CreateRGBSurfaceWithFormat(0, 40, 30, 32, SDL_PIXELFORMAT_ARGB8888);
+   for (i = 0; i < SDL_arraysize(targets); i++) {
+      targets[i] = SDL_CreateRGBSurfaceWithFormat(0, 660, 500, 32, RENDER_COMPARE_FORMAT);
+   }
+   SDLTest_AssertCheck(pattern && targets[0] && targets[1] && targets[2], "Verify test surfaces were created");
+   if (!pattern || !targets[0] || !targets[1] || !targets[2]) {
+      return TEST_ABORTED;
+   }
+   for (y = 0; y < pattern->h; y++) {
+      for (x = 0; x < pattern->w; x++) {
+         ((Uint32 *)pattern->pixels)[y * (pattern->pitch / 4) + x] = ((x * 6) << 24) | ((x * 6) << 16) | ((y * 8) << 8) | ((x ^ y) * 8);
+      }
+   }
+
+   SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+   for (i = 0; i < SDL_arraysize(targets); i++) {
+      SDL_zero(stats[i]);
+      SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_UPSCALE, upscale[i]);
+      SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, threads[i]);
+      swrenderer = SDL_CreateSoftwareRenderer(targets[i]);
+      SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+      if (swrenderer == NULL) {
+         break;
+      }
+      texture = SDL_CreateTextureFromSurface(swrenderer, pattern);
+      SDLTest_AssertCheck(texture != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+      if (texture != NULL) {
+         SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+         _drawLogicalTestScene(swrenderer, texture);
+         SDL_RenderGetStats(swrenderer, &stats[i]);
+         SDL_DestroyTexture(texture);
+      }
+      SDL_DestroyRenderer(swrenderer);
+   }
+   SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_UPSCALE, "0");
+   SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, "0");
+
+   /* Only a quarter of the pixels are drawn at the logical size */
+   SDLTest_AssertCheck(stats[1].pixels_filled < stats[0].pixels_filled / 2,
+                       "Validate pixels filled at the logical size, expected: less than %u, got: %u",
+                       (unsigned int) (stats[0].pixels_filled / 2), (unsigned int) stats[1].pixels_filled);
+   pixel = *(Uint32 *) targets[1]->pixels;
+   SDLTest_AssertCheck(pixel == 0xFF14283C, "Validate the border, expected: 0xff14283c, got: 0x%.8x", (unsigned int) pixel);
+
+   /* Blended copies go through the unscaled blitters at the logical size,
+      which round a little differently from the scaled ones. */
+   ret = SDLTest_CompareSurfaces(targets[1], targets[0], 9);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+   ret = SDLTest_CompareSurfaces(targets[2], targets[1], 0);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+
+   SDL_FreeSurface(pattern);
+   for (i = 0; i < SDL_arraysize(targets); i++) {
+      SDL_FreeSurface(targets[i]);
+   }
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests packing surfaces into a texture atlas and drawing them
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateTextureAtlas
+ */
+int
+render_testTextureAtlas(void *arg)
+{
+   SDL_Surface *target, *surfaces[10], *large, *small;
+   SDL_Renderer *swrenderer;
+   SDL_TextureAtlas *atlas;
+   SDL_Texture *texture, *other;
+   SDL_BlendMode blendMode;
+   SDL_RenderStats stats;
+   SDL_Rect rects[10], rect, dstrect;
+   int ids[10], id, i, j, ret;
+   Uint32 pixel, expected;
+
+   SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+   target = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, RENDER_COMPARE_FORMAT);
+   large = SDL_CreateRGBSurfaceWithFormat(0, 32, 32, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(target != NULL && large != NULL, "Verify test surfaces were created");
+   swrenderer = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL || large == NULL) {
+      SDL_FreeSurface(target);
+      SDL_FreeSurface(large);
+      return TEST_ABORTED;
+   }
+   for (i = 0; i < SDL_arraysize(surfaces); i++) {
+      surfaces[i] = SDL_CreateRGBSurfaceWithFormat(0, 9, 9, 24, SDL_PIXELFORMAT_RGB24);
+      SDL_FillRect(surfaces[i], NULL, SDL_MapRGB(surfaces[i]->format, i * 20, 255 - i * 20, 100));
+   }
+
+   /* Entries take up 10x10 pixels with the padding, so 9 of them fill a page */
+   atlas = SDL_CreateTextureAtlas(swrenderer, 0, 32, 32);
+   SDLTest_AssertCheck(atlas != NULL, "Verify result from SDL_CreateTextureAtlas is not NULL");
+   if (atlas == NULL) {
+      return TEST_ABORTED;
+   }
+   ret = SDL_AddTextureAtlasSurfaces(atlas, surfaces, 9, ids);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_AddTextureAtlasSurfaces, expected: 0, got: %i", ret);
+   texture = NULL;
+   for (i = 0; i < 9; i++) {
+      ret = SDL_QueryTextureAtlasEntry(atlas, ids[i], i == 0 ? &texture : &other, &rects[i]);
+      SDLTest_AssertCheck(ret == 0 && (i == 0 || other == texture),
+                          "Validate entry %i is in the first texture, got: %i", i, ret);
+      SDLTest_AssertCheck(rects[i].w == 9 && rects[i].h == 9 && rects[i].x >= 0 && rects[i].y >= 0 &&
+                          rects[i].x + rects[i].w <= 32 && rects[i].y + rects[i].h <= 32,
+                          "Validate entry %i, got: %i,%i %ix%i", i, rects[i].x, rects[i].y, rects[i].w, rects[i].h);
+      for (j = 0; j < i; j++) {
+         SDLTest_AssertCheck(!SDL_HasIntersection(&rects[i], &rects[j]), "Validate entries %i and %i don't overlap", j, i);
+      }
+   }
+   id = SDL_AddTextureAtlasSurface(atlas, surfaces[9]);
+   SDLTest_AssertCheck(id > 0, "Validate result from SDL_AddTextureAtlasSurface, expected: > 0, got: %i", id);
+   SDL_QueryTextureAtlasEntry(atlas, id, &other, NULL);
+   SDLTest_AssertCheck(other != NULL && other != texture, "Validate a full page adds a texture");
+
+   /* The copies from one texture are drawn as one command */
+   SDL_RenderPresent(swrenderer);
+   for (i = 0; i < 9; i++) {
+      dstrect.x = (i % 3) * 20;
+      dstrect.y = (i / 3) * 20;
+      dstrect.w = 9;
+      dstrect.h = 9;
+      SDL_RenderCopy(swrenderer, texture, &rects[i], &dstrect);
+   }
+   SDL_RenderPresent(swrenderer);
+   SDL_RenderGetStats(swrenderer, &stats);
+   SDLTest_AssertCheck(stats.commands_merged == 8, "Validate merged commands, expected: 8, got: %u", stats.commands_merged);
+   for (i = 0; i < 9; i++) {
+      pixel = ((Uint32 *) target->pixels)[((i / 3) * 20 + 4) * (target->pitch / 4) + (i % 3) * 20 + 4];
+      expected = 0xFF000000 | ((i * 20) << 16) | ((255 - i * 20) << 8) | 100;
+      SDLTest_AssertCheck(pixel == expected, "Validate entry %i, expected: 0x%.8x, got: 0x%.8x", i, (unsigned int) expected, (unsigned int) pixel);
+   }
+
+   /* Removed space is reused, and the padding of a smaller entry there is cleared */
+   SDL_RemoveTextureAtlasEntry(atlas, ids[4]);
+   ret = SDL_QueryTextureAtlasEntry(atlas, ids[4], NULL, NULL);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_QueryTextureAtlasEntry with a removed entry, expected: -1, got: %i", ret);
+   small = SDL_CreateRGBSurfaceWithFormat(0, 8, 8, 24, SDL_PIXELFORMAT_RGB24);
+   SDLTest_AssertCheck(small != NULL, "Verify test surface was created");
+   if (small != NULL) {
+      SDL_FillRect(small, NULL, SDL_MapRGB(small->format, 255, 255, 255));
+      ids[4] = SDL_AddTextureAtlasSurface(atlas, small);
+      SDL_QueryTextureAtlasEntry(atlas, ids[4], &other, &rect);
+      SDLTest_AssertCheck(other == texture && rect.x == rects[4].x && rect.y == rects[4].y && rect.w == 8 && rect.h == 8,
+                          "Validate the space of a removed entry is reused, got: %i,%i %ix%i", rect.x, rect.y, rect.w, rect.h);
+      SDL_GetTextureBlendMode(texture, &blendMode);
+      SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+      rect.w = rect.h = 9;
+      dstrect.x = dstrect.y = 0;
+      dstrect.w = dstrect.h = 9;
+      SDL_RenderCopy(swrenderer, texture, &rect, &dstrect);
+      SDL_RenderPresent(swrenderer);
+      SDL_SetTextureBlendMode(texture, blendMode);
+      for (i = 0; i < 9; i++) {
+         const Uint32 right = ((Uint32 *) target->pixels)[i * (target->pitch / 4) + 8];
+         const Uint32 below = ((Uint32 *) target->pixels)[8 * (target->pitch / 4) + i];
+         SDLTest_AssertCheck(right == 0 && below == 0,
+                             "Validate padding pixel %i of the reused space, expected: 0 and 0, got: 0x%.8x and 0x%.8x",
+                             i, (unsigned int) right, (unsigned int) below);
+      }
+      SDL_FreeSurface(small);
+   }
+
+   /* An empty page is free again */
+   for (i = 0; i < 9; i++) {
+      SDL_RemoveTextureAtlasEntry(atlas, ids[i]);
+   }
+   SDL_FillRect(large, NULL, 0xFF102030);
+   id = SDL_AddTextureAtlasSurface(atlas, large);
+   ret = SDL_QueryTextureAtlasEntry(atlas, id, &other, &rect);
+   SDLTest_AssertCheck(ret == 0 && other == texture && rect.x == 0 && rect.y == 0,
+                       "Validate a page that was emptied is reused, got: %i,%i", rect.x, rect.y);
+
+   /* Too large surfaces are rejected */
+   SDL_FreeSurface(large);
+   large = SDL_CreateRGBSurfaceWithFormat(0, 33, 8, 32, SDL_PIXELFORMAT_ARGB8888);
+   id = SDL_AddTextureAtlasSurface(atlas, large);
+   SDLTest_AssertCheck(id == -1, "Validate result from SDL_AddTextureAtlasSurface with a surface that doesn't fit, expected: -1, got: %i", id);
+
+   SDL_DestroyTextureAtlas(atlas);
+   SDL_DestroyRenderer(swrenderer);
+   for (i = 0; i < SDL_arraysize(surfaces); i++) {
+      SDL_FreeSurface(surfaces[i]);
+   }
+   SDL_FreeSurface(large);
+   SDL_FreeSurface(target);
+
+   return TEST_COMPLETED;
+}
+
+/* Draws a frame with more vertex data than SDL_HINT_RENDER_VERTEX_CAPACITY reserves */
+static void
+_drawVertexCapacityTestScene(SDL_Renderer *swrenderer, SDL_Vertex *grid, int num_vertices)
+{
+   SDL_Rect rects[40];
+   int i;
+
+   SDL_SetRenderDrawColor(swrenderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+   SDL_RenderGeometry(swrenderer, NULL, grid, num_vertices, NULL, 0);
+   for (i = 0; i < SDL_arraysize(rects); i++) {
+      rects[i].x = i * 8;
+      rects[i].y = 232;
+      rects[i].w = 4;
+      rects[i].h = 8;
+   }
+   SDL_SetRenderDrawColor(swrenderer, 0, 255, 0, SDL_ALPHA_OPAQUE);
+   SDL_RenderFillRects(swrenderer, rects, SDL_arraysize(rects));
+   SDL_RenderPresent(swrenderer);
+}
+
+/**
+ * @brief Tests drawing more geometry than the reserved vertex data holds.
+ */
+int
+render_testVertexCapacity(void *arg)
+{
+   const char *capacity[] = { "64", NULL };
+   const int cols = 40, rows = 29;
+   SDL_Surface *targets[2];
+   SDL_Renderer *swrenderer;
+   SDL_Vertex *grid;
+   Uint32 pixel;
+   Uint8 r, g, b;
+   int ret, i, x, y, num_vertices = 0;
+
+   grid = (SDL_Vertex *) SDL_calloc(cols * rows * 6, sizeof(*grid));
+   SDLTest_AssertCheck(grid != NULL, "Verify vertices were allocated");
+   if (grid == NULL) {
+      return TEST_ABORTED;
+   }
+   /* Two triangles for each 8x8 cell, each cell in its own color */
+   for (y = 0; y < rows; y++) {
+      for (x = 0; x < cols; x++) {
+         const float corners[6][2] = { { 0, 0 }, { 8, 0 }, { 8, 8 }, { 0, 0 }, { 8, 8 }, { 0, 8 } };
+         for (i = 0; i < 6; i++) {
+            SDL_Vertex *v = &grid[num_vertices++];
+            v->position.x = x * 8 + corners[i][0];
+            v->position.y = y * 8 + corners[i][1];
+            v->color.r = (Uint8) (x * 6 + 10);
+            v->color.g = 0;
+            v->color.b = (Uint8) (y * 8 + 10);
+            v->color.a = 255;
+         }
+      }
+   }
+
+   SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+   for (i = 0; i < SDL_arraysize(targets); i++) {
+      targets[i] = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 32, RENDER_COMPARE_FORMAT);
+      SDLTest_AssertCheck(targets[i] != NULL, "Verify target surface was created");
+      SDL_SetHint(SDL_HINT_RENDER_VERTEX_CAPACITY, capacity[i]);
+      swrenderer = targets[i] ? SDL_CreateSoftwareRenderer(targets[i]) : NULL;
+      SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+      if (swrenderer != NULL) {
+         /* The second frame reuses the vertex data the first one grew */
+         _drawVertexCapacityTestScene(swrenderer, grid, num_vertices);
+         _drawVertexCapacityTestScene(swrenderer, grid, num_vertices);
+         SDL_DestroyRenderer(swrenderer);
+      }
+   }
+   SDL_SetHint(SDL_HINT_RENDER_VERTEX_CAPACITY, NULL);
+
+   if (targets[0]) {
+      /* Check that the last cell of the grid and the rects made it */
+      pixel = ((Uint32 *)targets[0]->pixels)[(rows * 8 - 4) * (targets[0]->pitch / 4) + cols * 8 - 4];
+      SDL_GetRGB(pixel, targets[0]->format, &r, &g, &b);
+      SDLTest_AssertCheck(r == (cols - 1) * 6 + 10 && b == (rows - 1) * 8 + 10,
+                          "Validate the last grid cell, expected: %i,0,%i, got: %i,%i,%i",
+                          (cols - 1) * 6 + 10, (rows - 1) * 8 + 10, r, g, b);
+      pixel = ((Uint32 *)targets[0]->pixels)[236 * (targets[0]->pitch / 4) + 313];
+      SDL_GetRGB(pixel, targets[0]->format, &r, &g, &b);
+      SDLTest_AssertCheck(r == 0 && g == 255 && b == 0, "Validate the last rect, expected: 0,255,0, got: %i,%i,%i", r, g, b);
+   }
+   if (targets[0] && targets[1]) {
+      ret = SDLTest_CompareSurfaces(targets[0], targets[1], 0);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces with and without the reserved capacity, expected: 0, got: %i", ret);
+   }
+
+   for (i = 0; i < SDL_arraysize(targets); i++) {
+      SDL_FreeSurface(targets[i]);
+   }
+   SDL_free(grid);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that the SSE2 and NEON rotation give the same pixels as the plain C code.
+ */
+int
+render_testRotateSIMD(void *arg)
+{
+   const char *simd[] = { "1", "0" };
+   const SDL_RendererFlip flips[] = { SDL_FLIP_NONE, SDL_FLIP_HORIZONTAL, SDL_FLIP_VERTICAL };
+   SDL_Surface *targets[2], *pattern;
+   SDL_Renderer *swrenderers[2];
+   SDL_Texture *textures[2];
+   SDL_Rect rect;
+   double angle;
+   int i, y, step, wrong = 0;
+
+   pattern = SDL_CreateRGBSurfaceWithFormat(0, 61, 37, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(pattern != NULL, "Verify pattern surface was created");
+   if (pattern == NULL) {
+      return TEST_ABORTED;
+   }
+   for (i = 0; i < pattern->w * pattern->h; i++) {
+      ((Uint32 *)pattern->pixels)[i] = i * 2654435761u;
+   }
+
+   /* The smooth rotation is the one with SSE2 and NEON code */
+   SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
+   for (i = 0; i < SDL_arraysize(targets); i++) {
+      targets[i] = SDL_CreateRGBSurfaceWithFormat(0, 160, 160, 32, SDL_PIXELFORMAT_ARGB8888);
+      SDLTest_AssertCheck(targets[i] != NULL, "Verify target surface was created");
+      swrenderers[i] = targets[i] ? SDL_CreateSoftwareRenderer(targets[i]) : NULL;
+      SDLTest_AssertCheck(swrenderers[i] != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+      textures[i] = swrenderers[i] ? SDL_CreateTextureFromSurface(swrenderers[i], pattern) : NULL;
+      SDLTest_AssertCheck(textures[i] != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+      if (textures[i] != NULL) {
+         SDL_SetTextureBlendMode(textures[i], SDL_BLENDMODE_NONE);
+      }
+   }
+   SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, NULL);
+
+   if (textures[0] && textures[1]) {
+      /* Odd angles and sizes, so rows start and end at every offset into the vectors */
+      for (step = 0; step < 120; step++) {
+         angle = step * 3.07 - 6.0;
+         rect.w = 40 + (step * 7) % 70;
+         rect.h = 30 + (step * 5) % 50;
+         rect.x = (160 - rect.w) / 2;
+         rect.y = (160 - rect.h) / 2;
+         for (i = 0; i < SDL_arraysize(targets); i++) {
+            SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_SIMD, simd[i]);
+            SDL_SetRenderDrawColor(swrenderers[i], 0, 0, 0, 0);
+            SDL_RenderClear(swrenderers[i]);
+            SDL_RenderCopyEx(swrenderers[i], textures[i], NULL, &rect, angle, NULL, flips[step % SDL_arraysize(flips)]);
+            SDL_RenderPresent(swrenderers[i]);
+         }
+         for (y = 0; y < targets[0]->h; y++) {
+            if (SDL_memcmp((Uint8 *)targets[0]->pixels + y * targets[0]->pitch,
+                           (Uint8 *)targets[1]->pixels + y * targets[1]->pitch, targets[0]->w * 4) != 0) {
+               ++wrong;
+               break;
+            }
+         }
+      }
+      SDLTest_AssertCheck(wrong == 0, "Validate that the rotations match the plain C code, expected: 0 different angles, got: %i", wrong);
+   }
+   SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_SIMD, NULL);
+
+   for (i = 0; i < SDL_arraysize(targets); i++) {
+      if (textures[i]) {
+         SDL_DestroyTexture(textures[i]);
+      }
+      if (swrenderers[i]) {
+         SDL_DestroyRenderer(swrenderers[i]);
+      }
+      SDL_FreeSurface(targets[i]);
+   }
+   SDL_FreeSurface(pattern);
+
+   return TEST_COMPLETED;
+}
+
 /**
  * @brief Checks to see if functionality is supported. Helper function.
  */
@@ -1085,9 +2938,57 @@ static const SDLTest_TestCaseReference renderTest6 =
 static const SDLTest_TestCaseReference renderTest7 =
         {  (SDLTest_TestCaseFp)render_testBlitBlend, "render_testBlitBlend", "Tests blitting with blending", TEST_DISABLED };
 
+static const SDLTest_TestCaseReference renderTest8 =
+        {  (SDLTest_TestCaseFp)render_testSoftwareYUVCopy, "render_testSoftwareYUVCopy", "Tests copying YUV textures with the software renderer", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest9 =
+        {  (SDLTest_TestCaseFp)render_testSoftwareThreads, "render_testSoftwareThreads", "Tests drawing with the software renderer on several threads", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest10 =
+        {  (SDLTest_TestCaseFp)render_testCopyBatch, "render_testCopyBatch", "Tests drawing a batch of texture copies", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest11 =
+        {  (SDLTest_TestCaseFp)render_testMergedCommands, "render_testMergedCommands", "Tests merging draw commands in the batching queue", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest12 =
+        {  (SDLTest_TestCaseFp)render_testRotatedCopies, "render_testRotatedCopies", "Tests flipped and rotated copies with the software renderer", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest13 =
+        {  (SDLTest_TestCaseFp)render_testWideLines, "render_testWideLines", "Tests wide lines and convex polygons with the software renderer", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest14 =
+        {  (SDLTest_TestCaseFp)render_testGeometry, "render_testGeometry", "Tests triangle geometry with the software renderer", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest15 =
+        {  (SDLTest_TestCaseFp)render_testStats, "render_testStats", "Tests the frame statistics of the software renderer", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest16 =
+        {  (SDLTest_TestCaseFp)render_testCapture, "render_testCapture", "Tests recording and playing back a render capture", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest17 =
+        {  (SDLTest_TestCaseFp)render_testDamage, "render_testDamage", "Tests the damage rects of the software renderer", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest18 =
+        {  (SDLTest_TestCaseFp)render_testStreamingBuffers, "render_testStreamingBuffers", "Tests updating multi-buffered streaming textures while they are queued", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest19 =
+        {  (SDLTest_TestCaseFp)render_testReadPixelsAsync, "render_testReadPixelsAsync", "Tests reading pixels back without flushing the render commands", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest20 =
+        {  (SDLTest_TestCaseFp)render_testLogicalUpscale, "render_testLogicalUpscale", "Tests drawing at the logical size and upscaling when presenting", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest21 =
+        {  (SDLTest_TestCaseFp)render_testTextureAtlas, "render_testTextureAtlas", "Tests packing surfaces into a texture atlas and drawing them", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest22 =
+        {  (SDLTest_TestCaseFp)render_testVertexCapacity, "render_testVertexCapacity", "Tests drawing more geometry than the reserved vertex data holds", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest23 =
+        {  (SDLTest_TestCaseFp)render_testRotateSIMD, "render_testRotateSIMD", "Tests that the SSE2 and NEON rotation give the same pixels as the plain C code", TEST_ENABLED };
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] =  {
-    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, NULL
+    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, &renderTest8, &renderTest9, &renderTest10, &renderTest11, &renderTest12, &renderTest13, &renderTest14, &renderTest15, &renderTest16, &renderTest17, &renderTest18, &renderTest19, &renderTest20, &renderTest21, &renderTest22, &renderTest23, NULL
 };
 
 /* Render test suite (global) */
@@ -588,6 +588,263 @@ surface_testBlitBlendLoop(void *arg) {
 
 }
 
+/**
+ * @brief Tests bilinear stretch blits.
+ */
+int
+surface_testSoftStretchLinear(void *arg)
+{
+    static const Uint32 formats[] = { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB565 };
+    SDL_Surface *src, *dst;
+    Uint32 pixel, c0, c1, mid;
+    int i, x, y, ret;
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        src = SDL_CreateRGBSurfaceWithFormat(0, 2, 2, 0, formats[i]);
+        dst = SDL_CreateRGBSurfaceWithFormat(0, 7, 5, 0, formats[i]);
+        SDLTest_AssertCheck(src != NULL && dst != NULL, "Verify surfaces are not NULL");
+        if (src == NULL || dst == NULL) {
+            SDL_FreeSurface(src);
+            SDL_FreeSurface(dst);
+            continue;
+        }
+
+        /* A solid color has to come out unchanged */
+        pixel = SDL_MapRGBA(src->format, 0x40, 0x80, 0xC0, 0xFF);
+        SDL_FillRect(src, NULL, pixel);
+        ret = SDL_SoftStretchLinear(src, NULL, dst, NULL);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SoftStretchLinear, expected: 0, got: %i", ret);
+        for (y = 0; y < dst->h; ++y) {
+            for (x = 0; x < dst->w; ++x) {
+                Uint32 value;
+                if (dst->format->BytesPerPixel == 4) {
+                    value = ((Uint32 *) ((Uint8 *) dst->pixels + y * dst->pitch))[x];
+                } else {
+                    value = ((Uint16 *) ((Uint8 *) dst->pixels + y * dst->pitch))[x];
+                }
+                if (value != pixel) {
+                    SDLTest_AssertCheck(value == pixel, "Verify pixel (%d,%d), expected: 0x%08x, got: 0x%08x", x, y, pixel, value);
+                    x = dst->w;
+                    y = dst->h;
+                }
+            }
+        }
+
+        /* A horizontal gradient has to keep its end points and produce in-between values */
+        c0 = SDL_MapRGBA(src->format, 0x00, 0x00, 0x00, 0xFF);
+        c1 = SDL_MapRGBA(src->format, 0xFF, 0xFF, 0xFF, 0xFF);
+        if (src->format->BytesPerPixel == 4) {
+            ((Uint32 *) src->pixels)[0] = c0;
+            ((Uint32 *) src->pixels)[1] = c1;
+            SDL_memcpy((Uint8 *) src->pixels + src->pitch, src->pixels, 8);
+        } else {
+            ((Uint16 *) src->pixels)[0] = (Uint16) c0;
+            ((Uint16 *) src->pixels)[1] = (Uint16) c1;
+            SDL_memcpy((Uint8 *) src->pixels + src->pitch, src->pixels, 4);
+        }
+        ret = SDL_SoftStretchLinear(src, NULL, dst, NULL);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SoftStretchLinear, expected: 0, got: %i", ret);
+        if (dst->format->BytesPerPixel == 4) {
+            Uint32 *row = (Uint32 *) ((Uint8 *) dst->pixels + 2 * dst->pitch);
+            SDLTest_AssertCheck(row[0] == c0 && row[6] == c1, "Verify end points of the gradient");
+            mid = row[3];
+        } else {
+            Uint16 *row = (Uint16 *) ((Uint8 *) dst->pixels + 2 * dst->pitch);
+            SDLTest_AssertCheck(row[0] == c0 && row[6] == c1, "Verify end points of the gradient");
+            mid = row[3];
+        }
+        {
+            Uint8 r, g, b;
+            SDL_GetRGB(mid, dst->format, &r, &g, &b);
+            SDLTest_AssertCheck(r > 0x60 && r < 0xA0, "Verify filtered center pixel, got red: %d", (int) r);
+        }
+
+        SDL_FreeSurface(src);
+        SDL_FreeSurface(dst);
+    }
+
+    /* Unsupported formats are rejected */
+    src = SDL_CreateRGBSurfaceWithFormat(0, 2, 2, 0, SDL_PIXELFORMAT_RGB24);
+    dst = SDL_CreateRGBSurfaceWithFormat(0, 4, 4, 0, SDL_PIXELFORMAT_RGB24);
+    ret = SDL_SoftStretchLinear(src, NULL, dst, NULL);
+    SDLTest_AssertCheck(ret == -1, "Validate result from SDL_SoftStretchLinear with RGB24, expected: -1, got: %i", ret);
+    SDL_FreeSurface(src);
+    SDL_FreeSurface(dst);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests linear scaled copies that filter through an intermediate surface.
+ */
+int
+surface_testBlitScaledLinearModulated(void *arg)
+{
+    const SDL_Rect small = { 3, 5, 20, 12 };
+    const SDL_Rect large = { 0, 0, 50, 40 };
+    SDL_Surface *target, *src, *first = NULL;
+    SDL_Renderer *renderer = NULL;
+    SDL_Texture *texture = NULL;
+    int i, x, y, ret;
+
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
+    target = SDL_CreateRGBSurfaceWithFormat(0, 64, 48, 0, SDL_PIXELFORMAT_RGB888);
+    src = SDL_CreateRGBSurfaceWithFormat(0, 8, 8, 0, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(target != NULL && src != NULL, "Verify surfaces are not NULL");
+    if (target && src) {
+        for (y = 0; y < src->h; ++y) {
+            Uint32 *row = (Uint32 *) ((Uint8 *) src->pixels + y * src->pitch);
+            for (x = 0; x < src->w; ++x) {
+                row[x] = SDL_MapRGBA(src->format, (Uint8) (x * 37), (Uint8) (y * 29),
+                                     (Uint8) ((x + y) * 16), (Uint8) (0x40 + x * 24));
+            }
+        }
+        renderer = SDL_CreateSoftwareRenderer(target);
+        SDLTest_AssertCheck(renderer != NULL, "Verify software renderer is not NULL");
+    }
+    if (renderer) {
+        texture = SDL_CreateTextureFromSurface(renderer, src);
+        SDLTest_AssertCheck(texture != NULL, "Verify texture is not NULL");
+    }
+    if (texture) {
+        SDL_SetTextureColorMod(texture, 0xC0, 0x80, 0xFF);
+        SDL_SetTextureAlphaMod(texture, 0xE0);
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+        /* Scaling to another size in between must not leave anything behind */
+        for (i = 0; i < 3; ++i) {
+            SDL_SetRenderDrawColor(renderer, 0x10, 0x20, 0x30, 0xFF);
+            SDL_RenderClear(renderer);
+            SDL_RenderCopy(renderer, texture, NULL, (i == 1) ? &large : &small);
+            SDL_RenderFlush(renderer);
+            if (i == 0) {
+                first = SDL_DuplicateSurface(target);
+            }
+        }
+        SDLTest_AssertCheck(first != NULL, "Verify copy of the first result is not NULL");
+        if (first) {
+            const Uint32 background = SDL_MapRGB(first->format, 0x10, 0x20, 0x30);
+            const Uint32 value = ((Uint32 *) ((Uint8 *) first->pixels + (small.y + 6) * first->pitch))[small.x + 10];
+            SDLTest_AssertCheck(value != background, "Verify the texture was drawn, got: 0x%08x", value);
+            ret = SDLTest_CompareSurfaces(target, first, 0);
+            SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+        }
+    }
+
+    SDL_FreeSurface(first);
+    if (texture) {
+        SDL_DestroyTexture(texture);
+    }
+    if (renderer) {
+        SDL_DestroyRenderer(renderer);
+    }
+    SDL_FreeSurface(src);
+    SDL_FreeSurface(target);
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, NULL);
+
+    return TEST_COMPLETED;
+}
+
+/* Reads one pixel value the way SDL stores it in memory */
+static Uint32
+_readPixel(const Uint8 *p, int bpp)
+{
+    switch (bpp) {
+    case 2:
+        return *(const Uint16 *) p;
+    case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        return p[0] | (p[1] << 8) | (p[2] << 16);
+#else
+        return (p[0] << 16) | (p[1] << 8) | p[2];
+#endif
+    default:
+        return *(const Uint32 *) p;
+    }
+}
+
+/**
+ * @brief Tests the optimized RGB to RGB paths of SDL_ConvertPixels against the pixel format mapping.
+ */
+int
+surface_testConvertPixelsRGB(void *arg)
+{
+    static const Uint32 conversions[][2] = {
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565 },
+        { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB565 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888 },
+        { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888 },
+        { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ABGR8888 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888 },
+        { SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_RGB888 },
+        { SDL_PIXELFORMAT_BGR24, SDL_PIXELFORMAT_RGB888 },
+        { SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ARGB8888 },
+        { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB24 },
+        { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR24 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB24 }
+    };
+    /* Odd sizes, so every kernel also runs its scalar tail */
+    const int width = 37, height = 3;
+    const int src_pitch = width * 4 + 8, dst_pitch = width * 4 + 4;
+    Uint8 *src, *dst;
+    SDL_PixelFormat *src_fmt, *dst_fmt;
+    int i, x, y, ret;
+
+    src = (Uint8 *) SDL_malloc(src_pitch * height);
+    dst = (Uint8 *) SDL_malloc(dst_pitch * height);
+    SDLTest_AssertCheck(src != NULL && dst != NULL, "Verify buffers are not NULL");
+    if (src == NULL || dst == NULL) {
+        SDL_free(src);
+        SDL_free(dst);
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < src_pitch * height; ++i) {
+        src[i] = SDLTest_RandomUint8();
+    }
+
+    for (i = 0; i < SDL_arraysize(conversions); ++i) {
+        int mismatches = 0;
+
+        src_fmt = SDL_AllocFormat(conversions[i][0]);
+        dst_fmt = SDL_AllocFormat(conversions[i][1]);
+        SDLTest_AssertCheck(src_fmt != NULL && dst_fmt != NULL, "Verify pixel formats are not NULL");
+        if (src_fmt == NULL || dst_fmt == NULL) {
+            SDL_FreeFormat(src_fmt);
+            SDL_FreeFormat(dst_fmt);
+            continue;
+        }
+
+        ret = SDL_ConvertPixels(width, height, src_fmt->format, src, src_pitch, dst_fmt->format, dst, dst_pitch);
+        SDLTest_AssertPass("Call to SDL_ConvertPixels(%s -> %s)",
+            SDL_GetPixelFormatName(src_fmt->format), SDL_GetPixelFormatName(dst_fmt->format));
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDL_ConvertPixels, expected: 0, got: %i", ret);
+
+        for (y = 0; y < height; ++y) {
+            for (x = 0; x < width; ++x) {
+                Uint32 s = _readPixel(src + y * src_pitch + x * src_fmt->BytesPerPixel, src_fmt->BytesPerPixel);
+                Uint32 d = _readPixel(dst + y * dst_pitch + x * dst_fmt->BytesPerPixel, dst_fmt->BytesPerPixel);
+                Uint8 r, g, b, a, er, eg, eb, ea;
+
+                SDL_GetRGBA(s, src_fmt, &r, &g, &b, &a);
+                SDL_GetRGBA(SDL_MapRGBA(dst_fmt, r, g, b, a), dst_fmt, &er, &eg, &eb, &ea);
+                SDL_GetRGBA(d, dst_fmt, &r, &g, &b, &a);
+                if (r != er || g != eg || b != eb || a != ea) {
+                    ++mismatches;
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify converted pixels, expected: 0 mismatches, got: %i", mismatches);
+
+        SDL_FreeFormat(src_fmt);
+        SDL_FreeFormat(dst_fmt);
+    }
+
+    SDL_free(src);
+    SDL_free(dst);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Surface test cases */
@@ -630,11 +887,20 @@ static const SDLTest_TestCaseReference surfaceTest11 =
 static const SDLTest_TestCaseReference surfaceTest12 =
         { (SDLTest_TestCaseFp)surface_testBlitBlendMod, "surface_testBlitBlendMod", "Tests blitting routines with mod blending mode.", TEST_ENABLED};
 
+static const SDLTest_TestCaseReference surfaceTest13 =
+        { (SDLTest_TestCaseFp)surface_testSoftStretchLinear, "surface_testSoftStretchLinear", "Tests bilinear stretch blits.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest14 =
+        { (SDLTest_TestCaseFp)surface_testConvertPixelsRGB, "surface_testConvertPixelsRGB", "Tests the optimized RGB to RGB pixel conversions.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest15 =
+        { (SDLTest_TestCaseFp)surface_testBlitScaledLinearModulated, "surface_testBlitScaledLinearModulated", "Tests linear scaled copies with color and alpha modulation.", TEST_ENABLED};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] =  {
     &surfaceTest1, &surfaceTest2, &surfaceTest3, &surfaceTest4, &surfaceTest5,
     &surfaceTest6, &surfaceTest7, &surfaceTest8, &surfaceTest9, &surfaceTest10,
-    &surfaceTest11, &surfaceTest12, NULL
+    &surfaceTest11, &surfaceTest12, &surfaceTest13, &surfaceTest14, &surfaceTest15, NULL
 };
 
 /* Surface test suite (global) */
@@ -0,0 +1,206 @@
+/*
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+/* Simple program:  Play back a render capture as fast as possible and time it
+
+   Record a capture by running a program with SDL_RENDER_CAPTURE_FILE set to
+   the file to write, and optionally SDL_RENDER_CAPTURE_FRAMES to the number
+   of frames to record. With --checksum, every frame is read back and a CRC32
+   of all of them is printed; run with --renderer software to get the same
+   checksum on every machine.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "SDL_test_common.h"
+#include "SDL_test_crc32.h"
+
+static SDLTest_CommonState *state;
+
+/* Call this instead of exit(), so we can clean up SDL: atexit() is evil. */
+static void
+quit(int rc)
+{
+    SDLTest_CommonQuit(state);
+    exit(rc);
+}
+
+/* Adds the pixels of the frame that was just drawn to the checksum */
+static int
+ChecksumFrame(SDL_Renderer *renderer, SDLTest_Crc32Context *crc, CrcUint32 *checksum)
+{
+    int w, h;
+    void *pixels;
+
+    if (SDL_GetRendererOutputSize(renderer, &w, &h) < 0) {
+        return -1;
+    }
+    pixels = SDL_malloc(w * h * 4);
+    if (!pixels) {
+        return SDL_OutOfMemory();
+    }
+    if (SDL_RenderReadPixels(renderer, NULL, SDL_PIXELFORMAT_ARGB8888, pixels, w * 4) < 0) {
+        SDL_free(pixels);
+        return -1;
+    }
+    SDLTest_Crc32CalcBuffer(crc, (CrcUint8 *) pixels, w * h * 4, checksum);
+    SDL_free(pixels);
+    return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+    const char *file = NULL;
+    SDL_bool checksum_frames = SDL_FALSE;
+    int loops = 1;
+    SDL_RenderReplay *replay;
+    SDL_Renderer *renderer;
+    SDLTest_Crc32Context crc;
+    CrcUint32 checksum = 0;
+    Uint64 total = 0, fastest = 0, slowest = 0;
+    double frequency;
+    int frames = 0;
+    int done = 0;
+    int i, loop;
+    int w, h;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, SDL_INIT_VIDEO);
+    if (!state) {
+        return 1;
+    }
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (consumed == 0) {
+            consumed = -1;
+            if (SDL_strcasecmp(argv[i], "--checksum") == 0) {
+                checksum_frames = SDL_TRUE;
+                consumed = 1;
+            } else if (SDL_strcasecmp(argv[i], "--loops") == 0) {
+                if (argv[i + 1]) {
+                    loops = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                    consumed = 2;
+                }
+            } else if (!file && argv[i][0] != '-') {
+                file = argv[i];
+                consumed = 1;
+            }
+        }
+        if (consumed < 0) {
+            SDL_Log("Usage: %s %s [--checksum] [--loops N] file\n", argv[0], SDLTest_CommonUsage(state));
+            quit(1);
+        }
+        i += consumed;
+    }
+    if (!file) {
+        SDL_Log("Usage: %s %s [--checksum] [--loops N] file\n", argv[0], SDLTest_CommonUsage(state));
+        quit(1);
+    }
+
+    /* Make the window the size of the captured output */
+    replay = SDL_RenderOpenReplay(SDL_RWFromFile(file, "rb"), SDL_TRUE, &w, &h);
+    if (!replay) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open %s: %s\n", file, SDL_GetError());
+        quit(1);
+    }
+    SDL_RenderCloseReplay(replay);
+    state->window_w = w;
+    state->window_h = h;
+
+    if (!SDLTest_CommonInit(state)) {
+        quit(2);
+    }
+    renderer = state->renderers[0];
+
+    SDLTest_Crc32Init(&crc);
+    SDLTest_Crc32CalcStart(&crc, &checksum);
+    frequency = (double) SDL_GetPerformanceFrequency();
+
+    for (loop = 0; loop < loops && !done; ++loop) {
+        replay = SDL_RenderOpenReplay(SDL_RWFromFile(file, "rb"), SDL_TRUE, NULL, NULL);
+        if (!replay) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open %s: %s\n", file, SDL_GetError());
+            quit(1);
+        }
+        while (!done) {
+            const Uint64 start = SDL_GetPerformanceCounter();
+            Uint64 elapsed;
+            SDL_Event event;
+            int retval;
+
+            retval = SDL_RenderReplayFrame(replay, renderer);
+            if (retval < 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't replay frame %d: %s\n", frames, SDL_GetError());
+                SDL_RenderCloseReplay(replay);
+                quit(2);
+            }
+            if (retval == 0) {
+                break;
+            }
+            if (checksum_frames) {
+                /* Reading back stalls the renderer, so it isn't timed */
+                SDL_RenderFlush(renderer);
+                elapsed = SDL_GetPerformanceCounter() - start;
+                if (ChecksumFrame(renderer, &crc, &checksum) < 0) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't read frame %d: %s\n", frames, SDL_GetError());
+                    SDL_RenderCloseReplay(replay);
+                    quit(2);
+                }
+                SDL_RenderPresent(renderer);
+            } else {
+                SDL_RenderPresent(renderer);
+                elapsed = SDL_GetPerformanceCounter() - start;
+            }
+
+            total += elapsed;
+            if (frames == 0 || elapsed < fastest) {
+                fastest = elapsed;
+            }
+            if (elapsed > slowest) {
+                slowest = elapsed;
+            }
+            ++frames;
+
+            while (SDL_PollEvent(&event)) {
+                SDLTest_CommonEvent(state, &event, &done);
+            }
+        }
+        SDL_RenderCloseReplay(replay);
+    }
+    SDLTest_Crc32CalcEnd(&crc, &checksum);
+    SDLTest_Crc32Done(&crc);
+
+    /* Print out some timing information */
+    if (frames > 0) {
+        SDL_Log("%d frames in %.2f ms: %.3f ms per frame (fastest %.3f ms, slowest %.3f ms), %.2f frames per second\n",
+                frames, total * 1000.0 / frequency,
+                total * 1000.0 / frequency / frames,
+                fastest * 1000.0 / frequency, slowest * 1000.0 / frequency,
+                total ? frames * frequency / total : 0.0);
+    } else {
+        SDL_Log("The capture has no frames\n");
+    }
+    if (checksum_frames) {
+        SDL_Log("Checksum: 0x%.8x\n", (unsigned int) checksum);
+    }
+
+    quit(0);
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -42,7 +42,7 @@ static SDL_Surface *generate_test_pattern(int pattern_size)
 
         /* R, G, B in alternating horizontal bands */
         for (y = 0; y < pattern->h; y += thickness) {
-            for (i = 0; i < thickness; ++i) {
+            for (i = 0; i < thickness && (y + i) < pattern->h; ++i) {
                 p = (Uint8 *)pattern->pixels + (y + i) * pattern->pitch + ((y/thickness) % 3);
                 for (x = 0; x < pattern->w; ++x) {
                     *p = 0xFF;
@@ -54,7 +54,7 @@ static SDL_Surface *generate_test_pattern(int pattern_size)
         /* Black and white in alternating vertical bands */
         c = 0xFF;
         for (x = 1*thickness; x < pattern->w; x += 2*thickness) {
-            for (i = 0; i < thickness; ++i) {
+            for (i = 0; i < thickness && (x + i) < pattern->w; ++i) {
                 p = (Uint8 *)pattern->pixels + (x + i)*3;
                 for (y = 0; y < pattern->h; ++y) {
                     SDL_memset(p, c, 3);